@@ -34,11 +34,15 @@
 #include <cctype>
 #include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <vector>
 // aux
 #include "testing_set_get_matrix.hpp"
 #include "testing_set_get_matrix_async.hpp"
@@ -945,6 +949,19 @@ int run_bench_test(Arguments& arg, const std::string& filter, bool any_stride, b
             return 0;
     }
 
+    // Only gemm and gemm_ex time their hot calls with rocblas_time_hot_calls, and the other
+    // functions time them together, so warn once for each function which ignores the policy
+    if(rocblas_timing_get_policy().per_call && strcmp(function, "gemm")
+       && strcmp(function, "gemm_ex"))
+    {
+        static std::set<std::string> warned;
+        if(warned.insert(function).second)
+            rocblas_cerr << "rocblas-bench warning: --timing_per_call, --max_iters and "
+                            "--flush_cache are only supported by gemm and gemm_ex, and are "
+                            "ignored by "
+                         << function << std::endl;
+    }
+
 #if BUILD_WITH_TENSILE
     if(!strcmp(function, "gemm") || !strcmp(function, "gemm_batched"))
     {
@@ -1152,11 +1169,9 @@ void fix_batch(int argc, char* argv[])
         }
 }
 
-int main(int argc, char* argv[])
-try
+// Command-line options which are not stored directly in Arguments
+struct bench_options
 {
-    fix_batch(argc, argv);
-    Arguments   arg;
     std::string function;
     std::string precision;
     std::string a_type;
@@ -1167,13 +1182,23 @@ try
     std::string initialization;
     std::string arithmetic_check;
     std::string filter;
+    std::string bench_log;
+    std::string results;
+    std::string results_format;
     rocblas_int device_id;
     int         flags               = 0;
-    bool        datafile            = rocblas_parse_data(argc, argv);
     bool        atomics_not_allowed = false;
     bool        log_function_name   = false;
     bool        any_stride          = false;
 
+    rocblas_timing_policy timing;
+    double                max_time_ms = 0;
+};
+
+// Describe the command-line options, which are parsed into arg and opt.
+// arg and opt are set to the default values of the options.
+options_description bench_options_description(Arguments& arg, bench_options& opt)
+{
     arg.init(); // set all defaults
 
     options_description desc("rocblas-bench command line options");
@@ -1221,7 +1246,7 @@ try
          "Leading dimension of matrix D, is only applicable to BLAS-EX ")
 
         ("any_stride",
-         value<bool>(&any_stride)->default_value(false),
+         value<bool>(&opt.any_stride)->default_value(false),
          "Do not modify input strides based on leading dimensions")
 
         ("stride_a",
@@ -1279,40 +1304,40 @@ try
          value<double>(&arg.betai)->default_value(0.0), "specifies the imaginary part of the scalar beta")
 
         ("function,f",
-         value<std::string>(&function),
+         value<std::string>(&opt.function),
          "BLAS function to test.")
 
         ("precision,r",
-         value<std::string>(&precision)->default_value("f32_r"), "Precision. "
+         value<std::string>(&opt.precision)->default_value("f32_r"), "Precision. "
          "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
 
         ("a_type",
-         value<std::string>(&a_type), "Precision of matrix A. "
+         value<std::string>(&opt.a_type), "Precision of matrix A. "
          "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
 
         ("b_type",
-         value<std::string>(&b_type), "Precision of matrix B. "
+         value<std::string>(&opt.b_type), "Precision of matrix B. "
          "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
 
         ("c_type",
-         value<std::string>(&c_type), "Precision of matrix C. "
+         value<std::string>(&opt.c_type), "Precision of matrix C. "
          "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
 
         ("d_type",
-         value<std::string>(&d_type), "Precision of matrix D. "
+         value<std::string>(&opt.d_type), "Precision of matrix D. "
          "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
 
         ("compute_type",
-         value<std::string>(&compute_type), "Precision of computation. "
+         value<std::string>(&opt.compute_type), "Precision of computation. "
          "Options: h,s,d,c,z,f16_r,f32_r,f64_r,bf16_r,f32_c,f64_c,i8_r,i32_r")
 
         ("initialization",
-         value<std::string>(&initialization)->default_value("hpl"),
+         value<std::string>(&opt.initialization)->default_value("hpl"),
          "Intialize with random integers, trig functions sin and cos, or hpl-like input. "
          "Options: rand_int, trig_float, hpl")
 
         ("arithmetic_check",
-         value<std::string>(&arithmetic_check)->default_value("none"),
+         value<std::string>(&opt.arithmetic_check)->default_value("none"),
          "Check arithmetic for mixed precision gemm_ex. "
          "Options: ieee16_ieee32, none")
 
@@ -1356,6 +1381,42 @@ try
          value<rocblas_int>(&arg.cold_iters)->default_value(2),
          "Cold Iterations to run before entering the timing loop")
 
+        ("timing_per_call",
+         bool_switch(&opt.timing.per_call)->default_value(false),
+         "Time each hot call with events, and report the median, percentiles and standard "
+         "deviation of their times instead of the mean. Only supported by gemm and gemm_ex")
+
+        ("max_iters",
+         value<int>(&opt.timing.max_iters)->default_value(0),
+         "Time more hot calls than --iters, up to max_iters, until the confidence interval of the "
+         "mean meets --target_ci. Implies --timing_per_call")
+
+        ("target_ci",
+         value<double>(&opt.timing.target_ci)->default_value(0.01),
+         "Target half-width of the confidence interval of the mean time, relative to the mean")
+
+        ("confidence",
+         value<double>(&opt.timing.confidence)->default_value(0.95),
+         "Confidence level of the confidence interval of the mean time")
+
+        ("max_time_ms",
+         value<double>(&opt.max_time_ms)->default_value(10000),
+         "Stop timing more hot calls than --iters after this time, in milliseconds")
+
+        ("outlier_fence",
+         value<double>(&opt.timing.outlier_fence)->default_value(3.5),
+         "Exclude hot calls whose times are further from the median than this many scaled median "
+         "absolute deviations from the statistics. 0 keeps all of them")
+
+        ("flush_cache",
+         bool_switch(&opt.timing.flush_cache)->default_value(false),
+         "Overwrite a buffer before each hot call, so that it runs with cold caches. "
+         "Implies --timing_per_call")
+
+        ("flush_bytes",
+         value<size_t>(&opt.timing.flush_bytes)->default_value(0),
+         "Bytes written by each flush of --flush_cache. 0 (default) uses the size of the L2 cache")
+
         ("algo",
          value<uint32_t>(&arg.algo)->default_value(0),
          "extended precision gemm algorithm")
@@ -1365,15 +1426,15 @@ try
          "extended precision gemm solution index")
 
         ("flags",
-         value<int>(&flags)->default_value(rocblas_gemm_flags_none),
+         value<int>(&opt.flags)->default_value(rocblas_gemm_flags_none),
          "gemm_ex flags, 1: Use packed-i8, 0: (default) uses unpacked-i8, available on matrix-inst-supported device")
 
         ("atomics_not_allowed",
-         bool_switch(&atomics_not_allowed)->default_value(false),
+         bool_switch(&opt.atomics_not_allowed)->default_value(false),
          "Atomic operations with non-determinism in results are not allowed")
 
         ("device",
-         value<rocblas_int>(&device_id)->default_value(0),
+         value<rocblas_int>(&opt.device_id)->default_value(0),
          "Set default device to be used for subsequent program runs")
 
         ("c_noalias_d",
@@ -1389,42 +1450,40 @@ try
          "Set fixed workspace memory size instead of using rocblas managed memory")
 
         ("log_function_name",
-         bool_switch(&log_function_name)->default_value(false),
+         bool_switch(&opt.log_function_name)->default_value(false),
          "Function name precedes other itmes.")
 
         ("function_filter",
-         value<std::string>(&filter),
+         value<std::string>(&opt.filter),
          "Simple strstr filter on function name only without wildcards")
 
-        ("help,h", "produces this help message")
+        ("bench_log",
+         value<std::string>(&opt.bench_log),
+         "Run each rocblas-bench command line in a file, such as a bench log written with "
+         "ROCBLAS_LAYER=2 or a script of rocblas-bench commands. - reads standard input.")
 
-        ("version", "Prints the version number");
-    // clang-format on
+        ("results",
+         value<std::string>(&opt.results),
+         "Also write the results of all problems to a single file")
 
-    // parse command line into arg structure and stack variables using desc
-    variables_map vm;
-    store(parse_command_line(argc, argv, desc), vm);
-    notify(vm);
+        ("results_format",
+         value<std::string>(&opt.results_format)->default_value("csv"),
+         "Format of the --results file. Options: csv, json")
 
-    if((argc <= 1 && !datafile) || vm.count("help"))
-    {
-        rocblas_cout << desc << std::endl;
-        return 0;
-    }
+        ("help,h", "produces this help message")
 
-    if(vm.find("version") != vm.end())
-    {
-        size_t size;
-        rocblas_get_version_string_size(&size);
-        std::string blas_version(size - 1, '\0');
-        rocblas_get_version_string(blas_version.data(), size);
-        rocblas_cout << "rocBLAS version: " << blas_version << std::endl;
-        return 0;
-    }
+        ("version", "Prints the version number");
+    // clang-format on
 
-    // transfer local variable state
+    return desc;
+}
 
-    arg.atomics_mode = atomics_not_allowed ? rocblas_atomics_not_allowed : rocblas_atomics_allowed;
+// Transfer the options of a single benchmark from opt to arg, and validate them.
+// Throws std::invalid_argument if an option is invalid.
+void bench_set_arguments(Arguments& arg, bench_options& opt)
+{
+    arg.atomics_mode
+        = opt.atomics_not_allowed ? rocblas_atomics_not_allowed : rocblas_atomics_allowed;
 
     static const char* fp16AltImplEnvStr = std::getenv("ROCBLAS_INTERNAL_FP16_ALT_IMPL");
     static const int   fp16AltImplEnv
@@ -1432,66 +1491,50 @@ try
     if(fp16AltImplEnv != -1)
     {
         if(fp16AltImplEnv == 0)
-            flags &= ~rocblas_gemm_flags_fp16_alt_impl;
+            opt.flags &= ~rocblas_gemm_flags_fp16_alt_impl;
         else
-            flags |= rocblas_gemm_flags_fp16_alt_impl;
+            opt.flags |= rocblas_gemm_flags_fp16_alt_impl;
     }
 
     if((rocblas_gemm_flags_fp16_alt_impl & arg.flags)
        && rocblas_internal_get_arch_name() != "gfx90a")
-        flags &= ~rocblas_gemm_flags_fp16_alt_impl;
+        opt.flags &= ~rocblas_gemm_flags_fp16_alt_impl;
 
-    arg.flags = rocblas_gemm_flags(flags);
+    arg.flags = rocblas_gemm_flags(opt.flags);
 
-    ArgumentModel_set_log_function_name(log_function_name);
-
-    // Device Query
-    rocblas_int device_count = query_device_property();
-
-    rocblas_cout << std::endl;
-    if(device_count <= device_id)
-        throw std::invalid_argument("Invalid Device ID");
-    set_device(device_id);
-
-    if(datafile)
-        return rocblas_bench_datafile(filter, any_stride);
-
-    // single bench run
-
-    // validate arguments
-
-    std::transform(precision.begin(), precision.end(), precision.begin(), ::tolower);
-    auto prec = string2rocblas_datatype(precision);
+    std::transform(opt.precision.begin(), opt.precision.end(), opt.precision.begin(), ::tolower);
+    auto prec = string2rocblas_datatype(opt.precision);
     if(prec == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --precision " + precision);
+        throw std::invalid_argument("Invalid value for --precision " + opt.precision);
 
-    arg.a_type = a_type == "" ? prec : string2rocblas_datatype(a_type);
+    arg.a_type = opt.a_type == "" ? prec : string2rocblas_datatype(opt.a_type);
     if(arg.a_type == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --a_type " + a_type);
+        throw std::invalid_argument("Invalid value for --a_type " + opt.a_type);
 
-    arg.b_type = b_type == "" ? prec : string2rocblas_datatype(b_type);
+    arg.b_type = opt.b_type == "" ? prec : string2rocblas_datatype(opt.b_type);
     if(arg.b_type == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --b_type " + b_type);
+        throw std::invalid_argument("Invalid value for --b_type " + opt.b_type);
 
-    arg.c_type = c_type == "" ? prec : string2rocblas_datatype(c_type);
+    arg.c_type = opt.c_type == "" ? prec : string2rocblas_datatype(opt.c_type);
     if(arg.c_type == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --c_type " + c_type);
+        throw std::invalid_argument("Invalid value for --c_type " + opt.c_type);
 
-    arg.d_type = d_type == "" ? prec : string2rocblas_datatype(d_type);
+    arg.d_type = opt.d_type == "" ? prec : string2rocblas_datatype(opt.d_type);
     if(arg.d_type == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --d_type " + d_type);
+        throw std::invalid_argument("Invalid value for --d_type " + opt.d_type);
 
-    arg.compute_type = compute_type == "" ? prec : string2rocblas_datatype(compute_type);
+    arg.compute_type = opt.compute_type == "" ? prec : string2rocblas_datatype(opt.compute_type);
     if(arg.compute_type == static_cast<rocblas_datatype>(-1))
-        throw std::invalid_argument("Invalid value for --compute_type " + compute_type);
+        throw std::invalid_argument("Invalid value for --compute_type " + opt.compute_type);
 
-    arg.initialization = string2rocblas_initialization(initialization);
+    arg.initialization = string2rocblas_initialization(opt.initialization);
     if(arg.initialization == static_cast<rocblas_initialization>(-1))
-        throw std::invalid_argument("Invalid value for --initialization " + initialization);
+        throw std::invalid_argument("Invalid value for --initialization " + opt.initialization);
 
-    arg.arithmetic_check = string2rocblas_arithmetic_check(arithmetic_check);
+    arg.arithmetic_check = string2rocblas_arithmetic_check(opt.arithmetic_check);
     if(arg.arithmetic_check == static_cast<rocblas_arithmetic_check>(-1))
-        throw std::invalid_argument("Invalid value for --arithmetic_check " + arithmetic_check);
+        throw std::invalid_argument("Invalid value for --arithmetic_check "
+                                    + opt.arithmetic_check);
 
     if(arg.M < 0)
         throw std::invalid_argument("Invalid value for -m " + std::to_string(arg.M));
@@ -1500,11 +1543,150 @@ try
     if(arg.K < 0)
         throw std::invalid_argument("Invalid value for -k " + std::to_string(arg.K));
 
-    int copied = snprintf(arg.function, sizeof(arg.function), "%s", function.c_str());
+    int copied = snprintf(arg.function, sizeof(arg.function), "%s", opt.function.c_str());
     if(copied <= 0 || copied >= sizeof(arg.function))
         throw std::invalid_argument("Invalid value for --function");
+}
+
+// Run each rocblas-bench command line in a bench log, such as one written with ROCBLAS_LAYER=2,
+// or in a script of rocblas-bench commands. Empty lines, comments and other commands are
+// skipped. Options which select the device, the output or the timing apply to the whole run,
+// and are ignored on the command lines.
+int rocblas_bench_log(const std::string& filename, const std::string& filter, bool any_stride)
+{
+    std::ifstream log(filename == "-" ? "/dev/stdin" : filename);
+    if(!log)
+        throw std::invalid_argument("Cannot open bench log " + filename);
+
+    int         ret = 0;
+    std::string line;
+    std::vector<std::string> words;
+    for(size_t line_number = 1; std::getline(log, line); ++line_number)
+    {
+        if(!ArgumentModel_split_bench_command(line, words))
+            continue;
 
-    return run_bench_test(arg, filter, any_stride);
+        std::vector<char*> argv;
+        for(auto& word : words)
+            argv.push_back(&word[0]);
+        argv.push_back(nullptr);
+
+        Arguments     arg;
+        bench_options opt;
+        try
+        {
+            auto          desc = bench_options_description(arg, opt);
+            variables_map vm;
+            store(parse_command_line(int(words.size()), argv.data(), desc), vm);
+            notify(vm);
+            bench_set_arguments(arg, opt);
+        }
+        catch(const std::invalid_argument& exp)
+        {
+            rocblas_cerr << filename << ":" << line_number << ": " << exp.what() << std::endl;
+            ret = -1;
+            continue;
+        }
+
+        ret |= run_bench_test(arg, filter, any_stride || opt.any_stride, true);
+    }
+    test_cleanup::cleanup();
+    return ret;
+}
+
+int main(int argc, char* argv[])
+try
+{
+    fix_batch(argc, argv);
+    Arguments     arg;
+    bench_options opt;
+    bool          datafile = rocblas_parse_data(argc, argv);
+
+    auto desc = bench_options_description(arg, opt);
+
+    // parse command line into arg structure and stack variables using desc
+    variables_map vm;
+    store(parse_command_line(argc, argv, desc), vm);
+    notify(vm);
+
+    if((argc <= 1 && !datafile) || vm.count("help"))
+    {
+        rocblas_cout << desc << std::endl;
+        return 0;
+    }
+
+    if(vm.find("version") != vm.end())
+    {
+        size_t size;
+        rocblas_get_version_string_size(&size);
+        std::string blas_version(size - 1, '\0');
+        rocblas_get_version_string(blas_version.data(), size);
+        rocblas_cout << "rocBLAS version: " << blas_version << std::endl;
+        return 0;
+    }
+
+    if(datafile && opt.bench_log != "")
+        throw std::invalid_argument("--bench_log cannot be used with --yaml or --data");
+
+    ArgumentModel_results_format results_format;
+    if(opt.results_format == "csv")
+        results_format = ArgumentModel_results_format::csv;
+    else if(opt.results_format == "json")
+        results_format = ArgumentModel_results_format::json;
+    else
+        throw std::invalid_argument("Invalid value for --results_format " + opt.results_format);
+
+    ArgumentModel_set_log_function_name(opt.log_function_name);
+
+    if(!(opt.timing.target_ci > 0))
+        throw std::invalid_argument("Invalid value for --target_ci "
+                                    + std::to_string(opt.timing.target_ci));
+    if(!(opt.timing.confidence > 0 && opt.timing.confidence < 1))
+        throw std::invalid_argument("Invalid value for --confidence "
+                                    + std::to_string(opt.timing.confidence));
+    if(!(opt.timing.outlier_fence >= 0))
+        throw std::invalid_argument("Invalid value for --outlier_fence "
+                                    + std::to_string(opt.timing.outlier_fence));
+
+    // Adaptive iteration counts and cache flushes need the time of each hot call
+    if(opt.timing.max_iters > 0 || opt.timing.flush_cache)
+        opt.timing.per_call = true;
+    opt.timing.max_time_us = opt.max_time_ms * 1000;
+    rocblas_timing_set_policy(opt.timing);
+
+    // Device Query
+    rocblas_int device_count = query_device_property();
+
+    rocblas_cout << std::endl;
+    if(device_count <= opt.device_id)
+        throw std::invalid_argument("Invalid Device ID");
+    set_device(opt.device_id);
+
+    std::unique_ptr<rocblas_internal_ostream> results;
+    if(opt.results != "")
+    {
+        results = std::make_unique<rocblas_internal_ostream>(opt.results);
+        ArgumentModel_set_results(results.get(), results_format);
+    }
+
+    int ret;
+    if(datafile || opt.bench_log != "")
+    {
+        // Handles and memory are reused from one problem to the next
+        rocblas_client_set_reuse(true);
+        ret = datafile ? rocblas_bench_datafile(opt.filter, opt.any_stride)
+                       : rocblas_bench_log(opt.bench_log, opt.filter, opt.any_stride);
+        rocblas_client_set_reuse(false);
+    }
+    else
+    {
+        // single bench run
+        bench_set_arguments(arg, opt);
+        ret = run_bench_test(arg, opt.filter, opt.any_stride);
+    }
+
+    ArgumentModel_set_results(nullptr, results_format);
+    return ret;
 }
 catch(const std::invalid_argument& exp)
 {
@@ -0,0 +1,62 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+/*****************************************************************************
+ * rocblas-log-decode converts a binary log, written when ROCBLAS_LAYER      *
+ * includes rocblas_layer_mode_log_binary (8), into the text of the trace    *
+ * and bench logs.                                                           *
+ *                                                                           *
+ *     rocblas-log-decode binary_log [trace_output [bench_output]]           *
+ *                                                                           *
+ * Outputs which are not given are written to standard output.               *
+ *****************************************************************************/
+
+#include "binary_log.hpp"
+#include <cstdio>
+#include <memory>
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2 || argc > 4)
+    {
+        fprintf(stderr, "Usage: %s binary_log [trace_output [bench_output]]\n", argv[0]);
+        return 1;
+    }
+
+    auto open_output = [&](int i) {
+        return i < argc ? std::make_unique<rocblas_internal_ostream>(argv[i])
+                        : std::make_unique<rocblas_internal_ostream>(STDOUT_FILENO);
+    };
+    auto trace_os = open_output(2);
+    auto bench_os = open_output(3);
+
+    rocblas_binary_log_decoder decoder;
+    uint64_t                   dropped;
+    if(!decoder.decode(argv[1], *trace_os, *bench_os, dropped))
+    {
+        fprintf(stderr, "%s: %s is not a rocBLAS binary log\n", argv[0], argv[1]);
+        return 1;
+    }
+    if(dropped)
+        fprintf(stderr, "%s: %llu calls were dropped\n", argv[0], (unsigned long long)dropped);
+    return 0;
+}
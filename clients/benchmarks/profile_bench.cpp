@@ -0,0 +1,147 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+/*****************************************************************************
+ * rocblas-profile-bench measures the host time taken to count profiled      *
+ * calls from a number of threads. It compares rocblas_sharded_counter, with *
+ * which profile logging counts calls, to a table behind a reader-writer     *
+ * lock, with which profile logging counted calls before.                    *
+ *                                                                           *
+ *     rocblas-profile-bench [threads [calls [keys]]]                        *
+ *                                                                           *
+ * Each thread adds calls argument tuples, taken in turn from keys distinct  *
+ * tuples. The time per call is reported for 1, 2, 4, ... up to threads      *
+ * threads; it stays constant when the counting scales with the threads.     *
+ *****************************************************************************/
+
+#include "sharded_counter.hpp"
+#include "tuple_helper.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // Argument tuple of a profiled call, as built by log_profile
+    using tuple_t = std::tuple<const char*,
+                               const char*,
+                               const char*,
+                               rocblas_int,
+                               const char*,
+                               rocblas_int,
+                               const char*,
+                               rocblas_int>;
+    using hash_t  = tuple_helper::hash_t<tuple_t>;
+    using equal_t = tuple_helper::equal_t<tuple_t>;
+
+    // Table behind a reader-writer lock, as argument_profile counted calls before
+    class locked_counter
+    {
+        std::shared_timed_mutex                              m_mutex;
+        std::unordered_map<tuple_t, size_t, hash_t, equal_t> m_map;
+
+    public:
+        void add(tuple_t&& key)
+        {
+            {
+                // Existing tuples are counted atomically under a shared lock
+                std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+                auto                                      p = m_map.find(key);
+                if(p != m_map.end())
+                {
+                    __atomic_fetch_add(&p->second, 1, __ATOMIC_SEQ_CST);
+                    return;
+                }
+            }
+
+            // New tuples are inserted under an exclusive lock
+            std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+            __atomic_fetch_add(&m_map[std::move(key)], 1, __ATOMIC_SEQ_CST);
+        }
+    };
+
+    using sharded_counter = rocblas_sharded_counter<tuple_t, hash_t, equal_t>;
+
+    // Return the wall time in nanoseconds per call taken by threads threads, each adding
+    // calls tuples to a Counter, including the merging of the counts when it is destroyed
+    template <typename Counter>
+    double time_counter(int threads, size_t calls, rocblas_int keys)
+    {
+        auto start = std::chrono::steady_clock::now();
+        {
+            Counter                  counter;
+            std::vector<std::thread> workers;
+            for(int t = 0; t < threads; ++t)
+                workers.emplace_back([&counter, calls, keys, t] {
+                    for(size_t i = 0; i < calls; ++i)
+                        counter.add(tuple_t{"rocblas_function",
+                                            "rocblas_sgemm",
+                                            "M",
+                                            rocblas_int((i + t) % keys),
+                                            "N",
+                                            128,
+                                            "K",
+                                            128});
+                });
+            for(auto& worker : workers)
+                worker.join();
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / calls;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc > 4)
+    {
+        fprintf(stderr, "Usage: %s [threads [calls [keys]]]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int         threads = argc > 1 ? atoi(argv[1]) : int(std::thread::hardware_concurrency());
+    long long   calls   = argc > 2 ? atoll(argv[2]) : 1000000;
+    rocblas_int keys    = argc > 3 ? atoi(argv[3]) : 16;
+    if(threads < 1 || calls < 1 || keys < 1)
+    {
+        fprintf(stderr, "%s: threads, calls and keys must be positive\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("%d keys, %lld calls per thread\n", keys, calls);
+    printf("%8s %16s %16s %8s\n", "threads", "locked ns/call", "sharded ns/call", "speedup");
+    for(int t = 1;; t = t * 2 < threads ? t * 2 : threads)
+    {
+        double locked  = time_counter<locked_counter>(t, calls, keys);
+        double sharded = time_counter<sharded_counter>(t, calls, keys);
+        printf("%8d %16.1f %16.1f %8.2f\n", t, locked, sharded, locked / sharded);
+        if(t == threads)
+            break;
+    }
+
+    return EXIT_SUCCESS;
+}
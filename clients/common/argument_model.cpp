@@ -21,6 +21,12 @@
  * ************************************************************************ */
 
 #include "argument_model.hpp"
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <regex>
+#include <sstream>
+#include <vector>
 
 // this should have been a member variable but due to the complex variadic template this singleton allows global control
 
@@ -35,3 +41,127 @@ bool ArgumentModel_get_log_function_name()
 {
     return log_function_name;
 }
+
+static rocblas_internal_ostream*    results_os     = nullptr;
+static ArgumentModel_results_format results_format = ArgumentModel_results_format::csv;
+static std::string                  results_names; // column names of the last CSV result
+static std::mutex                   results_mutex;
+
+void ArgumentModel_set_results(rocblas_internal_ostream*    os,
+                               ArgumentModel_results_format format)
+{
+    std::lock_guard<std::mutex> lock(results_mutex);
+    results_os     = os;
+    results_format = format;
+    results_names.clear();
+}
+
+bool ArgumentModel_get_results()
+{
+    return results_os != nullptr;
+}
+
+void ArgumentModel_log_results(const char* function, std::string names, std::string values)
+{
+    std::lock_guard<std::mutex> lock(results_mutex);
+    if(!results_os)
+        return;
+
+    // The function name is always the first column
+    if(!log_function_name)
+    {
+        names  = "function," + names;
+        values = function + (',' + values);
+    }
+
+    if(results_format == ArgumentModel_results_format::json)
+        ArgumentModel_write_json(*results_os, names, values);
+    else
+    {
+        if(names != results_names)
+        {
+            *results_os << names << "\n";
+            results_names = std::move(names);
+        }
+        *results_os << values << "\n";
+    }
+    results_os->flush();
+}
+
+// Split a comma-separated list, removing the spaces around each item
+static std::vector<std::string> split_list(const std::string& list)
+{
+    std::vector<std::string> items;
+    for(size_t begin = 0; begin <= list.size();)
+    {
+        size_t end = list.find(',', begin);
+        if(end == std::string::npos)
+            end = list.size();
+        size_t first = list.find_first_not_of(' ', begin);
+        size_t last  = list.find_last_not_of(' ', end - 1);
+        items.push_back(first < end && last != std::string::npos && last >= first
+                            ? list.substr(first, last - first + 1)
+                            : "");
+        begin = end + 1;
+    }
+    return items;
+}
+
+// Write a string as a quoted JSON string
+static void write_json_string(rocblas_internal_ostream& os, const std::string& str)
+{
+    os << '"';
+    for(char c : str)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20)
+        {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", c);
+            os << escape;
+        }
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+void ArgumentModel_write_json(rocblas_internal_ostream& os,
+                              const std::string&        names,
+                              const std::string&        values)
+{
+    static const std::regex number(R"(-?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?)");
+
+    auto name_list  = split_list(names);
+    auto value_list = split_list(values);
+    auto count      = std::min(name_list.size(), value_list.size());
+
+    os << "{";
+    for(size_t i = 0; i < count; ++i)
+    {
+        os << (i ? ", " : "");
+        write_json_string(os, name_list[i]);
+        os << ": ";
+        if(std::regex_match(value_list[i], number))
+            os << value_list[i];
+        else
+            write_json_string(os, value_list[i]);
+    }
+    os << "}\n";
+}
+
+bool ArgumentModel_split_bench_command(const std::string& line, std::vector<std::string>& words)
+{
+    std::istringstream line_stream(line);
+    words.assign(std::istream_iterator<std::string>(line_stream), {});
+    if(words.empty() || words[0][0] == '#')
+        return false;
+
+    // The command is optional, but if there is one, it must be rocblas-bench
+    if(words[0][0] != '-')
+        return words[0].substr(words[0].find_last_of('/') + 1) == "rocblas-bench";
+
+    words.insert(words.begin(), "rocblas-bench");
+    return true;
+}
@@ -20,8 +20,10 @@
  *
  * ************************************************************************/
 #include "cblas_interface.hpp"
+#include "rocblas_convert.hpp"
 #include "rocblas_vector.hpp"
 #include "utility.hpp"
+#include <algorithm>
 #include <bitset>
 #include <omp.h>
 
@@ -370,18 +372,22 @@ void cblas_dgmm(rocblas_side side,
 
     ptrdiff_t shift_x = incx < 0 ? -ptrdiff_t(incx) * (K - 1) : 0;
 
-    for(size_t i = 0; i < m; i++)
+    // The columns are distributed over the threads, and each column is scanned contiguously
+#pragma omp parallel for schedule(static)
+    for(rocblas_int j = 0; j < n; j++)
     {
-        for(size_t j = 0; j < n; j++)
+        const T* A_j = A + j * size_t(lda);
+        T*       C_j = C + j * size_t(ldc);
+        if(rocblas_side_right == side)
         {
-            if(rocblas_side_right == side)
-            {
-                C[i + j * ldc] = A[i + j * lda] * x[shift_x + j * incx];
-            }
-            else
-            {
-                C[i + j * ldc] = A[i + j * lda] * x[shift_x + i * incx];
-            }
+            T x_j = x[shift_x + j * ptrdiff_t(incx)];
+            for(size_t i = 0; i < m; i++)
+                C_j[i] = A_j[i] * x_j;
+        }
+        else
+        {
+            for(size_t i = 0; i < m; i++)
+                C_j[i] = A_j[i] * x[shift_x + i * ptrdiff_t(incx)];
         }
     }
 }
@@ -443,6 +449,27 @@ inline rocblas_double_complex geam_conj_helper(const rocblas_double_complex& x)
     return std::conj(x);
 }
 
+// Side of the square tiles in which the blocked reference routines update a matrix, so that
+// a tile of each operand stays in cache even when the operand is transposed
+constexpr rocblas_int CBLAS_TILE_SIZE = 64;
+
+// Call f(i_begin, i_end, j_begin, j_end) for each tile of an m x n matrix, distributing the
+// tiles over OpenMP threads
+template <typename F>
+static void cblas_for_each_tile(rocblas_int m, rocblas_int n, F f)
+{
+    int64_t tiles_m = (m + CBLAS_TILE_SIZE - 1) / CBLAS_TILE_SIZE;
+    int64_t tiles_n = (n + CBLAS_TILE_SIZE - 1) / CBLAS_TILE_SIZE;
+
+#pragma omp parallel for schedule(static)
+    for(int64_t t = 0; t < tiles_m * tiles_n; t++)
+    {
+        rocblas_int i = rocblas_int(t % tiles_m) * CBLAS_TILE_SIZE;
+        rocblas_int j = rocblas_int(t / tiles_m) * CBLAS_TILE_SIZE;
+        f(i, std::min(i + CBLAS_TILE_SIZE, m), j, std::min(j + CBLAS_TILE_SIZE, n));
+    }
+}
+
 template <typename T>
 void cblas_geam_helper(rocblas_operation transA,
                        rocblas_operation transB,
@@ -457,25 +484,27 @@ void cblas_geam_helper(rocblas_operation transA,
                        T*                C,
                        rocblas_int       ldc)
 {
-    rocblas_int inc1_A = transA == rocblas_operation_none ? 1 : lda;
-    rocblas_int inc2_A = transA == rocblas_operation_none ? lda : 1;
-    rocblas_int inc1_B = transB == rocblas_operation_none ? 1 : ldb;
-    rocblas_int inc2_B = transB == rocblas_operation_none ? ldb : 1;
-
-#pragma omp parallel for
-    for(rocblas_int i = 0; i < M; i++)
-    {
-        for(rocblas_int j = 0; j < N; j++)
+    size_t inc1_A = transA == rocblas_operation_none ? 1 : lda;
+    size_t inc2_A = transA == rocblas_operation_none ? lda : 1;
+    size_t inc1_B = transB == rocblas_operation_none ? 1 : ldb;
+    size_t inc2_B = transB == rocblas_operation_none ? ldb : 1;
+
+    // C is updated tile by tile, so that transposed operands are read from cache
+    cblas_for_each_tile(M, N, [&](rocblas_int i0, rocblas_int i1, rocblas_int j0, rocblas_int j1) {
+        for(size_t j = j0; j < j1; j++)
         {
-            T a_val = alpha ? A[i * inc1_A + j * inc2_A] : 0;
-            T b_val = beta ? B[i * inc1_B + j * inc2_B] : 0;
-            if(transA == rocblas_operation_conjugate_transpose)
-                a_val = geam_conj_helper(a_val);
-            if(transB == rocblas_operation_conjugate_transpose)
-                b_val = geam_conj_helper(b_val);
-            C[i + j * ldc] = alpha * a_val + beta * b_val;
+            for(size_t i = i0; i < i1; i++)
+            {
+                T a_val = alpha ? A[i * inc1_A + j * inc2_A] : 0;
+                T b_val = beta ? B[i * inc1_B + j * inc2_B] : 0;
+                if(transA == rocblas_operation_conjugate_transpose)
+                    a_val = geam_conj_helper(a_val);
+                if(transB == rocblas_operation_conjugate_transpose)
+                    b_val = geam_conj_helper(b_val);
+                C[i + j * ldc] = alpha * a_val + beta * b_val;
+            }
         }
-    }
+    });
 }
 
 template <>
@@ -546,7 +575,137 @@ void cblas_geam(rocblas_operation       transa,
     return cblas_geam_helper(transa, transb, m, n, *alpha, A, lda, *beta, B, ldb, C, ldc);
 }
 
+// Rows, columns and depth of the tiles in which the mixed-precision gemm references convert
+// their operands, so that the converted copies are bounded however large the matrices are
+constexpr rocblas_int CBLAS_GEMM_TILE_M = 512;
+constexpr rocblas_int CBLAS_GEMM_TILE_N = 512;
+constexpr rocblas_int CBLAS_GEMM_TILE_K = 512;
+
+// Convert the rows x cols submatrix of src to dst with leading dimension ld_dst, distributing
+// the columns over OpenMP threads. convert(dst, src, n) converts n contiguous elements.
+template <typename Tdst, typename Tsrc, typename Convert>
+static void cblas_convert_tile(Tdst*       dst,
+                               size_t      ld_dst,
+                               const Tsrc* src,
+                               size_t      ld_src,
+                               rocblas_int rows,
+                               rocblas_int cols,
+                               Convert     convert)
+{
+#pragma omp parallel for schedule(static)
+    for(rocblas_int j = 0; j < cols; j++)
+        convert(dst + j * ld_dst, src + j * ld_src, size_t(rows));
+}
+
+// Convert with the conversions of the types, in bulk for half and bfloat16
+static constexpr auto cblas_convert_n
+    = [](auto* dst, const auto* src, size_t n) { rocblas_convert_n(dst, src, n); };
+
+// Compute a mixed-precision gemm in precision Tc, one tile of C at a time. The tiles of A and
+// B which a tile of C depends on are converted with convert one block of K at a time, and
+// accumulated into the tile. C is updated in place when To is Tc; otherwise the tile of C is
+// converted with convert, and rounded back to To once all of K has been accumulated. convert
+// converts columns of the tiles, as in cblas_convert_tile.
+template <typename Tc, typename Ti, typename To, typename Convert>
+static void cblas_gemm_tiled(rocblas_operation transA,
+                             rocblas_operation transB,
+                             rocblas_int       m,
+                             rocblas_int       n,
+                             rocblas_int       k,
+                             Tc                alpha,
+                             const Ti*         A,
+                             rocblas_int       lda,
+                             const Ti*         B,
+                             rocblas_int       ldb,
+                             Tc                beta,
+                             To*               C,
+                             rocblas_int       ldc,
+                             Convert           convert)
+{
+    constexpr bool convert_C = !std::is_same<To, Tc>{};
+
+    bool transA_ = transA != rocblas_operation_none;
+    bool transB_ = transB != rocblas_operation_none;
+
+    // Leading dimensions of the converted tiles, which are at least 1 even when k is 0
+    rocblas_int tile_m = std::max(std::min(m, CBLAS_GEMM_TILE_M), 1);
+    rocblas_int tile_n = std::max(std::min(n, CBLAS_GEMM_TILE_N), 1);
+    rocblas_int tile_k = std::max(std::min(k, CBLAS_GEMM_TILE_K), 1);
+    rocblas_int ld_A   = transA_ ? tile_k : tile_m;
+    rocblas_int ld_B   = transB_ ? tile_n : tile_k;
+
+    host_vector<Tc> A_tile(size_t(tile_m) * tile_k), B_tile(size_t(tile_k) * tile_n);
+    host_vector<Tc> C_tile(convert_C ? size_t(tile_m) * tile_n : 0);
+
+    for(rocblas_int j = 0; j < n; j += CBLAS_GEMM_TILE_N)
+    {
+        rocblas_int nb = std::min(n - j, CBLAS_GEMM_TILE_N);
+        for(rocblas_int i = 0; i < m; i += CBLAS_GEMM_TILE_M)
+        {
+            rocblas_int mb = std::min(m - i, CBLAS_GEMM_TILE_M);
+
+            To*         C_ij = C + i + j * size_t(ldc);
+            Tc*         C_c;
+            rocblas_int ld_C;
+            if constexpr(convert_C)
+            {
+                cblas_convert_tile(C_tile.data(), tile_m, C_ij, ldc, mb, nb, convert);
+                C_c  = C_tile;
+                ld_C = tile_m;
+            }
+            else
+            {
+                C_c  = C_ij;
+                ld_C = ldc;
+            }
+
+            // One block is computed when k is 0, so that C is still scaled by beta
+            for(rocblas_int l = 0; l < k || l == 0; l += CBLAS_GEMM_TILE_K)
+            {
+                rocblas_int kb = std::min(k - l, CBLAS_GEMM_TILE_K);
+
+                // The tiles are converted in the layout of A and B, so they keep their transposes
+                const Ti* A_il = transA_ ? A + l + i * size_t(lda) : A + i + l * size_t(lda);
+                const Ti* B_lj = transB_ ? B + j + l * size_t(ldb) : B + l + j * size_t(ldb);
+                cblas_convert_tile(A_tile.data(),
+                                   ld_A,
+                                   A_il,
+                                   lda,
+                                   transA_ ? kb : mb,
+                                   transA_ ? mb : kb,
+                                   convert);
+                cblas_convert_tile(B_tile.data(),
+                                   ld_B,
+                                   B_lj,
+                                   ldb,
+                                   transB_ ? nb : kb,
+                                   transB_ ? kb : nb,
+                                   convert);
+
+                cblas_gemm<Tc, Tc, Tc>(transA,
+                                       transB,
+                                       mb,
+                                       nb,
+                                       kb,
+                                       alpha,
+                                       A_tile,
+                                       ld_A,
+                                       B_tile,
+                                       ld_B,
+                                       l ? Tc(1) : beta,
+                                       C_c,
+                                       ld_C);
+            }
+
+            if constexpr(convert_C)
+                cblas_convert_tile(C_ij, ldc, C_tile.data(), tile_m, mb, nb, cblas_convert_n);
+        }
+    }
+}
+
 // gemm
+// cblas does not support rocblas_half or rocblas_bfloat16, so the operands are converted to
+// higher precision float. This gives a more precise result, which is acceptable for testing.
 template <>
 void cblas_gemm<rocblas_bfloat16, float, float>(rocblas_operation       transA,
                                                 rocblas_operation       transB,
@@ -563,35 +722,8 @@ void cblas_gemm<rocblas_bfloat16, float, float>(rocblas_operation       transA,
                                                 rocblas_int             ldc,
                                                 bool                    alt)
 {
-    // cblas does not support rocblas_bfloat16, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C,
-                ldc);
+    cblas_gemm_tiled(
+        transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, cblas_convert_n);
 }
 
 template <>
@@ -610,41 +742,8 @@ void cblas_gemm<rocblas_bfloat16, rocblas_bfloat16, float>(rocblas_operation
                                                            rocblas_int             ldc,
                                                            bool                    alt)
 {
-    // cblas does not support rocblas_bfloat16, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = static_cast<rocblas_bfloat16>(C_float[i]);
+    cblas_gemm_tiled(
+        transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, cblas_convert_n);
 }
 
 template <>
@@ -663,35 +762,8 @@ void cblas_gemm<rocblas_half, float, float>(rocblas_operation   transA,
                                             rocblas_int         ldc,
                                             bool                alt)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = A[i];
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = B[i];
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C,
-                ldc);
+    cblas_gemm_tiled(
+        transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, cblas_convert_n);
 }
 
 template <>
@@ -710,56 +782,17 @@ void cblas_gemm<rocblas_half, rocblas_half, float>(rocblas_operation   transA,
                                                    rocblas_int         ldc,
                                                    bool                alt)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
-
+    // With alt, the operands are truncated to bfloat16 before they are converted to float
+    auto truncate = [](float* dst, const rocblas_half* src, size_t n) {
+        for(size_t i = 0; i < n; i++)
+            dst[i] = rocblas_bfloat16(float(src[i]),
+                                      rocblas_bfloat16::rocblas_truncate_t::rocblas_truncate);
+    };
     if(alt)
-    {
-        for(size_t i = 0; i < sizeA; i++)
-            A_float[i] = rocblas_bfloat16(float(A[i]),
-                                          rocblas_bfloat16::rocblas_truncate_t::rocblas_truncate);
-        for(size_t i = 0; i < sizeB; i++)
-            B_float[i] = rocblas_bfloat16(float(B[i]),
-                                          rocblas_bfloat16::rocblas_truncate_t::rocblas_truncate);
-        for(size_t i = 0; i < sizeC; i++)
-            C_float[i] = rocblas_bfloat16(float(C[i]),
-                                          rocblas_bfloat16::rocblas_truncate_t::rocblas_truncate);
-    }
+        cblas_gemm_tiled(transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, truncate);
     else
-    {
-        for(size_t i = 0; i < sizeA; i++)
-            A_float[i] = A[i];
-        for(size_t i = 0; i < sizeB; i++)
-            B_float[i] = B[i];
-        for(size_t i = 0; i < sizeC; i++)
-            C_float[i] = C[i];
-    }
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = rocblas_half(C_float[i]);
+        cblas_gemm_tiled(
+            transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, cblas_convert_n);
 }
 
 template <>
@@ -778,43 +811,20 @@ void cblas_gemm<rocblas_half, rocblas_half, rocblas_half>(rocblas_operation   tr
                                                           rocblas_int         ldc,
                                                           bool                alt)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
-    // This will give more precise result which is acceptable for testing
-    float alpha_float = alpha;
-    float beta_float  = beta;
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = A[i];
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = B[i];
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = C[i];
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha_float,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta_float,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = rocblas_half(C_float[i]);
+    cblas_gemm_tiled(transA,
+                     transB,
+                     m,
+                     n,
+                     k,
+                     float(alpha),
+                     A,
+                     lda,
+                     B,
+                     ldb,
+                     float(beta),
+                     C,
+                     ldc,
+                     cblas_convert_n);
 }
 
 template <>
@@ -838,40 +848,20 @@ void cblas_gemm<int8_t, int32_t, int32_t>(rocblas_operation transA,
     // floats, so convert to doubles and downcast result down to int32_t.
     // NOTE: This will not properly account for 32-bit integer overflow, however
     //       the result should be acceptable for testing.
-
-    size_t const sizeA = ((transA == rocblas_operation_none) ? k : m) * size_t(lda);
-    size_t const sizeB = ((transB == rocblas_operation_none) ? n : k) * size_t(ldb);
-    size_t const sizeC = n * size_t(ldc);
-
-    host_vector<double> A_double(sizeA);
-    host_vector<double> B_double(sizeB);
-    host_vector<double> C_double(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_double[i] = static_cast<double>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_double[i] = static_cast<double>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_double[i] = static_cast<double>(C[i]);
-
-    // just directly cast, since transA, transB are integers in the enum
-    cblas_dgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_double,
-                lda,
-                B_double,
-                ldb,
-                beta,
-                C_double,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = static_cast<int32_t>(C_double[i]);
+    cblas_gemm_tiled(transA,
+                     transB,
+                     m,
+                     n,
+                     k,
+                     double(alpha),
+                     A,
+                     lda,
+                     B,
+                     ldb,
+                     double(beta),
+                     C,
+                     ldc,
+                     cblas_convert_n);
 }
 
 template <typename T, typename U>
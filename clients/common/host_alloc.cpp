@@ -33,6 +33,7 @@
 
 #include "host_alloc.hpp"
 #include "rocblas_test.hpp"
+#include "singletons.hpp"
 
 //!
 //! @brief Memory free helper.  Returns kB or -1 if unknown.
@@ -116,7 +117,7 @@ void* host_malloc(size_t size)
 {
     if(host_mem_safe(size))
     {
-        void* ptr = malloc(size);
+        void* ptr = rocblas_client_get_reuse() ? host_reuse_malloc(size) : malloc(size);
 
         static int value = -1;
 
@@ -142,8 +143,20 @@ void* host_malloc(size_t size)
 
 void* host_calloc(size_t nmemb, size_t size)
 {
-    if(host_mem_safe(nmemb * size))
-        return calloc(nmemb, size);
-    else
+    if(!host_mem_safe(nmemb * size))
         return nullptr;
+    if(!rocblas_client_get_reuse())
+        return calloc(nmemb, size);
+
+    // Reused memory must be cleared
+    void* ptr = host_reuse_malloc(nmemb * size);
+    if(ptr)
+        memset(ptr, 0, nmemb * size);
+    return ptr;
+}
+
+void host_free(void* ptr)
+{
+    if(!host_reuse_free(ptr))
+        free(ptr);
 }
@@ -229,19 +229,22 @@ static void validation_error [[noreturn]] (const char* name)
 
 // rocblas_gentest.py is expected to conform to this format.
 // rocblas_gentest.py uses rocblas_common.yaml to generate this format.
-void Arguments::validate(std::istream& ifs)
+size_t Arguments::validate(const char* data, size_t size)
 {
     char      header[8]{}, trailer[8]{};
     Arguments arg{};
 
-    ifs.read(header, sizeof(header));
-    ifs >> arg;
-    ifs.read(trailer, sizeof(trailer));
+    if(size < sizeof(header) + sizeof(arg) + sizeof(trailer))
+        validation_error("header");
+
+    memcpy(header, data, sizeof(header));
+    memcpy(&arg, data + sizeof(header), sizeof(arg));
+    memcpy(trailer, data + sizeof(header) + sizeof(arg), sizeof(trailer));
 
-    if(strcmp(header, "rocBLAS"))
+    if(memcmp(header, "rocBLAS", sizeof(header)))
         validation_error("header");
 
-    if(strcmp(trailer, "ROCblas"))
+    if(memcmp(trailer, "ROCblas", sizeof(trailer)))
         validation_error("trailer");
 
     auto check_func = [sig = 0u](const char* name, const auto& value) mutable {
@@ -258,4 +261,6 @@ void Arguments::validate(std::istream& ifs)
     // Apply check_func to each pair (name, value) of Arguments as a tuple
 #define CHECK_FUNC(NAME) check_func(#NAME, arg.NAME)
     FOR_EACH_ARGUMENT(CHECK_FUNC, ;);
+
+    return sizeof(header) + sizeof(arg) + sizeof(trailer);
 }
@@ -0,0 +1,240 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_data.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <queue>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool RocBLAS_TestData::data_file::read_file(const std::string& name)
+{
+#ifndef WIN32
+    // Map regular files. Other files, such as pipes, are read.
+    int fd = open(name.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd == -1)
+        return false;
+
+    struct stat st;
+    if(!fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size)
+    {
+        void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map != MAP_FAILED)
+        {
+            m_map  = map;
+            m_data = static_cast<const char*>(map);
+            m_size = st.st_size;
+        }
+    }
+    close(fd);
+    if(m_map)
+        return true;
+#endif
+
+    std::ifstream ifs(name, std::ifstream::in | std::ifstream::binary);
+    if(!ifs)
+        return false;
+    m_buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    if(ifs.bad())
+        return false;
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    return true;
+}
+
+bool RocBLAS_TestData::data_file::read_index()
+{
+    index_trailer trailer;
+    size_t        remaining = m_size - (m_records - m_data);
+
+    // Without a trailer, the rest of the file consists of records
+    if(remaining < sizeof(trailer)
+       || memcmp(m_data + m_size - sizeof(trailer), "RBINDEX", sizeof(trailer.magic)))
+    {
+        m_count = remaining / sizeof(Arguments);
+        return remaining % sizeof(Arguments) == 0;
+    }
+
+    memcpy(&trailer, m_data + m_size - sizeof(trailer), sizeof(trailer));
+    remaining -= sizeof(trailer);
+
+    // Each record is listed once in the index, with its number
+    size_t record_size = sizeof(Arguments) + sizeof(uint64_t);
+    if(trailer.records > remaining / record_size
+       || trailer.entries > (remaining - trailer.records * record_size) / sizeof(index_entry)
+       || remaining != trailer.records * record_size + trailer.entries * sizeof(index_entry))
+        return false;
+
+    m_count       = trailer.records;
+    m_entry_count = trailer.entries;
+    m_entries     = m_records + m_count * sizeof(Arguments);
+    m_numbers     = m_entries + m_entry_count * sizeof(index_entry);
+
+    // The entries partition the record numbers
+    uint64_t first = 0;
+    for(size_t i = 0; i < m_entry_count; ++i)
+    {
+        index_entry entry;
+        memcpy(&entry, m_entries + i * sizeof(entry), sizeof(entry));
+        if(entry.first != first || entry.count > m_count - first)
+            return false;
+        first += entry.count;
+    }
+    if(first != m_count)
+        return false;
+
+    for(size_t i = 0; i < m_count; ++i)
+    {
+        uint64_t number;
+        memcpy(&number, m_numbers + i * sizeof(number), sizeof(number));
+        if(number >= m_count)
+            return false;
+    }
+    return true;
+}
+
+RocBLAS_TestData::data_file::data_file(const std::string& name)
+{
+    if(!read_file(name))
+    {
+        rocblas_cerr << "Cannot open " << name << ": " << strerror(errno) << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // Validate the data file format
+    m_records = m_data + Arguments::validate(m_data, m_size);
+
+    if(!read_index())
+    {
+        rocblas_cerr << "Malformed test data in " << name << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+RocBLAS_TestData::data_file::~data_file()
+{
+#ifndef WIN32
+    if(m_map)
+        munmap(m_map, m_size);
+#endif
+}
+
+std::vector<size_t>
+    RocBLAS_TestData::data_file::select(bool function_filter(const Arguments&)) const
+{
+    // Without an index, function_filter is called for each record
+    std::vector<size_t> select;
+    if(!m_entries || !function_filter)
+    {
+        Arguments arg;
+        for(size_t i = 0; i < m_count; ++i)
+        {
+            if(sharded() && !m_shard[i])
+                continue;
+            if(function_filter)
+            {
+                get(i, arg);
+                if(!function_filter(arg))
+                    continue;
+            }
+            select.push_back(i);
+        }
+        return select;
+    }
+
+    Arguments arg;
+    for(size_t i = 0; i < m_entry_count; ++i)
+    {
+        index_entry entry;
+        memcpy(&entry, m_entries + i * sizeof(entry), sizeof(entry));
+        if(!entry.count)
+            continue;
+
+        uint64_t number;
+        memcpy(&number, m_numbers + entry.first * sizeof(number), sizeof(number));
+        get(number, arg);
+        if(!function_filter(arg))
+            continue;
+
+        for(size_t j = 0; j < entry.count; ++j)
+        {
+            memcpy(&number, m_numbers + (entry.first + j) * sizeof(number), sizeof(number));
+            if(!sharded() || m_shard[number])
+                select.push_back(number);
+        }
+    }
+
+    // Records of different entries are interleaved in the file, and are kept in file order
+    std::sort(select.begin(), select.end());
+    return select;
+}
+
+void RocBLAS_TestData::data_file::shard(size_t index, size_t count, double cost(const Arguments&))
+{
+    std::vector<double> costs(m_count);
+    Arguments           arg;
+    for(size_t i = 0; i < m_count; ++i)
+    {
+        get(i, arg);
+        costs[i] = cost(arg);
+    }
+
+    auto shards = assign_shards(costs, count);
+    m_shard.resize(m_count);
+    for(size_t i = 0; i < m_count; ++i)
+        m_shard[i] = shards[i] == index;
+}
+
+std::vector<size_t> RocBLAS_TestData::assign_shards(const std::vector<double>& costs,
+                                                    size_t                     count)
+{
+    std::vector<size_t> order(costs.size());
+    for(size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return costs[a] > costs[b];
+    });
+
+    // Min-heap of the shards by total cost, with ties broken by shard number
+    using load_t = std::pair<double, size_t>;
+    std::priority_queue<load_t, std::vector<load_t>, std::greater<load_t>> loads;
+    for(size_t i = 0; i < count; ++i)
+        loads.push({0.0, i});
+
+    std::vector<size_t> shards(costs.size());
+    for(size_t i : order)
+    {
+        auto load = loads.top();
+        loads.pop();
+        shards[i] = load.second;
+        loads.push({load.first + costs[i], load.second});
+    }
+    return shards;
+}
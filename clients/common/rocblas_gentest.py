@@ -26,6 +26,10 @@ import sys
 import os
 import argparse
 import ctypes
+import hashlib
+import multiprocessing
+import shutil
+import tempfile
 from fnmatch import fnmatchcase
 try:  # Import either the C or pure-Python YAML parser
     from yaml import CLoader as Loader
@@ -45,14 +49,89 @@ INCLUDE_RE = re.compile(r'include\s*:\s*([-.\w/]+)')
 
 args = {}
 testcases = set()
+index = {}
 datatypes = {}
 param = {}
 
 
 def main():
     args.update(parse_args().__dict__)
-    for doc in get_yaml_docs():
-        process_doc(doc)
+    source = read_source()
+
+    # With a cache directory, the records generated for the same source by the same version
+    # of this script are reused, and otherwise saved for the next run
+    cache_file = args.get('cache') and os.path.join(args['cache'], cache_key(source) + '.bin')
+    if cache_file and os.path.exists(cache_file):
+        with open(cache_file, 'rb') as cached:
+            shutil.copyfileobj(cached, args['outfile'])
+        return
+
+    out = args['outfile']
+    if cache_file:
+        args['outfile'] = CachedOutput(out, cache_file)
+
+    try:
+        for doc in get_yaml_docs(source):
+            process_doc(doc)
+        write_index(args['outfile'])
+    except BaseException:
+        if cache_file:
+            args['outfile'].discard()
+        raise
+
+    if cache_file:
+        args['outfile'].save()
+        args['outfile'] = out
+
+
+def cache_key(source):
+    """Hash of the expanded YAML source and of this script, which identifies the records"""
+    sha = hashlib.sha256()
+    with open(os.path.abspath(__file__), 'rb') as script:
+        sha.update(script.read())
+    for line in source:
+        sha.update(line[0].encode('utf_8'))
+    return sha.hexdigest()
+
+
+class CachedOutput:
+    """Output file which also writes the records to a temporary file in the cache. Failing to
+    write to the cache is not an error, since the records are still written to the output."""
+
+    def __init__(self, out, path):
+        self.out = out
+        self.path = path
+        try:
+            os.makedirs(os.path.dirname(path), exist_ok=True)
+            fd, self.tmp = tempfile.mkstemp(dir=os.path.dirname(path))
+            self.file = os.fdopen(fd, 'wb')
+        except OSError:
+            self.file = None
+
+    def write(self, byt):
+        self.out.write(byt)
+        if self.file:
+            try:
+                self.file.write(byt)
+            except OSError:
+                self.discard()
+
+    def discard(self):
+        """Remove the temporary file, without caching the records"""
+        if self.file:
+            self.file.close()
+            os.remove(self.tmp)
+            self.file = None
+
+    def save(self):
+        """Move the temporary file into place atomically, so that concurrent runs never see
+        a partial file"""
+        if self.file:
+            try:
+                self.file.close()
+                os.replace(self.tmp, self.path)
+            except OSError:
+                os.remove(self.tmp)
 
 
 def process_doc(doc):
@@ -89,10 +168,37 @@ def process_doc(doc):
     param['Functions'] = doc.get('Functions') or {}
 
     # Instantiate all of the tests, starting with defaults
+    cases = []
     for test in doc['Tests']:
         case = defaults.copy()
         case.update(test)
-        generate(case, instantiate)
+        cases.append(case)
+
+    # Tests are expanded by worker processes, which inherit the datatypes and parameters of
+    # the document. Their records are written in the order of the tests, as when they are
+    # expanded serially, and duplicates are removed across tests.
+    jobs = min(args['jobs'], len(cases))
+    if jobs > 1 and 'fork' in multiprocessing.get_all_start_methods():
+        with multiprocessing.get_context('fork').Pool(jobs) as pool:
+            for records, error in pool.imap(expand_case, cases, chunksize=4):
+                if error is not None:
+                    sys.exit(error)
+                for byt in records:
+                    write_record(byt)
+    else:
+        for case in cases:
+            generate(case, instantiate)
+
+
+def expand_case(case):
+    """Expand one test into its binary records, in a worker process. Errors are returned
+    instead of exiting, so that the main process can report them."""
+    records = []
+    try:
+        generate(case, lambda test: instantiate(test, records.append))
+    except SystemExit as err:
+        return None, err.code
+    return records, None
 
 
 def parse_args():
@@ -115,6 +221,13 @@ Expand rocBLAS YAML test data file into binary Arguments records
                         default=[])
     parser.add_argument('-t', '--template',
                         type=argparse.FileType('r'))
+    parser.add_argument('-j', '--jobs',
+                        help="Number of processes expanding tests",
+                        type=int,
+                        default=os.cpu_count() or 1)
+    parser.add_argument('--cache',
+                        help="Directory of generated files, reused when the "
+                        "YAML source is unchanged")
     return parser.parse_args()
 
 
@@ -145,13 +258,18 @@ def read_yaml_file(file):
     return source
 
 
-def get_yaml_docs():
-    """Parse the YAML file"""
+def read_source():
+    """Read the template and the YAML file, with their includes"""
     source = read_yaml_file(args['infile'])
 
     if args.get('template'):
         source = read_yaml_file(args['template']) + source
 
+    return source
+
+
+def get_yaml_docs(source):
+    """Parse the YAML source"""
     source_str = ''.join([line[0] for line in source])
 
     def mark_str(mark):
@@ -419,8 +537,8 @@ def write_signature(out):
         args['signature_written'] = True
 
 
-def write_test(test):
-    """Write the test case out to the binary file if not seen already"""
+def pack_test(test):
+    """Pack the test case into a binary Arguments record"""
 
     # For each argument declared in arguments, we generate a positional
     # argument in the Arguments constructor. For strings, we pass the
@@ -443,15 +561,53 @@ def write_test(test):
             sys.exit("TypeError: " + str(err) + " for " + name +
                      ", which has type " + str(type(test[name])) + "\n")
 
-    byt = bytes(param['Arguments'](*arg))
+    return bytes(param['Arguments'](*arg))
+
+
+def write_record(byt):
+    """Write the record out to the binary file if not seen already"""
     if byt not in testcases:
         testcases.add(byt)
         write_signature(args['outfile'])
         args['outfile'].write(byt)
+        index_record(byt)
+
 
+def index_record(byt):
+    """Add the number of the record to the index entry of its function"""
+    field = param['Arguments'].function
+    key = byt[field.offset:field.offset + field.size]
+    index.setdefault(key, []).append(len(testcases) - 1)
 
-def instantiate(test):
-    """Instantiate a given test case"""
+
+def write_index(out):
+    """Write the index of the records, followed by a trailer which locates it.
+
+    The index has an entry for each function, in the order in which they first appear, giving
+    the range of its record numbers in the array which follows the entries. Record numbers
+    are in increasing order within each entry."""
+    if not index:
+        return
+    function = next(iter(index))
+    entry = type('IndexEntry', (ctypes.Structure,),
+                 {'_fields_': [('function', ctypes.c_char * len(function)),
+                               ('first', ctypes.c_uint64),
+                               ('count', ctypes.c_uint64)]})
+    trailer = type('IndexTrailer', (ctypes.Structure,),
+                   {'_fields_': [('magic', ctypes.c_char * 8),
+                                 ('records', ctypes.c_uint64),
+                                 ('entries', ctypes.c_uint64)]})
+    first = 0
+    for function, records in index.items():
+        out.write(bytes(entry(function, first, len(records))))
+        first += len(records)
+    for records in index.values():
+        out.write(bytes((ctypes.c_uint64 * len(records))(*records)))
+    out.write(bytes(trailer(b"RBINDEX", len(testcases), len(index))))
+
+
+def instantiate(test, emit=write_record):
+    """Instantiate a given test case, passing its record to emit"""
     test = test.copy()
 
     # Any Arguments fields declared as enums (a_type, b_type, etc.)
@@ -500,7 +656,7 @@ def instantiate(test):
         test['known_bug_platforms'] = ' ' . join(known_bug_platforms) if test[
             'category'] not in ('known_bug') else ''
 
-        write_test(test)
+        emit(pack_test(test))
 
     except KeyError as err:
         sys.exit("Undefined value " + str(err) + "\n" + str(test))
@@ -31,6 +31,15 @@
 #include <string>
 #include <sys/types.h>
 
+// Directory where rocblas_gentest.py caches the data generated from YAML files. The cache
+// is only used when ROCBLAS_TEST_DATA_CACHE is set to a nonempty directory, since files
+// are never removed from it.
+static std::string rocblas_yaml_cache_dir()
+{
+    const char* dir = getenv("ROCBLAS_TEST_DATA_CACHE");
+    return dir ? dir : "";
+}
+
 // Parse YAML data
 static std::string rocblas_parse_yaml(const std::string& yaml)
 {
@@ -38,6 +47,9 @@ static std::string rocblas_parse_yaml(const std::string& yaml)
     auto        exepath = rocblas_exepath();
     auto cmd = exepath + "rocblas_gentest.py --template " + exepath + "rocblas_template.yaml -o "
                + tmp + " " + yaml;
+    auto cache = rocblas_yaml_cache_dir();
+    if(cache != "")
+        cmd += " --cache \"" + cache + "\"";
     rocblas_cerr << cmd << std::endl;
 
 #ifdef WIN32
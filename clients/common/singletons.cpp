@@ -21,6 +21,10 @@
  * ************************************************************************ */
 
 #include "singletons.hpp"
+#include "client_memory_pool.hpp"
+#include "utility.hpp"
+#include <atomic>
+#include <cstdlib>
 
 // global for device memory padding see d_vector.hpp
 size_t g_DVEC_PAD = 4096;
@@ -29,3 +33,89 @@ void d_vector_set_pad_length(size_t pad)
 {
     g_DVEC_PAD = pad;
 }
+
+// global for reusing handles and memory, see rocblas_client_set_reuse()
+static std::atomic<bool> g_client_reuse{false};
+
+namespace
+{
+    struct d_vector_allocator
+    {
+        bool allocate(void** ptr, size_t size)
+        {
+            return (hipMalloc)(ptr, size) == hipSuccess;
+        }
+
+        bool deallocate(void* ptr)
+        {
+            return (hipFree)(ptr) == hipSuccess;
+        }
+    };
+
+    struct host_allocator
+    {
+        bool allocate(void** ptr, size_t size)
+        {
+            return (*ptr = malloc(size)) != nullptr;
+        }
+
+        bool deallocate(void* ptr)
+        {
+            free(ptr);
+            return true;
+        }
+    };
+
+    auto& d_vector_pool()
+    {
+        static rocblas_client_memory_pool<d_vector_allocator> pool;
+        return pool;
+    }
+
+    auto& host_pool()
+    {
+        static rocblas_client_memory_pool<host_allocator> pool;
+        return pool;
+    }
+}
+
+void rocblas_client_set_reuse(bool reuse)
+{
+    g_client_reuse = reuse;
+    if(!reuse)
+    {
+        rocblas_local_handle::release_idle();
+        host_pool().release();
+        d_vector_pool().release();
+    }
+}
+
+bool rocblas_client_get_reuse()
+{
+    return g_client_reuse;
+}
+
+hipError_t d_vector_malloc(void** ptr, size_t size)
+{
+    if(!g_client_reuse)
+        return (hipMalloc)(ptr, size);
+    *ptr = d_vector_pool().allocate(size);
+    return *ptr ? hipSuccess : hipErrorOutOfMemory;
+}
+
+hipError_t d_vector_free(void* ptr)
+{
+    // Memory from the pool is freed by the pool, even after reuse is disabled
+    return d_vector_pool().deallocate(ptr, g_client_reuse) ? hipSuccess : (hipFree)(ptr);
+}
+
+void* host_reuse_malloc(size_t size)
+{
+    return host_pool().allocate(size);
+}
+
+bool host_reuse_free(void* ptr)
+{
+    // Memory from the pool is freed by the pool, even after reuse is disabled
+    return host_pool().deallocate(ptr, g_client_reuse);
+}
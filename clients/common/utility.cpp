@@ -27,13 +27,16 @@
 #endif
 #include "../../library/src/include/handle.hpp"
 #include "d_vector.hpp"
+#include "singletons.hpp"
 #include "utility.hpp"
 #include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 #include <new>
 #include <stdexcept>
 #include <stdlib.h>
+#include <vector>
 
 #ifdef WIN32
 #define strcasecmp(A, B) _stricmp(A, B)
@@ -187,6 +190,18 @@ double get_time_us_no_sync(void)
     return (static_cast<double>(duration));
 };
 
+static rocblas_timing_policy g_timing_policy;
+
+void rocblas_timing_set_policy(const rocblas_timing_policy& policy)
+{
+    g_timing_policy = policy;
+}
+
+const rocblas_timing_policy& rocblas_timing_get_policy()
+{
+    return g_timing_policy;
+}
+
 /* ============================================================================================ */
 /*  device query and print out their ID and name; return number of compute-capable devices. */
 rocblas_int query_device_property()
@@ -264,12 +279,58 @@ void set_device(rocblas_int device_id)
  * local handles *
  *****************/
 
+// Handles which are kept for reuse while rocblas_client_get_reuse() is true
+static std::vector<rocblas_handle> idle_handles;
+static std::mutex                  idle_handles_mutex;
+
+// Restore the state of a handle after it was used, so that it can be reused,
+// and restart its statistics. Numerical checking keeps sampling counts in the
+// handle, so a handle which checks numerics is not reused.
+static bool reset_handle(rocblas_handle handle)
+{
+    handle->rocblas_int8_type = rocblas_int8_type_for_hipblas_default;
+
+    return handle->check_numerics == rocblas_check_numerics_mode_no_check
+           && rocblas_reset_device_memory_stats(handle) == rocblas_status_success
+           && rocblas_reset_latency_stats(handle) == rocblas_status_success
+           && rocblas_set_stream(handle, nullptr) == rocblas_status_success
+           && rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host) == rocblas_status_success
+           && rocblas_set_atomics_mode(handle, rocblas_atomics_allowed) == rocblas_status_success
+           && rocblas_set_performance_metric(handle, rocblas_default_performance_metric)
+                  == rocblas_status_success
+           && rocblas_set_start_stop_events(handle, nullptr, nullptr) == rocblas_status_success
+           && rocblas_set_solution_fitness_query(handle, nullptr) == rocblas_status_success;
+}
+
+// The device memory ownership of a handle, and its size when user-managed, cannot
+// be restored exactly once a problem has changed them, so they are compared instead
+static std::tuple<bool, bool, size_t> device_memory_state(rocblas_handle handle)
+{
+    size_t size          = 0;
+    bool   user_managing = rocblas_is_user_managing_device_memory(handle);
+    if(user_managing)
+        rocblas_get_device_memory_size(handle, &size);
+    return {rocblas_is_managing_device_memory(handle), user_managing, size};
+}
+
 rocblas_local_handle::rocblas_local_handle()
 {
-    auto status = rocblas_create_handle(&m_handle);
+    if(rocblas_client_get_reuse())
+    {
+        std::lock_guard<std::mutex> lock(idle_handles_mutex);
+        if(!idle_handles.empty())
+        {
+            m_handle = idle_handles.back();
+            idle_handles.pop_back();
+        }
+    }
+
+    auto status = m_handle ? rocblas_status_success : rocblas_create_handle(&m_handle);
     if(status != rocblas_status_success)
         throw std::runtime_error(rocblas_status_to_string(status));
 
+    m_device_memory_state = device_memory_state(m_handle);
+
 #ifdef GOOGLE_TEST
     if(t_set_stream_callback)
     {
@@ -305,9 +366,26 @@ rocblas_local_handle::rocblas_local_handle(const Arguments& arg)
 
 rocblas_local_handle::~rocblas_local_handle()
 {
+    if(rocblas_client_get_reuse()
+       && (!m_memory || rocblas_set_workspace(m_handle, nullptr, 0) == rocblas_status_success)
+       && reset_handle(m_handle) && device_memory_state(m_handle) == m_device_memory_state)
+    {
+        std::lock_guard<std::mutex> lock(idle_handles_mutex);
+        idle_handles.push_back(m_handle);
+    }
+    else
+        rocblas_destroy_handle(m_handle);
+
     if(m_memory)
         (hipFree)(m_memory);
-    rocblas_destroy_handle(m_handle);
+}
+
+void rocblas_local_handle::release_idle()
+{
+    std::lock_guard<std::mutex> lock(idle_handles_mutex);
+    for(auto handle : idle_handles)
+        rocblas_destroy_handle(handle);
+    idle_handles.clear();
 }
 
 /*!
@@ -22,12 +22,72 @@
 
 #include "rocblas_test.hpp"
 
+#include "../../library/src/include/async_initializer.hpp"
+#include "../../library/src/include/async_transfer.hpp"
+#include "../../library/src/include/binary_log.hpp"
 #include "../../library/src/include/check_numerics_matrix.hpp"
+#include "../../library/src/include/check_numerics_queue.hpp"
+#include "../../library/src/include/check_numerics_sampler.hpp"
 #include "../../library/src/include/check_numerics_vector.hpp"
+#include "../../library/src/include/latency_stats.hpp"
+#include "../../library/src/include/sharded_counter.hpp"
+#include "../../library/src/include/solution_cache.hpp"
+#include "../../library/src/include/solution_cache_file.hpp"
+#include "../../library/src/include/staging_pool.hpp"
+#include "../../library/src/include/strided_copy.hpp"
+#include "../../library/src/include/workspace_arena.hpp"
+#include "../../library/src/include/workspace_pool.hpp"
+#include "../../library/src/include/workspace_stats.hpp"
+#include "client_memory_pool.hpp"
+#include "rocblas_convert.hpp"
 #include "rocblas_data.hpp"
 #include "rocblas_matrix.hpp"
+#include "rocblas_test_shard.hpp"
 #include "rocblas_vector.hpp"
+#include "timing_stats.hpp"
 #include "type_dispatch.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <map>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+// Tests of the internal components of the library and the clients. Each suite is named
+// after its function, accepts every type and is instantiated once per value of N.
+// The test of suite NAME is testing_NAME.
+#define INTERNAL_TEST_SUITE(NAME)                                                 \
+    struct NAME : RocBLAS_Test<NAME, testing_##NAME>                              \
+    {                                                                             \
+        static bool type_filter(const Arguments&)                                 \
+        {                                                                         \
+            return true;                                                          \
+        }                                                                         \
+                                                                                  \
+        static bool function_filter(const Arguments& arg)                         \
+        {                                                                         \
+            return !strcmp(arg.function, #NAME);                                  \
+        }                                                                         \
+                                                                                  \
+        static std::string name_suffix(const Arguments& arg)                      \
+        {                                                                         \
+            RocBLAS_TestName<NAME> name(arg.name);                                \
+            name << arg.N;                                                        \
+            return std::move(name);                                               \
+        }                                                                         \
+    };                                                                            \
+                                                                                  \
+    TEST_P(NAME, auxiliary)                                                       \
+    {                                                                             \
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_##NAME<>{}(GetParam())); \
+    }                                                                             \
+    INSTANTIATE_TEST_CATEGORIES(NAME)
 
 namespace
 {
@@ -1149,4 +1209,2700 @@ namespace
     }
     INSTANTIATE_TEST_CATEGORIES(check_numerics_matrix);
 
+    //
+    // solution selection cache
+
+    // Mock solution library which counts how many times a solution is selected
+    struct mock_solution_library
+    {
+        std::atomic<size_t> selections{0};
+
+        std::shared_ptr<size_t> findBestSolution(size_t problem)
+        {
+            ++selections;
+            return problem ? std::make_shared<size_t>(problem) : nullptr;
+        }
+    };
+
+    struct mock_problem_key
+    {
+        size_t m, n, k;
+    };
+
+    template <typename...>
+    struct testing_solution_cache : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            using cache_t = rocblas_solution_cache<mock_problem_key, std::shared_ptr<size_t>>;
+
+            mock_solution_library library;
+            cache_t               cache(2);
+
+            auto select = [&](size_t m) {
+                mock_problem_key key{};
+                key.m = m;
+                return cache.find_or_select(key, [&](std::shared_ptr<size_t>& solution) {
+                    solution = library.findBestSolution(m);
+                    return solution != nullptr;
+                });
+            };
+
+            // Repeated problems are only selected once
+            EXPECT_EQ(*select(1), 1u);
+            EXPECT_EQ(*select(1), 1u);
+            EXPECT_EQ(library.selections.load(), 1u);
+            EXPECT_EQ(cache.hits(), 1u);
+            EXPECT_EQ(cache.misses(), 1u);
+
+            // Problems without a solution are not cached
+            EXPECT_EQ(select(0), nullptr);
+            EXPECT_EQ(select(0), nullptr);
+            EXPECT_EQ(library.selections.load(), 3u);
+            EXPECT_EQ(cache.size(), 1u);
+
+            // The least recently used problem is evicted when the cache is full
+            select(2);
+            select(1);
+            select(3);
+            EXPECT_EQ(cache.evictions(), 1u);
+            EXPECT_EQ(cache.size(), 2u);
+            size_t selections = library.selections;
+            select(1);
+            EXPECT_EQ(library.selections.load(), selections);
+            select(2);
+            EXPECT_EQ(library.selections.load(), selections + 1);
+
+            // Capacities from the environment must be whole nonnegative numbers
+            size_t capacity = 7;
+            EXPECT_TRUE(rocblas_parse_solution_cache_capacity(" 0 ", capacity));
+            EXPECT_EQ(capacity, 0u);
+            EXPECT_TRUE(rocblas_parse_solution_cache_capacity("0x100", capacity));
+            EXPECT_EQ(capacity, 256u);
+            for(const char* str : {"", "abc", "-1", "12k", "1.5", "99999999999999999999999"})
+                EXPECT_FALSE(rocblas_parse_solution_cache_capacity(str, capacity)) << str;
+            EXPECT_EQ(capacity, 256u);
+
+            // Concurrent lookups of the same problems are consistent
+            cache.clear();
+            cache.set_capacity(arg.N);
+            std::vector<std::thread> threads;
+            for(int t = 0; t < 8; ++t)
+                threads.emplace_back([&] {
+                    for(int i = 0; i < 1000; ++i)
+                    {
+                        size_t m = i % arg.N + 1;
+                        EXPECT_EQ(*select(m), m);
+                    }
+                });
+            for(auto& thread : threads)
+                thread.join();
+            EXPECT_EQ(cache.hits() + cache.misses(), 8000u);
+            EXPECT_EQ(cache.evictions(), 0u);
+            EXPECT_EQ(cache.size(), size_t(arg.N));
+
+            // A capacity of 0 disables the cache
+            cache.set_capacity(0);
+            EXPECT_FALSE(cache.enabled());
+            EXPECT_EQ(cache.size(), 0u);
+
+            // Argument checking of the C API
+            rocblas_local_handle handle{arg};
+            size_t               hits, misses, evictions, size;
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_get_solution_cache_stats(nullptr, &hits, &misses, &evictions, &size),
+                rocblas_status_invalid_handle);
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_get_solution_cache_stats(handle, nullptr, &misses, &evictions, &size),
+                rocblas_status_invalid_pointer);
+            CHECK_ROCBLAS_ERROR(
+                rocblas_get_solution_cache_stats(handle, &hits, &misses, &evictions, &size));
+            CHECK_ROCBLAS_ERROR(rocblas_clear_solution_cache(handle));
+        }
+    };
+
+    INTERNAL_TEST_SUITE(solution_cache);
+
+    //
+    // persistent solution selection cache
+
+    template <typename...>
+    struct testing_solution_cache_file : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            using file_t = rocblas_solution_cache_file<mock_problem_key>;
+            using state  = file_t::file_state;
+
+            const size_t N = arg.N;
+
+            // Key of a mock problem
+            auto key = [](size_t m) {
+                mock_problem_key key{};
+                key.m = m;
+                key.n = m * 2;
+                return key;
+            };
+
+            // Replace the contents of the file at path
+            auto write_file = [](const std::string& path, const std::string& data) {
+                std::ofstream(path, std::ios::binary | std::ios::trunc) << data;
+            };
+
+            // rocblas_tempname() creates an empty file, which has no header
+            std::string path = rocblas_tempname();
+            EXPECT_EQ(file_t(path, "gfx90a", "1").state(), state::corrupt);
+            remove(path.c_str());
+
+            // Selections are remembered before the file is saved
+            {
+                file_t file(path, "gfx90a", "1");
+                EXPECT_EQ(file.state(), state::missing);
+                for(size_t m = 0; m < N; ++m)
+                    file.insert(key(m), m * 3);
+                int64_t index = -1;
+                EXPECT_TRUE(file.find(key(N / 2), index));
+                EXPECT_EQ(index, int64_t(N / 2 * 3));
+                EXPECT_EQ(file.added(), N);
+                EXPECT_TRUE(file.save());
+            }
+
+            // The file is reloaded by the next process with the same architecture and build
+            {
+                file_t file(path, "gfx90a", "1");
+                EXPECT_EQ(file.state(), state::loaded);
+                EXPECT_EQ(file.loaded(), N);
+                EXPECT_EQ(file.added(), 0u);
+                for(size_t m = 0; m < N; ++m)
+                {
+                    int64_t index = -1;
+                    EXPECT_TRUE(file.find(key(m), index));
+                    EXPECT_EQ(index, int64_t(m * 3));
+                }
+                int64_t index;
+                EXPECT_FALSE(file.find(key(N), index));
+
+                // Selections which are already in the file are not added again
+                file.insert(key(1), 3);
+                EXPECT_EQ(file.added(), 0u);
+
+                // New selections replace those in the file
+                file.insert(key(0), 7);
+                file.insert(key(N), 11);
+                EXPECT_EQ(file.added(), 2u);
+                EXPECT_TRUE(file.save());
+            }
+            {
+                file_t file(path, "gfx90a", "1");
+                EXPECT_EQ(file.state(), state::loaded);
+                EXPECT_EQ(file.loaded(), N + 1);
+                int64_t index = -1;
+                EXPECT_TRUE(file.find(key(0), index));
+                EXPECT_EQ(index, 7);
+                EXPECT_TRUE(file.find(key(N), index));
+                EXPECT_EQ(index, 11);
+            }
+
+            // A file written for another architecture or build is stale, and is not used
+            for(auto arch_build : {std::make_pair("gfx908", "1"), std::make_pair("gfx90a", "2")})
+            {
+                file_t  file(path, arch_build.first, arch_build.second);
+                int64_t index;
+                EXPECT_EQ(file.state(), state::stale);
+                EXPECT_EQ(file.loaded(), 0u);
+                EXPECT_FALSE(file.find(key(0), index));
+            }
+
+            // A stale file is replaced when it is saved
+            {
+                file_t file(path, "gfx908", "1");
+                file.insert(key(0), 5);
+                EXPECT_TRUE(file.save());
+            }
+            EXPECT_EQ(file_t(path, "gfx908", "1").loaded(), 1u);
+            EXPECT_EQ(file_t(path, "gfx90a", "1").state(), state::stale);
+
+            // Truncated files and files which are not solution caches are corrupt
+            std::string contents;
+            {
+                std::ifstream      in(path, std::ios::binary);
+                std::ostringstream ss;
+                ss << in.rdbuf();
+                contents = ss.str();
+            }
+            write_file(path, contents.substr(0, contents.size() - 1));
+            EXPECT_EQ(file_t(path, "gfx908", "1").state(), state::corrupt);
+            write_file(path, contents.substr(0, contents.size() / 2));
+            EXPECT_EQ(file_t(path, "gfx908", "1").state(), state::corrupt);
+            write_file(path, std::string(contents.size(), 'x'));
+            EXPECT_EQ(file_t(path, "gfx908", "1").state(), state::corrupt);
+
+            // A corrupt file is replaced when it is saved
+            {
+                file_t file(path, "gfx908", "1");
+                file.insert(key(2), 9);
+                EXPECT_TRUE(file.save());
+            }
+            EXPECT_EQ(file_t(path, "gfx908", "1").state(), state::loaded);
+
+            remove(path.c_str());
+        }
+    };
+
+    INTERNAL_TEST_SUITE(solution_cache_file);
+
+    //
+    // workspace arena
+
+    // Fake allocator which hands out host memory and records the live slabs
+    struct fake_slab_allocator
+    {
+        std::shared_ptr<std::set<void*>> slabs = std::make_shared<std::set<void*>>();
+        std::shared_ptr<bool>            fail  = std::make_shared<bool>(false);
+
+        bool allocate(void** ptr, size_t size)
+        {
+            if(*fail)
+                return false;
+            *ptr = malloc(size);
+            slabs->insert(*ptr);
+            return *ptr != nullptr;
+        }
+
+        bool deallocate(void* ptr)
+        {
+            free(ptr);
+            return slabs->erase(ptr) == 1;
+        }
+    };
+
+    template <typename...>
+    struct testing_workspace_arena : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            using arena_t = rocblas_workspace_arena<fake_slab_allocator>;
+            using block_t = arena_t::block;
+
+            fake_slab_allocator allocator;
+            auto                slabs = allocator.slabs;
+            {
+                arena_t arena(allocator);
+                block_t a, b, c, d, e, f;
+                size_t  size = arg.N;
+
+                // The first slab is allocated exactly
+                EXPECT_TRUE(arena.reserve(size));
+                EXPECT_EQ(arena.capacity(), size);
+
+                // Requests which do not fit fail unless the arena is allowed to grow
+                EXPECT_TRUE(arena.allocate(size / 2, false, a));
+                EXPECT_FALSE(arena.allocate(size, false, b));
+                EXPECT_TRUE(arena.allocate(size, true, b));
+                EXPECT_EQ(arena.slab_count(), 2u);
+                EXPECT_EQ(arena.capacity(), size + rocblas_workspace_slab_size(size));
+                EXPECT_EQ(arena.in_use(), size / 2 + size);
+
+                // Memory already handed out is never moved
+                EXPECT_NE(a.addr, nullptr);
+                EXPECT_NE(a.slab, b.slab);
+
+                // 0-sized requests succeed without using memory
+                EXPECT_TRUE(arena.allocate(0, false, e));
+                EXPECT_EQ(e.addr, nullptr);
+                EXPECT_TRUE(arena.deallocate(e));
+
+                // The newest slab must be freed in LIFO order
+                EXPECT_TRUE(arena.allocate(1, false, c));
+                EXPECT_EQ(c.slab, b.slab);
+                EXPECT_FALSE(arena.deallocate(b));
+                EXPECT_TRUE(arena.deallocate(c));
+
+                // Older slabs are used when the newest slab is full
+                EXPECT_TRUE(arena.allocate(rocblas_workspace_slab_size(size) - size, false, f));
+                EXPECT_EQ(f.slab, b.slab);
+                EXPECT_TRUE(arena.allocate(size / 4, false, c));
+                EXPECT_EQ(c.slab, a.slab);
+
+                // Older slabs can be freed in any order
+                EXPECT_TRUE(arena.deallocate(a));
+                EXPECT_TRUE(arena.deallocate(c));
+                EXPECT_EQ(arena.available(), size);
+
+                // An older slab is reused once all of its blocks are freed
+                EXPECT_TRUE(arena.allocate(size, false, d));
+                EXPECT_EQ(d.slab, a.slab);
+                EXPECT_TRUE(arena.deallocate(d));
+                EXPECT_TRUE(arena.deallocate(f));
+                EXPECT_TRUE(arena.deallocate(b));
+                EXPECT_EQ(arena.in_use(), 0u);
+
+                // Idle slabs are freed when the arena grows, instead of being kept
+                size_t grown = arena.capacity() + 1;
+                EXPECT_TRUE(arena.allocate(grown, true, d));
+                EXPECT_EQ(arena.slab_count(), 1u);
+                EXPECT_EQ(arena.capacity(), rocblas_workspace_slab_size(grown));
+                EXPECT_EQ(slabs->size(), 1u);
+                EXPECT_TRUE(arena.deallocate(d));
+
+                // If a new slab cannot be allocated, idle slabs are still freed
+                *arena.allocator().fail = true;
+                EXPECT_FALSE(arena.allocate(arena.capacity() + 1, true, d));
+                EXPECT_EQ(arena.slab_count(), 0u);
+                EXPECT_TRUE(slabs->empty());
+                *arena.allocator().fail = false;
+
+                // Memory in use cannot be released
+                EXPECT_TRUE(arena.allocate(size, true, d));
+                EXPECT_FALSE(arena.release());
+                EXPECT_TRUE(arena.deallocate(d));
+                EXPECT_TRUE(arena.release());
+                EXPECT_TRUE(slabs->empty());
+
+                // Adopted memory is never freed by the arena
+                char user_owned[64];
+                arena.adopt(user_owned, sizeof(user_owned));
+                EXPECT_TRUE(arena.allocate(sizeof(user_owned), false, d));
+                EXPECT_EQ(d.addr, user_owned);
+                EXPECT_TRUE(arena.deallocate(d));
+            }
+
+            // All slabs are freed when the arena is destroyed
+            EXPECT_TRUE(slabs->empty());
+        }
+    };
+
+    INTERNAL_TEST_SUITE(workspace_arena);
+
+    //
+    // workspace statistics
+
+    template <typename...>
+    struct testing_workspace_stats : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            // Routine names are recorded by address, so use two copies of the same name
+            static const char gemv[]  = "gemv";
+            static const char gemv2[] = "gemv";
+            static const char trsm[]  = "trsm";
+
+            size_t                  size = arg.N;
+            rocblas_workspace_stats stats;
+
+            // 0-sized requests are ignored
+            stats.record(gemv, 0, true, false, 0, size);
+            EXPECT_EQ(stats.allocations(), 0u);
+            EXPECT_TRUE(stats.routines().empty());
+
+            stats.record(gemv, size, true, false, size, 2 * size);
+            stats.record(trsm, 4 * size, true, true, 5 * size, 6 * size);
+            stats.record(gemv2, 2 * size, true, false, 3 * size, 6 * size);
+            stats.record(trsm, 8 * size, false, false, size, 6 * size);
+
+            EXPECT_EQ(stats.peak_in_use(), 5 * size);
+            EXPECT_EQ(stats.peak_capacity(), 6 * size);
+            EXPECT_EQ(stats.allocations(), 3u);
+            EXPECT_EQ(stats.growths(), 1u);
+            EXPECT_EQ(stats.failures(), 1u);
+            EXPECT_EQ(stats.requested(), 15 * size);
+
+            // Routines with the same name are merged
+            auto routines = stats.routines();
+            ASSERT_EQ(routines.size(), 2u);
+            EXPECT_EQ(routines["gemv"].calls, 2u);
+            EXPECT_EQ(routines["gemv"].requested, 3 * size);
+            EXPECT_EQ(routines["gemv"].max_request, 2 * size);
+            EXPECT_EQ(routines["gemv"].failures, 0u);
+            EXPECT_EQ(routines["trsm"].calls, 2u);
+            EXPECT_EQ(routines["trsm"].max_request, 8 * size);
+            EXPECT_EQ(routines["trsm"].failures, 1u);
+
+            // The statistics are written as YAML, one line per routine
+            std::string path = rocblas_tempname();
+            {
+                rocblas_internal_ostream os(path);
+                stats.write_yaml(os, 0, 6 * size);
+            }
+            std::ifstream     file(path);
+            std::stringstream yaml;
+            yaml << file.rdbuf();
+            EXPECT_NE(yaml.str().find("peak_in_use: " + std::to_string(5 * size)),
+                      std::string::npos);
+            EXPECT_NE(yaml.str().find("growths: 1\n"), std::string::npos);
+            EXPECT_NE(yaml.str().find("    - { routine: \"gemv\", calls: 2, requested_bytes: "
+                                      + std::to_string(3 * size)),
+                      std::string::npos);
+            remove(path.c_str());
+
+            // Resetting restarts the peaks from the current state
+            stats.reset(size, 2 * size);
+            EXPECT_EQ(stats.peak_in_use(), size);
+            EXPECT_EQ(stats.peak_capacity(), 2 * size);
+            EXPECT_EQ(stats.allocations(), 0u);
+            EXPECT_EQ(stats.failures(), 0u);
+            EXPECT_TRUE(stats.routines().empty());
+
+            // C API
+            rocblas_local_handle handle{arg};
+            size_t               peak, allocations, growths, failures;
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_get_device_memory_stats(nullptr, &peak, &allocations, &growths, &failures),
+                rocblas_status_invalid_handle);
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_get_device_memory_stats(handle, &peak, nullptr, &growths, &failures),
+                rocblas_status_invalid_pointer);
+            EXPECT_ROCBLAS_STATUS(rocblas_write_device_memory_stats(handle, nullptr),
+                                  rocblas_status_invalid_pointer);
+            CHECK_ROCBLAS_ERROR(rocblas_reset_device_memory_stats(handle));
+            CHECK_ROCBLAS_ERROR(
+                rocblas_get_device_memory_stats(handle, &peak, &allocations, &growths, &failures));
+            EXPECT_EQ(peak, 0u);
+            EXPECT_EQ(allocations, 0u);
+
+            // Requests are attributed to the function called through the C API
+            size_t               n = 1 << 16;
+            float                result;
+            device_vector<float> dx(n);
+            CHECK_DEVICE_ALLOCATION(dx.memcheck());
+            CHECK_HIP_ERROR(hipMemset(dx, 0, n * sizeof(float)));
+            CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+            CHECK_ROCBLAS_ERROR(rocblas_snrm2(handle, n, dx, 1, &result));
+            CHECK_ROCBLAS_ERROR(rocblas_write_device_memory_stats(handle, path.c_str()));
+            std::ifstream     api_file(path);
+            std::stringstream api_yaml;
+            api_yaml << api_file.rdbuf();
+            EXPECT_NE(api_yaml.str().find("routine: \"rocblas_snrm2\""), std::string::npos);
+            remove(path.c_str());
+        }
+    };
+
+    INTERNAL_TEST_SUITE(workspace_stats);
+
+    //
+    // shared workspace pool
+
+    // Fake events whose completion is controlled by the test
+    struct fake_events
+    {
+        using stream_t = int;
+        using event_t  = size_t; // index + 1 in done
+
+        std::shared_ptr<std::vector<bool>> done  = std::make_shared<std::vector<bool>>();
+        std::shared_ptr<size_t>            waits = std::make_shared<size_t>(0);
+
+        bool record(event_t& event, stream_t)
+        {
+            if(!event)
+            {
+                done->push_back(false);
+                event = done->size();
+            }
+            else
+                done->at(event - 1) = false;
+            return true;
+        }
+
+        bool query(event_t event)
+        {
+            return done->at(event - 1);
+        }
+
+        bool wait(stream_t, event_t)
+        {
+            ++*waits;
+            return true;
+        }
+
+        void destroy(event_t) {}
+    };
+
+    template <typename...>
+    struct testing_workspace_pool : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            using pool_t = rocblas_workspace_pool<fake_slab_allocator, fake_events>;
+
+            fake_slab_allocator allocator;
+            fake_events         events;
+            auto                slabs = allocator.slabs;
+            size_t              size  = arg.N;
+            {
+                pool_t pool(allocator, events);
+                void*  a;
+                void*  b;
+                void*  c;
+                size_t a_size, b_size, c_size;
+
+                // A slab can be leased again immediately on the same stream
+                EXPECT_TRUE(pool.lease(size, 1, a, a_size));
+                EXPECT_EQ(a_size, size);
+                EXPECT_TRUE(pool.release(a, 1));
+                EXPECT_FALSE(pool.release(a, 1));
+                EXPECT_TRUE(pool.lease(size, 1, b, b_size));
+                EXPECT_EQ(b, a);
+                EXPECT_TRUE(pool.release(b, 1));
+
+                // Other streams cannot use the slab until its work has completed
+                EXPECT_TRUE(pool.lease(size, 2, b, b_size));
+                EXPECT_NE(b, a);
+                EXPECT_EQ(pool.capacity(), 2 * size);
+                EXPECT_EQ(pool.leased_count(), 1u);
+                EXPECT_TRUE(pool.release(b, 2));
+                events.done->at(0) = true;
+                EXPECT_TRUE(pool.lease(size / 2, 3, c, c_size));
+                EXPECT_EQ(c, a);
+
+                // Larger requests get a new slab
+                EXPECT_TRUE(pool.lease(2 * size, 3, a, a_size));
+                EXPECT_EQ(a_size, 2 * size);
+                EXPECT_EQ(pool.slab_count(), 3u);
+
+                // If no memory can be allocated, the stream waits on a slab still in use
+                *allocator.fail = true;
+                EXPECT_TRUE(pool.lease(size, 4, b, b_size));
+                EXPECT_EQ(*events.waits, 1u);
+                EXPECT_FALSE(pool.lease(size, 4, a, a_size));
+                *allocator.fail = false;
+
+                // Idle slabs are freed once their work has completed
+                EXPECT_TRUE(pool.release(b, 4));
+                EXPECT_TRUE(pool.release(c, 3));
+                pool.trim();
+                EXPECT_EQ(pool.slab_count(), 3u);
+                events.done->assign(events.done->size(), true);
+                pool.trim();
+                EXPECT_EQ(pool.slab_count(), 1u);
+                EXPECT_EQ(pool.leased_count(), 1u);
+
+                // Many threads can lease concurrently
+                std::vector<std::thread> threads;
+                for(int t = 0; t < 8; ++t)
+                    threads.emplace_back([&, t] {
+                        for(int i = 0; i < 100; ++i)
+                        {
+                            void*  addr;
+                            size_t addr_size;
+                            if(pool.lease(size, t + 10, addr, addr_size))
+                                pool.release(addr, t + 10);
+                        }
+                    });
+                for(auto& thread : threads)
+                    thread.join();
+                EXPECT_EQ(pool.leased_count(), 1u);
+                EXPECT_LE(pool.slab_count(), 9u);
+            }
+
+            // All slabs are freed when the pool is destroyed
+            EXPECT_TRUE(slabs->empty());
+
+            // C API
+            EXPECT_ROCBLAS_STATUS(rocblas_set_shared_workspace(nullptr),
+                                  rocblas_status_invalid_handle);
+            EXPECT_ROCBLAS_STATUS(rocblas_get_shared_workspace_size(nullptr, &size),
+                                  rocblas_status_invalid_handle);
+            EXPECT_ROCBLAS_STATUS(rocblas_trim_shared_workspace(nullptr),
+                                  rocblas_status_invalid_handle);
+
+            rocblas_local_handle handle{arg};
+            EXPECT_ROCBLAS_STATUS(rocblas_get_shared_workspace_size(handle, nullptr),
+                                  rocblas_status_invalid_pointer);
+            CHECK_ROCBLAS_ERROR(rocblas_set_shared_workspace(handle));
+            EXPECT_TRUE(rocblas_is_managing_device_memory(handle));
+
+            // An idle handle holds no device memory, even after a function used workspace
+            size_t n = 1 << 20;
+            float  result;
+            device_vector<float> dx(n);
+            CHECK_DEVICE_ALLOCATION(dx.memcheck());
+            CHECK_HIP_ERROR(hipMemset(dx, 0, n * sizeof(float)));
+            CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+            CHECK_ROCBLAS_ERROR(rocblas_snrm2(handle, n, dx, 1, &result));
+            EXPECT_EQ(result, 0.0f);
+
+            size_t handle_size, pool_size;
+            CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_size(handle, &handle_size));
+            CHECK_ROCBLAS_ERROR(rocblas_get_shared_workspace_size(handle, &pool_size));
+            EXPECT_EQ(handle_size, 0u);
+            EXPECT_GT(pool_size, 0u);
+
+            // Setting the device memory size stops using the pool
+            CHECK_ROCBLAS_ERROR(rocblas_set_device_memory_size(handle, 0));
+            CHECK_ROCBLAS_ERROR(rocblas_trim_shared_workspace(handle));
+        }
+    };
+
+    INTERNAL_TEST_SUITE(workspace_pool);
+
+    //
+    // asynchronous initialization
+
+    template <typename...>
+    struct testing_initialize_async : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            const size_t        N = arg.N;
+            size_t              completed, total;
+            std::vector<size_t> order;
+
+            {
+                rocblas_async_initializer init;
+                EXPECT_TRUE(init.progress(completed, total));
+                EXPECT_EQ(total, 0u);
+
+                // The stub loader blocks until it is released, like a slow library load
+                std::promise<void> release;
+                auto               loaded = release.get_future().share();
+
+                // The stub resolver fails for odd shapes
+                std::vector<rocblas_async_initializer::task> tasks;
+                tasks.push_back([&, loaded] {
+                    loaded.wait();
+                    order.push_back(0);
+                    return true;
+                });
+                for(size_t i = 1; i <= N; ++i)
+                    tasks.push_back([&, i] {
+                        order.push_back(i);
+                        return i % 2 == 0;
+                    });
+                init.submit(std::move(tasks));
+
+                EXPECT_FALSE(init.progress(completed, total));
+                EXPECT_EQ(completed, 0u);
+                EXPECT_EQ(total, N + 1);
+
+                // Tasks submitted while others are running are queued after them
+                init.submit({[&]() -> bool {
+                    order.push_back(N + 1);
+                    throw std::runtime_error("stub");
+                }});
+                EXPECT_FALSE(init.progress(completed, total));
+                EXPECT_EQ(total, N + 2);
+
+                release.set_value();
+                init.wait();
+                EXPECT_TRUE(init.progress(completed, total));
+                EXPECT_EQ(completed, N + 2);
+                EXPECT_EQ(total, N + 2);
+                EXPECT_EQ(init.failed(), (N + 1) / 2 + 1);
+
+                // A new thread is started for tasks submitted once the queue is empty,
+                // and the initializer waits for them when it is destroyed
+                init.submit({[&] {
+                    order.push_back(N + 2);
+                    return true;
+                }});
+            }
+
+            ASSERT_EQ(order.size(), N + 3);
+            for(size_t i = 0; i < order.size(); ++i)
+                EXPECT_EQ(order[i], i);
+
+            // Argument checking of the C API
+            rocblas_int ready;
+            EXPECT_ROCBLAS_STATUS(rocblas_initialize_async(nullptr, 1),
+                                  rocblas_status_invalid_pointer);
+            EXPECT_ROCBLAS_STATUS(rocblas_initialize_async(nullptr, -1),
+                                  rocblas_status_invalid_size);
+            EXPECT_ROCBLAS_STATUS(rocblas_get_initialize_progress(nullptr, &completed, &total),
+                                  rocblas_status_invalid_pointer);
+
+            rocblas_int        n = rocblas_int(N);
+            rocblas_gemm_shape shape{rocblas_datatype_f32_r,
+                                     rocblas_operation_none,
+                                     rocblas_operation_none,
+                                     n,
+                                     n,
+                                     n,
+                                     n,
+                                     n,
+                                     n,
+                                     0,
+                                     0,
+                                     0,
+                                     1,
+                                     1.0,
+                                     0.0};
+
+#ifdef BUILD_WITH_TENSILE
+            rocblas_gemm_shape bad_shape = shape;
+            bad_shape.type               = rocblas_datatype_i32_r;
+            EXPECT_ROCBLAS_STATUS(rocblas_initialize_async(&bad_shape, 1),
+                                  rocblas_status_invalid_value);
+            bad_shape     = shape;
+            bad_shape.lda = n - 1;
+            EXPECT_ROCBLAS_STATUS(rocblas_initialize_async(&bad_shape, 1),
+                                  rocblas_status_invalid_size);
+#endif
+
+            CHECK_ROCBLAS_ERROR(rocblas_initialize_async(&shape, 1));
+            do
+            {
+                CHECK_ROCBLAS_ERROR(rocblas_get_initialize_progress(&ready, &completed, &total));
+                if(!ready)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            } while(!ready);
+            EXPECT_EQ(completed, total);
+
+#ifdef BUILD_WITH_TENSILE
+            // The first call with the shape finds its solution in the cache
+            rocblas_local_handle handle;
+            size_t               hits, misses, evictions, size;
+            CHECK_ROCBLAS_ERROR(
+                rocblas_get_solution_cache_stats(handle, &hits, &misses, &evictions, &size));
+
+            float                alpha = 1, beta = 0;
+            device_vector<float> dA(N * N), dB(N * N), dC(N * N);
+            CHECK_DEVICE_ALLOCATION(dA.memcheck());
+            CHECK_DEVICE_ALLOCATION(dB.memcheck());
+            CHECK_DEVICE_ALLOCATION(dC.memcheck());
+            CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
+            CHECK_ROCBLAS_ERROR(rocblas_sgemm(handle,
+                                              rocblas_operation_none,
+                                              rocblas_operation_none,
+                                              n,
+                                              n,
+                                              n,
+                                              &alpha,
+                                              dA,
+                                              n,
+                                              dB,
+                                              n,
+                                              &beta,
+                                              dC,
+                                              n));
+
+            size_t new_hits, new_misses;
+            CHECK_ROCBLAS_ERROR(rocblas_get_solution_cache_stats(
+                handle, &new_hits, &new_misses, &evictions, &size));
+            EXPECT_EQ(new_hits, hits + 1);
+            EXPECT_EQ(new_misses, misses);
+#endif
+        }
+    };
+
+    INTERNAL_TEST_SUITE(initialize_async);
+
+    //
+    // sharded counter used by profile logging
+
+    template <typename...>
+    struct testing_sharded_counter : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            constexpr int threads = 32;
+            constexpr int keys    = 7;
+            size_t        calls   = arg.N;
+
+            // Small limits, so that shards are merged while they are in use
+            rocblas_sharded_counter<int> counter(4, 64);
+
+            // Each thread adds the shared keys, and a key of its own
+            std::vector<std::thread> workers;
+            for(int t = 0; t < threads; ++t)
+                workers.emplace_back([&, t] {
+                    for(size_t i = 0; i < calls; ++i)
+                        counter.add(int(i % keys));
+                    counter.add(keys + t);
+                });
+            for(auto& worker : workers)
+                worker.join();
+
+            // The shards of exited threads are merged and dropped
+            std::map<int, size_t> counts;
+            counter.for_each([&](int key, size_t count) { counts[key] += count; });
+            EXPECT_EQ(counter.shard_count(), 0u);
+
+            ASSERT_EQ(counts.size(), size_t(keys + threads));
+            for(int key = 0; key < keys; ++key)
+                EXPECT_EQ(counts[key], threads * ((calls + keys - 1 - key) / keys));
+            for(int t = 0; t < threads; ++t)
+                EXPECT_EQ(counts[keys + t], 1u);
+
+            // A thread adding to several counters of the same type keeps a shard of each
+            size_t total = 0;
+            {
+                rocblas_sharded_counter<int> other;
+                for(size_t i = 0; i < calls; ++i)
+                {
+                    other.add(1);
+                    counter.add(1);
+                }
+                EXPECT_EQ(other.shard_count(), 1u);
+                EXPECT_EQ(counter.shard_count(), 1u);
+
+                counts.clear();
+                other.for_each([&](int key, size_t count) { counts[key] += count; });
+                EXPECT_EQ(counts.size(), 1u);
+                EXPECT_EQ(counts[1], calls);
+
+                counter.for_each([&](int, size_t count) { total += count; });
+                EXPECT_EQ(total, threads * (calls + 1) + calls);
+            }
+
+            // The shard of a destroyed counter does not affect the others
+            rocblas_sharded_counter<int> next;
+            next.add(2);
+            counter.add(2);
+            EXPECT_EQ(next.shard_count(), 1u);
+            EXPECT_EQ(counter.shard_count(), 1u);
+            total = 0;
+            counter.for_each([&](int, size_t count) { total += count; });
+            EXPECT_EQ(total, threads * (calls + 1) + calls + 1);
+        }
+    };
+
+    INTERNAL_TEST_SUITE(sharded_counter);
+
+    //
+    // binary trace and bench logging
+
+    template <typename...>
+    struct testing_binary_log : rocblas_test_valid
+    {
+        // Log a call, and output it as text in the same way as log_trace and log_bench
+        template <typename H, typename... Ts>
+        static void log_call(rocblas_binary_log&       log,
+                             rocblas_log_kind          kind,
+                             rocblas_internal_ostream& os,
+                             const H&                  head,
+                             const Ts&... xs)
+        {
+            log.write(kind, &log, head, xs...);
+            const char* sep = kind == rocblas_log_kind::trace ? "," : " ";
+            os << head;
+            ((os << sep << xs), ...);
+            os << std::endl;
+        }
+
+        // Log a call with more arguments than fit in a call
+        template <size_t... I>
+        static void log_long_call(rocblas_binary_log& log, std::index_sequence<I...>)
+        {
+            log.write(rocblas_log_kind::trace, &log, rocblas_int(I)...);
+        }
+
+        static std::vector<std::string> lines(const std::string& text)
+        {
+            std::vector<std::string> result;
+            std::istringstream       is(text);
+            for(std::string line; std::getline(is, line);)
+                result.push_back(line);
+            return result;
+        }
+
+        void operator()(const Arguments& arg)
+        {
+            constexpr int            threads = 4;
+            size_t                   N       = arg.N;
+            std::string              path    = rocblas_tempname();
+            std::vector<float>       x(N);
+            rocblas_internal_ostream trace, bench, thread_trace[threads];
+            {
+                rocblas_binary_log log(path);
+                ASSERT_TRUE(log.is_open());
+
+                for(size_t i = 0; i < N; ++i)
+                {
+                    log_call(log,
+                             rocblas_log_kind::trace,
+                             trace,
+                             "rocblas_test_function",
+                             rocblas_operation_transpose,
+                             rocblas_fill_lower,
+                             rocblas_diagonal_unit,
+                             rocblas_side_right,
+                             rocblas_datatype_f64_c,
+                             rocblas_int(i),
+                             rocblas_stride(i) * -1000000007,
+                             i,
+                             float(i) / 3,
+                             double(i) / 7,
+                             rocblas_float_complex(i, -float(i)),
+                             rocblas_double_complex(0.5, i),
+                             rocblas_bfloat16(float(i)),
+                             &x[i],
+                             std::string("id") + std::to_string(i % 3),
+                             bool(i & 1),
+                             'c',
+                             rocblas_status_invalid_size,
+                             rocblas_gemm_algo_standard,
+                             rocblas_gemm_flags_none,
+                             rocblas_atomics_not_allowed);
+
+                    log_call(log,
+                             rocblas_log_kind::bench,
+                             bench,
+                             "./rocblas-bench",
+                             "-f",
+                             "gemm",
+                             rocblas_log_bench_scalar<float>{"alpha", i * 0.25f},
+                             rocblas_log_bench_scalar<rocblas_double_complex>{
+                                 "beta", {1, double(i % 2)}},
+                             "--lda",
+                             i);
+
+                    // Drain the rings before they can fill, so that no calls are dropped
+                    if(i % 1000 == 999)
+                        log.flush();
+                }
+
+                // Calls of other threads are interleaved by time
+                std::vector<std::thread> workers;
+                for(int t = 0; t < threads; ++t)
+                    workers.emplace_back([&, t] {
+                        for(size_t i = 0; i < N; ++i)
+                        {
+                            log_call(log,
+                                     rocblas_log_kind::trace,
+                                     thread_trace[t],
+                                     "rocblas_thread_function",
+                                     t,
+                                     int64_t(i));
+                            if(i % 1000 == 999)
+                                log.flush();
+                        }
+                    });
+                for(auto& worker : workers)
+                    worker.join();
+
+                // Arguments beyond the slots of a call are dropped, and shown as ...
+                log_long_call(log, std::make_index_sequence<ROCBLAS_BINARY_LOG_CALL_SLOTS + 4>{});
+                for(size_t i = 0; i < ROCBLAS_BINARY_LOG_CALL_SLOTS; ++i)
+                    trace << (i ? "," : "") << i;
+                trace << ",..." << std::endl;
+
+                // Calls after the log is closed are ignored
+                log.close();
+                EXPECT_FALSE(log.is_open());
+                log.write(rocblas_log_kind::trace, &log, "rocblas_closed");
+            }
+
+            rocblas_internal_ostream   decoded_trace, decoded_bench;
+            uint64_t                   dropped;
+            rocblas_binary_log_decoder decoder;
+            ASSERT_TRUE(decoder.decode(path, decoded_trace, decoded_bench, dropped));
+            EXPECT_EQ(dropped, 0u);
+            EXPECT_EQ(decoded_bench.str(), bench.str());
+
+            // The calls of the main thread come first and last; the calls of the other
+            // threads are in order for each thread
+            auto expected = lines(trace.str());
+            auto actual   = lines(decoded_trace.str());
+            ASSERT_EQ(actual.size(), expected.size() + threads * N);
+            for(size_t i = 0; i < N; ++i)
+                EXPECT_EQ(actual[i], expected[i]);
+            EXPECT_EQ(actual.back(), expected.back());
+
+            for(int t = 0; t < threads; ++t)
+            {
+                std::string prefix = "rocblas_thread_function," + std::to_string(t) + ",";
+                std::string thread_lines;
+                for(size_t i = N; i < N + threads * N; ++i)
+                    if(!actual[i].compare(0, prefix.size(), prefix))
+                        thread_lines += actual[i] + "\n";
+                EXPECT_EQ(thread_lines, thread_trace[t].str());
+            }
+
+            // A file which is not a binary log is rejected
+            {
+                std::ofstream(path) << "rocblas_sgemm,N,N,1,1,1\n";
+            }
+            EXPECT_FALSE(decoder.decode(path, decoded_trace, decoded_bench, dropped));
+            remove(path.c_str());
+        }
+    };
+
+    INTERNAL_TEST_SUITE(binary_log);
+
+    template <typename...>
+    struct testing_latency_stats : rocblas_test_valid
+    {
+        // Simulate the hooks of a call to function, which allocates workspace and uses
+        // the stream after its arguments are logged twice, and launches for launch_time
+        static void call(const std::shared_ptr<rocblas_latency_stats>& stats,
+                         const char*                                   function,
+                         std::chrono::nanoseconds                      launch_time = {})
+        {
+            rocblas_latency_call::begin(stats, function);
+            rocblas_latency_call::log_end(stats.get());
+            rocblas_latency_call::log_end(stats.get());
+            auto start = rocblas_latency_call::now();
+            rocblas_latency_call::workspace(stats.get(), start, rocblas_latency_call::now());
+            rocblas_latency_call::event(stats.get());
+            rocblas_latency_call::event(stats.get());
+            std::this_thread::sleep_for(launch_time);
+            rocblas_latency_call::end(stats.get());
+        }
+
+        void operator()(const Arguments& arg)
+        {
+            size_t N = arg.N;
+
+            // Every value is in a bucket no wider than 1/16 of its lower bound
+            for(uint64_t v : {0ull, 1ull, 15ull, 16ull, 17ull, 31ull, 32ull, 1000ull, 123456789ull})
+            {
+                size_t b = rocblas_latency_histogram::bucket(v);
+                EXPECT_LE(rocblas_latency_histogram::bucket_lower(b), v);
+                EXPECT_GT(rocblas_latency_histogram::bucket_lower(b + 1), v);
+                EXPECT_LE(rocblas_latency_histogram::bucket_lower(b + 1)
+                              - rocblas_latency_histogram::bucket_lower(b),
+                          std::max<uint64_t>(1, v / ROCBLAS_LATENCY_SUB_BUCKETS));
+            }
+            EXPECT_EQ(rocblas_latency_histogram::bucket(~uint64_t(0)), ROCBLAS_LATENCY_BUCKETS - 1);
+
+            // Percentiles are within the precision of the buckets
+            rocblas_latency_histogram hist;
+            EXPECT_EQ(hist.percentile(50), 0u);
+            for(size_t i = 1; i <= N; ++i)
+                hist.record(i * 1000);
+            EXPECT_EQ(hist.count(), N);
+            EXPECT_EQ(hist.min(), 1000u);
+            EXPECT_EQ(hist.max(), N * 1000);
+            EXPECT_DOUBLE_EQ(hist.mean(), (N + 1) * 500.0);
+            for(double p : {1.0, 50.0, 90.0, 99.0})
+            {
+                double expected = std::max<double>(1, std::ceil(p / 100 * N)) * 1000;
+                EXPECT_NEAR(hist.percentile(p), expected, expected / ROCBLAS_LATENCY_SUB_BUCKETS);
+            }
+            EXPECT_EQ(hist.percentile(100), N * 1000);
+
+            // Calls are recorded when they end, and a call which does not end is dropped.
+            // Phases add up to the total.
+            auto stats = std::make_shared<rocblas_latency_stats>();
+            for(size_t i = 0; i < N; ++i)
+                call(stats, "rocblas_sgemv");
+            EXPECT_EQ(stats->histogram("rocblas_sgemv", rocblas_latency_phase_total).count(), N);
+            rocblas_latency_call::begin(stats, "rocblas_dgemv");
+            rocblas_latency_call::log_end(stats.get());
+            call(stats, "rocblas_dgemv");
+            EXPECT_EQ(stats->histogram("rocblas_dgemv", rocblas_latency_phase_total).count(), 1u);
+
+            auto   functions = stats->functions();
+            auto&  phases    = functions["rocblas_sgemv"];
+            double sum       = 0;
+            for(int p = rocblas_latency_phase_arguments; p < ROCBLAS_LATENCY_PHASES; ++p)
+            {
+                EXPECT_EQ(phases[p].count(), N);
+                sum += phases[p].mean();
+            }
+            EXPECT_NEAR(sum, phases[rocblas_latency_phase_total].mean(), 1e-6 * sum + 1e-6);
+
+            // Calls which are not logged are recorded with no logging time, and events
+            // outside of a call are ignored
+            rocblas_latency_call::begin(stats, "rocblas_get_stream");
+            rocblas_latency_call::event(stats.get());
+            rocblas_latency_call::end(stats.get());
+            call(stats, "rocblas_sgemv");
+            rocblas_latency_call::log_end(stats.get());
+            rocblas_latency_call::event(stats.get());
+            rocblas_latency_call::end(stats.get());
+            auto logging = stats->histogram("rocblas_get_stream", rocblas_latency_phase_logging);
+            EXPECT_EQ(logging.count(), 1u);
+            EXPECT_EQ(logging.max(), 0u);
+            EXPECT_EQ(stats->histogram("rocblas_sgemv", rocblas_latency_phase_total).count(),
+                      N + 1);
+
+            // The time after the last use of the stream, such as the last kernel launch,
+            // is part of the call
+            std::thread([&] {
+                call(stats, "rocblas_strsv", std::chrono::milliseconds(1));
+            }).join();
+            auto dispatch = stats->histogram("rocblas_strsv", rocblas_latency_phase_dispatch);
+            EXPECT_EQ(dispatch.count(), 1u);
+            EXPECT_GE(dispatch.min(), 1000000u);
+
+            // Statistics are written as YAML, one line per phase
+            std::string path = rocblas_tempname();
+            {
+                rocblas_internal_ostream os(path);
+                stats->write_yaml(os, 0);
+            }
+            std::ifstream     file(path);
+            std::stringstream yaml;
+            yaml << file.rdbuf();
+            EXPECT_NE(yaml.str().find("    - rocblas_function: \"rocblas_sgemv\"\n      calls: "
+                                      + std::to_string(N + 1) + "\n      total_ns: { mean: "),
+                      std::string::npos);
+            EXPECT_NE(yaml.str().find("      dispatch_ns: { mean: "), std::string::npos);
+            remove(path.c_str());
+
+            stats->reset();
+            EXPECT_TRUE(stats->functions().empty());
+
+            // A call left open when its statistics are destroyed is dropped
+            call(stats, "rocblas_sgemv");
+            stats.reset();
+            call(std::make_shared<rocblas_latency_stats>(), "rocblas_sgemv");
+
+            // C API. Latency is not measured unless it is enabled by ROCBLAS_LAYER.
+            rocblas_local_handle handle{arg};
+            size_t               calls;
+            double               mean, percentile;
+            EXPECT_ROCBLAS_STATUS(rocblas_get_latency_stats(nullptr,
+                                                            "rocblas_sgemv",
+                                                            rocblas_latency_phase_total,
+                                                            50,
+                                                            &calls,
+                                                            &mean,
+                                                            &percentile),
+                                  rocblas_status_invalid_handle);
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_get_latency_stats(
+                    handle, nullptr, rocblas_latency_phase_total, 50, &calls, &mean, &percentile),
+                rocblas_status_invalid_pointer);
+            EXPECT_ROCBLAS_STATUS(rocblas_get_latency_stats(handle,
+                                                            "rocblas_sgemv",
+                                                            rocblas_latency_phase_total,
+                                                            101,
+                                                            &calls,
+                                                            &mean,
+                                                            &percentile),
+                                  rocblas_status_invalid_value);
+            EXPECT_ROCBLAS_STATUS(rocblas_write_latency_stats(handle, nullptr),
+                                  rocblas_status_invalid_pointer);
+            CHECK_ROCBLAS_ERROR(rocblas_reset_latency_stats(handle));
+            CHECK_ROCBLAS_ERROR(rocblas_get_latency_stats(handle,
+                                                          "rocblas_sgemv",
+                                                          rocblas_latency_phase_dispatch,
+                                                          99,
+                                                          &calls,
+                                                          &mean,
+                                                          &percentile));
+            EXPECT_EQ(calls, 0u);
+        }
+    };
+
+    INTERNAL_TEST_SUITE(latency_stats);
+
+    template <typename...>
+    struct testing_strided_copy : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            size_t n = arg.N;
+
+            // The vector kernels are checked for each instruction set supported by the CPU
+            std::vector<rocblas_strided_copy_isa> isas{rocblas_strided_copy_isa::scalar};
+            if(rocblas_strided_copy_cpu_isa() >= rocblas_strided_copy_isa::avx2)
+                isas.push_back(rocblas_strided_copy_isa::avx2);
+            if(rocblas_strided_copy_cpu_isa() >= rocblas_strided_copy_isa::avx512)
+                isas.push_back(rocblas_strided_copy_isa::avx512);
+
+            // Pack and unpack elements of various sizes and strides, and compare with
+            // a copy of each element
+            for(auto isa : isas)
+            {
+                for(size_t elem_size : {1, 2, 3, 4, 8, 12, 16, 32})
+                {
+                    for(size_t inc : {1, 2, 3, 7, 100})
+                    {
+                        // Large strides are checked with fewer elements
+                        size_t stride = elem_size * inc;
+                        size_t n      = std::min<size_t>(arg.N, (64 << 20) / stride);
+
+                        std::vector<char> strided(n * stride), packed(n * elem_size);
+                        for(size_t i = 0; i < strided.size(); ++i)
+                            strided[i] = char(i * 7 + elem_size);
+
+                        rocblas_strided_copy_host(
+                            packed.data(), elem_size, strided.data(), stride, n, elem_size, isa);
+                        for(size_t i = 0; i < n; ++i)
+                            ASSERT_EQ(
+                                memcmp(&packed[i * elem_size], &strided[i * stride], elem_size),
+                                0);
+
+                        // Unpacking must only write the elements, not the gaps between them
+                        std::vector<char> unpacked(n * stride, char(0x5a));
+                        rocblas_strided_copy_host(
+                            unpacked.data(), stride, packed.data(), elem_size, n, elem_size, isa);
+                        for(size_t i = 0; i < unpacked.size(); ++i)
+                        {
+                            if(i % stride < elem_size)
+                                ASSERT_EQ(unpacked[i], strided[i]);
+                            else
+                                ASSERT_EQ(unpacked[i], char(0x5a));
+                        }
+                    }
+                }
+            }
+
+            // Pack columns of a matrix with a leading dimension, then unpack them
+            for(size_t row_bytes : {4, 8, 24, 1000})
+            {
+                size_t            ld = row_bytes + 8, cols = std::max<size_t>(1, n / 100);
+                std::vector<char> a(ld * cols), t(row_bytes * cols), b(ld * cols, char(0x5a));
+                for(size_t i = 0; i < a.size(); ++i)
+                    a[i] = char(i * 13 + 1);
+
+                rocblas_strided_copy_2d(t.data(), row_bytes, a.data(), ld, row_bytes, cols);
+                rocblas_strided_copy_2d(b.data(), ld, t.data(), row_bytes, row_bytes, cols);
+                for(size_t i = 0; i < b.size(); ++i)
+                    ASSERT_EQ(b[i], i % ld < row_bytes ? a[i] : char(0x5a));
+            }
+        }
+    };
+
+    INTERNAL_TEST_SUITE(strided_copy);
+
+    template <typename...>
+    struct testing_staging_pool : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            using pool_t = rocblas_staging_pool<fake_slab_allocator>;
+
+            fake_slab_allocator allocator;
+            auto                slabs      = allocator.slabs;
+            size_t              size       = arg.N;
+            size_t              size_class = pool_t::size_class(size);
+            EXPECT_GE(size_class, size);
+            EXPECT_TRUE(size_class == ROCBLAS_STAGING_MIN_SIZE || size_class / 2 < size);
+            {
+                pool_t pool(2 * size_class, allocator);
+
+                // A returned buffer is reused by later requests which fit in it
+                auto a = pool.lease(size);
+                ASSERT_TRUE(a);
+                EXPECT_EQ(a.size(), size_class);
+                void* addr = a.get();
+                a.reset();
+                auto b = pool.lease(size / 2 + 1);
+                EXPECT_EQ(b.get(), addr);
+
+                auto stats = pool.stats();
+                EXPECT_EQ(stats.requests, 2u);
+                EXPECT_EQ(stats.reuses, 1u);
+                EXPECT_EQ(stats.allocations, 1u);
+
+                // Buffers in use are not shared
+                auto c = pool.lease(size);
+                auto d = pool.lease(size);
+                EXPECT_NE(c.get(), b.get());
+                EXPECT_NE(d.get(), c.get());
+                EXPECT_EQ(pool.stats().held, 3 * size_class);
+                EXPECT_EQ(pool.stats().leased, 3 * size_class);
+
+                // Idle buffers beyond the limit are freed, least recently used first
+                b.reset();
+                c.reset();
+                d.reset();
+                stats = pool.stats();
+                EXPECT_EQ(stats.trimmed, 1u);
+                EXPECT_EQ(stats.held, 2 * size_class);
+                EXPECT_EQ(stats.leased, 0u);
+                EXPECT_EQ(slabs->count(addr), 0u);
+
+                // A moved lease is returned once
+                auto e = pool.lease(size);
+                auto f = std::move(e);
+                EXPECT_FALSE(e);
+                EXPECT_TRUE(f);
+                f.reset();
+                EXPECT_EQ(pool.stats().leased, 0u);
+                EXPECT_FALSE(pool.lease(0));
+
+                // If no buffer can be allocated, the idle buffers are freed
+                auto big        = pool.lease(4 * size_class);
+                *allocator.fail = true;
+                EXPECT_FALSE(pool.lease(8 * size_class));
+                *allocator.fail = false;
+                stats           = pool.stats();
+                EXPECT_EQ(stats.failures, 1u);
+                EXPECT_EQ(stats.held, big.size());
+
+                // A buffer larger than the limit is freed when it is returned
+                big.reset();
+                EXPECT_EQ(pool.stats().held, 0u);
+
+                // Lowering the limit, or trimming, frees idle buffers
+                a = pool.lease(size);
+                b = pool.lease(size);
+                a.reset();
+                b.reset();
+                pool.set_idle_limit(size_class);
+                EXPECT_EQ(pool.stats().held, size_class);
+                pool.trim();
+                EXPECT_EQ(pool.stats().held, 0u);
+
+                // Many threads can lease concurrently
+                pool.set_idle_limit(8 * size_class);
+                std::vector<std::thread> threads;
+                for(int t = 0; t < 8; ++t)
+                    threads.emplace_back([&] {
+                        for(int i = 0; i < 100; ++i)
+                        {
+                            auto lease = pool.lease(size);
+                            if(lease)
+                                memset(lease.get(), 0, size);
+                        }
+                    });
+                for(auto& thread : threads)
+                    thread.join();
+                stats = pool.stats();
+                EXPECT_EQ(stats.leased, 0u);
+                EXPECT_LE(stats.allocations - stats.trimmed, 8u);
+                EXPECT_EQ(stats.requests, stats.reuses + stats.allocations + stats.failures);
+            }
+
+            // Idle buffers are freed when the pool is destroyed
+            EXPECT_TRUE(slabs->empty());
+
+            // C API
+            size_t requests, reuses, host_bytes, device_bytes;
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_get_staging_buffer_stats(nullptr, &reuses, &host_bytes, &device_bytes),
+                rocblas_status_invalid_pointer);
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_get_staging_buffer_stats(&requests, &reuses, &host_bytes, nullptr),
+                rocblas_status_invalid_pointer);
+            CHECK_ROCBLAS_ERROR(
+                rocblas_get_staging_buffer_stats(&requests, &reuses, &host_bytes, &device_bytes));
+
+            // Strided transfers lease two host and two device buffers, which later calls reuse
+            rocblas_int          n = std::min<rocblas_int>(arg.N, 100000);
+            std::vector<float>   hx(2 * n), hy(2 * n);
+            device_vector<float> dy(2 * n);
+            CHECK_DEVICE_ALLOCATION(dy.memcheck());
+            for(rocblas_int i = 0; i < 2 * n; ++i)
+                hx[i] = float(i);
+            for(int call = 0; call < 2; ++call)
+            {
+                CHECK_ROCBLAS_ERROR(rocblas_set_vector(n, sizeof(float), hx.data(), 2, dy, 2));
+                CHECK_ROCBLAS_ERROR(rocblas_get_vector(n, sizeof(float), dy, 2, hy.data(), 2));
+            }
+            for(rocblas_int i = 0; i < n; ++i)
+                EXPECT_EQ(hy[2 * i], hx[2 * i]);
+
+            size_t requests_after, reuses_after;
+            CHECK_ROCBLAS_ERROR(rocblas_get_staging_buffer_stats(
+                &requests_after, &reuses_after, &host_bytes, &device_bytes));
+            EXPECT_EQ(requests_after - requests, 16u);
+            EXPECT_GE(reuses_after - reuses, 12u);
+            EXPECT_GT(host_bytes, 0u);
+            EXPECT_GT(device_bytes, 0u);
+
+            CHECK_ROCBLAS_ERROR(rocblas_trim_staging_buffers());
+            CHECK_ROCBLAS_ERROR(
+                rocblas_get_staging_buffer_stats(&requests, &reuses, &host_bytes, &device_bytes));
+            EXPECT_EQ(host_bytes, 0u);
+            EXPECT_EQ(device_bytes, 0u);
+        }
+    };
+
+    INTERNAL_TEST_SUITE(staging_pool);
+
+    // Host emulation of a stream, whose work is queued until it is run
+    struct emulated_stream
+    {
+        std::vector<std::function<void()>> work;
+        size_t                             completed = 0;
+
+        void run()
+        {
+            for(; completed < work.size(); ++completed)
+                work[completed]();
+        }
+    };
+
+    // Events which complete once the emulated stream has run the work enqueued before them
+    struct emulated_events
+    {
+        using stream_t = emulated_stream*;
+        using event_t  = size_t; // index + 1 in recorded
+
+        std::shared_ptr<std::vector<std::pair<emulated_stream*, size_t>>> recorded
+            = std::make_shared<std::vector<std::pair<emulated_stream*, size_t>>>();
+        std::shared_ptr<bool> fail = std::make_shared<bool>(false);
+
+        bool record(event_t& event, stream_t stream)
+        {
+            if(*fail)
+                return false;
+            if(!event)
+            {
+                recorded->emplace_back();
+                event = recorded->size();
+            }
+            recorded->at(event - 1) = {stream, stream->work.size()};
+            return true;
+        }
+
+        bool query(event_t event)
+        {
+            auto& r = recorded->at(event - 1);
+            return r.first->completed >= r.second;
+        }
+
+        void destroy(event_t) {}
+    };
+
+    // Runtime of the asynchronous transfers, with host memory standing in for device memory
+    struct emulated_runtime
+    {
+        using stream_t        = emulated_stream*;
+        using pool_t          = rocblas_staging_pool<fake_slab_allocator>;
+        using host_buffer_t   = pool_t::lease_t;
+        using device_buffer_t = pool_t::lease_t;
+        using releases_t      = rocblas_deferred_release<
+            emulated_events,
+            std::unique_ptr<rocblas_async_staging<emulated_runtime>>>;
+
+        pool_t&     host_pool;
+        pool_t&     device_pool;
+        releases_t& releases;
+        size_t      synchronizations = 0;
+        size_t      host_funcs       = 0;
+        size_t      copies           = 0;
+        size_t      launches         = 0;
+
+        host_buffer_t lease_host(size_t size)
+        {
+            return host_pool.lease(size);
+        }
+
+        device_buffer_t lease_device(size_t size)
+        {
+            return device_pool.lease(size);
+        }
+
+        bool host_func(stream_t stream, void (*fn)(void*), void* arg)
+        {
+            ++host_funcs;
+            stream->work.push_back([=] { fn(arg); });
+            return true;
+        }
+
+        bool copy(void* dst, const void* src, size_t size, bool, stream_t stream)
+        {
+            ++copies;
+            stream->work.push_back([=] { memcpy(dst, src, size); });
+            return true;
+        }
+
+        template <typename U, typename V>
+        bool copy_matrix(size_t   rows,
+                         size_t   cols,
+                         size_t   elem_size,
+                         U        a,
+                         size_t   stride_a,
+                         size_t   lda,
+                         V        b,
+                         size_t   stride_b,
+                         size_t   ldb,
+                         size_t   batch_count,
+                         stream_t stream)
+        {
+            ++launches;
+            stream->work.push_back([=] {
+                for(size_t i = 0; i < batch_count; ++i)
+                    rocblas_strided_copy_2d(rocblas_batched_tile(b, i, stride_b),
+                                            ldb * elem_size,
+                                            rocblas_batched_tile(a, i, stride_a),
+                                            lda * elem_size,
+                                            rows * elem_size,
+                                            cols);
+            });
+            return true;
+        }
+
+        bool defer(std::unique_ptr<rocblas_async_staging<emulated_runtime>>& staging,
+                   stream_t                                                  stream)
+        {
+            return releases.defer(staging, stream);
+        }
+
+        bool synchronize(stream_t stream)
+        {
+            ++synchronizations;
+            stream->run();
+            return true;
+        }
+    };
+
+    template <typename...>
+    struct testing_async_transfer : rocblas_test_valid
+    {
+        // Check that the elements of a rows x cols matrix are equal in a and b, and that the
+        // bytes between the columns of b are equal to fill
+        static void check_matrix(const std::vector<char>& a,
+                                 size_t                   lda,
+                                 const std::vector<char>& b,
+                                 size_t                   ldb,
+                                 size_t                   rows,
+                                 size_t                   elem_size,
+                                 char                     fill)
+        {
+            for(size_t i = 0; i < b.size(); ++i)
+            {
+                size_t col = i / (ldb * elem_size), row_byte = i % (ldb * elem_size);
+                if(row_byte < rows * elem_size)
+                    ASSERT_EQ(b[i], a[col * lda * elem_size + row_byte]);
+                else
+                    ASSERT_EQ(b[i], fill);
+            }
+        }
+
+        void operator()(const Arguments& arg)
+        {
+            using pool_t = emulated_runtime::pool_t;
+
+            size_t rows = arg.N, cols = 7, elem_size = 8;
+            for(auto ld : {std::make_pair(rows, rows + 3),
+                           std::make_pair(rows + 5, rows),
+                           std::make_pair(rows + 5, rows + 3),
+                           std::make_pair(rows, rows)})
+            {
+                size_t lda = ld.first, ldb = ld.second;
+
+                fake_slab_allocator          allocator;
+                emulated_events              events;
+                size_t                       limit = ROCBLAS_STAGING_DEFAULT_IDLE_LIMIT;
+                pool_t                       host_pool(limit, allocator);
+                pool_t                       device_pool(limit, allocator);
+                emulated_runtime::releases_t releases(events);
+                emulated_runtime             runtime{host_pool, device_pool, releases};
+                emulated_stream              stream;
+
+                std::vector<char> a(lda * cols * elem_size), d(ldb * cols * elem_size, 0x5a);
+                std::vector<char> b(lda * cols * elem_size, 0x33);
+                for(size_t i = 0; i < a.size(); ++i)
+                    a[i] = char(i * 7 + 1);
+
+                auto set = [&](const std::vector<char>& src, std::vector<char>& dst) {
+                    return rocblas_set_matrix_async_staged(
+                        runtime, rows, cols, elem_size, src.data(), lda, dst.data(), ldb, &stream);
+                };
+                auto get = [&](const std::vector<char>& src, std::vector<char>& dst) {
+                    return rocblas_get_matrix_async_staged(
+                        runtime, rows, cols, elem_size, src.data(), ldb, dst.data(), lda, &stream);
+                };
+
+                // Nothing is copied before the stream reaches the transfer, and the host
+                // matrix is read at that point
+                EXPECT_EQ(set(a, d), rocblas_status_success);
+                EXPECT_EQ(releases.pending(), 1u);
+                EXPECT_TRUE(std::all_of(d.begin(), d.end(), [](char c) { return c == 0x5a; }));
+                a[0] += 1;
+                stream.run();
+                check_matrix(a, lda, d, ldb, rows, elem_size, 0x5a);
+
+                // The host matrix is written when the stream reaches the end of the transfer.
+                // The completed transfer is released when the next one is enqueued.
+                EXPECT_EQ(get(d, b), rocblas_status_success);
+                EXPECT_EQ(releases.pending(), 1u);
+                EXPECT_TRUE(std::all_of(b.begin(), b.end(), [](char c) { return c == 0x33; }));
+                stream.run();
+                check_matrix(a, lda, b, lda, rows, elem_size, 0x33);
+
+                // The staging buffers are returned once the stream has completed the transfer
+                EXPECT_EQ(releases.collect(), 1u);
+                EXPECT_EQ(releases.pending(), 0u);
+                EXPECT_EQ(host_pool.stats().leased, 0u);
+                EXPECT_EQ(device_pool.stats().leased, 0u);
+
+                // Buffers and events are reused by later transfers
+                for(int i = 0; i < 10; ++i)
+                {
+                    set(a, d);
+                    stream.run();
+                }
+                EXPECT_LE(releases.event_count(), 2u);
+                EXPECT_LE(host_pool.stats().allocations + device_pool.stats().allocations, 4u);
+
+                // If no event can be recorded, the transfer completes before returning
+                *events.fail = true;
+                EXPECT_EQ(set(b, d), rocblas_status_success);
+                EXPECT_EQ(runtime.synchronizations, 1u);
+                check_matrix(b, lda, d, ldb, rows, elem_size, 0x5a);
+                *events.fail = false;
+
+                // If no staging buffer can be leased, nothing is enqueued
+                releases.collect();
+                host_pool.trim();
+                device_pool.trim();
+                *allocator.fail = true;
+                size_t enqueued = stream.work.size();
+                EXPECT_EQ(get(d, b),
+                          lda == rows && ldb == rows ? rocblas_status_success
+                                                     : rocblas_status_memory_error);
+                if(lda != rows || ldb != rows)
+                    EXPECT_EQ(stream.work.size(), enqueued);
+                *allocator.fail = false;
+                stream.run();
+                releases.collect();
+                EXPECT_EQ(releases.pending(), 0u);
+            }
+        }
+    };
+
+    INTERNAL_TEST_SUITE(async_transfer);
+
+    template <typename...>
+    struct testing_batched_transfer : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            using pool_t = emulated_runtime::pool_t;
+
+            size_t batch_count = arg.N, rows = 5, cols = 3, elem_size = 4, lda = 7, ldb = 6;
+            size_t tile_bytes = rows * cols * elem_size, max_bytes = 3 * tile_bytes;
+            size_t chunks = (batch_count + 2) / 3;
+
+            // The chunks of the plan cover the batch in order, within max_bytes and max_tiles
+            for(size_t max_tiles : {size_t(2), ROCBLAS_BATCHED_TRANSFER_MAX_TILES})
+            {
+                rocblas_batched_transfer_plan plan(
+                    rows, cols, elem_size, batch_count, max_bytes, max_tiles);
+                size_t covered = 0;
+                for(size_t k = 0; k < plan.chunks(); ++k)
+                {
+                    EXPECT_EQ(plan.first(k), covered);
+                    EXPECT_GE(plan.count(k), 1u);
+                    EXPECT_LE(plan.count(k), max_tiles);
+                    EXPECT_LE(plan.count(k) * tile_bytes, plan.buffer_bytes());
+                    covered += plan.count(k);
+                }
+                EXPECT_EQ(covered, batch_count);
+                EXPECT_LE(plan.buffer_bytes(), max_bytes);
+            }
+
+            // Host matrices a and c, and "device" matrices b, with gaps between them. The arrays
+            // of pointers list the host matrices in reverse order.
+            size_t            stride_a = (lda * cols + 2) * elem_size;
+            size_t            stride_b = (ldb * cols + 1) * elem_size;
+            std::vector<char> a(stride_a * batch_count), b(stride_b * batch_count, 0x5a);
+            std::vector<char> c(stride_a * batch_count, 0x33);
+            for(size_t i = 0; i < a.size(); ++i)
+                a[i] = char(i * 13 + 5);
+
+            std::vector<const char*> a_ptrs(batch_count);
+            std::vector<char*>       b_ptrs(batch_count), c_ptrs(batch_count);
+            for(size_t i = 0; i < batch_count; ++i)
+            {
+                a_ptrs[i] = a.data() + (batch_count - 1 - i) * stride_a;
+                b_ptrs[i] = b.data() + i * stride_b;
+                c_ptrs[i] = c.data() + (batch_count - 1 - i) * stride_a;
+            }
+
+            // Results of per-matrix copies
+            std::vector<char> b_gold = b, c_gold = c;
+            for(size_t i = 0; i < batch_count; ++i)
+            {
+                rocblas_strided_copy_2d(b_ptrs[i] - b.data() + b_gold.data(),
+                                        ldb * elem_size,
+                                        a_ptrs[i],
+                                        lda * elem_size,
+                                        rows * elem_size,
+                                        cols);
+                rocblas_strided_copy_2d(c_ptrs[i] - c.data() + c_gold.data(),
+                                        lda * elem_size,
+                                        a_ptrs[i],
+                                        lda * elem_size,
+                                        rows * elem_size,
+                                        cols);
+            }
+
+            fake_slab_allocator          allocator;
+            emulated_events              events;
+            size_t                       limit = ROCBLAS_STAGING_DEFAULT_IDLE_LIMIT;
+            pool_t                       host_pool(limit, allocator);
+            pool_t                       device_pool(limit, allocator);
+            emulated_runtime::releases_t releases(events);
+            emulated_stream              stream;
+
+            // Each chunk is packed on the host, moved by one copy and unpacked by one kernel,
+            // through one staging buffer of each kind. The array of host pointers may be freed
+            // once the transfer is enqueued.
+            {
+                emulated_runtime         runtime{host_pool, device_pool, releases};
+                std::vector<const char*> ptrs     = a_ptrs;
+                size_t                   requests = host_pool.stats().requests;
+                EXPECT_EQ(rocblas_set_matrix_batched_staged(runtime,
+                                                            rows,
+                                                            cols,
+                                                            elem_size,
+                                                            ptrs.data(),
+                                                            lda,
+                                                            0,
+                                                            b_ptrs.data(),
+                                                            ldb,
+                                                            0,
+                                                            batch_count,
+                                                            &stream,
+                                                            max_bytes),
+                          rocblas_status_success);
+                std::fill(ptrs.begin(), ptrs.end(), nullptr);
+                stream.run();
+                EXPECT_TRUE(b == b_gold);
+                EXPECT_EQ(runtime.host_funcs, chunks);
+                EXPECT_EQ(runtime.copies, chunks);
+                EXPECT_EQ(runtime.launches, chunks);
+                EXPECT_EQ(host_pool.stats().requests, requests + 1);
+            }
+
+            // The mirrored transfer, from the "device" matrices to host matrices
+            {
+                emulated_runtime   runtime{host_pool, device_pool, releases};
+                std::vector<char*> ptrs = c_ptrs;
+                EXPECT_EQ(rocblas_get_matrix_batched_staged(runtime,
+                                                            rows,
+                                                            cols,
+                                                            elem_size,
+                                                            b_ptrs.data(),
+                                                            ldb,
+                                                            0,
+                                                            ptrs.data(),
+                                                            lda,
+                                                            0,
+                                                            batch_count,
+                                                            &stream,
+                                                            max_bytes),
+                          rocblas_status_success);
+                std::fill(ptrs.begin(), ptrs.end(), nullptr);
+                stream.run();
+                EXPECT_TRUE(c == c_gold);
+                EXPECT_EQ(runtime.host_funcs, chunks);
+                EXPECT_EQ(runtime.copies, chunks);
+                EXPECT_EQ(runtime.launches, chunks);
+            }
+
+            // Strided matrices give the same results as arrays of pointers
+            std::vector<char> a_rev(a.size());
+            for(size_t i = 0; i < batch_count; ++i)
+                memcpy(a_rev.data() + i * stride_a, a_ptrs[i], stride_a);
+            std::fill(b.begin(), b.end(), 0x5a);
+            {
+                emulated_runtime runtime{host_pool, device_pool, releases};
+                EXPECT_EQ(rocblas_set_matrix_batched_staged(runtime,
+                                                            rows,
+                                                            cols,
+                                                            elem_size,
+                                                            (const char*)a_rev.data(),
+                                                            lda,
+                                                            stride_a,
+                                                            b.data(),
+                                                            ldb,
+                                                            stride_b,
+                                                            batch_count,
+                                                            &stream,
+                                                            max_bytes),
+                          rocblas_status_success);
+                stream.run();
+                EXPECT_TRUE(b == b_gold);
+            }
+
+            // Contiguous matrices are moved by one copy per chunk, without staging
+            std::vector<char> packed(tile_bytes * batch_count), packed_gold(packed.size());
+            for(size_t i = 0; i < batch_count; ++i)
+                rocblas_strided_copy_2d(packed_gold.data() + i * tile_bytes,
+                                        rows * elem_size,
+                                        a_ptrs[i],
+                                        lda * elem_size,
+                                        rows * elem_size,
+                                        cols);
+            {
+                emulated_runtime  runtime{host_pool, device_pool, releases};
+                std::vector<char> d(packed.size());
+                EXPECT_EQ(rocblas_set_matrix_batched_staged(runtime,
+                                                            rows,
+                                                            cols,
+                                                            elem_size,
+                                                            (const char*)packed_gold.data(),
+                                                            rows,
+                                                            tile_bytes,
+                                                            d.data(),
+                                                            rows,
+                                                            tile_bytes,
+                                                            batch_count,
+                                                            &stream,
+                                                            max_bytes),
+                          rocblas_status_success);
+                EXPECT_EQ(rocblas_get_matrix_batched_staged(runtime,
+                                                            rows,
+                                                            cols,
+                                                            elem_size,
+                                                            (const char*)d.data(),
+                                                            rows,
+                                                            tile_bytes,
+                                                            packed.data(),
+                                                            rows,
+                                                            tile_bytes,
+                                                            batch_count,
+                                                            &stream,
+                                                            max_bytes),
+                          rocblas_status_success);
+                stream.run();
+                EXPECT_TRUE(packed == packed_gold);
+                EXPECT_EQ(runtime.host_funcs, 0u);
+                EXPECT_EQ(runtime.launches, 0u);
+                EXPECT_EQ(runtime.copies, 2 * chunks);
+            }
+
+            releases.collect();
+            EXPECT_EQ(releases.pending(), 0u);
+            EXPECT_EQ(host_pool.stats().leased, 0u);
+            EXPECT_EQ(device_pool.stats().leased, 0u);
+        }
+    };
+
+    INTERNAL_TEST_SUITE(batched_transfer);
+
+    // Runtime of the numerical check queue, with host memory standing in for device memory
+    struct emulated_check_numerics_runtime
+    {
+        using stream_t = emulated_stream*;
+        using event_t  = emulated_events::event_t;
+        using flags_t  = rocblas_check_numerics_t;
+
+        struct report_t
+        {
+            const char* function_name;
+            bool        is_input;
+            flags_t     flags;
+        };
+
+        struct state_t
+        {
+            emulated_events       events;
+            std::vector<flags_t>  device, host;
+            std::vector<report_t> reports;
+            size_t                synchronizations = 0;
+            bool                  fail_allocate    = false;
+            bool                  deallocated      = false;
+        };
+
+        state_t& state;
+
+        bool allocate(flags_t** device, flags_t** host, size_t count)
+        {
+            if(state.fail_allocate)
+                return false;
+            state.device.assign(count, flags_t{});
+            state.host.assign(count, flags_t{});
+            *device = state.device.data();
+            *host   = state.host.data();
+            return true;
+        }
+
+        void deallocate(flags_t* device, flags_t* host)
+        {
+            state.deallocated = device == state.device.data() && host == state.host.data();
+        }
+
+        bool clear(flags_t* device, stream_t stream)
+        {
+            stream->work.push_back([=] { *device = flags_t{}; });
+            return true;
+        }
+
+        bool read(flags_t* host, const flags_t* device, stream_t stream)
+        {
+            stream->work.push_back([=] { *host = *device; });
+            return true;
+        }
+
+        bool record(event_t& event, stream_t stream)
+        {
+            return state.events.record(event, stream);
+        }
+
+        bool query(event_t event)
+        {
+            return state.events.query(event);
+        }
+
+        bool synchronize(event_t event)
+        {
+            ++state.synchronizations;
+            state.events.recorded->at(event - 1).first->run();
+            return true;
+        }
+
+        void destroy(event_t) {}
+
+        rocblas_status report(const char*    function_name,
+                              int            check_numerics,
+                              bool           is_input,
+                              const flags_t& flags)
+        {
+            state.reports.push_back({function_name, is_input, flags});
+            bool abnormal = flags.has_NaN || flags.has_Inf || flags.has_denorm;
+            return abnormal && (check_numerics & rocblas_check_numerics_mode_fail)
+                       ? rocblas_status_check_numerics_fail
+                       : rocblas_status_success;
+        }
+    };
+
+    template <typename...>
+    struct testing_check_numerics_queue : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            using runtime_t = emulated_check_numerics_runtime;
+            using queue_t   = rocblas_check_numerics_queue<runtime_t>;
+            using flags_t   = runtime_t::flags_t;
+
+            const size_t capacity  = arg.N;
+            const int    immediate = rocblas_check_numerics_mode_fail;
+            const int    deferred  = immediate | rocblas_check_numerics_mode_deferred;
+            const char*  axpy      = "rocblas_saxpy";
+            const char*  scal      = "rocblas_sscal";
+
+            // Emulate a check kernel, which sets a flag if the operand is abnormal
+            auto launch = [](emulated_stream& s, flags_t* flags, bool nan) {
+                s.work.push_back([=] {
+                    if(nan)
+                        flags->has_NaN = true;
+                    else
+                        flags->has_zero = true;
+                });
+            };
+
+            {
+                // The streams are declared after the state, whose memory their work uses
+                runtime_t::state_t state;
+                emulated_stream    stream, other;
+                queue_t            queue(capacity, runtime_t{state});
+
+                // The operands of one direction of a call share a slot and its readback
+                flags_t* x = nullptr;
+                flags_t* y = nullptr;
+                EXPECT_EQ(queue.check(axpy, deferred, true, &stream, true, x),
+                          rocblas_status_success);
+                launch(stream, x, true);
+                EXPECT_EQ(queue.check(axpy, deferred, true, &stream, true, y),
+                          rocblas_status_success);
+                launch(stream, y, false);
+                EXPECT_EQ(x, y);
+                EXPECT_EQ(queue.pending(), 1u);
+                EXPECT_EQ(queue.readbacks(), 0u);
+                EXPECT_EQ(queue.poll(), rocblas_status_success);
+
+                // The outputs close the slot of the inputs. Nothing is reported until the
+                // readback has completed, and the failure is returned only once.
+                EXPECT_EQ(queue.check(axpy, deferred, false, &stream, true, y),
+                          rocblas_status_success);
+                launch(stream, y, false);
+                EXPECT_EQ(queue.readbacks(), 1u);
+                if(capacity > 1)
+                {
+                    EXPECT_NE(x, y);
+                    EXPECT_EQ(queue.poll(), rocblas_status_success);
+                    EXPECT_TRUE(state.reports.empty());
+                    stream.run();
+                    EXPECT_EQ(queue.poll(), rocblas_status_check_numerics_fail);
+                    EXPECT_EQ(state.synchronizations, 0u);
+                }
+                else
+                {
+                    // With a single slot, the inputs are retired when the outputs are checked
+                    EXPECT_EQ(state.synchronizations, 1u);
+                    EXPECT_EQ(queue.poll(), rocblas_status_check_numerics_fail);
+                }
+                EXPECT_EQ(queue.poll(), rocblas_status_success);
+                ASSERT_EQ(state.reports.size(), 1u);
+                EXPECT_TRUE(state.reports[0].is_input);
+                EXPECT_TRUE(state.reports[0].flags.has_NaN);
+                EXPECT_TRUE(state.reports[0].flags.has_zero);
+                EXPECT_FALSE(state.reports[0].flags.has_Inf);
+
+                // The open slot is reported by a flush
+                EXPECT_TRUE(queue.is_open());
+                EXPECT_EQ(queue.flush(), rocblas_status_success);
+                EXPECT_FALSE(queue.is_open());
+                EXPECT_EQ(queue.pending(), 0u);
+                ASSERT_EQ(state.reports.size(), 2u);
+                EXPECT_FALSE(state.reports[1].is_input);
+                EXPECT_FALSE(state.reports[1].flags.has_NaN);
+                EXPECT_TRUE(state.reports[1].flags.has_zero);
+
+                // Immediate checks do not share slots, and each one is reported by its flush.
+                // Reused slots are cleared before the check.
+                for(int i = 0; i < 3; ++i)
+                {
+                    EXPECT_EQ(queue.check(scal, immediate, true, &stream, false, x),
+                              rocblas_status_success);
+                    launch(stream, x, i == 1);
+                    EXPECT_EQ(queue.flush(),
+                              i == 1 ? rocblas_status_check_numerics_fail
+                                     : rocblas_status_success);
+                    EXPECT_EQ(state.reports.back().flags.has_NaN, i == 1);
+                }
+                EXPECT_EQ(state.reports.size(), 5u);
+
+                // Checks on different streams do not share a slot
+                EXPECT_EQ(queue.check(scal, deferred, true, &stream, true, x),
+                          rocblas_status_success);
+                EXPECT_EQ(queue.check(scal, deferred, true, &other, true, y),
+                          rocblas_status_success);
+                EXPECT_EQ(queue.pending(), capacity > 1 ? 2u : 1u);
+                EXPECT_EQ(queue.flush(), rocblas_status_success);
+                EXPECT_EQ(state.reports.size(), 7u);
+
+                // A full ring retires its oldest slot, so that checks are reported in order
+                size_t readbacks = queue.readbacks();
+                size_t checks    = 2 * capacity + 1;
+                for(size_t i = 0; i < checks; ++i)
+                {
+                    EXPECT_EQ(queue.check(i % 2 ? axpy : scal, deferred, i % 2, &stream, true, x),
+                              rocblas_status_success);
+                    launch(stream, x, false);
+                    EXPECT_LE(queue.pending(), capacity);
+                }
+                EXPECT_EQ(queue.flush(), rocblas_status_success);
+                EXPECT_EQ(queue.readbacks(), readbacks + checks);
+                ASSERT_EQ(state.reports.size(), 7 + checks);
+                for(size_t i = 0; i < checks; ++i)
+                {
+                    EXPECT_EQ(state.reports[7 + i].function_name, i % 2 ? axpy : scal);
+                    EXPECT_EQ(state.reports[7 + i].is_input, bool(i % 2));
+                }
+
+                // A slot whose readback cannot be enqueued is not reported
+                EXPECT_EQ(queue.check(axpy, deferred, true, &stream, true, x),
+                          rocblas_status_success);
+                *state.events.fail = true;
+                EXPECT_EQ(queue.check(axpy, deferred, false, &stream, true, y),
+                          rocblas_status_internal_error);
+                *state.events.fail = false;
+                EXPECT_EQ(queue.flush(), rocblas_status_success);
+                EXPECT_EQ(state.reports.size(), 7 + checks);
+                EXPECT_EQ(queue.pending(), 0u);
+
+            }
+
+            // Pending checks are reported, and the ring is freed, when the queue is destroyed
+            runtime_t::state_t scoped_state;
+            emulated_stream    stream;
+            {
+                queue_t  scoped(capacity, runtime_t{scoped_state});
+                flags_t* flags = nullptr;
+                EXPECT_EQ(scoped.check(scal, deferred, false, &stream, true, flags),
+                          rocblas_status_success);
+                launch(stream, flags, true);
+            }
+            ASSERT_EQ(scoped_state.reports.size(), 1u);
+            EXPECT_TRUE(scoped_state.reports[0].flags.has_NaN);
+            EXPECT_TRUE(scoped_state.deallocated);
+
+            // A ring which cannot be allocated fails the check
+            runtime_t::state_t state;
+            state.fail_allocate = true;
+            queue_t  queue(capacity, runtime_t{state});
+            flags_t* flags = nullptr;
+            EXPECT_EQ(queue.check(axpy, deferred, true, &stream, true, flags),
+                      rocblas_status_memory_error);
+            EXPECT_EQ(queue.pending(), 0u);
+            EXPECT_EQ(queue.flush(), rocblas_status_success);
+            EXPECT_FALSE(state.deallocated);
+        }
+    };
+
+    INTERNAL_TEST_SUITE(check_numerics_queue);
+
+    template <typename...>
+    struct testing_check_numerics_sampler : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            const size_t calls = arg.N;
+            const char*  axpy  = "rocblas_saxpy";
+            const char*  gemv  = "rocblas_sgemv";
+            const auto   small = rocblas_check_numerics_sampler::profile({8, 1, 1});
+            const auto   large = rocblas_check_numerics_sampler::profile({1024, 1, 1});
+
+            rocblas_check_numerics_sampler sampler;
+
+            // Make the checks of one call with two inputs and one output, returning whether
+            // they were made. The decision of the first check applies to the others.
+            auto call = [&](const char* function, uint64_t profile) {
+                bool sampled = sampler.check(function, true, profile);
+                EXPECT_EQ(sampler.check(function, true, profile), sampled);
+                EXPECT_EQ(sampler.check(function, false, profile), sampled);
+                return sampled;
+            };
+
+            // By default every call is checked
+            EXPECT_EQ(sampler.policy(), rocblas_check_numerics_sample_all);
+            for(size_t i = 0; i < calls; ++i)
+                EXPECT_TRUE(call(axpy, small));
+            EXPECT_EQ(sampler.stats(axpy).calls, calls);
+            EXPECT_EQ(sampler.stats(axpy).sampled, calls);
+            EXPECT_EQ(sampler.stats(gemv).calls, 0u);
+
+            // Every Nth call of each function is checked, starting with the first
+            ASSERT_TRUE(sampler.set_policy(rocblas_check_numerics_sample_every_nth, 3));
+            EXPECT_EQ(sampler.stats(axpy).calls, 0u);
+            for(size_t i = 0; i < calls; ++i)
+            {
+                EXPECT_EQ(call(axpy, small), i % 3 == 0);
+                EXPECT_EQ(call(gemv, large), i % 3 == 0);
+            }
+            EXPECT_EQ(sampler.stats(axpy).calls, calls);
+            EXPECT_EQ(sampler.stats(axpy).sampled, (calls + 2) / 3);
+            EXPECT_EQ(sampler.stats(gemv).sampled, (calls + 2) / 3);
+
+            // Consecutive calls of one function are told apart by their checks of the inputs
+            // following checks of the outputs
+            ASSERT_TRUE(sampler.set_policy(rocblas_check_numerics_sample_every_nth, 2));
+            EXPECT_TRUE(sampler.check(axpy, true, small));
+            EXPECT_TRUE(sampler.check(axpy, false, small));
+            EXPECT_TRUE(sampler.check(axpy, false, small));
+            EXPECT_FALSE(sampler.check(axpy, true, small));
+            EXPECT_FALSE(sampler.check(axpy, false, small));
+            EXPECT_TRUE(sampler.check(axpy, true, small));
+            EXPECT_EQ(sampler.stats(axpy).calls, 3u);
+
+            // Calls which are ended by their public function are counted separately, even
+            // when a failed check of the inputs returns early, or only the inputs are checked
+            ASSERT_TRUE(sampler.set_policy(rocblas_check_numerics_sample_every_nth, 2));
+            for(size_t i = 0; i < calls; ++i)
+            {
+                EXPECT_EQ(sampler.check(axpy, true, small), i % 2 == 0);
+                sampler.end_call();
+            }
+            EXPECT_EQ(sampler.stats(axpy).calls, calls);
+
+            ASSERT_TRUE(sampler.set_policy(rocblas_check_numerics_sample_first, 1));
+            EXPECT_TRUE(sampler.check(axpy, true, small));
+            sampler.end_call();
+            EXPECT_FALSE(sampler.check(axpy, true, small));
+            EXPECT_FALSE(sampler.check(axpy, true, small));
+            sampler.end_call();
+            EXPECT_EQ(sampler.stats(axpy).calls, 2u);
+            EXPECT_EQ(sampler.stats(axpy).sampled, 1u);
+
+            // A random fraction of the calls is checked, and the sequence is reproducible
+            ASSERT_TRUE(sampler.set_policy(rocblas_check_numerics_sample_fraction, 0.25));
+            std::vector<bool> decisions;
+            for(size_t i = 0; i < calls; ++i)
+                decisions.push_back(call(axpy, small));
+            size_t sampled = std::count(decisions.begin(), decisions.end(), true);
+            EXPECT_EQ(sampler.stats(axpy).sampled, sampled);
+            if(calls >= 1000)
+            {
+                EXPECT_GT(sampled, calls / 5);
+                EXPECT_LT(sampled, calls * 3 / 10);
+            }
+            ASSERT_TRUE(sampler.set_policy(rocblas_check_numerics_sample_fraction, 0.25));
+            for(size_t i = 0; i < calls; ++i)
+                EXPECT_EQ(call(axpy, small), decisions[i]);
+
+            for(double fraction : {0.0, 1.0})
+            {
+                ASSERT_TRUE(sampler.set_policy(rocblas_check_numerics_sample_fraction, fraction));
+                for(size_t i = 0; i < calls; ++i)
+                    EXPECT_EQ(call(axpy, small), fraction == 1.0);
+            }
+
+            // The first K calls of each function with each profile are checked
+            ASSERT_TRUE(sampler.set_policy(rocblas_check_numerics_sample_first, 2));
+            for(size_t i = 0; i < calls; ++i)
+            {
+                EXPECT_EQ(call(axpy, small), i < 2);
+                EXPECT_EQ(call(axpy, large), i < 2);
+                EXPECT_EQ(call(gemv, small), i < 2);
+            }
+            EXPECT_EQ(sampler.stats(axpy).calls, 2 * calls);
+            EXPECT_EQ(sampler.stats(axpy).sampled, std::min<size_t>(calls, 2) * 2);
+
+            // Statistics of functions with equal names are merged
+            std::string name = axpy;
+            sampler.check(name.c_str(), true, small);
+            EXPECT_EQ(sampler.stats(axpy).calls, 2 * calls + 1);
+            auto functions = sampler.functions();
+            ASSERT_EQ(functions.size(), 2u);
+            EXPECT_EQ(functions.begin()->first, axpy);
+            EXPECT_EQ(functions.begin()->second.calls, 2 * calls + 1);
+
+            // Invalid policies are rejected, and leave the policy unchanged
+            EXPECT_FALSE(sampler.set_policy(rocblas_check_numerics_sample_every_nth, 0));
+            EXPECT_FALSE(sampler.set_policy(rocblas_check_numerics_sample_every_nth, 2.5));
+            EXPECT_FALSE(sampler.set_policy(rocblas_check_numerics_sample_every_nth, 0x1.0p64));
+            EXPECT_FALSE(sampler.set_policy(rocblas_check_numerics_sample_every_nth, INFINITY));
+            EXPECT_FALSE(sampler.set_policy(rocblas_check_numerics_sample_fraction, 1.5));
+            EXPECT_FALSE(sampler.set_policy(rocblas_check_numerics_sample_fraction, NAN));
+            EXPECT_FALSE(sampler.set_policy(rocblas_check_numerics_sample_first, -1));
+            EXPECT_FALSE(sampler.set_policy(rocblas_check_numerics_sampling(4), 1));
+            EXPECT_EQ(sampler.policy(), rocblas_check_numerics_sample_first);
+            EXPECT_EQ(sampler.stats(axpy).calls, 2 * calls + 1);
+
+            // Policies can be parsed from the environment variable
+            EXPECT_TRUE(sampler.parse("every:10"));
+            EXPECT_EQ(sampler.policy(), rocblas_check_numerics_sample_every_nth);
+            EXPECT_EQ(sampler.value(), 10);
+            EXPECT_TRUE(sampler.parse("fraction:0.01"));
+            EXPECT_EQ(sampler.policy(), rocblas_check_numerics_sample_fraction);
+            EXPECT_EQ(sampler.value(), 0.01);
+            EXPECT_TRUE(sampler.parse("first:1"));
+            EXPECT_EQ(sampler.policy(), rocblas_check_numerics_sample_first);
+            for(const char* spec : {"", "every", "every:", "every:x", "every:0", "first:1x", "x:1"})
+                EXPECT_FALSE(sampler.parse(spec));
+            EXPECT_EQ(sampler.policy(), rocblas_check_numerics_sample_first);
+            EXPECT_TRUE(sampler.parse("all"));
+            EXPECT_EQ(sampler.policy(), rocblas_check_numerics_sample_all);
+        }
+    };
+
+    INTERNAL_TEST_SUITE(check_numerics_sampler);
+
+    template <typename...>
+    struct testing_convert_n : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            // Arrays are converted in chunks of N elements, at offsets which misalign them,
+            // so that the vector kernels leave remainders of every length
+            size_t chunk = std::max<size_t>(arg.N, 1);
+            auto   convert = [&](auto* dst, const auto* src, size_t n, rocblas_convert_isa isa) {
+                for(size_t i = 0; i < n; i += chunk)
+                    rocblas_convert_n(dst + i, src + i, std::min(chunk, n - i), isa);
+            };
+
+            // Every half and bfloat16 value
+            std::vector<uint16_t> bits(65536 + 3);
+            for(size_t i = 0; i < bits.size(); ++i)
+                bits[i] = uint16_t(i);
+            auto halfs = reinterpret_cast<const rocblas_half*>(bits.data());
+            auto bf16s = reinterpret_cast<const rocblas_bfloat16*>(bits.data());
+
+            // Floats with every sign, exponent and high mantissa, and low mantissas which
+            // are rounded in each direction, are ties, or are the payloads of NaNs
+            std::vector<float> floats;
+            for(uint32_t high = 0; high < 65536; ++high)
+                for(uint32_t low : {0x0000, 0x0001, 0x0fff, 0x1000, 0x1001, 0x3000,
+                                    0x7fff, 0x8000, 0x8001, 0xc000, 0xffff})
+                {
+                    uint32_t u = high << 16 | low;
+                    float    f;
+                    memcpy(&f, &u, sizeof(f));
+                    floats.push_back(f);
+                }
+
+            // rocblas_bfloat16(float) rounds finite values to nearest even, truncates Inf
+            // and NaN, and keeps NaNs whose high mantissa bits are 0 from becoming Inf
+            for(float f : floats)
+            {
+                uint32_t u;
+                memcpy(&u, &f, sizeof(u));
+                uint32_t expected = (u & 0x7f800000) != 0x7f800000
+                                        ? (u + 0x7fff + ((u >> 16) & 1)) >> 16
+                                        : (u | (u & 0xffff ? 0x10000 : 0)) >> 16;
+                ASSERT_EQ(rocblas_bfloat16(f).data, expected);
+            }
+
+            // The vector kernels are checked for each instruction set supported by the CPU,
+            // and must give the bits of the scalar conversions
+            std::vector<rocblas_convert_isa> isas{rocblas_convert_isa::scalar};
+            if(rocblas_convert_cpu_isa() >= rocblas_convert_isa::avx2)
+                isas.push_back(rocblas_convert_isa::avx2);
+            if(rocblas_convert_cpu_isa() >= rocblas_convert_isa::avx512)
+                isas.push_back(rocblas_convert_isa::avx512);
+
+            for(auto isa : isas)
+            {
+                for(size_t offset : {0, 1, 3})
+                {
+                    auto   half = halfs + offset;
+                    auto   bf16 = bf16s + offset;
+                    size_t n    = bits.size() - offset;
+
+                    std::vector<float> f(n);
+                    convert(f.data(), half, n, isa);
+                    for(size_t i = 0; i < n; ++i)
+                    {
+                        float expected = float(half[i]);
+                        ASSERT_EQ(memcmp(&f[i], &expected, sizeof(float)), 0);
+                    }
+
+                    convert(f.data(), bf16, n, isa);
+                    for(size_t i = 0; i < n; ++i)
+                    {
+                        float expected = float(bf16[i]);
+                        ASSERT_EQ(memcmp(&f[i], &expected, sizeof(float)), 0);
+                    }
+
+                    const float* src = floats.data() + offset;
+                    size_t       m   = floats.size() - offset;
+
+                    std::vector<rocblas_half> h(m);
+                    convert(h.data(), src, m, isa);
+                    for(size_t i = 0; i < m; ++i)
+                    {
+                        rocblas_half expected = rocblas_half(src[i]);
+                        ASSERT_EQ(memcmp(&h[i], &expected, sizeof(rocblas_half)), 0);
+                    }
+
+                    std::vector<rocblas_bfloat16> b(m);
+                    convert(b.data(), src, m, isa);
+                    for(size_t i = 0; i < m; ++i)
+                        ASSERT_EQ(b[i].data, rocblas_bfloat16(src[i]).data);
+                }
+            }
+
+            // Conversions to double go through float, which is exact
+            std::vector<double> d(bits.size());
+            rocblas_convert_n(d.data(), halfs, d.size());
+            for(size_t i = 0; i < d.size(); ++i)
+            {
+                double expected = float(halfs[i]);
+                ASSERT_EQ(memcmp(&d[i], &expected, sizeof(double)), 0);
+            }
+            rocblas_convert_n(d.data(), bf16s, d.size());
+            for(size_t i = 0; i < d.size(); ++i)
+            {
+                double expected = float(bf16s[i]);
+                ASSERT_EQ(memcmp(&d[i], &expected, sizeof(double)), 0);
+            }
+        }
+    };
+
+    INTERNAL_TEST_SUITE(convert_n);
+
+    //
+    // sharded test execution
+
+    template <typename...>
+    struct testing_test_shards : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            const size_t N = arg.N;
+
+            // The cost model grows with the size of the problem
+            Arguments problem{};
+            strcpy(problem.function, "gemm_strided_batched_ex");
+            problem.M = problem.N = problem.K = 64;
+            problem.batch_count                = 1;
+            double small                       = rocblas_test_cost(problem);
+            problem.M = problem.N = problem.K = 1024;
+            double large                       = rocblas_test_cost(problem);
+            EXPECT_GT(large, 100 * small);
+            problem.batch_count = 10;
+            EXPECT_GT(rocblas_test_cost(problem), 9 * large);
+            problem.M = -1;
+            EXPECT_GT(rocblas_test_cost(problem), 0.0);
+
+            // Items of very different costs are balanced between 7 shards, and the
+            // assignment only depends on the costs
+            std::vector<double> costs(N);
+            for(size_t i = 0; i < N; ++i)
+                costs[i] = (i * 7919 % 1000) * 1e-3 + (i % 97 ? 0 : 50);
+            auto shards = RocBLAS_TestData::assign_shards(costs, 7);
+            EXPECT_EQ(shards, RocBLAS_TestData::assign_shards(costs, 7));
+
+            std::vector<double> loads(7);
+            double              max_cost = 0;
+            for(size_t i = 0; i < N; ++i)
+            {
+                ASSERT_LT(shards[i], 7u);
+                loads[shards[i]] += costs[i];
+                max_cost = std::max(max_cost, costs[i]);
+            }
+            double total = std::accumulate(loads.begin(), loads.end(), 0.0);
+            for(double load : loads)
+                EXPECT_LE(load, total / 7 + max_cost);
+
+            // Reports of the same test suite are merged, with their counts added
+            auto write_report = [](const std::string& path, const char* time, size_t tests) {
+                std::ofstream report(path);
+                report << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                       << "<testsuites tests=\"" << tests << "\" failures=\"1\" time=\"" << time
+                       << "\" name=\"AllTests\">\n"
+                       << "  <testsuite name=\"_/gemm\" tests=\"" << tests
+                       << "\" failures=\"1\" time=\"" << time << "\">\n";
+                for(size_t i = 0; i < tests; ++i)
+                    report << "    <testcase name=\"quick_" << i << "\" time=\"0\" />\n";
+                report << "  </testsuite>\n"
+                       << "</testsuites>\n";
+            };
+
+            std::vector<std::string> reports{rocblas_tempname(), rocblas_tempname()};
+            write_report(reports[0], "1.5", N);
+            write_report(reports[1], "2.5", 2);
+
+            std::stringstream merged;
+            EXPECT_TRUE(rocblas_merge_gtest_xml(reports, merged));
+            auto xml = merged.str();
+            EXPECT_NE(xml.find("<testsuites tests=\"" + std::to_string(N + 2)
+                               + "\" failures=\"2\" time=\"2.500\""),
+                      std::string::npos);
+            EXPECT_NE(xml.find("<testsuite name=\"_/gemm\" tests=\"" + std::to_string(N + 2)
+                               + "\" failures=\"2\" time=\"4.000\">"),
+                      std::string::npos);
+            EXPECT_EQ(std::count(xml.begin(), xml.end(), '\n'), ptrdiff_t(N + 2 + 5));
+
+            for(auto& report : reports)
+                remove(report.c_str());
+            EXPECT_FALSE(rocblas_merge_gtest_xml(reports, merged));
+        }
+    };
+
+    INTERNAL_TEST_SUITE(test_shards);
+
+    //
+    // rocblas-bench memory reuse
+
+    template <typename...>
+    struct testing_client_memory_pool : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            using pool_t   = rocblas_client_memory_pool<fake_slab_allocator>;
+            const size_t N = 64 * arg.N; // bytes
+
+            // Blocks are rounded up by at most 1/8, in multiples of 8 bytes
+            for(size_t size = 1; size < N * 100; size += size / 3 + 1)
+            {
+                size_t block = pool_t::block_size(size);
+                EXPECT_GE(block, size);
+                EXPECT_LE(block, size + size / 8 + 8);
+                EXPECT_EQ(block % 8, 0u);
+                EXPECT_GE(pool_t::block_size(size + 1), block);
+            }
+
+            fake_slab_allocator allocator;
+            {
+                pool_t pool(allocator);
+
+                // A freed block is reused by a request of the same size
+                void* a = pool.allocate(N);
+                ASSERT_NE(a, nullptr);
+                EXPECT_TRUE(pool.deallocate(a));
+                EXPECT_FALSE(pool.deallocate(a));
+                EXPECT_FALSE(pool.deallocate(&allocator));
+                EXPECT_EQ(pool.allocate(N), a);
+                void* b = pool.allocate(N);
+                ASSERT_NE(b, nullptr);
+                EXPECT_NE(b, a);
+                EXPECT_EQ(allocator.slabs->size(), 2u);
+                EXPECT_EQ(pool.stats().reuses, 1u);
+                EXPECT_EQ(pool.stats().held, 2 * pool_t::block_size(N));
+                EXPECT_EQ(pool.stats().in_use, 2 * pool_t::block_size(N));
+
+                // A larger request replaces an idle block which is too small
+                EXPECT_TRUE(pool.deallocate(a));
+                EXPECT_TRUE(pool.deallocate(b));
+                void* c = pool.allocate(4 * N);
+                ASSERT_NE(c, nullptr);
+                EXPECT_EQ(allocator.slabs->size(), 2u);
+                EXPECT_EQ(pool.idle_count(), 1u);
+                EXPECT_EQ(pool.stats().held, pool_t::block_size(N) + pool_t::block_size(4 * N));
+
+                // A block is not reused by a request of less than half of its size
+                EXPECT_TRUE(pool.deallocate(c));
+                void* d = pool.allocate(N);
+                void* e = pool.allocate(N);
+                ASSERT_NE(d, nullptr);
+                ASSERT_NE(e, nullptr);
+                EXPECT_NE(d, c);
+                EXPECT_NE(e, c);
+                EXPECT_EQ(pool.idle_count(), 1u);
+                EXPECT_EQ(allocator.slabs->size(), 3u);
+
+                // When an allocation fails, the idle blocks are freed before it is retried
+                *allocator.fail = true;
+                EXPECT_EQ(pool.allocate(100 * N), nullptr);
+                EXPECT_EQ(pool.stats().failures, 1u);
+                EXPECT_EQ(pool.idle_count(), 0u);
+                EXPECT_EQ(allocator.slabs->size(), 2u);
+                *allocator.fail = false;
+
+                // A block which is not kept is freed, and release() frees the idle blocks
+                EXPECT_TRUE(pool.deallocate(d, false));
+                EXPECT_EQ(allocator.slabs->size(), 1u);
+                EXPECT_TRUE(pool.deallocate(e));
+                EXPECT_EQ(allocator.slabs->size(), 1u);
+                pool.release();
+                EXPECT_EQ(allocator.slabs->size(), 0u);
+                EXPECT_EQ(pool.stats().held, 0u);
+                EXPECT_EQ(pool.stats().in_use, 0u);
+
+                // Idle blocks are freed when the pool is destroyed
+                EXPECT_TRUE(pool.deallocate(pool.allocate(N)));
+                EXPECT_EQ(allocator.slabs->size(), 1u);
+            }
+            EXPECT_EQ(allocator.slabs->size(), 0u);
+
+            // The results of rocblas-bench are written as CSV, with the column names repeated
+            // only when they change, or as JSON
+            rocblas_internal_ostream csv;
+            ArgumentModel_set_results(&csv, ArgumentModel_results_format::csv);
+            for(size_t i = 0; i < 3; ++i)
+                ArgumentModel_log_results(
+                    i < 2 ? "gemm" : "axpy", i < 2 ? "M,us" : "N,us", std::to_string(i) + ", 1.5");
+            ArgumentModel_set_results(nullptr, ArgumentModel_results_format::csv);
+            EXPECT_FALSE(ArgumentModel_get_results());
+            EXPECT_EQ(csv.str(),
+                      "function,M,us\ngemm,0, 1.5\ngemm,1, 1.5\nfunction,N,us\naxpy,2, 1.5\n");
+
+            rocblas_internal_ostream json;
+            ArgumentModel_write_json(json,
+                                     "function,M,transA,alpha,name,rocblas-Gflops,us",
+                                     "gemm,128,N,-1.5e-3,a\"b, 12.25, nan");
+            EXPECT_EQ(json.str(),
+                      "{\"function\": \"gemm\", \"M\": 128, \"transA\": \"N\", "
+                      "\"alpha\": -1.5e-3, \"name\": \"a\\\"b\", \"rocblas-Gflops\": 12.25, "
+                      "\"us\": \"nan\"}\n");
+
+            // Lines of a bench log are split into rocblas-bench command lines
+            std::vector<std::string> words;
+            EXPECT_TRUE(ArgumentModel_split_bench_command("./rocblas-bench -f dot -n 8 ", words));
+            EXPECT_EQ(words, (std::vector<std::string>{"./rocblas-bench", "-f", "dot", "-n", "8"}));
+            EXPECT_TRUE(ArgumentModel_split_bench_command("  -f axpy\t-n 10", words));
+            EXPECT_EQ(words, (std::vector<std::string>{"rocblas-bench", "-f", "axpy", "-n", "10"}));
+            for(const char* line : {"", "  \t", "# rocblas-bench -f gemm", "echo -f gemm"})
+                EXPECT_FALSE(ArgumentModel_split_bench_command(line, words)) << line;
+            EXPECT_FALSE(ArgumentModel_split_bench_command("./rocblas-bench2", words));
+
+            // A handle released while reuse is enabled is reacquired with its state and its
+            // statistics reset
+            hipStream_t stream;
+            CHECK_HIP_ERROR(hipStreamCreate(&stream));
+            rocblas_client_set_reuse(true);
+            rocblas_handle reused;
+            bool           checks_numerics;
+            size_t         peak, allocations, growths, failures;
+            {
+                rocblas_local_handle handle{arg};
+                reused          = handle;
+                checks_numerics = reused->check_numerics;
+
+                size_t               n = 1 << 16;
+                float                result;
+                device_vector<float> dx(n);
+                CHECK_DEVICE_ALLOCATION(dx.memcheck());
+                CHECK_HIP_ERROR(hipMemset(dx, 0, n * sizeof(float)));
+                CHECK_ROCBLAS_ERROR(rocblas_snrm2(handle, n, dx, 1, &result));
+                CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_stats(
+                    handle, &peak, &allocations, &growths, &failures));
+                EXPECT_GT(allocations, 0u);
+
+                CHECK_ROCBLAS_ERROR(rocblas_set_stream(handle, stream));
+                CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
+            }
+            {
+                rocblas_local_handle handle{arg};
+
+                // A handle which checks numerics is not reused
+                if(!checks_numerics)
+                    EXPECT_EQ(rocblas_handle(handle), reused);
+
+                hipStream_t          handle_stream;
+                rocblas_pointer_mode mode;
+                CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &handle_stream));
+                CHECK_ROCBLAS_ERROR(rocblas_get_pointer_mode(handle, &mode));
+                CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_stats(
+                    handle, &peak, &allocations, &growths, &failures));
+                EXPECT_EQ(handle_stream, hipStream_t{});
+                EXPECT_EQ(mode, rocblas_pointer_mode_host);
+                EXPECT_EQ(allocations, 0u);
+                EXPECT_EQ(failures, 0u);
+            }
+            rocblas_client_set_reuse(false);
+            CHECK_HIP_ERROR(hipStreamDestroy(stream));
+        }
+    };
+
+    INTERNAL_TEST_SUITE(client_memory_pool);
+
+    template <typename...>
+    struct testing_timing_stats : rocblas_test_valid
+    {
+        void operator()(const Arguments& arg)
+        {
+            size_t N = arg.N;
+
+            // Percentiles interpolate linearly between the closest ranks
+            std::vector<double> sorted{1, 2, 3, 4};
+            EXPECT_DOUBLE_EQ(rocblas_percentile(sorted, 0), 1);
+            EXPECT_DOUBLE_EQ(rocblas_percentile(sorted, 25), 1.75);
+            EXPECT_DOUBLE_EQ(rocblas_percentile(sorted, 50), 2.5);
+            EXPECT_DOUBLE_EQ(rocblas_percentile(sorted, 100), 4);
+
+            EXPECT_NEAR(rocblas_normal_quantile(0.975), 1.959964, 1e-6);
+            EXPECT_NEAR(rocblas_normal_quantile(0.005), -2.575829, 1e-6);
+            EXPECT_NEAR(rocblas_student_t_quantile(0.975, 1), 12.7062, 1e-4);
+            EXPECT_NEAR(rocblas_student_t_quantile(0.975, 2), 4.3027, 1e-4);
+            EXPECT_NEAR(rocblas_student_t_quantile(0.975, 4), 2.7764, 3e-3);
+            EXPECT_NEAR(rocblas_student_t_quantile(0.975, 9), 2.2622, 1e-3);
+            EXPECT_NEAR(rocblas_student_t_quantile(0.995, 29), 2.7564, 1e-3);
+
+            // The times alternate between 99 and 101 us, followed by an outlier
+            rocblas_timing_policy policy;
+            rocblas_timing_stats  stats;
+            for(size_t i = 0; i < 2 * N; i++)
+                stats.add(i % 2 ? 101 : 99);
+            stats.add(1000);
+
+            auto s = stats.summarize(policy);
+            EXPECT_TRUE(s.per_call);
+            EXPECT_EQ(s.iters, 2 * N + 1);
+            EXPECT_EQ(s.rejected, 1u);
+            EXPECT_DOUBLE_EQ(s.mean, 100);
+            EXPECT_DOUBLE_EQ(s.median, 100);
+            EXPECT_DOUBLE_EQ(s.min, 99);
+            EXPECT_DOUBLE_EQ(s.max, 101);
+            EXPECT_LE(s.p5, s.median);
+            EXPECT_GE(s.p95, s.median);
+            EXPECT_DOUBLE_EQ(s.stddev, std::sqrt(2.0 * N / (2 * N - 1)));
+            EXPECT_DOUBLE_EQ(s.ci,
+                             rocblas_student_t_quantile(0.975, 2 * N - 1) * s.stddev
+                                 / std::sqrt(2.0 * N));
+            EXPECT_EQ(s.converged, N >= 10);
+
+            // Without a fence, the outlier is kept
+            policy.outlier_fence = 0;
+            s                    = stats.summarize(policy);
+            EXPECT_EQ(s.rejected, 0u);
+            EXPECT_DOUBLE_EQ(s.max, 1000);
+            EXPECT_DOUBLE_EQ(s.mean, (200.0 * N + 1000) / (2 * N + 1));
+
+            // If more than half of the times are equal, the MAD is 0, and none are rejected
+            rocblas_timing_stats equal;
+            for(double us : {5, 5, 5, 50})
+                equal.add(us);
+            policy = {};
+            EXPECT_EQ(equal.summarize(policy).rejected, 0u);
+
+            // N calls are timed, and then more only if there is a max_iters. Their number
+            // doubles until the confidence interval is narrow enough, or max_iters is reached.
+            rocblas_timing_stats adaptive;
+            EXPECT_EQ(adaptive.next_batch(policy, N, 0), N);
+            while(adaptive.size() < N)
+                adaptive.add(adaptive.size() % 2 ? 101 : 99);
+            EXPECT_EQ(adaptive.next_batch(policy, N, 0), 0u);
+
+            policy.max_iters = 8 * N;
+            while(size_t batch = adaptive.next_batch(policy, N, 0))
+            {
+                EXPECT_EQ(batch, adaptive.size());
+                for(size_t i = 0; i < batch; i++)
+                    adaptive.add(adaptive.size() % 2 ? 101 : 99);
+            }
+            EXPECT_EQ(adaptive.size(), N == 1 ? 8 : N);
+
+            // No more calls are timed once the time limit is exceeded
+            rocblas_timing_stats noisy;
+            noisy.add(50);
+            noisy.add(150);
+            EXPECT_EQ(noisy.next_batch(policy, 2, 0), 2u);
+            EXPECT_EQ(noisy.next_batch(policy, 2, policy.max_time_us), 0u);
+
+            // Hot calls timed together only have a mean
+            auto total = rocblas_timing_summary::total(1000.0 * N, N);
+            EXPECT_FALSE(total.per_call);
+            EXPECT_EQ(total.iters, N);
+            EXPECT_DOUBLE_EQ(total.median, 1000);
+            EXPECT_DOUBLE_EQ(total.mean, 1000);
+        }
+    };
+
+    INTERNAL_TEST_SUITE(timing_stats);
+
 } // namespace
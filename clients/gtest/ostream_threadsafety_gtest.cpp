@@ -34,6 +34,8 @@ namespace
         {
             if(!strcmp(arg.function, "ostream_threadsafety"))
                 testing_ostream_threadsafety(arg);
+            else if(!strcmp(arg.function, "ostream_throughput"))
+                testing_ostream_throughput(arg);
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
@@ -50,13 +52,17 @@ namespace
         // Filter for which functions apply to this suite
         static bool function_filter(const Arguments& arg)
         {
-            return !strcmp(arg.function, "ostream_threadsafety");
+            return !strcmp(arg.function, "ostream_threadsafety")
+                   || !strcmp(arg.function, "ostream_throughput");
         }
 
         // Google Test name suffix based on parameters
         static std::string name_suffix(const Arguments& arg)
         {
-            return RocBLAS_TestName<ostream_threadsafety>(arg.name);
+            RocBLAS_TestName<ostream_threadsafety> name(arg.name);
+            if(!strcmp(arg.function, "ostream_throughput"))
+                name << arg.N;
+            return std::move(name);
         }
     };
 
@@ -25,6 +25,7 @@
 #include "rocblas_data.hpp"
 #include "rocblas_parse_data.hpp"
 #include "rocblas_test.hpp"
+#include "rocblas_test_shard.hpp"
 #include "test_cleanup.hpp"
 #include "utility.hpp"
 
@@ -252,14 +253,22 @@ int main(int argc, char** argv)
 
     rocblas_print_version();
 
-    // Set test device
-    rocblas_set_test_device();
+    // Parse --shards and --shard options
+    size_t shards = rocblas_parse_shards(argc, argv);
+
+    // Set test device, unless the tests run in worker processes
+    if(!shards)
+        rocblas_set_test_device();
 
     rocblas_print_usage_warning();
 
     // Set data file path
     rocblas_parse_data(argc, argv, rocblas_exepath() + "rocblas_gtest.data");
 
+    // Run shards of the tests in worker processes
+    if(shards)
+        return rocblas_run_shards(shards, RocBLAS_TestData::get_filename(), argc, argv);
+
     // Initialize Google Tests
     testing::InitGoogleTest(&argc, argv);
 
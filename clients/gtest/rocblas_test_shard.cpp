@@ -0,0 +1,456 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas_test_shard.hpp"
+#include "flops.hpp"
+#include "rocblas_data.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <system_error>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+double rocblas_test_cost(const Arguments& arg)
+{
+    // Base name of the function, without its batched and extended variants
+    std::string name = arg.function;
+    for(const char* suffix : {"_ex", "_strided_batched", "_batched"})
+    {
+        size_t len = strlen(suffix);
+        if(name.size() > len && !name.compare(name.size() - len, len, suffix))
+            name.resize(name.size() - len);
+    }
+
+    // Invalid sizes are tested without computing anything
+    rocblas_int M = std::max(arg.M, 0), N = std::max(arg.N, 0), K = std::max(arg.K, 0);
+    rocblas_int KL = std::max(arg.KL, 0), KU = std::max(arg.KU, 0);
+    auto        transA = char2rocblas_operation(arg.transA);
+    auto        side   = char2rocblas_side(arg.side);
+
+    auto is = [&](std::initializer_list<const char*> names) {
+        return std::any_of(names.begin(), names.end(), [&](const char* s) { return name == s; });
+    };
+
+    double gflops;
+    if(is({"gemm"}))
+        gflops = gemm_gflop_count<float>(M, N, K);
+    else if(is({"geam"}))
+        gflops = geam_gflop_count<float>(M, N);
+    else if(is({"dgmm"}))
+        gflops = dgmm_gflop_count<float>(M, N);
+    else if(is({"symm", "hemm"}))
+        gflops = symm_gflop_count<float>(side, M, N);
+    else if(is({"syrk", "herk"}))
+        gflops = syrk_gflop_count<float>(N, K);
+    else if(is({"syr2k", "her2k"}))
+        gflops = syr2k_gflop_count<float>(N, K);
+    else if(is({"syrkx", "herkx"}))
+        gflops = syrkx_gflop_count<float>(N, K);
+    else if(is({"trmm"}))
+        gflops = trmm_gflop_count<float>(M, N, side);
+    else if(is({"trsm"}))
+        gflops = trsm_gflop_count<float>(M, N, side == rocblas_side_left ? M : N);
+    else if(is({"trtri"}))
+        gflops = trtri_gflop_count<float>(N);
+    else if(is({"gemv"}))
+        gflops = gemv_gflop_count<float>(transA, M, N);
+    else if(is({"gbmv"}))
+        gflops = gbmv_gflop_count<float>(transA, M, N, KL, KU);
+    else if(is({"ger", "geru", "gerc"}))
+        gflops = ger_gflop_count<float>(M, N);
+    else if(is({"hbmv", "sbmv", "tbmv", "tbsv"}))
+        gflops = sbmv_gflop_count<float>(N, K);
+    else if(is({"hemv", "hpmv", "her", "her2", "hpr", "hpr2", "symv", "spmv", "spr", "spr2",
+                "syr", "syr2", "trmv", "tpmv", "trsv", "tpsv"}))
+        gflops = symv_gflop_count<float>(N);
+    else
+        gflops = axpy_gflop_count<float>(N);
+
+    // Complex arithmetic takes about 4 times as many operations
+    if(arg.a_type == rocblas_datatype_f32_c || arg.a_type == rocblas_datatype_f64_c)
+        gflops *= 4;
+
+    // Every test has a fixed overhead for its handle and allocations, and every batch
+    // instance has its own reference call
+    size_t batch = std::max(arg.batch_count, 1);
+    return 1e-2 + batch * (1e-5 + gflops);
+}
+
+size_t rocblas_parse_shards(int& argc, char** argv)
+{
+    size_t shards = 0;
+    char** argv_p = argv + 1;
+
+    // Scan, process and remove any --shards or --shard options
+    for(int i = 1; argv[i]; ++i)
+    {
+        if(!strcmp(argv[i], "--shards") || !strcmp(argv[i], "--shard"))
+        {
+            if(!argv[i + 1] || !argv[i + 1][0])
+            {
+                rocblas_cerr << "The " << argv[i] << " option requires an argument" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+
+            size_t index, count;
+            char   extra;
+            if(!strcmp(argv[i], "--shards"))
+            {
+                if(sscanf(argv[i + 1], "%zu%c", &count, &extra) != 1 || !count)
+                {
+                    rocblas_cerr << "Invalid number of shards: " << argv[i + 1] << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                shards = count;
+            }
+            else
+            {
+                if(sscanf(argv[i + 1], "%zu/%zu%c", &index, &count, &extra) != 2
+                   || index >= count)
+                {
+                    rocblas_cerr << "Invalid shard: " << argv[i + 1] << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                RocBLAS_TestData::set_shard(index, count, rocblas_test_cost);
+            }
+            ++i;
+        }
+        else
+        {
+            *argv_p++ = argv[i];
+            if(!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help"))
+                rocblas_cout << "--shards <N>: run the tests in N worker processes\n"
+                             << std::endl;
+        }
+    }
+
+    // argc and argv contain remaining options and non-option arguments
+    *argv_p = nullptr;
+    argc    = argv_p - argv;
+
+    return shards;
+}
+
+// Path of the XML report requested with --gtest_output or GTEST_OUTPUT, or "" if none
+static std::string rocblas_gtest_xml_path(const std::string& output)
+{
+    if(output.empty())
+        return "";
+    if(output == "xml")
+        return "test_detail.xml";
+    if(output.compare(0, 4, "xml:"))
+    {
+        rocblas_cerr << "Only XML reports are merged from shards; ignoring " << output
+                     << std::endl;
+        return "";
+    }
+
+    std::string path = output.substr(4);
+    if(path.empty() || path.back() == '/')
+        path += "rocblas-test.xml";
+    return path;
+}
+
+int rocblas_run_shards(size_t count, const std::string& filename, int argc, char** argv)
+{
+#ifdef WIN32
+    rocblas_cerr << "The --shards option is not supported on Windows" << std::endl;
+    return EXIT_FAILURE;
+#else
+    // The workers write their own reports, which are merged where the report was requested
+    const char*              env_output = getenv("GTEST_OUTPUT");
+    std::string              output     = env_output ? env_output : "";
+    std::vector<std::string> forward;
+    for(int i = 1; i < argc; ++i)
+    {
+        if(!strncmp(argv[i], "--gtest_output=", 15))
+            output = argv[i] + 15;
+        else
+            forward.push_back(argv[i]);
+    }
+    std::string xml = rocblas_gtest_xml_path(output);
+
+    struct worker
+    {
+        pid_t       pid;
+        std::string log, report;
+    };
+
+    std::string         base = rocblas_tempname();
+    std::vector<worker> workers(count);
+    rocblas_cout << "[ SHARDS   ] Running " << count << " shards of " << filename << std::endl;
+
+    for(size_t i = 0; i < count; ++i)
+    {
+        auto& w  = workers[i];
+        w.log    = base + ".shard" + std::to_string(i) + ".log";
+        w.report = base + ".shard" + std::to_string(i) + ".xml";
+
+        std::vector<std::string> args{argv[0],
+                                      "--data",
+                                      filename,
+                                      "--shard",
+                                      std::to_string(i) + "/" + std::to_string(count),
+                                      "--gtest_output=xml:" + w.report};
+        args.insert(args.end(), forward.begin(), forward.end());
+        std::vector<char*> args_c;
+        for(auto& arg : args)
+            args_c.push_back(&arg[0]);
+        args_c.push_back(nullptr);
+
+        // The output of each worker is written to its log, which is printed when it exits
+        w.pid = fork();
+        if(w.pid == 0)
+        {
+            int fd = open(w.log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if(fd != -1)
+            {
+                dup2(fd, STDOUT_FILENO);
+                dup2(fd, STDERR_FILENO);
+                execv("/proc/self/exe", args_c.data());
+            }
+            _exit(127);
+        }
+        else if(w.pid == -1)
+        {
+            rocblas_cerr << "Cannot start shard " << i << ": "
+                         << std::error_code(errno, std::generic_category()).message() << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    size_t failed = 0;
+    for(size_t n = 0; n < count; ++n)
+    {
+        int   status;
+        pid_t pid = wait(&status);
+        if(pid == -1)
+            break;
+        auto it = std::find_if(
+            workers.begin(), workers.end(), [=](const worker& w) { return w.pid == pid; });
+        if(it == workers.end())
+            continue;
+
+        std::ifstream      log(it->log);
+        std::ostringstream contents;
+        contents << log.rdbuf();
+        rocblas_cout << "[ SHARD    ] " << it - workers.begin() << "/" << count << "\n"
+                     << contents.str() << std::flush;
+
+        if(!WIFEXITED(status) || WEXITSTATUS(status))
+        {
+            ++failed;
+            rocblas_cout << "[ SHARD    ] " << it - workers.begin() << "/" << count
+                         << (WIFEXITED(status) ? " exited with status " : " killed by signal ")
+                         << (WIFEXITED(status) ? WEXITSTATUS(status) : WTERMSIG(status))
+                         << std::endl;
+        }
+    }
+
+    // Shards which crashed have no report, and are only counted as failures
+    bool merged = true;
+    if(!xml.empty())
+    {
+        std::vector<std::string> reports;
+        std::error_code          ec;
+        for(auto& w : workers)
+            if(fs::exists(w.report, ec))
+                reports.push_back(w.report);
+
+        // Like Google Test, create the directory of the report
+        auto dir = fs::path(xml).parent_path();
+        if(!dir.empty())
+            fs::create_directories(dir, ec);
+
+        std::ofstream os(xml);
+        merged = rocblas_merge_gtest_xml(reports, os) && os.flush();
+        if(!merged)
+            rocblas_cerr << "Cannot merge the XML reports of the shards into " << xml
+                         << std::endl;
+    }
+
+    for(auto& w : workers)
+    {
+        remove(w.log.c_str());
+        remove(w.report.c_str());
+    }
+    remove(base.c_str());
+
+    rocblas_cout << "[ SHARDS   ] " << count - failed << " of " << count << " shards passed"
+                 << std::endl;
+    return failed || !merged ? EXIT_FAILURE : EXIT_SUCCESS;
+#endif
+}
+
+namespace
+{
+    // Attributes of an XML element, in the order in which they appear
+    using xml_attributes = std::vector<std::pair<std::string, std::string>>;
+
+    xml_attributes parse_attributes(const std::string& tag)
+    {
+        static const std::regex regex{R"re(([\w:-]+)="([^"]*)")re"};
+        xml_attributes          attributes;
+        for(std::sregex_iterator it(tag.begin(), tag.end(), regex), end; it != end; ++it)
+            attributes.emplace_back((*it)[1], (*it)[2]);
+        return attributes;
+    }
+
+    // Value of the attribute called name, or nullptr if there is none
+    std::string* attribute(xml_attributes& attributes, const char* name)
+    {
+        for(auto& p : attributes)
+            if(p.first == name)
+                return &p.second;
+        return nullptr;
+    }
+
+    // Combine the attributes of an element of a shard into the merged attributes. Counts are
+    // added, and times are added, or take their maximum for shards which ran in parallel.
+    // The earliest timestamp is kept.
+    void merge_attributes(xml_attributes& merged, xml_attributes& shard, bool parallel)
+    {
+        for(const char* count : {"tests", "failures", "disabled", "skipped", "errors"})
+        {
+            std::string* value = attribute(merged, count);
+            std::string* other = attribute(shard, count);
+            if(value && other)
+                *value = std::to_string(atoll(value->c_str()) + atoll(other->c_str()));
+        }
+
+        std::string* time       = attribute(merged, "time");
+        std::string* other_time = attribute(shard, "time");
+        if(time && other_time)
+        {
+            double a = atof(time->c_str()), b = atof(other_time->c_str());
+            char   str[32];
+            snprintf(str, sizeof(str), "%.3f", parallel ? std::max(a, b) : a + b);
+            *time = str;
+        }
+
+        std::string* timestamp       = attribute(merged, "timestamp");
+        std::string* other_timestamp = attribute(shard, "timestamp");
+        if(timestamp && other_timestamp && *other_timestamp < *timestamp)
+            *timestamp = *other_timestamp;
+    }
+
+    void write_tag(std::ostream&         os,
+                   const char*           indent,
+                   const char*           name,
+                   const xml_attributes& attributes)
+    {
+        os << indent << "<" << name;
+        for(auto& p : attributes)
+            os << " " << p.first << "=\"" << p.second << "\"";
+        os << ">\n";
+    }
+}
+
+bool rocblas_merge_gtest_xml(const std::vector<std::string>& reports, std::ostream& os)
+{
+    struct suite
+    {
+        xml_attributes attributes;
+        std::string    body; // lines between the start and end tags
+    };
+
+    xml_attributes               all;
+    std::vector<std::string>     order; // names of the suites in order of first appearance
+    std::map<std::string, suite> suites;
+
+    for(auto& report : reports)
+    {
+        std::ifstream ifs(report);
+        if(!ifs)
+            return false;
+
+        suite*      current = nullptr;
+        std::string line;
+        while(std::getline(ifs, line))
+        {
+            auto start = line.find_first_not_of(" ");
+            if(start == std::string::npos)
+                continue;
+
+            if(!line.compare(start, 11, "<testsuites"))
+            {
+                auto attributes = parse_attributes(line);
+                if(all.empty())
+                    all = std::move(attributes);
+                else
+                    merge_attributes(all, attributes, true);
+            }
+            else if(!line.compare(start, 11, "<testsuite "))
+            {
+                auto attributes = parse_attributes(line);
+                auto name       = attribute(attributes, "name");
+                if(!name)
+                    return false;
+
+                auto it = suites.find(*name);
+                if(it == suites.end())
+                {
+                    order.push_back(*name);
+                    current             = &suites[*name];
+                    current->attributes = std::move(attributes);
+                }
+                else
+                {
+                    current = &it->second;
+                    merge_attributes(current->attributes, attributes, false);
+                }
+
+                // An empty test suite has no end tag
+                if(!line.compare(line.size() - 2, 2, "/>"))
+                    current = nullptr;
+            }
+            else if(!line.compare(start, 12, "</testsuite>"))
+                current = nullptr;
+            else if(current)
+                current->body += line + "\n";
+        }
+    }
+
+    os << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    write_tag(os, "", "testsuites", all);
+    for(auto& name : order)
+    {
+        auto& s = suites[name];
+        write_tag(os, "  ", "testsuite", s.attributes);
+        os << s.body << "  </testsuite>\n";
+    }
+    os << "</testsuites>\n";
+    return bool(os);
+}
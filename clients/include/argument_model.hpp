@@ -23,6 +23,9 @@
 #pragma once
 
 #include "rocblas_arguments.hpp"
+#include "timing_stats.hpp"
+#include <string>
+#include <vector>
 
 namespace ArgumentLogging
 {
@@ -32,6 +35,35 @@ namespace ArgumentLogging
 void ArgumentModel_set_log_function_name(bool f);
 bool ArgumentModel_get_log_function_name();
 
+// rocblas-bench can also write the results of all of the problems it runs to a single stream,
+// with the function name, the arguments and the performance of each problem. As CSV, the
+// column names are only repeated when they change. As JSON, each problem is an object on its
+// own line.
+enum class ArgumentModel_results_format
+{
+    csv,
+    json,
+};
+
+void ArgumentModel_set_results(rocblas_internal_ostream*    os,
+                               ArgumentModel_results_format format);
+bool ArgumentModel_get_results();
+
+// Write one result to the results stream. names and values are comma-separated lists.
+void ArgumentModel_log_results(const char* function, std::string names, std::string values);
+
+// Write one result as a JSON object. Numbers are written as JSON numbers, and other values
+// as strings.
+void ArgumentModel_write_json(rocblas_internal_ostream& os,
+                              const std::string&        names,
+                              const std::string&        values);
+
+// Split a line of a bench log, such as one written with ROCBLAS_LAYER=2, or of a script of
+// rocblas-bench commands, into the words of a rocblas-bench command line, starting with the
+// command. The command is optional on the line. Returns false for empty lines, comments and
+// other commands.
+bool ArgumentModel_split_bench_command(const std::string& line, std::vector<std::string>& words);
+
 // ArgumentModel template has a variadic list of argument enums
 template <rocblas_argument... Args>
 class ArgumentModel
@@ -46,6 +78,9 @@ class ArgumentModel
         return false;
     }
 
+    // Statistics of the hot calls, if they were timed by rocblas_time_hot_calls
+    const rocblas_timing_summary* m_time = nullptr;
+
 public:
     void log_perf(rocblas_internal_ostream& name_line,
                   rocblas_internal_ostream& val_line,
@@ -63,8 +98,9 @@ public:
         rocblas_int    batch_count     = has_batch_count ? arg.batch_count : 1;
         rocblas_int    hot_calls       = arg.iters < 1 ? 1 : arg.iters;
 
-        // gpu time is total cumulative over hot calls, cpu is not
-        if(hot_calls > 1)
+        // gpu time is total cumulative over hot calls, cpu is not,
+        // unless it is the median from rocblas_time_hot_calls
+        if(hot_calls > 1 && !m_time)
             gpu_us /= hot_calls;
 
         // per/us to per/sec *10^6
@@ -88,6 +124,14 @@ public:
         name_line << ",us";
         val_line << ", " << gpu_us;
 
+        if(m_time && m_time->per_call)
+        {
+            name_line << ",us-mean,us-stddev,us-min,us-p5,us-p95,us-max,us-ci,iters,outliers";
+            val_line << ", " << m_time->mean << ", " << m_time->stddev << ", " << m_time->min
+                     << ", " << m_time->p5 << ", " << m_time->p95 << ", " << m_time->max << ", "
+                     << m_time->ci << ", " << m_time->iters << ", " << m_time->rejected;
+        }
+
         if(arg.unit_check || arg.norm_check)
         {
             if(cpu_us != ArgumentLogging::NA_value)
@@ -203,6 +247,29 @@ public:
                      norm3,
                      norm4);
 
+        if(ArgumentModel_get_results())
+            ArgumentModel_log_results(arg.function, name_list.str(), value_list.str());
+
         str << name_list << "\n" << value_list << std::endl;
     }
+
+    // Log the arguments with the times of the hot calls from rocblas_time_hot_calls. Their median
+    // is reported as the time, followed by the other statistics if the calls were timed one at
+    // a time.
+    template <typename T>
+    void log_args(rocblas_internal_ostream&     str,
+                  const Arguments&              arg,
+                  const rocblas_timing_summary& time,
+                  double                        gflops,
+                  double                        gpu_bytes = ArgumentLogging::NA_value,
+                  double                        cpu_us    = ArgumentLogging::NA_value,
+                  double                        norm1     = ArgumentLogging::NA_value,
+                  double                        norm2     = ArgumentLogging::NA_value,
+                  double                        norm3     = ArgumentLogging::NA_value,
+                  double                        norm4     = ArgumentLogging::NA_value)
+    {
+        m_time = &time;
+        log_args<T>(str, arg, time.median, gflops, gpu_bytes, cpu_us, norm1, norm2, norm3, norm4);
+        m_time = nullptr;
+    }
 };
@@ -34,6 +34,7 @@
 #include "rocblas_random.hpp"
 #include "rocblas_test.hpp"
 #include "rocblas_vector.hpp"
+#include "timing_engine.hpp"
 #include "unit.hpp"
 #include "utility.hpp"
 
@@ -193,8 +194,7 @@ void testing_gemm(const Arguments& arg)
     T h_alpha = arg.get_alpha<T>();
     T h_beta  = arg.get_beta<T>();
 
-    double gpu_time_used, cpu_time_used;
-    gpu_time_used = cpu_time_used      = 0.0;
+    double               cpu_time_used = 0.0;
     double               rocblas_error = 0.0;
     bool                 HMM           = arg.HMM;
     rocblas_local_handle handle{arg};
@@ -363,7 +363,6 @@ void testing_gemm(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
@@ -375,18 +374,16 @@ void testing_gemm(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        rocblas_timing_summary gpu_time;
+        rocblas_time_hot_calls(arg, stream, gpu_time, [&] {
             rocblas_gemm_fn(
                 handle, transA, transB, M, N, K, &h_alpha, dA, lda, dB, ldb, &h_beta, dC, ldc);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_transA, e_transB, e_M, e_N, e_K, e_alpha, e_lda, e_beta, e_ldb, e_ldc>{}
             .log_args<T>(rocblas_cout,
                          arg,
-                         gpu_time_used,
+                         gpu_time,
                          gemm_gflop_count<T>(M, N, K),
                          ArgumentLogging::NA_value,
                          cpu_time_used,
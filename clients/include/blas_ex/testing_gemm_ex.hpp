@@ -35,6 +35,7 @@
 #include "rocblas_random.hpp"
 #include "rocblas_test.hpp"
 #include "rocblas_vector.hpp"
+#include "timing_engine.hpp"
 #include "type_dispatch.hpp"
 #include "unit.hpp"
 #include "utility.hpp"
@@ -255,9 +256,8 @@ void testing_gemm_ex(const Arguments& arg)
     Tc h_alpha_Tc = arg.get_alpha<Tc>();
     Tc h_beta_Tc  = arg.get_beta<Tc>();
 
-    double gpu_time_used, cpu_time_used;
-    gpu_time_used = cpu_time_used = 0.0;
-    double rocblas_error          = 0.0;
+    double cpu_time_used = 0.0;
+    double rocblas_error = 0.0;
 
     rocblas_local_handle handle{arg};
     auto                 transA = char2rocblas_operation(arg.transA);
@@ -642,7 +642,6 @@ void testing_gemm_ex(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
@@ -676,9 +675,8 @@ void testing_gemm_ex(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        rocblas_timing_summary gpu_time;
+        rocblas_time_hot_calls(arg, stream, gpu_time, [&] {
             rocblas_gemm_ex_fn(handle,
                                transA,
                                transB,
@@ -703,8 +701,7 @@ void testing_gemm_ex(const Arguments& arg)
                                algo,
                                solution_index,
                                flags);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_transA,
                       e_transB,
@@ -720,7 +717,7 @@ void testing_gemm_ex(const Arguments& arg)
                       e_batch_count>{}
             .log_args<Tc>(rocblas_cout,
                           arg,
-                          gpu_time_used,
+                          gpu_time,
                           gemm_gflop_count<Tc>(M, N, K),
                           ArgumentLogging::NA_value,
                           cpu_time_used,
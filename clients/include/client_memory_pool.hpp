@@ -0,0 +1,187 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_client_memory_pool is a thread-safe pool of memory blocks, which  *
+ * lets rocblas-bench reuse the host and device memory of one problem for    *
+ * the next, instead of allocating and freeing it for every problem.         *
+ *                                                                           *
+ * Freed blocks become idle, and are reused by requests which they can hold  *
+ * without leaving more than about half of the block unused. When no idle    *
+ * block can be reused, the largest idle block which is too small is freed,  *
+ * and a larger block replaces it, so that the blocks grow with the problems *
+ * without accumulating. New blocks are rounded up to at most 1/8 more than  *
+ * the request, so that sizes which grow in small steps do not reallocate    *
+ * every time. If an allocation fails, all of the idle blocks are freed and  *
+ * the allocation is retried.                                                *
+ *                                                                           *
+ * Block memory is obtained from an Allocator, with the same interface as    *
+ * for rocblas_workspace_arena:                                              *
+ *                                                                           *
+ *     bool allocate(void** ptr, size_t size);                               *
+ *     bool deallocate(void* ptr);                                           *
+ *****************************************************************************/
+
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+template <typename Allocator>
+class rocblas_client_memory_pool
+{
+public:
+    // Counters of a pool
+    struct stats_t
+    {
+        size_t requests    = 0; // number of blocks requested
+        size_t reuses      = 0; // number of requests satisfied by an idle block
+        size_t allocations = 0; // number of blocks allocated
+        size_t failures    = 0; // number of requests which could not be satisfied
+        size_t held        = 0; // total size of all blocks, in use or idle
+        size_t in_use      = 0; // total size of the blocks in use
+    };
+
+private:
+    mutable std::mutex                m_mutex;
+    Allocator                         m_allocator;
+    std::unordered_map<void*, size_t> m_in_use; // sizes of the blocks in use, by address
+    std::multimap<size_t, void*>      m_idle; // addresses of the idle blocks, by size
+    stats_t                           m_stats;
+
+    // Free an idle block. Lock must be held.
+    void free_idle(typename std::multimap<size_t, void*>::iterator block)
+    {
+        // A block which cannot be freed is dropped from the pool
+        m_allocator.deallocate(block->second);
+        m_stats.held -= block->first;
+        m_idle.erase(block);
+    }
+
+public:
+    explicit rocblas_client_memory_pool(Allocator allocator = Allocator{})
+        : m_allocator(std::move(allocator))
+    {
+    }
+
+    // Idle blocks are freed when the pool is destroyed. Blocks in use are not.
+    ~rocblas_client_memory_pool()
+    {
+        release();
+    }
+
+    // The pool is not copyable or assignable
+    rocblas_client_memory_pool(const rocblas_client_memory_pool&) = delete;
+    rocblas_client_memory_pool& operator=(const rocblas_client_memory_pool&) = delete;
+
+    // Round up size to a multiple of 1/16 to 1/8 of it, and of at least 8 bytes
+    static constexpr size_t block_size(size_t size)
+    {
+        size_t step = 8;
+        while(step * 16 <= size)
+            step *= 2;
+        return (size + step - 1) / step * step;
+    }
+
+    // Allocate a block of at least size bytes, returning nullptr on failure
+    void* allocate(size_t size)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.requests += 1;
+
+        // Reuse the smallest idle block which is large enough, if it is not too large
+        size_t block = block_size(size);
+        auto   fit   = m_idle.lower_bound(size);
+        if(fit != m_idle.end() && fit->first / 2 <= block)
+        {
+            void* addr = fit->second;
+            m_in_use.emplace(addr, fit->first);
+            m_stats.in_use += fit->first;
+            m_stats.reuses += 1;
+            m_idle.erase(fit);
+            return addr;
+        }
+
+        // Replace the largest idle block which is too small with a new block
+        if(fit != m_idle.begin())
+            free_idle(std::prev(fit));
+
+        void* addr = nullptr;
+        if(!m_allocator.allocate(&addr, block))
+        {
+            while(!m_idle.empty())
+                free_idle(m_idle.begin());
+            if(!m_allocator.allocate(&addr, block))
+            {
+                m_stats.failures += 1;
+                return nullptr;
+            }
+        }
+
+        m_in_use.emplace(addr, block);
+        m_stats.allocations += 1;
+        m_stats.held += block;
+        m_stats.in_use += block;
+        return addr;
+    }
+
+    // Return a block to the pool. If keep is false, the block is freed instead of becoming
+    // idle. Returns false, without doing anything, if addr is not a block in use.
+    bool deallocate(void* addr, bool keep = true)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        block = m_in_use.find(addr);
+        if(block == m_in_use.end())
+            return false;
+
+        m_stats.in_use -= block->second;
+        auto idle = m_idle.emplace(block->second, addr);
+        m_in_use.erase(block);
+        if(!keep)
+            free_idle(idle);
+        return true;
+    }
+
+    // Free the idle blocks
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        while(!m_idle.empty())
+            free_idle(m_idle.begin());
+    }
+
+    size_t idle_count() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_idle.size();
+    }
+
+    stats_t stats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+};
@@ -88,7 +88,8 @@ public:
     T* device_vector_setup()
     {
         T* d = nullptr;
-        if(use_HMM ? hipMallocManaged(&d, m_bytes) : (hipMalloc)(&d, m_bytes) != hipSuccess)
+        if((use_HMM ? hipMallocManaged(&d, m_bytes) : d_vector_malloc((void**)&d, m_bytes))
+           != hipSuccess)
         {
             rocblas_cerr << "Warning: hip can't allocate " << m_bytes << " bytes ("
                          << (m_bytes >> 30) << " GB)" << std::endl;
@@ -149,7 +150,7 @@ public:
                 d -= m_pad; // restore to start of alloc
 
             // Free device memory
-            CHECK_HIP_ERROR((hipFree)(d));
+            CHECK_HIP_ERROR(d_vector_free(d));
         }
     }
 };
@@ -28,12 +28,12 @@
 ptrdiff_t host_bytes_available();
 
 //!
-//! @brief Allocates memory which can be freed with free.  Returns nullptr if swap required.
+//! @brief Allocates memory which can be freed with host_free.  Returns nullptr if swap required.
 //!
 void* host_malloc(size_t size);
 
 //!
-//! @brief Allocates memory which can be freed with free.  Throws exception if swap required.
+//! @brief Allocates memory which can be freed with host_free.  Throws exception if swap required.
 //!
 inline void* host_malloc_throw(size_t nmemb, size_t size)
 {
@@ -46,12 +46,12 @@ inline void* host_malloc_throw(size_t nmemb, size_t size)
 }
 
 //!
-//! @brief Allocates cleared memory which can be freed with free.  Returns nullptr if swap required.
+//! @brief Allocates cleared memory which can be freed with host_free.  Returns nullptr if swap required.
 //!
 void* host_calloc(size_t nmemb, size_t size);
 
 //!
-//! @brief Allocates cleared memory which can be freed with free.  Throws exception if swap required.
+//! @brief Allocates cleared memory which can be freed with host_free.  Throws exception if swap required.
 //!
 inline void* host_calloc_throw(size_t nmemb, size_t size)
 {
@@ -63,6 +63,11 @@ inline void* host_calloc_throw(size_t nmemb, size_t size)
     return ptr;
 }
 
+//!
+//! @brief Frees memory allocated by host_malloc or host_calloc.
+//!
+void host_free(void* ptr);
+
 //!
 //! @brief  Allocator which allocates with host_calloc
 //!
@@ -85,7 +90,7 @@ struct host_memory_allocator
 
     void deallocate(T* ptr, std::size_t n)
     {
-        free(ptr);
+        host_free(ptr);
     }
 };
 
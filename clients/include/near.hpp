@@ -32,6 +32,7 @@
 #pragma once
 
 #include "rocblas.h"
+#include "rocblas_convert.hpp"
 #include "rocblas_math.hpp"
 #include "rocblas_test.hpp"
 #include "rocblas_vector.hpp"
@@ -99,9 +100,58 @@ ROCBLAS_CLANG_STATIC constexpr double sum_error_tolerance<rocblas_double_complex
 
 #endif
 
-#define NEAR_ASSERT_HALF(a, b, err) ASSERT_NEAR(double(a), double(b), err)
-
-#define NEAR_ASSERT_BF16(a, b, err) ASSERT_NEAR(double(a), double(b), err)
+// Half or bfloat16 matrices of a batch, indexed like a strided batch of float matrices, whose
+// columns are converted to float in bulk when they are first indexed. batch(k) returns matrix
+// k, and element i of column j of matrix k has index i + j * lda + k * lda * N.
+template <typename BATCH>
+class near_converted_batch
+{
+    BATCH              m_batch;
+    size_t             m_M, m_N, m_lda;
+    host_vector<float> m_column;
+    size_t             m_first = ~size_t{0}; // index of the first element of m_column
+
+public:
+    near_converted_batch(BATCH batch, size_t M, size_t N, size_t lda)
+        : m_batch(batch)
+        , m_M(M)
+        , m_N(N)
+        , m_lda(lda)
+        , m_column(M)
+    {
+    }
+
+    float operator[](size_t index)
+    {
+        size_t first = index - index % m_lda;
+        if(first != m_first)
+        {
+            size_t column = index / m_lda;
+            rocblas_convert_n(m_column.data(), m_batch(column / m_N) + (column % m_N) * m_lda, m_M);
+            m_first = first;
+        }
+        return m_column[index - first];
+    }
+};
+
+// Check half or bfloat16 matrices after converting their columns to float in bulk. The
+// conversions are exact, so this is the same as checking the elements one at a time.
+// hCPU(k) and hGPU(k) return the matrices of batch k.
+template <typename CPU_BATCH, typename GPU_BATCH>
+inline void near_check_converted(rocblas_int M,
+                                 rocblas_int N,
+                                 rocblas_int lda,
+                                 CPU_BATCH   hCPU,
+                                 GPU_BATCH   hGPU,
+                                 rocblas_int batch_count,
+                                 double      abs_error)
+{
+#ifdef GOOGLE_TEST
+    near_converted_batch<CPU_BATCH> cpu(hCPU, M, N, lda);
+    near_converted_batch<GPU_BATCH> gpu(hGPU, M, N, lda);
+    NEAR_CHECK(M, N, lda, size_t(lda) * N, cpu, gpu, batch_count, abs_error, ASSERT_NEAR);
+#endif
+}
 
 #define NEAR_ASSERT_COMPLEX(a, b, err)                  \
     do                                                  \
@@ -132,7 +182,8 @@ inline void near_check_general(rocblas_int         M,
                                const rocblas_half* hGPU,
                                double              abs_error)
 {
-    NEAR_CHECK(M, N, lda, 0, hCPU, hGPU, 1, abs_error, NEAR_ASSERT_HALF);
+    near_check_converted(
+        M, N, lda, [=](size_t) { return hCPU; }, [=](size_t) { return hGPU; }, 1, abs_error);
 }
 
 template <>
@@ -143,7 +194,8 @@ inline void near_check_general<rocblas_bfloat16, float>(rocblas_int
                                                         const rocblas_bfloat16* hGPU,
                                                         double                  abs_error)
 {
-    NEAR_CHECK(M, N, lda, 0, hCPU, hGPU, 1, abs_error, NEAR_ASSERT_BF16);
+    near_check_converted(
+        M, N, lda, [=](size_t) { return hCPU; }, [=](size_t) { return hGPU; }, 1, abs_error);
 }
 
 template <>
@@ -193,7 +245,14 @@ inline void near_check_general(rocblas_int         M,
                                rocblas_int         batch_count,
                                double              abs_error)
 {
-    NEAR_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, abs_error, NEAR_ASSERT_HALF);
+    near_check_converted(
+        M,
+        N,
+        lda,
+        [=](size_t k) { return hCPU + k * strideA; },
+        [=](size_t k) { return hGPU + k * strideA; },
+        batch_count,
+        abs_error);
 }
 
 template <>
@@ -206,7 +265,14 @@ inline void near_check_general<rocblas_bfloat16, float>(rocblas_int
                                                         rocblas_int             batch_count,
                                                         double                  abs_error)
 {
-    NEAR_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, abs_error, NEAR_ASSERT_BF16);
+    near_check_converted(
+        M,
+        N,
+        lda,
+        [=](size_t k) { return hCPU + k * strideA; },
+        [=](size_t k) { return hGPU + k * strideA; },
+        batch_count,
+        abs_error);
 }
 
 template <>
@@ -258,7 +324,14 @@ inline void near_check_general(rocblas_int                     M,
                                rocblas_int                     batch_count,
                                double                          abs_error)
 {
-    NEAR_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, abs_error, NEAR_ASSERT_HALF);
+    near_check_converted(
+        M,
+        N,
+        lda,
+        [=](size_t k) { return hCPU[k].data(); },
+        [=](size_t k) { return hGPU[k].data(); },
+        batch_count,
+        abs_error);
 }
 template <>
 inline void near_check_general<rocblas_bfloat16, float>(rocblas_int                         M,
@@ -269,7 +342,14 @@ inline void near_check_general<rocblas_bfloat16, float>(rocblas_int
                                                         rocblas_int batch_count,
                                                         double      abs_error)
 {
-    NEAR_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, abs_error, NEAR_ASSERT_BF16);
+    near_check_converted(
+        M,
+        N,
+        lda,
+        [=](size_t k) { return hCPU[k].data(); },
+        [=](size_t k) { return hGPU[k].data(); },
+        batch_count,
+        abs_error);
 }
 
 template <>
@@ -319,7 +399,14 @@ inline void near_check_general(rocblas_int               M,
                                rocblas_int               batch_count,
                                double                    abs_error)
 {
-    NEAR_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, abs_error, NEAR_ASSERT_HALF);
+    near_check_converted(
+        M,
+        N,
+        lda,
+        [=](size_t k) { return hCPU[k]; },
+        [=](size_t k) { return hGPU[k]; },
+        batch_count,
+        abs_error);
 }
 
 template <>
@@ -331,7 +418,14 @@ inline void near_check_general<rocblas_bfloat16, float>(rocblas_int
                                                         rocblas_int                   batch_count,
                                                         double                        abs_error)
 {
-    NEAR_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, abs_error, NEAR_ASSERT_BF16);
+    near_check_converted(
+        M,
+        N,
+        lda,
+        [=](size_t k) { return hCPU[k]; },
+        [=](size_t k) { return hGPU[k]; },
+        batch_count,
+        abs_error);
 }
 
 template <>
@@ -25,6 +25,7 @@
 #include "lapack_utilities.hpp"
 #include "norm.hpp"
 #include "rocblas.h"
+#include "rocblas_convert.hpp"
 #include "rocblas_vector.hpp"
 #include "utility.hpp"
 #include <cstdio>
@@ -109,7 +110,7 @@ double norm_check_general(
     return error;
 }
 
-// For BF16 and half, we convert the results to double first
+// For BF16 and half, we convert the results to double first, one column at a time
 template <typename T,
           typename VEC,
           std::enable_if_t<std::is_same<T, rocblas_half>{} || std::is_same<T, rocblas_bfloat16>{},
@@ -123,12 +124,9 @@ double norm_check_general(
 
     for(rocblas_int i = 0; i < N; i++)
     {
-        for(rocblas_int j = 0; j < M; j++)
-        {
-            size_t idx       = j + i * (size_t)lda;
-            hCPU_double[idx] = hCPU[idx];
-            hGPU_double[idx] = hGPU[idx];
-        }
+        size_t idx = i * (size_t)lda;
+        rocblas_convert_n(&hCPU_double[idx], &hCPU[idx], M);
+        rocblas_convert_n(&hGPU_double[idx], &hGPU[idx], M);
     }
 
     return norm_check_general<double>(norm_type, M, N, lda, hCPU_double, hGPU_double);
@@ -352,12 +350,9 @@ inline double norm_check_symmetric(char          norm_type,
 
     for(rocblas_int i = 0; i < N; i++)
     {
-        for(rocblas_int j = 0; j < N; j++)
-        {
-            size_t idx       = j + i * (size_t)lda;
-            hCPU_double[idx] = hCPU[idx];
-            hGPU_double[idx] = hGPU[idx];
-        }
+        size_t idx = i * (size_t)lda;
+        rocblas_convert_n(&hCPU_double[idx], &hCPU[idx], N);
+        rocblas_convert_n(&hGPU_double[idx], &hGPU[idx], N);
     }
 
     return norm_check_symmetric(norm_type, uplo, N, lda, hCPU_double.data(), hGPU_double.data());
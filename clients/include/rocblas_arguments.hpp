@@ -204,8 +204,9 @@ struct Arguments
 
     // clang-format on
 
-    // Validate input format.
-    static void validate(std::istream& ifs);
+    // Validate input format, given size bytes of binary data. Returns the size of the
+    // signature which precedes the records.
+    static size_t validate(const char* data, size_t size);
 
     // Function to print Arguments out to stream in YAML format
     friend rocblas_internal_ostream& operator<<(rocblas_internal_ostream& str,
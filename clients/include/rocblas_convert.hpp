@@ -0,0 +1,299 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if(defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__)) \
+    && !defined(WIN32)
+#define ROCBLAS_CONVERT_X86 1
+#include <immintrin.h>
+#else
+#define ROCBLAS_CONVERT_X86 0
+#endif
+
+/* ============================================================================================ */
+/*! \brief Bulk conversion of arrays between rocblas_half or rocblas_bfloat16 and float.
+
+    rocblas_convert_n(dst, src, n) converts n contiguous elements. The results are identical,
+    bit for bit, to converting each element with the conversions of the types, including the
+    rounding to nearest even, subnormals, and the preservation of NaNs: the scalar loops are
+    the portable implementation, and the vector kernels are used on x86-64 when the CPU
+    supports them. The instruction set is chosen once, at run time, so the clients do not have
+    to be built for a particular CPU.
+
+    Half precision uses the F16C and AVX-512 conversion instructions, which the compiler also
+    uses for single elements. bfloat16 is rounded with integer arithmetic in vector registers,
+    because the AVX-512 BF16 instructions flush subnormals and quiet signaling NaNs. */
+
+// Instruction sets which can be used by the vector kernels
+enum class rocblas_convert_isa
+{
+    scalar,
+    avx2, // AVX2 and F16C
+    avx512,
+};
+
+// The best instruction set supported by the CPU, detected on first use
+inline rocblas_convert_isa rocblas_convert_cpu_isa()
+{
+#if ROCBLAS_CONVERT_X86
+    static const rocblas_convert_isa isa = [] {
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f"))
+            return rocblas_convert_isa::avx512;
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c"))
+            return rocblas_convert_isa::avx2;
+        return rocblas_convert_isa::scalar;
+    }();
+    return isa;
+#else
+    return rocblas_convert_isa::scalar;
+#endif
+}
+
+#if ROCBLAS_CONVERT_X86
+
+// The vector kernels return the number of elements converted, leaving the remainder to the
+// scalar loop
+
+__attribute__((target("avx2,f16c"))) inline size_t
+    rocblas_convert_half_to_float_avx2(float* dst, const rocblas_half* src, size_t n)
+{
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(src + i))));
+    return i;
+}
+
+__attribute__((target("avx2,f16c"))) inline size_t
+    rocblas_convert_float_to_half_avx2(rocblas_half* dst, const float* src, size_t n)
+{
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+        _mm_storeu_si128((__m128i*)(dst + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_CUR_DIRECTION));
+    return i;
+}
+
+__attribute__((target("avx512f"))) inline size_t
+    rocblas_convert_half_to_float_avx512(float* dst, const rocblas_half* src, size_t n)
+{
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(dst + i,
+                         _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(src + i))));
+    return i;
+}
+
+__attribute__((target("avx512f"))) inline size_t
+    rocblas_convert_float_to_half_avx512(rocblas_half* dst, const float* src, size_t n)
+{
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16)
+        _mm256_storeu_si256((__m256i*)(dst + i),
+                            _mm512_cvtps_ph(_mm512_loadu_ps(src + i), _MM_FROUND_CUR_DIRECTION));
+    return i;
+}
+
+__attribute__((target("avx2"))) inline size_t
+    rocblas_convert_bfloat16_to_float_avx2(float* dst, const rocblas_bfloat16* src, size_t n)
+{
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        __m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + i)));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_slli_epi32(x, 16));
+    }
+    return i;
+}
+
+// Round 8 floats to bfloat16 as rocblas_bfloat16(float) does, returning them in the low halves
+// of the 32-bit lanes
+__attribute__((target("avx2"))) inline __m256i rocblas_convert_round_bfloat16_avx2(__m256i u)
+{
+    const __m256i exponent = _mm256_set1_epi32(0x7f800000);
+
+    // Finite values are rounded to nearest even
+    __m256i lsb     = _mm256_and_si256(_mm256_srli_epi32(u, 16), _mm256_set1_epi32(1));
+    __m256i rounded = _mm256_add_epi32(_mm256_add_epi32(u, _mm256_set1_epi32(0x7fff)), lsb);
+
+    // Inf and NaN are truncated, setting the lowest bit of a NaN whose low bits are nonzero
+    __m256i low_zero = _mm256_cmpeq_epi32(_mm256_and_si256(u, _mm256_set1_epi32(0xffff)),
+                                          _mm256_setzero_si256());
+    __m256i nan_bit  = _mm256_andnot_si256(low_zero, _mm256_set1_epi32(0x10000));
+    __m256i special  = _mm256_or_si256(u, nan_bit);
+
+    __m256i is_special = _mm256_cmpeq_epi32(_mm256_and_si256(u, exponent), exponent);
+    return _mm256_srli_epi32(_mm256_blendv_epi8(rounded, special, is_special), 16);
+}
+
+__attribute__((target("avx2"))) inline size_t
+    rocblas_convert_float_to_bfloat16_avx2(rocblas_bfloat16* dst, const float* src, size_t n)
+{
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16)
+    {
+        __m256i lo = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i hi = _mm256_loadu_si256((const __m256i*)(src + i + 8));
+        lo         = rocblas_convert_round_bfloat16_avx2(lo);
+        hi         = rocblas_convert_round_bfloat16_avx2(hi);
+
+        // Packing interleaves the 128-bit halves of lo and hi, which are then put in order
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xd8);
+        _mm256_storeu_si256((__m256i*)(dst + i), packed);
+    }
+    return i;
+}
+
+__attribute__((target("avx512f"))) inline size_t
+    rocblas_convert_bfloat16_to_float_avx512(float* dst, const rocblas_bfloat16* src, size_t n)
+{
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16)
+    {
+        __m512i x = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)(src + i)));
+        _mm512_storeu_si512(dst + i, _mm512_slli_epi32(x, 16));
+    }
+    return i;
+}
+
+__attribute__((target("avx512f"))) inline size_t
+    rocblas_convert_float_to_bfloat16_avx512(rocblas_bfloat16* dst, const float* src, size_t n)
+{
+    const __m512i exponent = _mm512_set1_epi32(0x7f800000);
+
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16)
+    {
+        __m512i u = _mm512_loadu_si512(src + i);
+
+        __m512i lsb     = _mm512_and_si512(_mm512_srli_epi32(u, 16), _mm512_set1_epi32(1));
+        __m512i rounded = _mm512_add_epi32(_mm512_add_epi32(u, _mm512_set1_epi32(0x7fff)), lsb);
+
+        __mmask16 low_nonzero = _mm512_test_epi32_mask(u, _mm512_set1_epi32(0xffff));
+        __m512i   special = _mm512_mask_or_epi32(u, low_nonzero, u, _mm512_set1_epi32(0x10000));
+
+        __mmask16 is_special = _mm512_cmpeq_epi32_mask(_mm512_and_si512(u, exponent), exponent);
+        __m512i   result     = _mm512_mask_blend_epi32(is_special, rounded, special);
+        _mm256_storeu_si256((__m256i*)(dst + i),
+                            _mm512_cvtepi32_epi16(_mm512_srli_epi32(result, 16)));
+    }
+    return i;
+}
+
+#endif // ROCBLAS_CONVERT_X86
+
+// Convert n elements with the scalar conversion of the types
+template <typename Tdst, typename Tsrc>
+inline void rocblas_convert_n(Tdst* dst, const Tsrc* src, size_t n)
+{
+    for(size_t i = 0; i < n; i++)
+        dst[i] = static_cast<Tdst>(src[i]);
+}
+
+// Convert n elements with the kernel of isa, if there is one, and the scalar loop for the
+// elements which it leaves
+template <typename Tdst, typename Tsrc>
+inline void rocblas_convert_dispatch(Tdst*               dst,
+                                     const Tsrc*         src,
+                                     size_t              n,
+                                     rocblas_convert_isa isa,
+                                     size_t (*avx2)(Tdst*, const Tsrc*, size_t),
+                                     size_t (*avx512)(Tdst*, const Tsrc*, size_t))
+{
+    size_t done = 0;
+    if(isa == rocblas_convert_isa::avx512 && avx512)
+        done = avx512(dst, src, n);
+    else if(isa == rocblas_convert_isa::avx2 && avx2)
+        done = avx2(dst, src, n);
+    rocblas_convert_n<Tdst, Tsrc>(dst + done, src + done, n - done);
+}
+
+#if ROCBLAS_CONVERT_X86
+#define ROCBLAS_CONVERT_KERNELS(KERNEL) \
+    rocblas_convert_##KERNEL##_avx2, rocblas_convert_##KERNEL##_avx512
+#else
+#define ROCBLAS_CONVERT_KERNELS(KERNEL) nullptr, nullptr
+#endif
+
+inline void rocblas_convert_n(float*              dst,
+                              const rocblas_half* src,
+                              size_t              n,
+                              rocblas_convert_isa isa = rocblas_convert_cpu_isa())
+{
+    rocblas_convert_dispatch(dst, src, n, isa, ROCBLAS_CONVERT_KERNELS(half_to_float));
+}
+
+inline void rocblas_convert_n(rocblas_half*       dst,
+                              const float*        src,
+                              size_t              n,
+                              rocblas_convert_isa isa = rocblas_convert_cpu_isa())
+{
+    rocblas_convert_dispatch(dst, src, n, isa, ROCBLAS_CONVERT_KERNELS(float_to_half));
+}
+
+inline void rocblas_convert_n(float*                  dst,
+                              const rocblas_bfloat16* src,
+                              size_t                  n,
+                              rocblas_convert_isa     isa = rocblas_convert_cpu_isa())
+{
+    rocblas_convert_dispatch(dst, src, n, isa, ROCBLAS_CONVERT_KERNELS(bfloat16_to_float));
+}
+
+inline void rocblas_convert_n(rocblas_bfloat16*   dst,
+                              const float*        src,
+                              size_t              n,
+                              rocblas_convert_isa isa = rocblas_convert_cpu_isa())
+{
+    rocblas_convert_dispatch(dst, src, n, isa, ROCBLAS_CONVERT_KERNELS(float_to_bfloat16));
+}
+
+#undef ROCBLAS_CONVERT_KERNELS
+
+// Half and bfloat16 are converted to double through blocks of floats, which convert exactly
+template <typename T>
+inline void rocblas_convert_n_through_float(double* dst, const T* src, size_t n)
+{
+    constexpr size_t block = 256;
+    float            buffer[block];
+    for(size_t i = 0; i < n; i += block)
+    {
+        size_t count = std::min(block, n - i);
+        rocblas_convert_n(buffer, src + i, count);
+        rocblas_convert_n(dst + i, buffer, count);
+    }
+}
+
+inline void rocblas_convert_n(double* dst, const rocblas_half* src, size_t n)
+{
+    rocblas_convert_n_through_float(dst, src, n);
+}
+
+inline void rocblas_convert_n(double* dst, const rocblas_bfloat16* src, size_t n)
+{
+    rocblas_convert_n_through_float(dst, src, n);
+}
@@ -24,16 +24,16 @@
 
 #include "rocblas_arguments.hpp"
 #include "test_cleanup.hpp"
-#include <cerrno>
-#include <cstdio>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
-#include <fstream>
 #include <functional>
-#include <iostream>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #if __has_include(<filesystem>)
 #include <filesystem>
@@ -48,6 +48,89 @@ namespace fs = std::experimental::filesystem;
 // Class used to read Arguments data into the tests
 class RocBLAS_TestData
 {
+public:
+    // Binary test data generated by rocblas_gentest.py. The file is memory-mapped when
+    // possible, and read into memory otherwise.
+    //
+    // After the signature and the records, the file has an index with an entry for each
+    // function, listing the numbers of its records. A trailer at the end of
+    // the file locates the index. Files without a trailer are read without an index.
+    class data_file
+    {
+    public:
+        struct index_entry
+        {
+            char     function[sizeof(Arguments::function)];
+            uint64_t first; // position of the entry's first record number in the index
+            uint64_t count; // number of records of the entry
+        };
+
+        struct index_trailer
+        {
+            char     magic[8];
+            uint64_t records;
+            uint64_t entries;
+        };
+
+    private:
+        const char*       m_data        = nullptr;
+        size_t            m_size        = 0;
+        const char*       m_records     = nullptr; // first record, following the signature
+        size_t            m_count       = 0; // number of records
+        const char*       m_entries     = nullptr; // index entries, or nullptr without an index
+        size_t            m_entry_count = 0;
+        const char*       m_numbers     = nullptr; // record numbers of the index entries
+        std::vector<char> m_buffer; // contents of the file, if it is not mapped
+        void*             m_map = nullptr;
+        std::vector<bool> m_shard; // whether each record is in the shard, if sharded
+
+        // Map or read the file, returning false if it cannot be read
+        bool read_file(const std::string& name);
+
+        // Validate the index, returning false if it is malformed
+        bool read_index();
+
+    public:
+        // Open and validate the file, exiting if it cannot be read or is malformed
+        explicit data_file(const std::string& name);
+        ~data_file();
+
+        data_file(const data_file&) = delete;
+        data_file& operator=(const data_file&) = delete;
+
+        size_t size() const
+        {
+            return m_count;
+        }
+
+        // Copy record i
+        void get(size_t i, Arguments& arg) const
+        {
+            memcpy(&arg, m_records + i * sizeof(Arguments), sizeof(Arguments));
+        }
+
+        // The numbers of the records, in increasing order, whose function is accepted by
+        // function_filter. function_filter is called once for each index entry, with the
+        // entry's first record, so it must only depend on the record's function name.
+        // Without an index, it is called for each record. If the records are sharded, only
+        // the records in the shard are selected.
+        std::vector<size_t> select(bool function_filter(const Arguments&)) const;
+
+        // Restrict the records to those assigned to shard index of count shards
+        void shard(size_t index, size_t count, double cost(const Arguments&));
+
+        bool sharded() const
+        {
+            return !m_shard.empty();
+        }
+    };
+
+    // Assign each item to one of count shards, balancing the total cost of the shards.
+    // Items are assigned in decreasing order of cost to the shard with the least total
+    // cost so far, so the assignment only depends on the costs.
+    static std::vector<size_t> assign_shards(const std::vector<double>& costs, size_t count);
+
+private:
     // data filename
     static auto& filename()
     {
@@ -56,44 +139,102 @@ class RocBLAS_TestData
         return filename;
     }
 
-    // filter iterator
-    class iterator : public std::istream_iterator<Arguments>
+    // Shard of the records run by this process, and the cost model balancing the shards
+    struct shard_t
+    {
+        size_t index = 0;
+        size_t count = 1;
+        double (*cost)(const Arguments&) = nullptr;
+    };
+
+    static auto& shard()
+    {
+        static shard_t shard;
+        return shard;
+    }
+
+    // filter iterator over the records selected by a function filter, or over all records
+    class iterator
     {
-        bool (*const filter)(const Arguments&) = nullptr;
+        // Numbers of the selected records, or nullptr if all records are selected
+        std::shared_ptr<const std::vector<size_t>> select;
+        const data_file*                           data = nullptr;
+
+        bool (*filter)(const Arguments&) = nullptr;
+
+        size_t    pos = 0; // position in the selected records
+        Arguments arg{};   // current record
+
+        size_t count() const
+        {
+            return data ? select ? select->size() : data->size() : 0;
+        }
 
-        // Skip entries for which filter is false
+        // Read entries until one passes the filter, or until the end is reached
         void skip_filter()
         {
-            static auto endIter = std::istream_iterator<Arguments>{};
-            if(filter)
-                while(*this != endIter && !filter(**this))
-                    ++*static_cast<std::istream_iterator<Arguments>*>(this);
+            for(; pos < count(); ++pos)
+            {
+                data->get(select ? (*select)[pos] : pos, arg);
+                if(!filter || filter(arg))
+                    break;
+            }
         }
 
     public:
-        // Constructor takes a filter and iterator
-        iterator(bool filter(const Arguments&), std::istream_iterator<Arguments> iter)
-            : std::istream_iterator<Arguments>(iter)
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = Arguments;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const Arguments*;
+        using reference         = const Arguments&;
+
+        // Constructor takes the data, the selected records and a filter
+        iterator(const data_file*                           data,
+                 std::shared_ptr<const std::vector<size_t>> select,
+                 bool                                       filter(const Arguments&))
+            : select(std::move(select))
+            , data(data)
             , filter(filter)
         {
             skip_filter();
         }
 
-        // Default end iterator and nullptr filter
+        // Default end iterator
         iterator() = default;
 
+        const Arguments& operator*() const
+        {
+            return arg;
+        }
+
+        const Arguments* operator->() const
+        {
+            return &arg;
+        }
+
         // Preincrement iterator operator with filtering
         iterator& operator++()
         {
-            ++*static_cast<std::istream_iterator<Arguments>*>(this);
+            ++pos;
             skip_filter();
             return *this;
         }
 
         // We do not need a postincrement iterator operator
-        // We delete it here so that the base class's isn't silently called
         // To implement it, use "auto old = *this; ++*this; return old;"
         iterator operator++(int) = delete;
+
+        // All iterators which have reached the end are equal
+        friend bool operator==(const iterator& a, const iterator& b)
+        {
+            bool a_end = a.pos >= a.count(), b_end = b.pos >= b.count();
+            return a_end || b_end ? a_end == b_end : a.pos == b.pos;
+        }
+
+        friend bool operator!=(const iterator& a, const iterator& b)
+        {
+            return !(a == b);
+        }
     };
 
 public:
@@ -109,36 +250,39 @@ public:
         }
     }
 
-    // begin() iterator which accepts an optional filter.
-    static iterator begin(bool filter(const Arguments&) = nullptr)
+    static const std::string& get_filename()
     {
-        static std::ifstream* ifs = nullptr;
+        return filename();
+    }
+
+    // Only iterate over the records assigned to shard index of count shards, using the cost
+    // of each record to balance the shards
+    static void set_shard(size_t index, size_t count, double cost(const Arguments&))
+    {
+        shard() = {index, count, cost};
+    }
+
+    // begin() iterator which accepts an optional filter, and an optional function filter
+    // which depends only on the function name, and is used to look up records in the index
+    static iterator begin(bool filter(const Arguments&)          = nullptr,
+                          bool function_filter(const Arguments&) = nullptr)
+    {
+        static data_file* data = nullptr;
 
         // If this is the first time, or after test_cleanup::cleanup() has been called
-        if(!ifs)
+        if(!data)
         {
-            std::string fileToOpen = filename();
-            // Allocate a std::ifstream and register it to be deleted during cleanup
-            ifs = test_cleanup::allocate(
-                &ifs, fileToOpen, std::ifstream::in | std::ifstream::binary);
-            if(!ifs || ifs->fail())
-            {
-                rocblas_cerr << "Cannot open " << fileToOpen << ": " << strerror(errno)
-                             << std::endl;
-                exit(EXIT_FAILURE);
-            }
+            data = test_cleanup::allocate(&data, filename());
+            if(shard().count > 1)
+                data->shard(shard().index, shard().count, shard().cost);
         }
 
-        // We re-seek the file back to position 0
-        ifs->clear();
-        ifs->seekg(0);
-
-        // Validate the data file format
-        Arguments::validate(*ifs);
-
         // We create a filter iterator which will choose only the test cases we want right now.
         // This is to preserve Gtest structure while not creating no-op tests which "always pass".
-        return iterator(filter, std::istream_iterator<Arguments>(*ifs));
+        std::shared_ptr<const std::vector<size_t>> select;
+        if(function_filter || data->sharded())
+            select = std::make_shared<std::vector<size_t>>(data->select(function_filter));
+        return iterator(data, std::move(select), filter);
     }
 
     // end() iterator
@@ -156,17 +156,19 @@ inline void rocblas_expect_status(rocblas_status status, rocblas_status expect)
 // Function which matches Arguments with a category, accounting for arg.known_bug_platforms
 bool match_test_category(const Arguments& arg, const char* category);
 
-// The tests are instantiated by filtering through the RocBLAS_Data stream
+// The tests are instantiated by filtering through the RocBLAS_Data records
 // The filter is by category and by the type_filter() and function_filter()
-// functions in the testclass
+// functions in the testclass. function_filter() is also used to look up the
+// records of the testclass in the index, so it must only depend on arg.function.
 #define INSTANTIATE_TEST_CATEGORY(testclass, category)                                            \
     INSTANTIATE_TEST_SUITE_P(category,                                                            \
                              testclass,                                                           \
-                             testing::ValuesIn(RocBLAS_TestData::begin([](const Arguments& arg) { \
-                                                   return match_test_category(arg, #category)     \
-                                                          && testclass::function_filter(arg)      \
-                                                          && testclass::type_filter(arg);         \
-                                               }),                                                \
+                             testing::ValuesIn(RocBLAS_TestData::begin(                           \
+                                                   [](const Arguments& arg) {                     \
+                                                       return match_test_category(arg, #category) \
+                                                              && testclass::type_filter(arg);     \
+                                                   },                                             \
+                                                   testclass::function_filter),                   \
                                                RocBLAS_TestData::end()),                          \
                              testclass::PrintToStringParamName());
 
@@ -0,0 +1,52 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "rocblas_arguments.hpp"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* ============================================================================================ */
+/*! \brief  Sharded execution of rocblas-test. With --shards N, rocblas-test runs as a driver,
+ *  which starts N worker processes with --shard i/N. Each worker runs the records of the test
+ *  data which are assigned to its shard, and the driver merges their Google Test XML reports.
+ */
+
+// Estimated cost of running the test described by arg, in billions of floating point
+// operations. It is used to balance the shards, so only its relative size matters.
+double rocblas_test_cost(const Arguments& arg);
+
+// Parse and remove the --shards and --shard options. Returns the number of worker processes
+// to start with --shards, or 0. With --shard, the test data is restricted to the shard.
+size_t rocblas_parse_shards(int& argc, char** argv);
+
+// Run the remaining command-line arguments in count worker processes, on the test data in
+// filename. Returns the exit status of the driver.
+int rocblas_run_shards(size_t count, const std::string& filename, int argc, char** argv);
+
+// Merge Google Test XML reports of the shards, which ran in parallel. Test suites with the
+// same name are merged, and the elapsed time is the longest time of the shards. Returns false
+// if a report cannot be read.
+bool rocblas_merge_gtest_xml(const std::vector<std::string>& reports, std::ostream& os);
@@ -20,7 +20,27 @@
  *
  * ************************************************************************ */
 
+#pragma once
+
+#include <cstddef>
+#include <hip/hip_runtime.h>
+
 // global for device memory padding see d_vector.hpp
 
 extern size_t g_DVEC_PAD;
 void          d_vector_set_pad_length(size_t pad);
+
+// global for reusing handles and memory across the problems run by rocblas-bench. While reuse
+// is enabled, rocblas_local_handle, d_vector and host_malloc reuse the handles and memory freed
+// by earlier problems. Disabling reuse frees them.
+void rocblas_client_set_reuse(bool reuse);
+bool rocblas_client_get_reuse();
+
+// device memory of d_vector, which comes from a rocblas_client_memory_pool while reuse is enabled
+hipError_t d_vector_malloc(void** ptr, size_t size);
+hipError_t d_vector_free(void* ptr);
+
+// host memory of host_malloc while reuse is enabled. host_reuse_free returns false, without
+// freeing ptr, if it was not allocated by host_reuse_malloc.
+void* host_reuse_malloc(size_t size);
+bool  host_reuse_free(void* ptr);
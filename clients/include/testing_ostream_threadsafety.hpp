@@ -28,9 +28,12 @@
 #include "rocblas_test.hpp"
 #include "rocblas_vector.hpp"
 #include "utility.hpp"
+#include <chrono>
 #include <cstdio>
+#include <fstream>
 #include <sstream>
 #include <thread>
+#include <vector>
 #ifdef WIN32
 #include <fcntl.h>
 #include <io.h>
@@ -153,3 +156,78 @@ inline void testing_ostream_threadsafety(const Arguments& arg)
         fs::remove(path);
     }
 }
+
+// Measure the throughput of many threads writing short lines to the same file, with and
+// without waiting for each line to be written, and verify that no lines are lost or garbled
+inline void testing_ostream_throughput(const Arguments& arg)
+{
+    constexpr size_t NTHREAD = 16; // Number of threads to run simultaneously
+    size_t           NLINES  = arg.N; // Number of lines each thread outputs
+
+    // Each line identifies its thread and index, followed by a payload derived from them
+    auto line = [](size_t t, size_t i) {
+        return std::to_string(t) + " " + std::to_string(i) + " rocblas_sgemm,N,T,"
+               + std::to_string(t * i) + "," + std::to_string(i % 97);
+    };
+
+    for(bool async : {false, true})
+    {
+        std::string path = rocblas_tempname();
+        double      seconds;
+        {
+            rocblas_internal_ostream file(path);
+
+            auto thread_func = [&](size_t t) {
+                rocblas_internal_ostream os = file.dup();
+                os.set_async(async);
+                for(size_t i = 0; i < NLINES; ++i)
+                    os << line(t, i) << std::endl;
+            };
+
+            auto start = std::chrono::steady_clock::now();
+
+            std::thread threads[NTHREAD];
+            for(size_t t = 0; t < NTHREAD; ++t)
+                threads[t] = std::thread(thread_func, t);
+            for(auto& t : threads)
+                t.join();
+
+            // A flush which waits is a barrier for all of the lines queued before it
+            file << "end" << std::endl;
+
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                          .count();
+        }
+
+        std::ifstream       is(path);
+        std::vector<size_t> next(NTHREAD);
+        size_t              count = 0;
+        std::string         last;
+        for(std::string str; std::getline(is, str); ++count)
+        {
+            last = str;
+            if(str == "end")
+                continue;
+
+            // Lines of each thread are written in order
+            size_t t = NTHREAD, i = 0;
+            sscanf(str.c_str(), "%zu %zu", &t, &i);
+            ASSERT_LT(t, NTHREAD) << "garbled output in " << path << ": " << str;
+            ASSERT_EQ(str, line(t, next[t])) << "lost or garbled output in " << path;
+            ++next[t];
+        }
+        EXPECT_EQ(count, NTHREAD * NLINES + 1);
+        EXPECT_EQ(last, "end");
+
+        rocblas_cout << "ostream_throughput: " << (async ? "async" : "sync") << " flush, "
+                     << NTHREAD << " threads, " << NTHREAD * NLINES / seconds << " lines/s"
+                     << std::endl;
+
+        is.close();
+#ifdef WIN32
+        // need all file descriptors closed to allow file removal on windows before process exits
+        rocblas_internal_ostream::clear_workers();
+#endif
+        remove(path.c_str());
+    }
+}
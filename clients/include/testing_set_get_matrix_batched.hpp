@@ -0,0 +1,198 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "bytes.hpp"
+#include "cblas_interface.hpp"
+#include "flops.hpp"
+#include "norm.hpp"
+#include "rocblas.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_test.hpp"
+#include "rocblas_vector.hpp"
+#include "unit.hpp"
+#include "utility.hpp"
+
+// Tests rocblas_set_matrix_batched and rocblas_get_matrix_batched, their strided_batched forms
+// if arg.function contains "strided", and their asynchronous forms if it contains "async"
+template <typename T>
+void testing_set_get_matrix_batched(const Arguments& arg)
+{
+    rocblas_int          rows        = arg.M;
+    rocblas_int          cols        = arg.N;
+    rocblas_int          lda         = arg.lda;
+    rocblas_int          ldb         = arg.ldb;
+    rocblas_int          ldc         = arg.ldc;
+    rocblas_int          batch_count = arg.batch_count;
+    bool                 strided     = strstr(arg.function, "strided") != nullptr;
+    bool                 async       = strstr(arg.function, "async") != nullptr;
+    rocblas_local_handle handle{arg};
+
+    hipStream_t stream;
+    rocblas_get_stream(handle, &stream);
+
+    // The matrices of each batch are stored one after the other
+    rocblas_stride stride_a = size_t(lda) * cols;
+    rocblas_stride stride_b = size_t(ldb) * cols;
+    rocblas_stride stride_c = size_t(ldc) * cols;
+
+    auto set = [&](const void* const* a, const void* a0, void* const* c, void* c0) {
+        if(strided && async)
+            return rocblas_set_matrix_strided_batched_async(
+                rows, cols, sizeof(T), a0, lda, stride_a, c0, ldc, stride_c, batch_count, stream);
+        else if(strided)
+            return rocblas_set_matrix_strided_batched(
+                rows, cols, sizeof(T), a0, lda, stride_a, c0, ldc, stride_c, batch_count);
+        else if(async)
+            return rocblas_set_matrix_batched_async(
+                rows, cols, sizeof(T), a, lda, c, ldc, batch_count, stream);
+        else
+            return rocblas_set_matrix_batched(rows, cols, sizeof(T), a, lda, c, ldc, batch_count);
+    };
+
+    auto get = [&](const void* const* c, const void* c0, void* const* b, void* b0) {
+        if(strided && async)
+            return rocblas_get_matrix_strided_batched_async(
+                rows, cols, sizeof(T), c0, ldc, stride_c, b0, ldb, stride_b, batch_count, stream);
+        else if(strided)
+            return rocblas_get_matrix_strided_batched(
+                rows, cols, sizeof(T), c0, ldc, stride_c, b0, ldb, stride_b, batch_count);
+        else if(async)
+            return rocblas_get_matrix_batched_async(
+                rows, cols, sizeof(T), c, ldc, b, ldb, batch_count, stream);
+        else
+            return rocblas_get_matrix_batched(rows, cols, sizeof(T), c, ldc, b, ldb, batch_count);
+    };
+
+    // argument sanity check, quick return if input parameters are invalid before allocating invalid
+    // memory
+    bool invalidGPUMatrix = rows < 0 || cols < 0 || ldc <= 0 || ldc < rows || batch_count < 0;
+    bool invalidSet       = invalidGPUMatrix || lda <= 0 || lda < rows;
+    bool invalidGet       = invalidGPUMatrix || ldb <= 0 || ldb < rows;
+    bool quickReturn      = !rows || !cols || !batch_count;
+
+    if(invalidSet || invalidGet || quickReturn)
+    {
+        EXPECT_ROCBLAS_STATUS(set(nullptr, nullptr, nullptr, nullptr),
+                              invalidSet    ? rocblas_status_invalid_size
+                              : quickReturn ? rocblas_status_success
+                                            : rocblas_status_invalid_pointer);
+
+        EXPECT_ROCBLAS_STATUS(get(nullptr, nullptr, nullptr, nullptr),
+                              invalidGet    ? rocblas_status_invalid_size
+                              : quickReturn ? rocblas_status_success
+                                            : rocblas_status_invalid_pointer);
+
+        return;
+    }
+
+    // Naming: dK is in GPU (device) memory. hK is in CPU (host) memory
+    host_pinned_vector<T> ha(stride_a * batch_count);
+    host_pinned_vector<T> hb(stride_b * batch_count);
+    host_vector<T>        hb_gold(stride_b * batch_count);
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error = 0.0;
+
+    // allocate memory on device, as one block of batch_count matrices
+    device_batch_vector<T> dc(stride_c, 1, batch_count);
+    CHECK_DEVICE_ALLOCATION(dc.memcheck());
+
+    // Arrays of pointers to the matrices, on the host for host matrices and on the device for
+    // device matrices
+    std::vector<const void*> ha_ptrs(batch_count);
+    std::vector<void*>       hb_ptrs(batch_count);
+    for(rocblas_int i = 0; i < batch_count; ++i)
+    {
+        ha_ptrs[i] = &ha[i * stride_a];
+        hb_ptrs[i] = &hb[i * stride_b];
+    }
+    void* const* dc_ptrs = (void* const*)dc.ptr_on_device();
+
+    // Initial Data on CPU
+    rocblas_seedrand();
+    rocblas_init<T>(ha, rows, cols, lda, stride_a, batch_count);
+    rocblas_init<T>(hb, rows, cols, ldb, stride_b, batch_count);
+    std::copy(hb.begin(), hb.end(), hb_gold.begin());
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        CHECK_ROCBLAS_ERROR(set(ha_ptrs.data(), ha, dc_ptrs, dc[0]));
+        CHECK_ROCBLAS_ERROR(get((const void* const*)dc_ptrs, dc[0], hb_ptrs.data(), hb));
+
+        // reference calculation
+        cpu_time_used = get_time_us_no_sync();
+        for(rocblas_int b = 0; b < batch_count; b++)
+            for(int i1 = 0; i1 < rows; i1++)
+                for(int i2 = 0; i2 < cols; i2++)
+                    hb_gold[b * stride_b + i1 + i2 * ldb] = ha[b * stride_a + i1 + i2 * lda];
+
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+
+        if(arg.unit_check)
+        {
+            unit_check_general<T>(rows, cols, ldb, stride_b, hb_gold, hb, batch_count);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error = norm_check_general<T>(
+                'F', rows, cols, ldb, stride_b, hb_gold, (T*)hb, batch_count);
+        }
+    }
+
+    if(arg.timing)
+    {
+        int number_cold_calls = arg.cold_iters;
+        int number_hot_calls  = arg.iters;
+
+        for(int iter = 0; iter < number_cold_calls; iter++)
+        {
+            set(ha_ptrs.data(), ha, dc_ptrs, dc[0]);
+            get((const void* const*)dc_ptrs, dc[0], hb_ptrs.data(), hb);
+        }
+
+        gpu_time_used = get_time_us_sync(stream); // in microseconds
+
+        for(int iter = 0; iter < number_hot_calls; iter++)
+        {
+            set(ha_ptrs.data(), ha, dc_ptrs, dc[0]);
+            get((const void* const*)dc_ptrs, dc[0], hb_ptrs.data(), hb);
+        }
+
+        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+
+        ArgumentModel<e_M, e_N, e_lda, e_ldb, e_ldc, e_batch_count>{}.log_args<T>(
+            rocblas_cout,
+            arg,
+            gpu_time_used,
+            ArgumentLogging::NA_value,
+            set_get_matrix_gbyte_count<T>(rows, cols) * batch_count,
+            cpu_time_used,
+            rocblas_error);
+    }
+}
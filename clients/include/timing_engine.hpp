@@ -0,0 +1,181 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_time_hot_calls times the hot calls of a problem as specified by   *
+ * the timing policy of rocblas-bench.                                       *
+ *                                                                           *
+ * By default, the hot calls are timed together by the host, and only their  *
+ * mean is known. With per-call timing, each hot call is bracketed by a pair *
+ * of events, and rocblas_timing_stats summarizes the times of the calls and *
+ * decides how many more to time. The calls of a batch are enqueued without  *
+ * synchronizing, and their events are read when the batch has completed.    *
+ *                                                                           *
+ * To time calls with cold caches, a flush buffer can be overwritten before  *
+ * each call, outside of its events. The buffer has two windows, which are   *
+ * overwritten in turn, so that each flush writes memory which is not cached *
+ * from the previous flush.                                                  *
+ *****************************************************************************/
+
+#include "rocblas_arguments.hpp"
+#include "rocblas_test.hpp"
+#include "singletons.hpp"
+#include "timing_stats.hpp"
+#include "utility.hpp"
+#include <vector>
+
+// Events and flush buffer used to time hot calls one at a time
+class rocblas_timing_events
+{
+    hipStream_t             m_stream;
+    std::vector<hipEvent_t> m_events; // start and stop events of the hot calls of a batch
+    char*                   m_flush   = nullptr;
+    size_t                  m_window  = 0; // size of each of the two windows of the flush buffer
+    size_t                  m_flushes = 0;
+
+public:
+    explicit rocblas_timing_events(hipStream_t stream)
+        : m_stream(stream)
+    {
+    }
+
+    ~rocblas_timing_events()
+    {
+        for(auto event : m_events)
+            (void)hipEventDestroy(event);
+        if(m_flush)
+            (void)d_vector_free(m_flush);
+    }
+
+    // The events are not copyable or assignable
+    rocblas_timing_events(const rocblas_timing_events&) = delete;
+    rocblas_timing_events& operator=(const rocblas_timing_events&) = delete;
+
+    // Allocate the flush buffer, if the policy flushes the caches
+    hipError_t init(const rocblas_timing_policy& policy)
+    {
+        if(!policy.flush_cache)
+            return hipSuccess;
+
+        size_t window = policy.flush_bytes;
+        if(!window)
+        {
+            int        device, l2_size;
+            hipError_t status = hipGetDevice(&device);
+            if(status == hipSuccess)
+                status = hipDeviceGetAttribute(&l2_size, hipDeviceAttributeL2CacheSize, device);
+            if(status != hipSuccess)
+                return status;
+            window = l2_size;
+        }
+
+        void*      flush;
+        hipError_t status = d_vector_malloc(&flush, 2 * window);
+        if(status == hipSuccess)
+        {
+            m_flush  = static_cast<char*>(flush);
+            m_window = window;
+        }
+        return status;
+    }
+
+    // Create events for at least count hot calls
+    hipError_t reserve(size_t count)
+    {
+        while(m_events.size() < 2 * count)
+        {
+            hipEvent_t event;
+            hipError_t status = hipEventCreate(&event);
+            if(status != hipSuccess)
+                return status;
+            m_events.push_back(event);
+        }
+        return hipSuccess;
+    }
+
+    hipEvent_t start(size_t i) const
+    {
+        return m_events[2 * i];
+    }
+
+    hipEvent_t stop(size_t i) const
+    {
+        return m_events[2 * i + 1];
+    }
+
+    // Overwrite the next window of the flush buffer, if there is one
+    hipError_t flush()
+    {
+        if(!m_flush)
+            return hipSuccess;
+        return hipMemsetAsync(m_flush + (m_flushes++ % 2) * m_window, 0, m_window, m_stream);
+    }
+};
+
+// Time the hot calls of a problem on stream, where hot_call enqueues one call. At least
+// arg.iters calls are timed, and the statistics of their times are stored in time.
+template <typename F>
+void rocblas_time_hot_calls(const Arguments&        arg,
+                            hipStream_t             stream,
+                            rocblas_timing_summary& time,
+                            F&&                     hot_call)
+{
+    const auto& policy = rocblas_timing_get_policy();
+    if(!policy.per_call)
+    {
+        double gpu_time_used = get_time_us_sync(stream); // in microseconds
+        for(int i = 0; i < arg.iters; i++)
+            hot_call();
+        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        time          = rocblas_timing_summary::total(gpu_time_used, std::max(arg.iters, 0));
+        return;
+    }
+
+    rocblas_timing_events events(stream);
+    CHECK_HIP_ERROR(events.init(policy));
+
+    rocblas_timing_stats stats;
+    size_t               min_iters = std::max(arg.iters, 1);
+    double               start_us  = get_time_us_no_sync();
+    while(size_t batch = stats.next_batch(policy, min_iters, get_time_us_no_sync() - start_us))
+    {
+        CHECK_HIP_ERROR(events.reserve(batch));
+        for(size_t i = 0; i < batch; i++)
+        {
+            CHECK_HIP_ERROR(events.flush());
+            CHECK_HIP_ERROR(hipEventRecord(events.start(i), stream));
+            hot_call();
+            CHECK_HIP_ERROR(hipEventRecord(events.stop(i), stream));
+        }
+
+        CHECK_HIP_ERROR(hipEventSynchronize(events.stop(batch - 1)));
+        for(size_t i = 0; i < batch; i++)
+        {
+            float ms;
+            CHECK_HIP_ERROR(hipEventElapsedTime(&ms, events.start(i), events.stop(i)));
+            stats.add(ms * 1000.0);
+        }
+    }
+    time = stats.summarize(policy);
+}
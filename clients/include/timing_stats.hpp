@@ -0,0 +1,269 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_timing_stats collects the times of individual hot calls, and      *
+ * summarizes them with robust statistics: the median, percentiles and the   *
+ * standard deviation, after rejecting outliers which are further from the   *
+ * median than a number of scaled median absolute deviations (MAD).          *
+ *                                                                           *
+ * It also decides how many more hot calls to time. After the minimum number *
+ * of calls, the number of calls doubles until the confidence interval of    *
+ * the mean is narrower than the target, or a limit is reached.              *
+ *                                                                           *
+ * It is host code without any dependencies on the device, so that it can be *
+ * tested with fixed samples.                                                *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// How rocblas-bench times the hot calls of a problem
+struct rocblas_timing_policy
+{
+    bool   per_call      = false; // time each hot call with events, and report statistics
+    int    max_iters     = 0;     // time up to max_iters hot calls, until the target is met
+    double target_ci     = 0.01;  // target half-width of the confidence interval, over the mean
+    double confidence    = 0.95;  // confidence level of the confidence interval
+    double max_time_us   = 1e7;   // stop timing more hot calls after this time
+    double outlier_fence = 3.5;   // reject times beyond this many scaled MADs; 0 keeps all
+    bool   flush_cache   = false; // overwrite a flush buffer before each hot call
+    size_t flush_bytes   = 0;     // size written by each flush, 0 for the size of the L2 cache
+};
+
+// Statistics of the times of the hot calls of a problem, in microseconds
+struct rocblas_timing_summary
+{
+    size_t iters     = 0; // number of hot calls timed
+    size_t rejected  = 0; // number of outliers, which are not included in the statistics
+    double median    = 0;
+    double mean      = 0;
+    double stddev    = 0;
+    double min       = 0;
+    double max       = 0;
+    double p5        = 0;
+    double p95       = 0;
+    double ci        = 0; // half-width of the confidence interval of the mean
+    bool   per_call  = false; // whether the hot calls were timed one at a time
+    bool   converged = false; // whether ci met the target of the policy
+
+    // Summary of hot calls which were timed together, of which only the mean is known
+    static rocblas_timing_summary total(double total_us, size_t iters)
+    {
+        rocblas_timing_summary s;
+        s.iters  = iters;
+        s.mean   = iters ? total_us / iters : total_us;
+        s.median = s.min = s.max = s.p5 = s.p95 = s.mean;
+        return s;
+    }
+};
+
+// p-th percentile of sorted values, interpolating linearly between the closest ranks
+inline double rocblas_percentile(const std::vector<double>& sorted, double p)
+{
+    if(sorted.empty())
+        return 0;
+    double rank  = std::min(std::max(p, 0.0), 100.0) / 100 * (sorted.size() - 1);
+    size_t lower = size_t(rank);
+    if(lower + 1 >= sorted.size())
+        return sorted.back();
+    return sorted[lower] + (rank - lower) * (sorted[lower + 1] - sorted[lower]);
+}
+
+// Quantile of the standard normal distribution, by Acklam's rational approximation, which has
+// a relative error below 1.2e-9
+inline double rocblas_normal_quantile(double p)
+{
+    static constexpr double a[] = {-3.969683028665376e+01,
+                                   2.209460984245205e+02,
+                                   -2.759285104469687e+02,
+                                   1.383577518672690e+02,
+                                   -3.066479806614716e+01,
+                                   2.506628277459239e+00};
+    static constexpr double b[] = {-5.447609879822406e+01,
+                                   1.615858368580409e+02,
+                                   -1.556989798598866e+02,
+                                   6.680131188771972e+01,
+                                   -1.328068155288572e+01};
+    static constexpr double c[] = {-7.784894002430293e-03,
+                                   -3.223964580411365e-01,
+                                   -2.400758277161838e+00,
+                                   -2.549732539343734e+00,
+                                   4.374664141464968e+00,
+                                   2.938163982698783e+00};
+    static constexpr double d[] = {7.784695709041462e-03,
+                                   3.224671290700398e-01,
+                                   2.445134137142996e+00,
+                                   3.754408661907416e+00};
+
+    if(p <= 0 || p >= 1)
+        return p <= 0 ? -std::numeric_limits<double>::infinity()
+                      : std::numeric_limits<double>::infinity();
+
+    // Tails
+    if(p < 0.02425 || p > 1 - 0.02425)
+    {
+        double q = std::sqrt(-2 * std::log(p < 0.5 ? p : 1 - p));
+        double x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+                   / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+        return p < 0.5 ? x : -x;
+    }
+
+    // Central region
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+           / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+// Quantile of Student's t distribution with dof degrees of freedom. It is exact for 1 and 2
+// degrees of freedom, and uses the Cornish-Fisher expansion otherwise, which is within 0.2%
+// from 3 degrees of freedom for the usual confidence levels.
+inline double rocblas_student_t_quantile(double p, size_t dof)
+{
+    if(dof == 0)
+        return std::numeric_limits<double>::quiet_NaN();
+    if(dof == 1)
+        return std::tan(3.14159265358979323846 * (p - 0.5));
+    if(dof == 2)
+        return (2 * p - 1) / std::sqrt(2 * p * (1 - p));
+
+    double z  = rocblas_normal_quantile(p);
+    double z2 = z * z;
+    double v  = double(dof);
+    double g1 = z * (z2 + 1) / 4;
+    double g2 = z * ((5 * z2 + 16) * z2 + 3) / 96;
+    double g3 = z * (((3 * z2 + 19) * z2 + 17) * z2 - 15) / 384;
+    double g4 = z * ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) / 92160;
+    return z + (g1 + (g2 + (g3 + g4 / v) / v) / v) / v;
+}
+
+class rocblas_timing_stats
+{
+    std::vector<double> m_samples;
+
+public:
+    // Add the time of one hot call
+    void add(double us)
+    {
+        m_samples.push_back(us);
+    }
+
+    void clear()
+    {
+        m_samples.clear();
+    }
+
+    size_t size() const
+    {
+        return m_samples.size();
+    }
+
+    const std::vector<double>& samples() const
+    {
+        return m_samples;
+    }
+
+    // Summarize the samples, rejecting outliers as specified by policy
+    rocblas_timing_summary summarize(const rocblas_timing_policy& policy) const
+    {
+        rocblas_timing_summary s;
+        s.iters    = m_samples.size();
+        s.per_call = true;
+        if(m_samples.empty())
+            return s;
+
+        std::vector<double> sorted(m_samples);
+        std::sort(sorted.begin(), sorted.end());
+
+        // The MAD is scaled to estimate the standard deviation of normally distributed samples.
+        // If more than half of the samples are equal, the MAD is 0, and none are rejected.
+        if(policy.outlier_fence > 0 && sorted.size() >= 3)
+        {
+            double              median = rocblas_percentile(sorted, 50);
+            std::vector<double> deviations;
+            deviations.reserve(sorted.size());
+            for(double x : sorted)
+                deviations.push_back(std::abs(x - median));
+            std::sort(deviations.begin(), deviations.end());
+            double fence = policy.outlier_fence * 1.4826 * rocblas_percentile(deviations, 50);
+
+            if(fence > 0)
+            {
+                auto outlier = [=](double x) { return std::abs(x - median) > fence; };
+                sorted.erase(std::remove_if(sorted.begin(), sorted.end(), outlier), sorted.end());
+            }
+        }
+        s.rejected = s.iters - sorted.size();
+
+        size_t n   = sorted.size();
+        double sum = 0;
+        for(double x : sorted)
+            sum += x;
+        s.mean = sum / n;
+
+        double squares = 0;
+        for(double x : sorted)
+            squares += (x - s.mean) * (x - s.mean);
+        s.stddev = n > 1 ? std::sqrt(squares / (n - 1)) : 0;
+
+        s.min    = sorted.front();
+        s.max    = sorted.back();
+        s.median = rocblas_percentile(sorted, 50);
+        s.p5     = rocblas_percentile(sorted, 5);
+        s.p95    = rocblas_percentile(sorted, 95);
+
+        if(n > 1)
+        {
+            double t    = rocblas_student_t_quantile(0.5 + policy.confidence / 2, n - 1);
+            s.ci        = t * s.stddev / std::sqrt(double(n));
+            s.converged = s.ci <= policy.target_ci * s.mean;
+        }
+        else
+            s.ci = std::numeric_limits<double>::infinity();
+
+        return s;
+    }
+
+    // Number of hot calls to time next, or 0 when timing is complete. At least min_iters calls
+    // are timed. Unless policy.max_iters is larger, timing is complete after min_iters calls.
+    // Otherwise, the number of calls doubles until the confidence interval meets the target,
+    // max_iters calls have been timed, or elapsed_us exceeds the time limit.
+    size_t next_batch(const rocblas_timing_policy& policy,
+                      size_t                       min_iters,
+                      double                       elapsed_us) const
+    {
+        size_t n = m_samples.size();
+        if(n < min_iters)
+            return min_iters - n;
+
+        size_t max_iters = std::max(size_t(std::max(policy.max_iters, 0)), min_iters);
+        if(n >= max_iters || elapsed_us >= policy.max_time_us || summarize(policy).converged)
+            return 0;
+        return std::min(std::max(n, size_t(1)), max_iters - n);
+    }
+};
@@ -26,10 +26,12 @@
 #include "../../library/src/include/utility.hpp"
 #include "rocblas.h"
 #include "rocblas_vector.hpp"
+#include "timing_stats.hpp"
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -104,9 +106,12 @@ void rocblas_client_initialize();
 /*! \brief  local handle which is automatically created and destroyed  */
 class rocblas_local_handle
 {
-    rocblas_handle m_handle;
+    rocblas_handle m_handle = nullptr;
     void*          m_memory = nullptr;
 
+    // Device memory state of m_handle when it was acquired, which must be unchanged to reuse it
+    std::tuple<bool, bool, size_t> m_device_memory_state;
+
 public:
     rocblas_local_handle();
 
@@ -114,6 +119,9 @@ public:
 
     ~rocblas_local_handle();
 
+    // Destroy the handles kept for reuse while rocblas_client_get_reuse() was true
+    static void release_idle();
+
     rocblas_local_handle(const rocblas_local_handle&) = delete;
     rocblas_local_handle(rocblas_local_handle&&)      = delete;
     rocblas_local_handle& operator=(const rocblas_local_handle&) = delete;
@@ -150,6 +158,10 @@ double get_time_us_sync(hipStream_t stream);
 /*! \brief  CPU Timer(in microsecond): no GPU synchronization and return wall time */
 double get_time_us_no_sync();
 
+/*! \brief  Timing policy of rocblas-bench, which applies to all of the problems it runs */
+void                         rocblas_timing_set_policy(const rocblas_timing_policy& policy);
+const rocblas_timing_policy& rocblas_timing_get_policy();
+
 /* ============================================================================================ */
 // Return path of this executable
 std::string rocblas_exepath();
@@ -282,6 +282,9 @@ ROCBLAS_EXPORT rocblas_status rocblas_get_vector_async(rocblas_int n,
      \details
     rocblas_set_matrix_async copies a matrix from pinned host memory to device memory asynchronously.
     Memory on the host must be allocated with hipHostMalloc or the transfer will be synchronous.
+    If lda or ldb is not equal to rows, the matrix is staged through pinned host and device buffers:
+    the host matrix is packed by a host function enqueued on the stream, so it is read when the
+    stream reaches the transfer, and the function returns without waiting for the transfer.
     @param[in]
     rows        [rocblas_int]
                 number of rows in matrices
@@ -317,6 +320,9 @@ ROCBLAS_EXPORT rocblas_status rocblas_set_matrix_async(rocblas_int rows,
      \details
     rocblas_get_matrix_async copies a matrix from device memory to pinned host memory asynchronously.
     Memory on the host must be allocated with hipHostMalloc or the transfer will be synchronous.
+    If lda or ldb is not equal to rows, the matrix is staged through device and pinned host buffers:
+    the host matrix is unpacked by a host function enqueued on the stream, so it is written when
+    the stream reaches the end of the transfer, and the function returns without waiting for it.
     @param[in]
     rows        [rocblas_int]
                 number of rows in matrices
@@ -348,6 +354,352 @@ ROCBLAS_EXPORT rocblas_status rocblas_get_matrix_async(rocblas_int rows,
                                                        rocblas_int ldb,
                                                        hipStream_t stream);
 
+/*! \brief copy a batch of matrices from host to device
+     \details
+    rocblas_set_matrix_batched copies batch_count matrices from host memory to device memory.
+    The matrices are packed into one staging buffer, moved by one transfer and unpacked by one
+    kernel, in chunks of up to 16 MB, so the cost on the host does not grow with the number of
+    matrices like that of repeated calls to rocblas_set_matrix.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           host array of batch_count pointers to matrices on the host
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of A_i, lda >= rows
+    @param[out]
+    b           device array of batch_count pointers to matrices on the GPU
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of B_i, ldb >= rows
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_matrix_batched(rocblas_int       rows,
+                                                         rocblas_int       cols,
+                                                         rocblas_int       elem_size,
+                                                         const void* const a[],
+                                                         rocblas_int       lda,
+                                                         void* const       b[],
+                                                         rocblas_int       ldb,
+                                                         rocblas_int       batch_count);
+
+/*! \brief copy a batch of matrices from device to host
+     \details
+    rocblas_get_matrix_batched copies batch_count matrices from device memory to host memory.
+    The matrices are packed by one kernel, moved by one transfer and unpacked from one staging
+    buffer, in chunks of up to 16 MB.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           device array of batch_count pointers to matrices on the GPU
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of A_i, lda >= rows
+    @param[out]
+    b           host array of batch_count pointers to matrices on the host
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of B_i, ldb >= rows
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_matrix_batched(rocblas_int       rows,
+                                                         rocblas_int       cols,
+                                                         rocblas_int       elem_size,
+                                                         const void* const a[],
+                                                         rocblas_int       lda,
+                                                         void* const       b[],
+                                                         rocblas_int       ldb,
+                                                         rocblas_int       batch_count);
+
+/*! \brief copy a strided batch of matrices from host to device
+     \details
+    rocblas_set_matrix_strided_batched copies batch_count matrices from host memory to device
+    memory, like rocblas_set_matrix_batched. Matrices which are contiguous in memory, with
+    lda == rows and stride_a == rows * cols, are transferred without staging.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           pointer to the first matrix on the host
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of A_i, lda >= rows
+    @param[in]
+    stride_a    [rocblas_stride]
+                stride in elements from the start of one matrix A_i to the next one A_(i + 1)
+    @param[out]
+    b           pointer to the first matrix on the GPU
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of B_i, ldb >= rows
+    @param[in]
+    stride_b    [rocblas_stride]
+                stride in elements from the start of one matrix B_i to the next one B_(i + 1)
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_matrix_strided_batched(rocblas_int    rows,
+                                                                 rocblas_int    cols,
+                                                                 rocblas_int    elem_size,
+                                                                 const void*    a,
+                                                                 rocblas_int    lda,
+                                                                 rocblas_stride stride_a,
+                                                                 void*          b,
+                                                                 rocblas_int    ldb,
+                                                                 rocblas_stride stride_b,
+                                                                 rocblas_int    batch_count);
+
+/*! \brief copy a strided batch of matrices from device to host
+     \details
+    rocblas_get_matrix_strided_batched copies batch_count matrices from device memory to host
+    memory, like rocblas_get_matrix_batched. Matrices which are contiguous in memory, with
+    ldb == rows and stride_b == rows * cols, are transferred without staging.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           pointer to the first matrix on the GPU
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of A_i, lda >= rows
+    @param[in]
+    stride_a    [rocblas_stride]
+                stride in elements from the start of one matrix A_i to the next one A_(i + 1)
+    @param[out]
+    b           pointer to the first matrix on the host
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of B_i, ldb >= rows
+    @param[in]
+    stride_b    [rocblas_stride]
+                stride in elements from the start of one matrix B_i to the next one B_(i + 1)
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_matrix_strided_batched(rocblas_int    rows,
+                                                                 rocblas_int    cols,
+                                                                 rocblas_int    elem_size,
+                                                                 const void*    a,
+                                                                 rocblas_int    lda,
+                                                                 rocblas_stride stride_a,
+                                                                 void*          b,
+                                                                 rocblas_int    ldb,
+                                                                 rocblas_stride stride_b,
+                                                                 rocblas_int    batch_count);
+
+/*! \brief asynchronously copy a batch of matrices from host to device
+     \details
+    rocblas_set_matrix_batched_async is the asynchronous form of rocblas_set_matrix_batched.
+    Memory on the host must be allocated with hipHostMalloc. The host matrices are packed by host
+    functions enqueued on the stream, so they are read when the stream reaches the transfer, and
+    the function returns without waiting for the transfer. The host array a may be freed as soon
+    as the function returns. If no staging buffer can be allocated, rocblas_status_memory_error
+    is returned and nothing is enqueued.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           host array of batch_count pointers to matrices on the host
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of A_i, lda >= rows
+    @param[out]
+    b           device array of batch_count pointers to matrices on the GPU
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of B_i, ldb >= rows
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+    @param[in]
+    stream      specifies the stream into which this transfer request is queued
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_matrix_batched_async(rocblas_int       rows,
+                                                               rocblas_int       cols,
+                                                               rocblas_int       elem_size,
+                                                               const void* const a[],
+                                                               rocblas_int       lda,
+                                                               void* const       b[],
+                                                               rocblas_int       ldb,
+                                                               rocblas_int       batch_count,
+                                                               hipStream_t       stream);
+
+/*! \brief asynchronously copy a batch of matrices from device to host
+     \details
+    rocblas_get_matrix_batched_async is the asynchronous form of rocblas_get_matrix_batched.
+    Memory on the host must be allocated with hipHostMalloc. The host matrices are unpacked by
+    host functions enqueued on the stream, so they are written when the stream reaches the end
+    of the transfer. The host array b may be freed as soon as the function returns. If no staging
+    buffer can be allocated, rocblas_status_memory_error is returned and nothing is enqueued.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           device array of batch_count pointers to matrices on the GPU
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of A_i, lda >= rows
+    @param[out]
+    b           host array of batch_count pointers to matrices on the host
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of B_i, ldb >= rows
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+    @param[in]
+    stream      specifies the stream into which this transfer request is queued
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_matrix_batched_async(rocblas_int       rows,
+                                                               rocblas_int       cols,
+                                                               rocblas_int       elem_size,
+                                                               const void* const a[],
+                                                               rocblas_int       lda,
+                                                               void* const       b[],
+                                                               rocblas_int       ldb,
+                                                               rocblas_int       batch_count,
+                                                               hipStream_t       stream);
+
+/*! \brief asynchronously copy a strided batch of matrices from host to device
+     \details
+    rocblas_set_matrix_strided_batched_async is the asynchronous form of
+    rocblas_set_matrix_strided_batched, with the same requirements as
+    rocblas_set_matrix_batched_async.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           pointer to the first matrix on the host
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of A_i, lda >= rows
+    @param[in]
+    stride_a    [rocblas_stride]
+                stride in elements from the start of one matrix A_i to the next one A_(i + 1)
+    @param[out]
+    b           pointer to the first matrix on the GPU
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of B_i, ldb >= rows
+    @param[in]
+    stride_b    [rocblas_stride]
+                stride in elements from the start of one matrix B_i to the next one B_(i + 1)
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+    @param[in]
+    stream      specifies the stream into which this transfer request is queued
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_matrix_strided_batched_async(rocblas_int    rows,
+                                                                       rocblas_int    cols,
+                                                                       rocblas_int    elem_size,
+                                                                       const void*    a,
+                                                                       rocblas_int    lda,
+                                                                       rocblas_stride stride_a,
+                                                                       void*          b,
+                                                                       rocblas_int    ldb,
+                                                                       rocblas_stride stride_b,
+                                                                       rocblas_int    batch_count,
+                                                                       hipStream_t    stream);
+
+/*! \brief asynchronously copy a strided batch of matrices from device to host
+     \details
+    rocblas_get_matrix_strided_batched_async is the asynchronous form of
+    rocblas_get_matrix_strided_batched, with the same requirements as
+    rocblas_get_matrix_batched_async.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           pointer to the first matrix on the GPU
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of A_i, lda >= rows
+    @param[in]
+    stride_a    [rocblas_stride]
+                stride in elements from the start of one matrix A_i to the next one A_(i + 1)
+    @param[out]
+    b           pointer to the first matrix on the host
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of B_i, ldb >= rows
+    @param[in]
+    stride_b    [rocblas_stride]
+                stride in elements from the start of one matrix B_i to the next one B_(i + 1)
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+    @param[in]
+    stream      specifies the stream into which this transfer request is queued
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_matrix_strided_batched_async(rocblas_int    rows,
+                                                                       rocblas_int    cols,
+                                                                       rocblas_int    elem_size,
+                                                                       const void*    a,
+                                                                       rocblas_int    lda,
+                                                                       rocblas_stride stride_a,
+                                                                       void*          b,
+                                                                       rocblas_int    ldb,
+                                                                       rocblas_stride stride_b,
+                                                                       rocblas_int    batch_count,
+                                                                       hipStream_t    stream);
+
 /*******************************************************************************
  * Function to set start/stop event handlers (for internal use only)
  ******************************************************************************/
@@ -394,6 +746,85 @@ ROCBLAS_EXPORT rocblas_status rocblas_set_performance_metric(rocblas_handle
 ROCBLAS_EXPORT rocblas_status rocblas_get_performance_metric(rocblas_handle              handle,
                                                              rocblas_performance_metric* metric);
 
+/*! \brief returns the counters of the solution selection cache
+     \details
+    rocBLAS memoizes the result of solution selection for gemm problems in a bounded per-device
+    cache, keyed on the types, transposes, sizes, strides, batch count and flags of the problem.
+    The default capacity can be changed with the environment variable ROCBLAS_SOLUTION_CACHE_SIZE,
+    which must be a nonnegative integer; otherwise a warning is printed and the default is used.
+    If the environment variable ROCBLAS_SOLUTION_CACHE_PATH names a file, the selections are also
+    written to that file at exit, and are reused by later processes running on the same GPU
+    architecture with the same build of rocBLAS and its Tensile library.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+    @param[out]
+    hits        pointer to the number of selections answered from the cache
+    @param[out]
+    misses      pointer to the number of selections which were not cached
+    @param[out]
+    evictions   pointer to the number of entries evicted to respect the capacity
+    @param[out]
+    size        pointer to the number of entries currently cached
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_solution_cache_stats(
+    rocblas_handle handle, size_t* hits, size_t* misses, size_t* evictions, size_t* size);
+
+/*! \brief sets the capacity of the solution selection cache
+     \details
+    Sets the maximum number of entries in the solution selection cache for the device of the
+    handle. Least recently used entries are evicted if necessary. A capacity of 0 disables caching.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+    @param[in]
+    capacity    maximum number of cached problems
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_solution_cache_capacity(rocblas_handle handle,
+                                                                  size_t         capacity);
+
+/*! \brief clears the solution selection cache
+     \details
+    Removes all entries from the solution selection cache for the device of the handle, and
+    resets its counters.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_clear_solution_cache(rocblas_handle handle);
+
+/*! \brief gets the counters of the staging buffer pools
+     \details
+    rocblas_set_vector, rocblas_get_vector, rocblas_set_matrix, rocblas_get_matrix and the
+    matrix async functions stage strided data in pinned host buffers and device buffers, which
+    are leased from pools and reused by later calls. Buffers of asynchronous transfers are
+    returned to the pools once the transfer has completed on its stream. There is one pool of
+    host buffers for the process, and one pool of device buffers for each device. Idle buffers
+    are kept up to a limit on their total size in each pool, 32 MB by default, which can be set
+    with the environment variable ROCBLAS_STAGING_POOL_LIMIT. Counters are for the host pool and
+    the pool of the current device.
+    @param[out]
+    requests        pointer to the number of buffers requested
+    @param[out]
+    reuses          pointer to the number of requests satisfied by an idle buffer
+    @param[out]
+    host_bytes      pointer to the total size of the pinned host buffers held by the pool
+    @param[out]
+    device_bytes    pointer to the total size of the device buffers held by the pool of the
+                    current device
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_staging_buffer_stats(size_t* requests,
+                                                               size_t* reuses,
+                                                               size_t* host_bytes,
+                                                               size_t* device_bytes);
+
+/*! \brief frees the idle staging buffers
+     \details
+    Frees the buffers of the host staging pool and of the staging pool of the current device
+    which are not in use.
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_trim_staging_buffers(void);
+
 #ifdef __cplusplus
 }
 #endif
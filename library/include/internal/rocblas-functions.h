@@ -18152,6 +18152,46 @@ ROCBLAS_EXPORT const char* rocblas_status_to_string(rocblas_status status);
  ******************************************************************************/
 ROCBLAS_EXPORT void rocblas_initialize(void);
 
+/*! \brief Initialize rocBLAS on the current HIP device in the background.
+    \details
+    Starts the initialization performed by rocblas_initialize() on a background thread, and returns
+    without waiting for it. The solutions of the given gemm shapes are then selected in advance, so
+    that the first calls with those shapes do not pay the selection cost. Shapes are resolved as
+    for a handle with the default settings, except for the size of its device memory: the selections
+    are used by every handle whose device memory is large enough for the selected solution.
+
+    rocBLAS functions called while initialization is in progress wait for the library to be loaded.
+    Calls made while a previous initialization is in progress are queued after it.
+    Use rocblas_get_initialize_progress() to query whether initialization has finished.
+
+    @param[in]
+    shapes  pointer to an array of count gemm shapes. May be nullptr if count is 0.
+    @param[in]
+    count   [rocblas_int]
+            number of shapes.
+
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_initialize_async(const rocblas_gemm_shape* shapes,
+                                                       rocblas_int               count);
+
+/*! \brief Query the progress of rocblas_initialize_async.
+    \details
+    Reports how many of the initialization steps requested by rocblas_initialize_async() have been
+    completed. Loading the library for a device is one step, and selecting the solution of each
+    shape is one step.
+
+    @param[out]
+    ready       pointer to 1 if all of the steps have been completed, 0 otherwise.
+    @param[out]
+    completed   pointer to the number of steps completed.
+    @param[out]
+    total       pointer to the number of steps requested.
+
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_initialize_progress(rocblas_int* ready,
+                                                              size_t*      completed,
+                                                              size_t*      total);
+
 /*
  * ===========================================================================
  *    build information
@@ -18289,6 +18329,212 @@ ROCBLAS_EXPORT bool rocblas_is_managing_device_memory(rocblas_handle handle);
  ******************************************************************************/
 ROCBLAS_EXPORT bool rocblas_is_user_managing_device_memory(rocblas_handle handle);
 
+/*! \brief
+    \details
+    Makes the handle lease device memory from a workspace pool shared by all handles of its device.
+
+    Any previously allocated device memory managed by the handle is freed.
+
+    The handle leases memory from the pool when a function needs it, and returns it when the
+    function has been enqueued. Reuse of the memory by other handles is ordered after the work
+    on the returning handle's stream using HIP events, so idle handles hold no device memory.
+    Calling rocblas_set_device_memory_size() or rocblas_set_workspace() stops using the pool.
+    Handles are created using the pool if the environment variable ROCBLAS_SHARED_WORKSPACE is set to 1,
+    and ROCBLAS_DEVICE_MEMORY_SIZE is not set to a nonzero size.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_shared_workspace(rocblas_handle handle);
+
+/*! \brief
+    \details
+    Gets the total size of the shared workspace pool of the handle's device
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if size is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[out]
+    size            size of the shared workspace pool
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_shared_workspace_size(rocblas_handle handle,
+                                                                size_t*        size);
+
+/*! \brief
+    \details
+    Frees the memory of the shared workspace pool of the handle's device which is not leased,
+    and whose last use has completed
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_trim_shared_workspace(rocblas_handle handle);
+
+/*! \brief
+    \details
+    Gets running statistics of the device memory requests made through the handle.
+    These can be used to choose a size for rocblas_set_device_memory_size() which avoids
+    growing the device memory while the application is running.
+    The statistics are kept from the creation of the handle, or from the last call to
+    rocblas_reset_device_memory_stats().
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if any pointer is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[out]
+    peak_in_use     largest number of bytes of device memory in use at the same time
+    @param[out]
+    allocations     number of successful nonzero-sized requests
+    @param[out]
+    growths         number of requests which rocBLAS satisfied by allocating more device memory
+    @param[out]
+    failures        number of requests which could not be satisfied
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_device_memory_stats(rocblas_handle handle,
+                                                              size_t*        peak_in_use,
+                                                              size_t*        allocations,
+                                                              size_t*        growths,
+                                                              size_t*        failures);
+
+/*! \brief
+    \details
+    Resets the device memory statistics of the handle. The peak is restarted from the
+    amount of device memory currently in use.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_reset_device_memory_stats(rocblas_handle handle);
+
+/*! \brief
+    \details
+    Writes the device memory statistics of the handle to a file as YAML, including the
+    number of bytes requested by each rocBLAS routine. The file is overwritten.
+    The statistics of every handle are also appended to a file when the handle is destroyed,
+    if the environment variable ROCBLAS_DEVICE_MEMORY_STATS_PATH is set to its name.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if filename is nullptr;
+    rocblas_status_invalid_value if the file cannot be opened; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[in]
+    filename        name of the file to write
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_write_device_memory_stats(rocblas_handle handle,
+                                                                const char*    filename);
+
+/*! \brief
+    \details
+    Gets the host latency of one phase of the calls to a rocBLAS function made through the handle.
+    Latency is measured when the ROCBLAS_LAYER environment variable enables
+    rocblas_layer_mode_log_latency; otherwise no calls are counted.
+    Latencies are kept in histograms with a relative precision of 1/16, from the creation of the handle,
+    or from the last call to rocblas_reset_latency_stats().
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if any pointer is nullptr;
+    rocblas_status_invalid_value if phase is not a rocblas_latency_phase, or percentile is not between 0 and 100;
+    rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[in]
+    function        name of the rocBLAS function, such as "rocblas_sgemv"
+    @param[in]
+    phase           phase of the calls
+    @param[in]
+    percentile      percentile of the latency to get, between 0 and 100
+    @param[out]
+    calls           number of calls to the function which were measured
+    @param[out]
+    mean_ns         mean latency of the phase in nanoseconds, or 0 if there were no calls
+    @param[out]
+    percentile_ns   latency of the phase in nanoseconds below which percentile % of the calls fall,
+                    or 0 if there were no calls
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_latency_stats(rocblas_handle        handle,
+                                                        const char*           function,
+                                                        rocblas_latency_phase phase,
+                                                        double                percentile,
+                                                        size_t*               calls,
+                                                        double*               mean_ns,
+                                                        double*               percentile_ns);
+
+/*! \brief
+    \details
+    Resets the latency statistics of the handle.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_reset_latency_stats(rocblas_handle handle);
+
+/*! \brief
+    \details
+    Writes the latency statistics of the handle to a file as YAML, with the mean, median, 90th and
+    99th percentile and maximum latency of each phase of each rocBLAS function. The file is overwritten.
+    The statistics of every handle are also written when the handle is destroyed, to the file named by
+    the environment variable ROCBLAS_LOG_LATENCY_PATH or ROCBLAS_LOG_PATH, or to standard error.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if filename is nullptr;
+    rocblas_status_invalid_value if the file cannot be opened; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[in]
+    filename        name of the file to write
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_write_latency_stats(rocblas_handle handle,
+                                                          const char*    filename);
+
+/*! \brief
+    \details
+    Waits for the numerical checks of the handle which are still being read back, and reports them.
+    With rocblas_check_numerics_mode_deferred, the results of numerical checks are read back
+    asynchronously, so a function can return before its check has been reported.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_check_numerics_fail
+    if a check which has not yet returned a failure found a NaN/Inf/denormal value and
+    rocblas_check_numerics_mode_fail is set; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_synchronize_check_numerics(rocblas_handle handle);
+
+/*! \brief
+    \details
+    Sets the policy which selects the calls of the handle checked by numerical checking, which is
+    enabled by the ROCBLAS_CHECK_NUMERICS environment variable. The policy can also be set with the
+    environment variable ROCBLAS_CHECK_NUMERICS_SAMPLING, as "all", "every:N", "fraction:P" or "first:K".
+    The argument profile of a call is the shape of the first vector or matrix it checks. Random sampling
+    is reproducible: the sequence restarts whenever the policy is set. The sampling statistics are reset.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_value if policy
+    is not a rocblas_check_numerics_sampling or value is invalid for it; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[in]
+    policy          sampling policy
+    @param[in]
+    value           N, an integer of at least 1 and less than 2^64, for rocblas_check_numerics_sample_every_nth;
+                    the fraction of calls, between 0 and 1, for rocblas_check_numerics_sample_fraction;
+                    K, an integer of at least 0, for rocblas_check_numerics_sample_first;
+                    ignored for rocblas_check_numerics_sample_all
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_check_numerics_sampling(
+    rocblas_handle handle, rocblas_check_numerics_sampling policy, double value);
+
+/*! \brief
+    \details
+    Gets the number of calls to a rocBLAS function made through the handle while numerical checking
+    was enabled, and the number of them which were selected by the sampling policy and checked,
+    since the policy was last set.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if any
+    pointer is nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[in]
+    function        name of the rocBLAS function, such as "rocblas_saxpy"
+    @param[out]
+    calls           number of calls to the function
+    @param[out]
+    sampled         number of calls to the function which were checked
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_check_numerics_sampling_stats(rocblas_handle handle,
+                                                                        const char*    function,
+                                                                        size_t*        calls,
+                                                                        size_t*        sampled);
+
 /*! \brief
     \details
     Abort function which safely flushes all IO
@@ -257,8 +257,27 @@ typedef enum rocblas_layer_mode_
     rocblas_layer_mode_log_bench = 0x2,
     /*! \brief Outputs a YAML description of each rocBLAS function called, along with its arguments and number of times it was called. */
     rocblas_layer_mode_log_profile = 0x4,
+    /*! \brief Trace and bench logging write compact binary records, which are decoded offline by rocblas-log-decode, instead of text. */
+    rocblas_layer_mode_log_binary = 0x8,
+    /*! \brief Keeps histograms of the host time spent in each phase of each rocBLAS function. */
+    rocblas_layer_mode_log_latency = 0x10,
 } rocblas_layer_mode;
 
+/*! \brief Phase of a rocBLAS function call whose host latency is measured by rocblas_layer_mode_log_latency */
+typedef enum rocblas_latency_phase_
+{
+    /*! \brief The whole call, from its entry until it returns. */
+    rocblas_latency_phase_total = 0,
+    /*! \brief Checking the arguments, after they are logged. */
+    rocblas_latency_phase_arguments = 1,
+    /*! \brief Trace, bench and profile logging. */
+    rocblas_latency_phase_logging = 2,
+    /*! \brief Allocating device memory workspace. */
+    rocblas_latency_phase_workspace = 3,
+    /*! \brief Launching kernels, or dispatching to other libraries. */
+    rocblas_latency_phase_dispatch = 4,
+} rocblas_latency_phase;
+
 /*! \brief Indicates if layer is active with bitmask*/
 typedef enum rocblas_gemm_algo_
 {
@@ -321,6 +340,48 @@ typedef enum rocblas_check_numerics_mode_
     //Return 'rocblas_status_check_numeric_fail' status if there is NaN/Inf/denormal value
     rocblas_check_numerics_mode_fail = 0x4,
 
+    //Do not wait for the results of checks. They are reported once they have been read back,
+    //and a failure is returned by a later check or by rocblas_synchronize_check_numerics
+    rocblas_check_numerics_mode_deferred = 0x8,
+
 } rocblas_check_numerics_mode;
 
+/*! \brief Policy which selects the calls checked by numerical checking */
+typedef enum rocblas_check_numerics_sampling_
+{
+    /*! \brief Check every call. */
+    rocblas_check_numerics_sample_all = 0,
+    /*! \brief Check the first call of each function, and every Nth call after it. */
+    rocblas_check_numerics_sample_every_nth = 1,
+    /*! \brief Check a random fraction of the calls. */
+    rocblas_check_numerics_sample_fraction = 2,
+    /*! \brief Check the first K calls of each function with each argument profile. */
+    rocblas_check_numerics_sample_first = 3,
+} rocblas_check_numerics_sampling;
+
+/*! \brief Shape of a gemm problem whose solution is selected in advance by rocblas_initialize_async.
+    The fields correspond to the arguments of rocblas_<t>gemm_strided_batched; a non-batched
+    problem has a batch_count of 1 and strides of 0. */
+typedef struct rocblas_gemm_shape
+{
+    /*! \brief rocblas_datatype_f16_r, rocblas_datatype_f32_r, rocblas_datatype_f64_r,
+     * rocblas_datatype_f32_c or rocblas_datatype_f64_c */
+    rocblas_datatype  type;
+    rocblas_operation trans_a;
+    rocblas_operation trans_b;
+    rocblas_int       m;
+    rocblas_int       n;
+    rocblas_int       k;
+    rocblas_int       lda;
+    rocblas_int       ldb;
+    rocblas_int       ldc;
+    rocblas_stride    stride_a;
+    rocblas_stride    stride_b;
+    rocblas_stride    stride_c;
+    rocblas_int       batch_count;
+    /*! \brief Only whether alpha and beta are 0, 1, -1 or another value affects the selection */
+    double alpha;
+    double beta;
+} rocblas_gemm_shape;
+
 #endif
@@ -342,6 +342,164 @@ module rocblas
         end function rocblas_get_matrix_async
     end interface
 
+    interface
+        function rocblas_set_matrix_batched(rows, cols, elem_size, a, lda, b, ldb, batch_count) &
+            bind(c, name='rocblas_set_matrix_batched')
+            use iso_c_binding
+            use rocblas_enums
+            implicit none
+            integer(kind(rocblas_status_success)) :: rocblas_set_matrix_batched
+            integer(c_int), value :: rows
+            integer(c_int), value :: cols
+            integer(c_int), value :: elem_size
+            type(c_ptr), value :: a
+            integer(c_int), value :: lda
+            type(c_ptr), value :: b
+            integer(c_int), value :: ldb
+            integer(c_int), value :: batch_count
+        end function rocblas_set_matrix_batched
+    end interface
+
+    interface
+        function rocblas_get_matrix_batched(rows, cols, elem_size, a, lda, b, ldb, batch_count) &
+            bind(c, name='rocblas_get_matrix_batched')
+            use iso_c_binding
+            use rocblas_enums
+            implicit none
+            integer(kind(rocblas_status_success)) :: rocblas_get_matrix_batched
+            integer(c_int), value :: rows
+            integer(c_int), value :: cols
+            integer(c_int), value :: elem_size
+            type(c_ptr), value :: a
+            integer(c_int), value :: lda
+            type(c_ptr), value :: b
+            integer(c_int), value :: ldb
+            integer(c_int), value :: batch_count
+        end function rocblas_get_matrix_batched
+    end interface
+
+    interface
+        function rocblas_set_matrix_strided_batched(rows, cols, elem_size, a, lda, stride_a, b, ldb, stride_b, batch_count) &
+            bind(c, name='rocblas_set_matrix_strided_batched')
+            use iso_c_binding
+            use rocblas_enums
+            implicit none
+            integer(kind(rocblas_status_success)) :: rocblas_set_matrix_strided_batched
+            integer(c_int), value :: rows
+            integer(c_int), value :: cols
+            integer(c_int), value :: elem_size
+            type(c_ptr), value :: a
+            integer(c_int), value :: lda
+            integer(c_int64_t), value :: stride_a
+            type(c_ptr), value :: b
+            integer(c_int), value :: ldb
+            integer(c_int64_t), value :: stride_b
+            integer(c_int), value :: batch_count
+        end function rocblas_set_matrix_strided_batched
+    end interface
+
+    interface
+        function rocblas_get_matrix_strided_batched(rows, cols, elem_size, a, lda, stride_a, b, ldb, stride_b, batch_count) &
+            bind(c, name='rocblas_get_matrix_strided_batched')
+            use iso_c_binding
+            use rocblas_enums
+            implicit none
+            integer(kind(rocblas_status_success)) :: rocblas_get_matrix_strided_batched
+            integer(c_int), value :: rows
+            integer(c_int), value :: cols
+            integer(c_int), value :: elem_size
+            type(c_ptr), value :: a
+            integer(c_int), value :: lda
+            integer(c_int64_t), value :: stride_a
+            type(c_ptr), value :: b
+            integer(c_int), value :: ldb
+            integer(c_int64_t), value :: stride_b
+            integer(c_int), value :: batch_count
+        end function rocblas_get_matrix_strided_batched
+    end interface
+
+    interface
+        function rocblas_set_matrix_batched_async(rows, cols, elem_size, a, lda, b, ldb, batch_count, stream) &
+            bind(c, name='rocblas_set_matrix_batched_async')
+            use iso_c_binding
+            use rocblas_enums
+            implicit none
+            integer(kind(rocblas_status_success)) :: rocblas_set_matrix_batched_async
+            integer(c_int), value :: rows
+            integer(c_int), value :: cols
+            integer(c_int), value :: elem_size
+            type(c_ptr), value :: a
+            integer(c_int), value :: lda
+            type(c_ptr), value :: b
+            integer(c_int), value :: ldb
+            integer(c_int), value :: batch_count
+            type(c_ptr), value :: stream
+        end function rocblas_set_matrix_batched_async
+    end interface
+
+    interface
+        function rocblas_get_matrix_batched_async(rows, cols, elem_size, a, lda, b, ldb, batch_count, stream) &
+            bind(c, name='rocblas_get_matrix_batched_async')
+            use iso_c_binding
+            use rocblas_enums
+            implicit none
+            integer(kind(rocblas_status_success)) :: rocblas_get_matrix_batched_async
+            integer(c_int), value :: rows
+            integer(c_int), value :: cols
+            integer(c_int), value :: elem_size
+            type(c_ptr), value :: a
+            integer(c_int), value :: lda
+            type(c_ptr), value :: b
+            integer(c_int), value :: ldb
+            integer(c_int), value :: batch_count
+            type(c_ptr), value :: stream
+        end function rocblas_get_matrix_batched_async
+    end interface
+
+    interface
+        function rocblas_set_matrix_strided_batched_async(rows, cols, elem_size, a, lda, stride_a, &
+            b, ldb, stride_b, batch_count, stream) &
+            bind(c, name='rocblas_set_matrix_strided_batched_async')
+            use iso_c_binding
+            use rocblas_enums
+            implicit none
+            integer(kind(rocblas_status_success)) :: rocblas_set_matrix_strided_batched_async
+            integer(c_int), value :: rows
+            integer(c_int), value :: cols
+            integer(c_int), value :: elem_size
+            type(c_ptr), value :: a
+            integer(c_int), value :: lda
+            integer(c_int64_t), value :: stride_a
+            type(c_ptr), value :: b
+            integer(c_int), value :: ldb
+            integer(c_int64_t), value :: stride_b
+            integer(c_int), value :: batch_count
+            type(c_ptr), value :: stream
+        end function rocblas_set_matrix_strided_batched_async
+    end interface
+
+    interface
+        function rocblas_get_matrix_strided_batched_async(rows, cols, elem_size, a, lda, stride_a, &
+            b, ldb, stride_b, batch_count, stream) &
+            bind(c, name='rocblas_get_matrix_strided_batched_async')
+            use iso_c_binding
+            use rocblas_enums
+            implicit none
+            integer(kind(rocblas_status_success)) :: rocblas_get_matrix_strided_batched_async
+            integer(c_int), value :: rows
+            integer(c_int), value :: cols
+            integer(c_int), value :: elem_size
+            type(c_ptr), value :: a
+            integer(c_int), value :: lda
+            integer(c_int64_t), value :: stride_a
+            type(c_ptr), value :: b
+            integer(c_int), value :: ldb
+            integer(c_int64_t), value :: stride_b
+            integer(c_int), value :: batch_count
+            type(c_ptr), value :: stream
+        end function rocblas_get_matrix_strided_batched_async
+    end interface
+
     interface
         function rocblas_set_start_stop_events(handle, start_event, stop_event) &
             bind(c, name='rocblas_set_start_stop_events')
@@ -89,6 +89,7 @@ extern "C" {
                          typeo_*             result)       \
     try                                                    \
     {                                                      \
+        rocblas_call_scope call_scope(handle, __func__);   \
         return rocblas_asum_batched_impl<ROCBLAS_ASUM_NB>( \
             handle, n, x, incx, batch_count, result);      \
     }                                                      \
@@ -95,6 +95,7 @@ extern "C" {
                          typeo_*        results)                   \
     try                                                            \
     {                                                              \
+        rocblas_call_scope call_scope(handle, __func__);           \
         return rocblas_asum_strided_batched_impl<ROCBLAS_ASUM_NB>( \
             handle, n, x, incx, stridex, batch_count, results);    \
     }                                                              \
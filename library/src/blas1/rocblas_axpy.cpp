@@ -183,6 +183,7 @@ extern "C" {
                                  rocblas_int    incy)                    \
     try                                                                  \
     {                                                                    \
+        rocblas_call_scope call_scope(handle, __func__);                 \
         return rocblas_axpy_impl<ROCBLAS_AXPY_NB>(                       \
             handle, n, alpha, x, incx, y, incy, #routine_name_, "axpy"); \
     }                                                                    \
@@ -196,6 +196,7 @@ extern "C" {
                                  rocblas_int     batch_count)                                 \
     try                                                                                       \
     {                                                                                         \
+        rocblas_call_scope call_scope(handle, __func__);                                      \
         return rocblas_axpy_batched_impl<ROCBLAS_AXPY_NB>(                                    \
             handle, n, alpha, x, incx, y, incy, batch_count, #routine_name_, "axpy_batched"); \
     }                                                                                         \
@@ -222,6 +222,7 @@ extern "C" {
                                  rocblas_int    batch_count)                               \
     try                                                                                    \
     {                                                                                      \
+        rocblas_call_scope call_scope(handle, __func__);                                   \
         return rocblas_axpy_strided_batched_impl<ROCBLAS_AXPY_NB>(handle,                  \
                                                                   n,                       \
                                                                   alpha,                   \
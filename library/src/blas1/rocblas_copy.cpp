@@ -145,6 +145,7 @@ rocblas_status rocblas_scopy(rocblas_handle handle,
                              rocblas_int    incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_impl<ROCBLAS_COPY_NB>(handle, n, x, incx, y, incy);
 }
 catch(...)
@@ -160,6 +161,7 @@ rocblas_status rocblas_dcopy(rocblas_handle handle,
                              rocblas_int    incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_impl<ROCBLAS_COPY_NB>(handle, n, x, incx, y, incy);
 }
 catch(...)
@@ -175,6 +177,7 @@ rocblas_status rocblas_hcopy(rocblas_handle      handle,
                              rocblas_int         incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_impl<ROCBLAS_COPY_NB>(handle, n, x, incx, y, incy);
 }
 catch(...)
@@ -190,6 +193,7 @@ rocblas_status rocblas_ccopy(rocblas_handle               handle,
                              rocblas_int                  incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_impl<ROCBLAS_COPY_NB>(handle, n, x, incx, y, incy);
 }
 catch(...)
@@ -205,6 +209,7 @@ rocblas_status rocblas_zcopy(rocblas_handle                handle,
                              rocblas_int                   incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_impl<ROCBLAS_COPY_NB>(handle, n, x, incx, y, incy);
 }
 catch(...)
@@ -162,6 +162,7 @@ rocblas_status rocblas_scopy_batched(rocblas_handle     handle,
                                      rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_batched_impl<ROCBLAS_COPY_NB>(handle, n, x, incx, y, incy, batch_count);
 }
 catch(...)
@@ -178,6 +179,7 @@ rocblas_status rocblas_dcopy_batched(rocblas_handle      handle,
                                      rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_batched_impl<ROCBLAS_COPY_NB>(handle, n, x, incx, y, incy, batch_count);
 }
 catch(...)
@@ -194,6 +196,7 @@ rocblas_status rocblas_hcopy_batched(rocblas_handle            handle,
                                      rocblas_int               batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_batched_impl<ROCBLAS_COPY_NB>(handle, n, x, incx, y, incy, batch_count);
 }
 catch(...)
@@ -210,6 +213,7 @@ rocblas_status rocblas_ccopy_batched(rocblas_handle                     handle,
                                      rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_batched_impl<ROCBLAS_COPY_NB>(handle, n, x, incx, y, incy, batch_count);
 }
 catch(...)
@@ -226,6 +230,7 @@ rocblas_status rocblas_zcopy_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_batched_impl<ROCBLAS_COPY_NB>(handle, n, x, incx, y, incy, batch_count);
 }
 catch(...)
@@ -186,6 +186,7 @@ rocblas_status rocblas_scopy_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_strided_batched_impl<ROCBLAS_COPY_NB>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count);
 }
@@ -205,6 +206,7 @@ rocblas_status rocblas_dcopy_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_strided_batched_impl<ROCBLAS_COPY_NB>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count);
 }
@@ -224,6 +226,7 @@ rocblas_status rocblas_hcopy_strided_batched(rocblas_handle      handle,
                                              rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_strided_batched_impl<ROCBLAS_COPY_NB>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count);
 }
@@ -243,6 +246,7 @@ rocblas_status rocblas_ccopy_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_strided_batched_impl<ROCBLAS_COPY_NB>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count);
 }
@@ -262,6 +266,7 @@ rocblas_status rocblas_zcopy_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_copy_strided_batched_impl<ROCBLAS_COPY_NB>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count);
 }
@@ -184,6 +184,7 @@ rocblas_status rocblas_sdot(rocblas_handle handle,
                             float*         result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_impl<false>(handle, n, x, incx, y, incy, result);
 }
 catch(...)
@@ -200,6 +201,7 @@ rocblas_status rocblas_ddot(rocblas_handle handle,
                             double*        result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_impl<false>(handle, n, x, incx, y, incy, result);
 }
 catch(...)
@@ -216,6 +218,7 @@ rocblas_status rocblas_hdot(rocblas_handle      handle,
                             rocblas_half*       result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_impl<false>(handle, n, x, incx, y, incy, result);
 }
 catch(...)
@@ -232,6 +235,7 @@ rocblas_status rocblas_bfdot(rocblas_handle          handle,
                              rocblas_bfloat16*       result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_impl<false, rocblas_bfloat16, float>(handle, n, x, incx, y, incy, result);
 }
 catch(...)
@@ -248,6 +252,7 @@ rocblas_status rocblas_cdotu(rocblas_handle               handle,
                              rocblas_float_complex*       result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_impl<false>(handle, n, x, incx, y, incy, result);
 }
 catch(...)
@@ -264,6 +269,7 @@ rocblas_status rocblas_zdotu(rocblas_handle                handle,
                              rocblas_double_complex*       result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_impl<false>(handle, n, x, incx, y, incy, result);
 }
 catch(...)
@@ -280,6 +286,7 @@ rocblas_status rocblas_cdotc(rocblas_handle               handle,
                              rocblas_float_complex*       result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_impl<true>(handle, n, x, incx, y, incy, result);
 }
 catch(...)
@@ -296,6 +303,7 @@ rocblas_status rocblas_zdotc(rocblas_handle                handle,
                              rocblas_double_complex*       result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_impl<true>(handle, n, x, incx, y, incy, result);
 }
 catch(...)
@@ -207,6 +207,7 @@ rocblas_status rocblas_sdot_batched(rocblas_handle     handle,
                                     float*             results)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_batched_impl<false>(handle, n, x, incx, y, incy, batch_count, results);
 }
 catch(...)
@@ -224,6 +225,7 @@ rocblas_status rocblas_ddot_batched(rocblas_handle      handle,
                                     double*             results)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_batched_impl<false>(handle, n, x, incx, y, incy, batch_count, results);
 }
 catch(...)
@@ -241,6 +243,7 @@ rocblas_status rocblas_hdot_batched(rocblas_handle            handle,
                                     rocblas_half*             result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_batched_impl<false>(handle,
                                            n,
                                            (const rocblas_half* const*)x,
@@ -265,6 +268,7 @@ rocblas_status rocblas_bfdot_batched(rocblas_handle                handle,
                                      rocblas_bfloat16*             result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_batched_impl<false, rocblas_bfloat16, float>(
         handle, n, x, incx, y, incy, batch_count, result);
 }
@@ -283,6 +287,7 @@ rocblas_status rocblas_cdotu_batched(rocblas_handle                     handle,
                                      rocblas_float_complex*             results)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_batched_impl<false>(handle, n, x, incx, y, incy, batch_count, results);
 }
 catch(...)
@@ -300,6 +305,7 @@ rocblas_status rocblas_zdotu_batched(rocblas_handle                      handle,
                                      rocblas_double_complex*             results)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_batched_impl<false>(handle, n, x, incx, y, incy, batch_count, results);
 }
 catch(...)
@@ -317,6 +323,7 @@ rocblas_status rocblas_cdotc_batched(rocblas_handle                     handle,
                                      rocblas_float_complex*             results)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_batched_impl<true>(handle, n, x, incx, y, incy, batch_count, results);
 }
 catch(...)
@@ -334,6 +341,7 @@ rocblas_status rocblas_zdotc_batched(rocblas_handle                      handle,
                                      rocblas_double_complex*             results)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_batched_impl<true>(handle, n, x, incx, y, incy, batch_count, results);
 }
 catch(...)
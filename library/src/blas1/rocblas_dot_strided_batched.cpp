@@ -229,6 +229,7 @@ rocblas_status rocblas_sdot_strided_batched(rocblas_handle handle,
                                             float*         results)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_strided_batched_impl<false>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count, results);
 }
@@ -249,6 +250,7 @@ rocblas_status rocblas_ddot_strided_batched(rocblas_handle handle,
                                             double*        results)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_strided_batched_impl<false>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count, results);
 }
@@ -269,6 +271,7 @@ rocblas_status rocblas_hdot_strided_batched(rocblas_handle      handle,
                                             rocblas_half*       result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_strided_batched_impl<false>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count, result);
 }
@@ -289,6 +292,7 @@ rocblas_status rocblas_bfdot_strided_batched(rocblas_handle          handle,
                                              rocblas_bfloat16*       result)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_strided_batched_impl<false, rocblas_bfloat16, float>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count, result);
 }
@@ -309,6 +313,7 @@ rocblas_status rocblas_cdotu_strided_batched(rocblas_handle               handle
                                              rocblas_float_complex*       results)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_strided_batched_impl<false>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count, results);
 }
@@ -329,6 +334,7 @@ rocblas_status rocblas_zdotu_strided_batched(rocblas_handle                handl
                                              rocblas_double_complex*       results)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_strided_batched_impl<false>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count, results);
 }
@@ -350,6 +356,7 @@ rocblas_status rocblas_cdotc_strided_batched(rocblas_handle               handle
 try
 
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_strided_batched_impl<true>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count, results);
 }
@@ -370,6 +377,7 @@ rocblas_status rocblas_zdotc_strided_batched(rocblas_handle                handl
                                              rocblas_double_complex*       results)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_dot_strided_batched_impl<true>(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count, results);
 }
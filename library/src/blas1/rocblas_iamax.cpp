@@ -147,6 +147,7 @@ extern "C" {
                          rocblas_int*   results)                        \
     try                                                                 \
     {                                                                   \
+        rocblas_call_scope call_scope(handle, __func__);                \
         return rocblas_iamax_impl<typew_>(handle, n, x, incx, results); \
     }                                                                   \
     catch(...)                                                          \
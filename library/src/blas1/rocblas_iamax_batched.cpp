@@ -150,6 +150,7 @@ extern "C" {
                                  rocblas_int*     results)                               \
     try                                                                                  \
     {                                                                                    \
+        rocblas_call_scope call_scope(handle, __func__);                                 \
         return rocblas_iamax_batched_impl<S_>(handle, n, x, incx, batch_count, results); \
     }                                                                                    \
     catch(...)                                                                           \
@@ -153,6 +153,7 @@ extern "C" {
                                  rocblas_int*   results)        \
     try                                                         \
     {                                                           \
+        rocblas_call_scope call_scope(handle, __func__);        \
         return rocblas_iamax_strided_batched_impl<S_>(          \
             handle, n, x, incx, stridex, batch_count, results); \
     }                                                           \
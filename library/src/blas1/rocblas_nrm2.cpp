@@ -138,6 +138,7 @@ extern "C" {
         rocblas_handle handle, rocblas_int n, const typei_* x, rocblas_int incx, typeo_* results) \
     try                                                                                           \
     {                                                                                             \
+        rocblas_call_scope call_scope(handle, __func__);                                          \
         return rocblas_nrm2_impl<ROCBLAS_NRM2_NB>(handle, n, x, incx, results);                   \
     }                                                                                             \
     catch(...)                                                                                    \
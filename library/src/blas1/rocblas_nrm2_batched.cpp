@@ -139,6 +139,7 @@ extern "C" {
                          typeo_*             result)       \
     try                                                    \
     {                                                      \
+        rocblas_call_scope call_scope(handle, __func__);   \
         return rocblas_nrm2_batched_impl<ROCBLAS_NRM2_NB>( \
             handle, n, x, incx, batch_count, result);      \
     }                                                      \
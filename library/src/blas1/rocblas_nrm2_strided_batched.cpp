@@ -146,6 +146,7 @@ extern "C" {
                          typeo_*        results)                   \
     try                                                            \
     {                                                              \
+        rocblas_call_scope call_scope(handle, __func__);           \
         return rocblas_nrm2_strided_batched_impl<ROCBLAS_NRM2_NB>( \
             handle, n, x, incx, stridex, batch_count, results);    \
     }                                                              \
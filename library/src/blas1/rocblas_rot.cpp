@@ -158,6 +158,7 @@ rocblas_status rocblas_srot(rocblas_handle handle,
                             const float*   s)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_impl(handle, n, x, incx, y, incy, c, s);
 }
 catch(...)
@@ -175,6 +176,7 @@ rocblas_status rocblas_drot(rocblas_handle handle,
                             const double*  s)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_impl(handle, n, x, incx, y, incy, c, s);
 }
 catch(...)
@@ -192,6 +194,7 @@ rocblas_status rocblas_crot(rocblas_handle               handle,
                             const rocblas_float_complex* s)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_impl(handle, n, x, incx, y, incy, c, s);
 }
 catch(...)
@@ -209,6 +212,7 @@ rocblas_status rocblas_csrot(rocblas_handle         handle,
                              const float*           s)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_impl(handle, n, x, incx, y, incy, c, s);
 }
 catch(...)
@@ -226,6 +230,7 @@ rocblas_status rocblas_zrot(rocblas_handle                handle,
                             const rocblas_double_complex* s)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_impl(handle, n, x, incx, y, incy, c, s);
 }
 catch(...)
@@ -243,6 +248,7 @@ rocblas_status rocblas_zdrot(rocblas_handle          handle,
                              const double*           s)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_impl(handle, n, x, incx, y, incy, c, s);
 }
 catch(...)
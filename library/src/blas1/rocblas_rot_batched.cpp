@@ -170,6 +170,7 @@ rocblas_status rocblas_srot_batched(rocblas_handle handle,
                                     rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_batched_impl(handle, n, x, incx, y, incy, c, s, batch_count);
 }
 catch(...)
@@ -188,6 +189,7 @@ rocblas_status rocblas_drot_batched(rocblas_handle handle,
                                     rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_batched_impl(handle, n, x, incx, y, incy, c, s, batch_count);
 }
 catch(...)
@@ -206,6 +208,7 @@ rocblas_status rocblas_crot_batched(rocblas_handle               handle,
                                     rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_batched_impl(handle, n, x, incx, y, incy, c, s, batch_count);
 }
 catch(...)
@@ -224,6 +227,7 @@ rocblas_status rocblas_csrot_batched(rocblas_handle               handle,
                                      rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_batched_impl(handle, n, x, incx, y, incy, c, s, batch_count);
 }
 catch(...)
@@ -242,6 +246,7 @@ rocblas_status rocblas_zrot_batched(rocblas_handle                handle,
                                     rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_batched_impl(handle, n, x, incx, y, incy, c, s, batch_count);
 }
 catch(...)
@@ -260,6 +265,7 @@ rocblas_status rocblas_zdrot_batched(rocblas_handle                handle,
                                      rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_batched_impl(handle, n, x, incx, y, incy, c, s, batch_count);
 }
 catch(...)
@@ -196,6 +196,7 @@ rocblas_status rocblas_srot_strided_batched(rocblas_handle handle,
                                             rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_strided_batched_impl(
         handle, n, x, incx, stride_x, y, incy, stride_y, c, s, batch_count);
 }
@@ -217,6 +218,7 @@ rocblas_status rocblas_drot_strided_batched(rocblas_handle handle,
                                             rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_strided_batched_impl(
         handle, n, x, incx, stride_x, y, incy, stride_y, c, s, batch_count);
 }
@@ -238,6 +240,7 @@ rocblas_status rocblas_crot_strided_batched(rocblas_handle               handle,
                                             rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_strided_batched_impl(
         handle, n, x, incx, stride_x, y, incy, stride_y, c, s, batch_count);
 }
@@ -259,6 +262,7 @@ rocblas_status rocblas_csrot_strided_batched(rocblas_handle         handle,
                                              rocblas_int            batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_strided_batched_impl(
         handle, n, x, incx, stride_x, y, incy, stride_y, c, s, batch_count);
 }
@@ -280,6 +284,7 @@ rocblas_status rocblas_zrot_strided_batched(rocblas_handle                handle
                                             rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_strided_batched_impl(
         handle, n, x, incx, stride_x, y, incy, stride_y, c, s, batch_count);
 }
@@ -301,6 +306,7 @@ rocblas_status rocblas_zdrot_strided_batched(rocblas_handle          handle,
                                              rocblas_int             batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_strided_batched_impl(
         handle, n, x, incx, stride_x, y, incy, stride_y, c, s, batch_count);
 }
@@ -134,6 +134,7 @@ extern "C" {
 rocblas_status rocblas_srotg(rocblas_handle handle, float* a, float* b, float* c, float* s)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_impl(handle, a, b, c, s);
 }
 catch(...)
@@ -144,6 +145,7 @@ catch(...)
 rocblas_status rocblas_drotg(rocblas_handle handle, double* a, double* b, double* c, double* s)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_impl(handle, a, b, c, s);
 }
 catch(...)
@@ -158,6 +160,7 @@ rocblas_status rocblas_crotg(rocblas_handle         handle,
                              rocblas_float_complex* s)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_impl(handle, a, b, c, s);
 }
 catch(...)
@@ -172,6 +175,7 @@ rocblas_status rocblas_zrotg(rocblas_handle          handle,
                              rocblas_double_complex* s)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_impl(handle, a, b, c, s);
 }
 catch(...)
@@ -149,6 +149,7 @@ rocblas_status rocblas_srotg_batched(rocblas_handle handle,
                                      rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_batched_impl(handle, a, b, c, s, batch_count);
 }
 catch(...)
@@ -164,6 +165,7 @@ rocblas_status rocblas_drotg_batched(rocblas_handle handle,
                                      rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_batched_impl(handle, a, b, c, s, batch_count);
 }
 catch(...)
@@ -179,6 +181,7 @@ rocblas_status rocblas_crotg_batched(rocblas_handle               handle,
                                      rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_batched_impl(handle, a, b, c, s, batch_count);
 }
 catch(...)
@@ -194,6 +197,7 @@ rocblas_status rocblas_zrotg_batched(rocblas_handle                handle,
                                      rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_batched_impl(handle, a, b, c, s, batch_count);
 }
 catch(...)
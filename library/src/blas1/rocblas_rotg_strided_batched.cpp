@@ -186,6 +186,7 @@ rocblas_status rocblas_srotg_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_strided_batched_impl(
         handle, a, stride_a, b, stride_b, c, stride_c, s, stride_s, batch_count);
 }
@@ -206,6 +207,7 @@ rocblas_status rocblas_drotg_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_strided_batched_impl(
         handle, a, stride_a, b, stride_b, c, stride_c, s, stride_s, batch_count);
 }
@@ -226,6 +228,7 @@ rocblas_status rocblas_crotg_strided_batched(rocblas_handle         handle,
                                              rocblas_int            batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_strided_batched_impl(
         handle, a, stride_a, b, stride_b, c, stride_c, s, stride_s, batch_count);
 }
@@ -246,6 +249,7 @@ rocblas_status rocblas_zrotg_strided_batched(rocblas_handle          handle,
                                              rocblas_int             batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotg_strided_batched_impl(
         handle, a, stride_a, b, stride_b, c, stride_c, s, stride_s, batch_count);
 }
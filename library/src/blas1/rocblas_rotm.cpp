@@ -150,6 +150,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_srotm(rocblas_handle handle,
                                             const float*   param)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotm_impl(handle, n, x, incx, y, incy, param);
 }
 catch(...)
@@ -166,6 +167,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_drotm(rocblas_handle handle,
                                             const double*  param)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotm_impl(handle, n, x, incx, y, incy, param);
 }
 catch(...)
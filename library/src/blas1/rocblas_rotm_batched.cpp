@@ -162,6 +162,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_srotm_batched(rocblas_handle     handle,
                                                     rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotm_batched_impl(handle, n, x, incx, y, incy, param, batch_count);
 }
 catch(...)
@@ -179,6 +180,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_drotm_batched(rocblas_handle      handle,
                                                     rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotm_batched_impl(handle, n, x, incx, y, incy, param, batch_count);
 }
 catch(...)
@@ -198,6 +198,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_srotm_strided_batched(rocblas_handle handl
                                                             rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotm_strided_batched_impl(
         handle, n, x, incx, stride_x, y, incy, stride_y, param, stride_param, batch_count);
 }
@@ -219,6 +220,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_drotm_strided_batched(rocblas_handle handl
                                                             rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotm_strided_batched_impl(
         handle, n, x, incx, stride_x, y, incy, stride_y, param, stride_param, batch_count);
 }
@@ -129,6 +129,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_srotmg(
     rocblas_handle handle, float* d1, float* d2, float* x1, const float* y1, float* param)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotmg_impl(handle, d1, d2, x1, y1, param);
 }
 catch(...)
@@ -140,6 +141,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_drotmg(
     rocblas_handle handle, double* d1, double* d2, double* x1, const double* y1, double* param)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotmg_impl(handle, d1, d2, x1, y1, param);
 }
 catch(...)
@@ -144,6 +144,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_srotmg_batched(rocblas_handle     handle,
                                                      rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotmg_batched_impl(handle, d1, d2, x1, y1, param, batch_count);
 }
 catch(...)
@@ -160,6 +161,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_drotmg_batched(rocblas_handle      handle,
                                                      rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotmg_batched_impl(handle, d1, d2, x1, y1, param, batch_count);
 }
 catch(...)
@@ -202,6 +202,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_srotmg_strided_batched(rocblas_handle hand
                                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotmg_strided_batched_impl(handle,
                                               d1,
                                               stride_d1,
@@ -234,6 +235,7 @@ ROCBLAS_EXPORT rocblas_status rocblas_drotmg_strided_batched(rocblas_handle hand
                                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rotmg_strided_batched_impl(handle,
                                               d1,
                                               stride_d1,
@@ -125,6 +125,7 @@ rocblas_status rocblas_sscal(
     rocblas_handle handle, rocblas_int n, const float* alpha, float* x, rocblas_int incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx);
 }
 catch(...)
@@ -136,6 +137,7 @@ rocblas_status rocblas_dscal(
     rocblas_handle handle, rocblas_int n, const double* alpha, double* x, rocblas_int incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx);
 }
 catch(...)
@@ -150,6 +152,7 @@ rocblas_status rocblas_cscal(rocblas_handle               handle,
                              rocblas_int                  incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx);
 }
 catch(...)
@@ -164,6 +167,7 @@ rocblas_status rocblas_zscal(rocblas_handle                handle,
                              rocblas_int                   incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx);
 }
 catch(...)
@@ -179,6 +183,7 @@ rocblas_status rocblas_csscal(rocblas_handle         handle,
                               rocblas_int            incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx);
 }
 catch(...)
@@ -193,6 +198,7 @@ rocblas_status rocblas_zdscal(rocblas_handle          handle,
                               rocblas_int             incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx);
 }
 catch(...)
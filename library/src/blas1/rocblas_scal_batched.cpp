@@ -156,6 +156,7 @@ rocblas_status rocblas_sscal_batched(rocblas_handle handle,
                                      rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_batched_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx, batch_count);
 }
 catch(...)
@@ -171,6 +172,7 @@ rocblas_status rocblas_dscal_batched(rocblas_handle handle,
                                      rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_batched_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx, batch_count);
 }
 catch(...)
@@ -186,6 +188,7 @@ rocblas_status rocblas_cscal_batched(rocblas_handle               handle,
                                      rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_batched_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx, batch_count);
 }
 catch(...)
@@ -201,6 +204,7 @@ rocblas_status rocblas_zscal_batched(rocblas_handle                handle,
                                      rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_batched_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx, batch_count);
 }
 catch(...)
@@ -217,6 +221,7 @@ rocblas_status rocblas_csscal_batched(rocblas_handle               handle,
                                       rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_batched_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx, batch_count);
 }
 catch(...)
@@ -232,6 +237,7 @@ rocblas_status rocblas_zdscal_batched(rocblas_handle                handle,
                                       rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_batched_impl<ROCBLAS_SCAL_NB>(handle, n, alpha, x, incx, batch_count);
 }
 catch(...)
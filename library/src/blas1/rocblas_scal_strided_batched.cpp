@@ -172,6 +172,7 @@ rocblas_status rocblas_sscal_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_strided_batched_impl<ROCBLAS_SCAL_NB>(
         handle, n, alpha, x, incx, stridex, batch_count);
 }
@@ -189,6 +190,7 @@ rocblas_status rocblas_dscal_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_strided_batched_impl<ROCBLAS_SCAL_NB>(
         handle, n, alpha, x, incx, stridex, batch_count);
 }
@@ -206,6 +208,7 @@ rocblas_status rocblas_cscal_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_strided_batched_impl<ROCBLAS_SCAL_NB>(
         handle, n, alpha, x, incx, stridex, batch_count);
 }
@@ -223,6 +226,7 @@ rocblas_status rocblas_zscal_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_strided_batched_impl<ROCBLAS_SCAL_NB>(
         handle, n, alpha, x, incx, stridex, batch_count);
 }
@@ -241,6 +245,7 @@ rocblas_status rocblas_csscal_strided_batched(rocblas_handle         handle,
                                               rocblas_int            batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_strided_batched_impl<ROCBLAS_SCAL_NB>(
         handle, n, alpha, x, incx, stridex, batch_count);
 }
@@ -258,6 +263,7 @@ rocblas_status rocblas_zdscal_strided_batched(rocblas_handle          handle,
                                               rocblas_int             batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_strided_batched_impl<ROCBLAS_SCAL_NB>(
         handle, n, alpha, x, incx, stridex, batch_count);
 }
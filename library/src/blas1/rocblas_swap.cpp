@@ -138,6 +138,7 @@ rocblas_status rocblas_sswap(
     rocblas_handle handle, rocblas_int n, float* x, rocblas_int incx, float* y, rocblas_int incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_impl<ROCBLAS_SWAP_NB>(handle, n, x, incx, y, incy);
 }
 catch(...)
@@ -149,6 +150,7 @@ rocblas_status rocblas_dswap(
     rocblas_handle handle, rocblas_int n, double* x, rocblas_int incx, double* y, rocblas_int incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_impl<ROCBLAS_SWAP_NB>(handle, n, x, incx, y, incy);
 }
 catch(...)
@@ -164,6 +166,7 @@ rocblas_status rocblas_cswap(rocblas_handle         handle,
                              rocblas_int            incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_impl<ROCBLAS_SWAP_NB>(handle, n, x, incx, y, incy);
 }
 catch(...)
@@ -179,6 +182,7 @@ rocblas_status rocblas_zswap(rocblas_handle          handle,
                              rocblas_int             incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_impl<ROCBLAS_SWAP_NB>(handle, n, x, incx, y, incy);
 }
 catch(...)
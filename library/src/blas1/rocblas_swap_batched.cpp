@@ -158,6 +158,7 @@ rocblas_status rocblas_sswap_batched(rocblas_handle handle,
                                      rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_batched_impl(handle, n, x, incx, y, incy, batch_count);
 }
 catch(...)
@@ -174,6 +175,7 @@ rocblas_status rocblas_dswap_batched(rocblas_handle handle,
                                      rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_batched_impl(handle, n, x, incx, y, incy, batch_count);
 }
 catch(...)
@@ -190,6 +192,7 @@ rocblas_status rocblas_cswap_batched(rocblas_handle               handle,
                                      rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_batched_impl(handle, n, x, incx, y, incy, batch_count);
 }
 catch(...)
@@ -206,6 +209,7 @@ rocblas_status rocblas_zswap_batched(rocblas_handle                handle,
                                      rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_batched_impl(handle, n, x, incx, y, incy, batch_count);
 }
 catch(...)
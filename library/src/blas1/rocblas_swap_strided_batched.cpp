@@ -178,6 +178,7 @@ rocblas_status rocblas_sswap_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_strided_batched_impl(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count);
 }
@@ -197,6 +198,7 @@ rocblas_status rocblas_dswap_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_strided_batched_impl(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count);
 }
@@ -216,6 +218,7 @@ rocblas_status rocblas_cswap_strided_batched(rocblas_handle         handle,
                                              rocblas_int            batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_strided_batched_impl(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count);
 }
@@ -235,6 +238,7 @@ rocblas_status rocblas_zswap_strided_batched(rocblas_handle          handle,
                                              rocblas_int             batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_swap_strided_batched_impl(
         handle, n, x, incx, stridex, y, incy, stridey, batch_count);
 }
@@ -256,6 +256,7 @@ rocblas_status rocblas_sgbmv(rocblas_handle    handle,
                              rocblas_int       incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_impl(handle, transA, m, n, kl, ku, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
@@ -279,6 +280,7 @@ rocblas_status rocblas_dgbmv(rocblas_handle    handle,
                              rocblas_int       incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_impl(handle, transA, m, n, kl, ku, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
@@ -302,6 +304,7 @@ rocblas_status rocblas_cgbmv(rocblas_handle               handle,
                              rocblas_int                  incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_impl(handle, transA, m, n, kl, ku, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
@@ -325,6 +328,7 @@ rocblas_status rocblas_zgbmv(rocblas_handle                handle,
                              rocblas_int                   incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_impl(handle, transA, m, n, kl, ku, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
@@ -264,6 +264,7 @@ rocblas_status rocblas_sgbmv_batched(rocblas_handle     handle,
                                      rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_batched_impl(
         handle, transA, m, n, kl, ku, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
@@ -289,6 +290,7 @@ rocblas_status rocblas_dgbmv_batched(rocblas_handle      handle,
                                      rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_batched_impl(
         handle, transA, m, n, kl, ku, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
@@ -314,6 +316,7 @@ rocblas_status rocblas_cgbmv_batched(rocblas_handle                     handle,
                                      rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_batched_impl(
         handle, transA, m, n, kl, ku, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
@@ -339,6 +342,7 @@ rocblas_status rocblas_zgbmv_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_batched_impl(
         handle, transA, m, n, kl, ku, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
@@ -285,6 +285,7 @@ rocblas_status rocblas_sgbmv_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_strided_batched_impl(handle,
                                              transA,
                                              m,
@@ -329,6 +330,7 @@ rocblas_status rocblas_dgbmv_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_strided_batched_impl(handle,
                                              transA,
                                              m,
@@ -373,6 +375,7 @@ rocblas_status rocblas_cgbmv_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_strided_batched_impl(handle,
                                              transA,
                                              m,
@@ -417,6 +420,7 @@ rocblas_status rocblas_zgbmv_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gbmv_strided_batched_impl(handle,
                                              transA,
                                              m,
@@ -233,6 +233,7 @@ rocblas_status rocblas_sgemv(rocblas_handle    handle,
                              rocblas_int       incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_impl(handle, transA, m, n, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
@@ -254,6 +255,7 @@ rocblas_status rocblas_dgemv(rocblas_handle    handle,
                              rocblas_int       incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_impl(handle, transA, m, n, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
@@ -275,6 +277,7 @@ rocblas_status rocblas_cgemv(rocblas_handle               handle,
                              rocblas_int                  incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_impl(handle, transA, m, n, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
@@ -296,6 +299,7 @@ rocblas_status rocblas_zgemv(rocblas_handle                handle,
                              rocblas_int                   incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_impl(handle, transA, m, n, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
@@ -261,6 +261,7 @@ rocblas_status rocblas_sgemv_batched(rocblas_handle     handle,
                                      rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_batched_impl(
         handle, transA, m, n, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
@@ -284,6 +285,7 @@ rocblas_status rocblas_dgemv_batched(rocblas_handle      handle,
                                      rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_batched_impl(
         handle, transA, m, n, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
@@ -307,6 +309,7 @@ rocblas_status rocblas_cgemv_batched(rocblas_handle                     handle,
                                      rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_batched_impl(
         handle, transA, m, n, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
@@ -330,6 +333,7 @@ rocblas_status rocblas_zgemv_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_batched_impl(
         handle, transA, m, n, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
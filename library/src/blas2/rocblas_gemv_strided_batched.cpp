@@ -285,6 +285,7 @@ rocblas_status rocblas_sgemv_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_strided_batched_impl(handle,
                                              transA,
                                              m,
@@ -325,6 +326,7 @@ rocblas_status rocblas_dgemv_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_strided_batched_impl(handle,
                                              transA,
                                              m,
@@ -365,6 +367,7 @@ rocblas_status rocblas_cgemv_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_strided_batched_impl(handle,
                                              transA,
                                              m,
@@ -405,6 +408,7 @@ rocblas_status rocblas_zgemv_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemv_strided_batched_impl(handle,
                                              transA,
                                              m,
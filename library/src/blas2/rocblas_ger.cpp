@@ -213,6 +213,7 @@ extern "C" {
                                  rocblas_int    lda)                                       \
     try                                                                                    \
     {                                                                                      \
+        rocblas_call_scope call_scope(handle, __func__);                                   \
         return rocblas_ger_impl<CONJ_, T_>(handle, m, n, alpha, x, incx, y, incy, A, lda); \
     }                                                                                      \
     catch(...)                                                                             \
@@ -225,6 +225,7 @@ extern "C" {
                                  rocblas_int     batch_count)            \
     try                                                                  \
     {                                                                    \
+        rocblas_call_scope call_scope(handle, __func__);                 \
         return rocblas_ger_batched_impl<CONJ_, T_>(                      \
             handle, m, n, alpha, x, incx, y, incy, A, lda, batch_count); \
     }                                                                    \
@@ -283,6 +283,7 @@ extern "C" {
                                  rocblas_int    batch_count)             \
     try                                                                  \
     {                                                                    \
+        rocblas_call_scope call_scope(handle, __func__);                 \
         return rocblas_ger_strided_batched_impl<CONJ_, T_>(handle,       \
                                                            m,            \
                                                            n,            \
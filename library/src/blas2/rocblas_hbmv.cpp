@@ -200,6 +200,7 @@ rocblas_status rocblas_chbmv(rocblas_handle               handle,
                              rocblas_int                  incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hbmv_impl(handle, uplo, n, k, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
@@ -221,6 +222,7 @@ rocblas_status rocblas_zhbmv(rocblas_handle                handle,
                              rocblas_int                   incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hbmv_impl(handle, uplo, n, k, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
@@ -239,6 +239,7 @@ rocblas_status rocblas_chbmv_batched(rocblas_handle                     handle,
                                      rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hbmv_batched_impl(
         handle, uplo, n, k, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
@@ -262,6 +263,7 @@ rocblas_status rocblas_zhbmv_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hbmv_batched_impl(
         handle, uplo, n, k, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
@@ -260,6 +260,7 @@ rocblas_status rocblas_chbmv_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hbmv_strided_batched_impl(handle,
                                              uplo,
                                              n,
@@ -300,6 +301,7 @@ rocblas_status rocblas_zhbmv_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hbmv_strided_batched_impl(handle,
                                              uplo,
                                              n,
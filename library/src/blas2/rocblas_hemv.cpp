@@ -224,6 +224,7 @@ rocblas_status rocblas_chemv(rocblas_handle               handle,
                              rocblas_int                  incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hemv_impl(handle, uplo, n, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
@@ -244,6 +245,7 @@ rocblas_status rocblas_zhemv(rocblas_handle                handle,
                              rocblas_int                   incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hemv_impl(handle, uplo, n, alpha, A, lda, x, incx, beta, y, incy);
 }
 catch(...)
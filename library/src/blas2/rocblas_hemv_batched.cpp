@@ -248,6 +248,7 @@ rocblas_status rocblas_chemv_batched(rocblas_handle                     handle,
                                      rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hemv_batched_impl(
         handle, uplo, n, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
@@ -270,6 +271,7 @@ rocblas_status rocblas_zhemv_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hemv_batched_impl(
         handle, uplo, n, alpha, A, lda, x, incx, beta, y, incy, batch_count);
 }
@@ -271,6 +271,7 @@ rocblas_status rocblas_chemv_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hemv_strided_batched_impl(handle,
                                              uplo,
                                              n,
@@ -309,6 +310,7 @@ rocblas_status rocblas_zhemv_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hemv_strided_batched_impl(handle,
                                              uplo,
                                              n,
@@ -196,6 +196,7 @@ rocblas_status rocblas_cher(rocblas_handle               handle,
                             rocblas_int                  lda)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her_impl(handle, uplo, n, alpha, x, incx, A, lda);
 }
 catch(...)
@@ -213,6 +214,7 @@ rocblas_status rocblas_zher(rocblas_handle                handle,
                             rocblas_int                   lda)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her_impl(handle, uplo, n, alpha, x, incx, A, lda);
 }
 catch(...)
@@ -222,6 +222,7 @@ rocblas_status rocblas_cher2(rocblas_handle               handle,
                              rocblas_int                  lda)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her2_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda);
 }
 catch(...)
@@ -241,6 +242,7 @@ rocblas_status rocblas_zher2(rocblas_handle                handle,
                              rocblas_int                   lda)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her2_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda);
 }
 catch(...)
@@ -229,6 +229,7 @@ rocblas_status rocblas_cher2_batched(rocblas_handle                     handle,
                                      rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her2_batched_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda, batch_count);
 }
 catch(...)
@@ -249,6 +250,7 @@ rocblas_status rocblas_zher2_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her2_batched_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda, batch_count);
 }
 catch(...)
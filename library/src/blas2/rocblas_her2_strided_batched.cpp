@@ -250,6 +250,7 @@ rocblas_status rocblas_cher2_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her2_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, y, incy, stridey, A, lda, strideA, batch_count);
 }
@@ -274,6 +275,7 @@ rocblas_status rocblas_zher2_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her2_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, y, incy, stridey, A, lda, strideA, batch_count);
 }
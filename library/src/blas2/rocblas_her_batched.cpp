@@ -215,6 +215,7 @@ rocblas_status rocblas_cher_batched(rocblas_handle                     handle,
                                     rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her_batched_impl(handle, uplo, n, alpha, x, incx, A, lda, batch_count);
 }
 catch(...)
@@ -233,6 +234,7 @@ rocblas_status rocblas_zher_batched(rocblas_handle                      handle,
                                     rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her_batched_impl(handle, uplo, n, alpha, x, incx, A, lda, batch_count);
 }
 catch(...)
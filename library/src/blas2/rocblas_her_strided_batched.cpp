@@ -218,6 +218,7 @@ rocblas_status rocblas_cher_strided_batched(rocblas_handle               handle,
                                             rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, A, lda, strideA, batch_count);
 }
@@ -239,6 +240,7 @@ rocblas_status rocblas_zher_strided_batched(rocblas_handle                handle
                                             rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_her_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, A, lda, strideA, batch_count);
 }
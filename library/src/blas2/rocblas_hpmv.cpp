@@ -213,6 +213,7 @@ rocblas_status rocblas_chpmv(rocblas_handle               handle,
                              rocblas_int                  incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpmv_impl(handle, uplo, n, alpha, AP, x, incx, beta, y, incy);
 }
 catch(...)
@@ -232,6 +233,7 @@ rocblas_status rocblas_zhpmv(rocblas_handle                handle,
                              rocblas_int                   incy)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpmv_impl(handle, uplo, n, alpha, AP, x, incx, beta, y, incy);
 }
 catch(...)
@@ -219,6 +219,7 @@ rocblas_status rocblas_chpmv_batched(rocblas_handle                     handle,
                                      rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpmv_batched_impl(
         handle, uplo, n, alpha, AP, x, incx, beta, y, incy, batch_count);
 }
@@ -240,6 +241,7 @@ rocblas_status rocblas_zhpmv_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpmv_batched_impl(
         handle, uplo, n, alpha, AP, x, incx, beta, y, incy, batch_count);
 }
@@ -240,6 +240,7 @@ rocblas_status rocblas_chpmv_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpmv_strided_batched_impl(handle,
                                              uplo,
                                              n,
@@ -276,6 +277,7 @@ rocblas_status rocblas_zhpmv_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpmv_strided_batched_impl(handle,
                                              uplo,
                                              n,
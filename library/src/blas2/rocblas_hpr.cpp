@@ -175,6 +175,7 @@ rocblas_status rocblas_chpr(rocblas_handle               handle,
                             rocblas_float_complex*       AP)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpr_impl(handle, uplo, n, alpha, x, incx, AP);
 }
 catch(...)
@@ -191,6 +192,7 @@ rocblas_status rocblas_zhpr(rocblas_handle                handle,
                             rocblas_double_complex*       AP)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpr_impl(handle, uplo, n, alpha, x, incx, AP);
 }
 catch(...)
@@ -209,6 +209,7 @@ rocblas_status rocblas_chpr2(rocblas_handle               handle,
                              rocblas_float_complex*       AP)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpr2_impl(handle, uplo, n, alpha, x, incx, y, incy, AP);
 }
 catch(...)
@@ -227,6 +228,7 @@ rocblas_status rocblas_zhpr2(rocblas_handle                handle,
                              rocblas_double_complex*       AP)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpr2_impl(handle, uplo, n, alpha, x, incx, y, incy, AP);
 }
 catch(...)
@@ -237,6 +237,7 @@ rocblas_status rocblas_chpr2_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpr2_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, y, incy, stridey, AP, strideA, batch_count);
 }
@@ -260,6 +261,7 @@ rocblas_status rocblas_zhpr2_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpr2_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, y, incy, stridey, AP, strideA, batch_count);
 }
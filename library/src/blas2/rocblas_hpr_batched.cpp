@@ -190,6 +190,7 @@ rocblas_status rocblas_chpr_batched(rocblas_handle                     handle,
                                     rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpr_batched_impl(handle, uplo, n, alpha, x, incx, AP, batch_count);
 }
 catch(...)
@@ -207,6 +208,7 @@ rocblas_status rocblas_zhpr_batched(rocblas_handle                      handle,
                                     rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpr_batched_impl(handle, uplo, n, alpha, x, incx, AP, batch_count);
 }
 catch(...)
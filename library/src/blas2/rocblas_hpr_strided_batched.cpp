@@ -184,6 +184,7 @@ rocblas_status rocblas_chpr_strided_batched(rocblas_handle               handle,
                                             rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpr_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, AP, strideA, batch_count);
 }
@@ -204,6 +205,7 @@ rocblas_status rocblas_zhpr_strided_batched(rocblas_handle                handle
                                             rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_hpr_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, AP, strideA, batch_count);
 }
@@ -204,6 +204,7 @@ extern "C" {
                                  rocblas_int    incy)                                            \
     try                                                                                          \
     {                                                                                            \
+        rocblas_call_scope call_scope(handle, __func__);                                         \
         return rocblas_sbmv_impl<T_>(handle, uplo, n, k, alpha, A, lda, x, incx, beta, y, incy); \
     }                                                                                            \
     catch(...)                                                                                   \
@@ -187,6 +187,7 @@ extern "C" {
                                  rocblas_int    incy)                                    \
     try                                                                                  \
     {                                                                                    \
+        rocblas_call_scope call_scope(handle, __func__);                                 \
         return rocblas_spmv_impl<T_>(handle, uplo, n, alpha, A, x, incx, beta, y, incy); \
     }                                                                                    \
     catch(...)                                                                           \
@@ -179,6 +179,7 @@ rocblas_status rocblas_sspr(rocblas_handle handle,
                             float*         AP)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_impl(handle, uplo, n, alpha, x, incx, AP);
 }
 catch(...)
@@ -195,6 +196,7 @@ rocblas_status rocblas_dspr(rocblas_handle handle,
                             double*        AP)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_impl(handle, uplo, n, alpha, x, incx, AP);
 }
 catch(...)
@@ -211,6 +213,7 @@ rocblas_status rocblas_cspr(rocblas_handle               handle,
                             rocblas_float_complex*       AP)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_impl(handle, uplo, n, alpha, x, incx, AP);
 }
 catch(...)
@@ -227,6 +230,7 @@ rocblas_status rocblas_zspr(rocblas_handle                handle,
                             rocblas_double_complex*       AP)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_impl(handle, uplo, n, alpha, x, incx, AP);
 }
 catch(...)
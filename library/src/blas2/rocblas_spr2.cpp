@@ -209,6 +209,7 @@ rocblas_status rocblas_sspr2(rocblas_handle handle,
                              float*         AP)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr2_impl(handle, uplo, n, alpha, x, incx, y, incy, AP);
 }
 catch(...)
@@ -227,6 +228,7 @@ rocblas_status rocblas_dspr2(rocblas_handle handle,
                              double*        AP)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr2_impl(handle, uplo, n, alpha, x, incx, y, incy, AP);
 }
 catch(...)
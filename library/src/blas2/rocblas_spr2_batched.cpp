@@ -216,6 +216,7 @@ rocblas_status rocblas_sspr2_batched(rocblas_handle     handle,
                                      rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr2_batched_impl(handle, uplo, n, alpha, x, incx, y, incy, AP, batch_count);
 }
 catch(...)
@@ -235,6 +236,7 @@ rocblas_status rocblas_dspr2_batched(rocblas_handle      handle,
                                      rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr2_batched_impl(handle, uplo, n, alpha, x, incx, y, incy, AP, batch_count);
 }
 catch(...)
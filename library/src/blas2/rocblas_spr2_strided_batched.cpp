@@ -235,6 +235,7 @@ rocblas_status rocblas_sspr2_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr2_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stride_x, y, incy, stride_y, AP, strideA, batch_count);
 }
@@ -258,6 +259,7 @@ rocblas_status rocblas_dspr2_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr2_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stride_x, y, incy, stride_y, AP, strideA, batch_count);
 }
@@ -194,6 +194,7 @@ rocblas_status rocblas_sspr_batched(rocblas_handle     handle,
                                     rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_batched_impl(handle, uplo, n, alpha, x, incx, AP, batch_count);
 }
 catch(...)
@@ -211,6 +212,7 @@ rocblas_status rocblas_dspr_batched(rocblas_handle      handle,
                                     rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_batched_impl(handle, uplo, n, alpha, x, incx, AP, batch_count);
 }
 catch(...)
@@ -228,6 +230,7 @@ rocblas_status rocblas_cspr_batched(rocblas_handle                     handle,
                                     rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_batched_impl(handle, uplo, n, alpha, x, incx, AP, batch_count);
 }
 catch(...)
@@ -245,6 +248,7 @@ rocblas_status rocblas_zspr_batched(rocblas_handle                      handle,
                                     rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_batched_impl(handle, uplo, n, alpha, x, incx, AP, batch_count);
 }
 catch(...)
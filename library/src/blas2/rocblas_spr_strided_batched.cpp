@@ -189,6 +189,7 @@ rocblas_status rocblas_sspr_strided_batched(rocblas_handle handle,
                                             rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, AP, strideA, batch_count);
 }
@@ -209,6 +210,7 @@ rocblas_status rocblas_dspr_strided_batched(rocblas_handle handle,
                                             rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, AP, strideA, batch_count);
 }
@@ -229,6 +231,7 @@ rocblas_status rocblas_cspr_strided_batched(rocblas_handle               handle,
                                             rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, AP, strideA, batch_count);
 }
@@ -249,6 +252,7 @@ rocblas_status rocblas_zspr_strided_batched(rocblas_handle                handle
                                             rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_spr_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stridex, AP, strideA, batch_count);
 }
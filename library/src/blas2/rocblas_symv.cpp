@@ -231,6 +231,7 @@ extern "C" {
                                  rocblas_int    incy)                                         \
     try                                                                                       \
     {                                                                                         \
+        rocblas_call_scope call_scope(handle, __func__);                                      \
         return rocblas_symv_impl<T_>(handle, uplo, n, alpha, A, lda, x, incx, beta, y, incy); \
     }                                                                                         \
     catch(...)                                                                                \
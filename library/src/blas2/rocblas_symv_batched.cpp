@@ -258,6 +258,7 @@ extern "C" {
                                  rocblas_int     batch_count)                     \
     try                                                                           \
     {                                                                             \
+        rocblas_call_scope call_scope(handle, __func__);                          \
         return rocblas_symv_batched_impl<T_>(                                     \
             handle, uplo, n, alpha, A, lda, x, incx, beta, y, incy, batch_count); \
     }                                                                             \
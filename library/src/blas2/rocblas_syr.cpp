@@ -177,6 +177,7 @@ extern "C" {
                                  rocblas_int    lda)                      \
     try                                                                   \
     {                                                                     \
+        rocblas_call_scope call_scope(handle, __func__);                  \
         return rocblas_syr_impl(handle, uplo, n, alpha, x, incx, A, lda); \
     }                                                                     \
     catch(...)                                                            \
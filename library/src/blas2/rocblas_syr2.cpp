@@ -226,6 +226,7 @@ rocblas_status rocblas_ssyr2(rocblas_handle handle,
                              rocblas_int    lda)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda);
 }
 catch(...)
@@ -245,6 +246,7 @@ rocblas_status rocblas_dsyr2(rocblas_handle handle,
                              rocblas_int    lda)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda);
 }
 catch(...)
@@ -264,6 +266,7 @@ rocblas_status rocblas_csyr2(rocblas_handle               handle,
                              rocblas_int                  lda)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda);
 }
 catch(...)
@@ -283,6 +286,7 @@ rocblas_status rocblas_zsyr2(rocblas_handle                handle,
                              rocblas_int                   lda)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda);
 }
 catch(...)
@@ -233,6 +233,7 @@ rocblas_status rocblas_ssyr2_batched(rocblas_handle     handle,
                                      rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_batched_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda, batch_count);
 }
 catch(...)
@@ -253,6 +254,7 @@ rocblas_status rocblas_dsyr2_batched(rocblas_handle      handle,
                                      rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_batched_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda, batch_count);
 }
 catch(...)
@@ -273,6 +275,7 @@ rocblas_status rocblas_csyr2_batched(rocblas_handle                     handle,
                                      rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_batched_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda, batch_count);
 }
 catch(...)
@@ -293,6 +296,7 @@ rocblas_status rocblas_zsyr2_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_batched_impl(handle, uplo, n, alpha, x, incx, y, incy, A, lda, batch_count);
 }
 catch(...)
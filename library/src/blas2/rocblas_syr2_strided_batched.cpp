@@ -255,6 +255,7 @@ rocblas_status rocblas_ssyr2_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stride_x, y, incy, stride_y, A, lda, strideA, batch_count);
 }
@@ -279,6 +280,7 @@ rocblas_status rocblas_dsyr2_strided_batched(rocblas_handle handle,
                                              rocblas_int    batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stride_x, y, incy, stride_y, A, lda, strideA, batch_count);
 }
@@ -303,6 +305,7 @@ rocblas_status rocblas_csyr2_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stride_x, y, incy, stride_y, A, lda, strideA, batch_count);
 }
@@ -327,6 +330,7 @@ rocblas_status rocblas_zsyr2_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_syr2_strided_batched_impl(
         handle, uplo, n, alpha, x, incx, stride_x, y, incy, stride_y, A, lda, strideA, batch_count);
 }
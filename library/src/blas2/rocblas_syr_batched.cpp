@@ -186,6 +186,7 @@ extern "C" {
                                  rocblas_int     batch_count)            \
     try                                                                  \
     {                                                                    \
+        rocblas_call_scope call_scope(handle, __func__);                 \
         return rocblas_syr_batched_impl(                                 \
             handle, uplo, n, alpha, x, 0, incx, A, 0, lda, batch_count); \
     }                                                                    \
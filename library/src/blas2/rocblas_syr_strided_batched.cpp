@@ -201,6 +201,7 @@ extern "C" {
                                  rocblas_int    batch_count)                               \
     try                                                                                    \
     {                                                                                      \
+        rocblas_call_scope call_scope(handle, __func__);                                   \
         return rocblas_syr_strided_batched_impl(                                           \
             handle, uplo, n, alpha, x, 0, incx, stridex, A, 0, lda, strideA, batch_count); \
     }                                                                                      \
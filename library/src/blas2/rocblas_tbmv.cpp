@@ -194,6 +194,7 @@ rocblas_status rocblas_stbmv(rocblas_handle    handle,
                              rocblas_int       incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_impl(handle, uplo, transA, diag, m, k, A, lda, x, incx);
 }
 catch(...)
@@ -213,6 +214,7 @@ rocblas_status rocblas_dtbmv(rocblas_handle    handle,
                              rocblas_int       incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_impl(handle, uplo, transA, diag, m, k, A, lda, x, incx);
 }
 catch(...)
@@ -232,6 +234,7 @@ rocblas_status rocblas_ctbmv(rocblas_handle               handle,
                              rocblas_int                  incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_impl(handle, uplo, transA, diag, m, k, A, lda, x, incx);
 }
 catch(...)
@@ -251,6 +254,7 @@ rocblas_status rocblas_ztbmv(rocblas_handle                handle,
                              rocblas_int                   incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_impl(handle, uplo, transA, diag, m, k, A, lda, x, incx);
 }
 catch(...)
@@ -230,6 +230,7 @@ rocblas_status rocblas_stbmv_batched(rocblas_handle     handle,
                                      rocblas_int        incx,
                                      rocblas_int        batch_count)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_batched_impl(
         handle, uplo, transA, diag, m, k, A, lda, x, incx, batch_count);
 }
@@ -246,6 +247,7 @@ rocblas_status rocblas_dtbmv_batched(rocblas_handle      handle,
                                      rocblas_int         incx,
                                      rocblas_int         batch_count)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_batched_impl(
         handle, uplo, transA, diag, m, k, A, lda, x, incx, batch_count);
 }
@@ -262,6 +264,7 @@ rocblas_status rocblas_ctbmv_batched(rocblas_handle                     handle,
                                      rocblas_int                        incx,
                                      rocblas_int                        batch_count)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_batched_impl(
         handle, uplo, transA, diag, m, k, A, lda, x, incx, batch_count);
 }
@@ -278,6 +281,7 @@ rocblas_status rocblas_ztbmv_batched(rocblas_handle                      handle,
                                      rocblas_int                         incx,
                                      rocblas_int                         batch_count)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_batched_impl(
         handle, uplo, transA, diag, m, k, A, lda, x, incx, batch_count);
 }
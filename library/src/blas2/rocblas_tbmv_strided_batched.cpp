@@ -243,6 +243,7 @@ rocblas_status rocblas_stbmv_strided_batched(rocblas_handle    handle,
                                              rocblas_stride    stride_x,
                                              rocblas_int       batch_count)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_strided_batched_impl(
         handle, uplo, transA, diag, m, k, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -261,6 +262,7 @@ rocblas_status rocblas_dtbmv_strided_batched(rocblas_handle    handle,
                                              rocblas_stride    stride_x,
                                              rocblas_int       batch_count)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_strided_batched_impl(
         handle, uplo, transA, diag, m, k, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -279,6 +281,7 @@ rocblas_status rocblas_ctbmv_strided_batched(rocblas_handle               handle
                                              rocblas_stride               stride_x,
                                              rocblas_int                  batch_count)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_strided_batched_impl(
         handle, uplo, transA, diag, m, k, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -297,6 +300,7 @@ rocblas_status rocblas_ztbmv_strided_batched(rocblas_handle                handl
                                              rocblas_stride                stride_x,
                                              rocblas_int                   batch_count)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbmv_strided_batched_impl(
         handle, uplo, transA, diag, m, k, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -189,6 +189,7 @@ rocblas_status rocblas_stbsv(rocblas_handle    handle,
                              rocblas_int       incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_impl<STBSV_BLOCK>(handle, uplo, transA, diag, n, k, A, lda, x, incx);
 }
 catch(...)
@@ -208,6 +209,7 @@ rocblas_status rocblas_dtbsv(rocblas_handle    handle,
                              rocblas_int       incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_impl<DTBSV_BLOCK>(handle, uplo, transA, diag, n, k, A, lda, x, incx);
 }
 catch(...)
@@ -227,6 +229,7 @@ rocblas_status rocblas_ctbsv(rocblas_handle               handle,
                              rocblas_int                  incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_impl<STBSV_BLOCK>(handle, uplo, transA, diag, n, k, A, lda, x, incx);
 }
 catch(...)
@@ -246,6 +249,7 @@ rocblas_status rocblas_ztbsv(rocblas_handle                handle,
                              rocblas_int                   incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_impl<DTBSV_BLOCK>(handle, uplo, transA, diag, n, k, A, lda, x, incx);
 }
 catch(...)
@@ -206,6 +206,7 @@ rocblas_status rocblas_stbsv_batched(rocblas_handle     handle,
                                      rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_batched_impl<STBSV_BLOCK>(
         handle, uplo, transA, diag, n, k, A, lda, x, incx, batch_count);
 }
@@ -227,6 +228,7 @@ rocblas_status rocblas_dtbsv_batched(rocblas_handle      handle,
                                      rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_batched_impl<DTBSV_BLOCK>(
         handle, uplo, transA, diag, n, k, A, lda, x, incx, batch_count);
 }
@@ -248,6 +250,7 @@ rocblas_status rocblas_ctbsv_batched(rocblas_handle                     handle,
                                      rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_batched_impl<STBSV_BLOCK>(
         handle, uplo, transA, diag, n, k, A, lda, x, incx, batch_count);
 }
@@ -269,6 +272,7 @@ rocblas_status rocblas_ztbsv_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_batched_impl<DTBSV_BLOCK>(
         handle, uplo, transA, diag, n, k, A, lda, x, incx, batch_count);
 }
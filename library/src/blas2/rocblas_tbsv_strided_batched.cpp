@@ -234,6 +234,7 @@ rocblas_status rocblas_stbsv_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_strided_batched_impl<STBSV_BLOCK>(
         handle, uplo, transA, diag, n, k, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -257,6 +258,7 @@ rocblas_status rocblas_dtbsv_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_strided_batched_impl<DTBSV_BLOCK>(
         handle, uplo, transA, diag, n, k, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -280,6 +282,7 @@ rocblas_status rocblas_ctbsv_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_strided_batched_impl<STBSV_BLOCK>(
         handle, uplo, transA, diag, n, k, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -303,6 +306,7 @@ rocblas_status rocblas_ztbsv_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tbsv_strided_batched_impl<DTBSV_BLOCK>(
         handle, uplo, transA, diag, n, k, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -212,6 +212,7 @@ extern "C" {
                                  rocblas_int       incx)                     \
     try                                                                      \
     {                                                                        \
+        rocblas_call_scope call_scope(handle, __func__);                     \
         return rocblas_tpmv_impl(handle, uplo, transA, diag, m, A, x, incx); \
     }                                                                        \
     catch(...)                                                               \
@@ -228,6 +228,7 @@ extern "C" {
                                  rocblas_int       batch_count)                                   \
     try                                                                                           \
     {                                                                                             \
+        rocblas_call_scope call_scope(handle, __func__);                                          \
         return rocblas_tpmv_batched_impl(handle, uplo, transa, diag, m, a, x, incx, batch_count); \
     }                                                                                             \
     catch(...)                                                                                    \
@@ -242,6 +242,7 @@ extern "C" {
                                  rocblas_int       batch_count)                        \
     try                                                                                \
     {                                                                                  \
+        rocblas_call_scope call_scope(handle, __func__);                               \
         return rocblas_tpmv_strided_batched_impl(                                      \
             handle, uplo, transA, diag, m, A, stridea, x, incx, stridex, batch_count); \
     }                                                                                  \
@@ -175,6 +175,7 @@ rocblas_status rocblas_stpsv(rocblas_handle    handle,
                              rocblas_int       incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tpsv_impl<STPSV_BLOCK>(handle, uplo, transA, diag, n, AP, x, incx);
 }
 catch(...)
@@ -192,6 +193,7 @@ rocblas_status rocblas_dtpsv(rocblas_handle    handle,
                              rocblas_int       incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tpsv_impl<DTPSV_BLOCK>(handle, uplo, transA, diag, n, AP, x, incx);
 }
 catch(...)
@@ -209,6 +211,7 @@ rocblas_status rocblas_ctpsv(rocblas_handle               handle,
                              rocblas_int                  incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tpsv_impl<STPSV_BLOCK>(handle, uplo, transA, diag, n, AP, x, incx);
 }
 catch(...)
@@ -226,6 +229,7 @@ rocblas_status rocblas_ztpsv(rocblas_handle                handle,
                              rocblas_int                   incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     // return rocblas_status_success;
     return rocblas_tpsv_impl<DTPSV_BLOCK>(handle, uplo, transA, diag, n, AP, x, incx);
 }
@@ -189,6 +189,7 @@ rocblas_status rocblas_stpsv_batched(rocblas_handle     handle,
                                      rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tpsv_batched_impl<STPSV_BLOCK>(
         handle, uplo, transA, diag, n, AP, x, incx, batch_count);
 }
@@ -208,6 +209,7 @@ rocblas_status rocblas_dtpsv_batched(rocblas_handle      handle,
                                      rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tpsv_batched_impl<DTPSV_BLOCK>(
         handle, uplo, transA, diag, n, AP, x, incx, batch_count);
 }
@@ -228,6 +230,7 @@ rocblas_status rocblas_ctpsv_batched(rocblas_handle                     handle,
                                      rocblas_int batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tpsv_batched_impl<STPSV_BLOCK>(
         handle, uplo, transA, diag, n, AP, x, incx, batch_count);
 }
@@ -247,6 +250,7 @@ rocblas_status rocblas_ztpsv_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tpsv_batched_impl<DTPSV_BLOCK>(
         handle, uplo, transA, diag, n, AP, x, incx, batch_count);
 }
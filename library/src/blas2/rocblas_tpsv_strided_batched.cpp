@@ -204,6 +204,7 @@ rocblas_status rocblas_stpsv_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tpsv_strided_batched_impl<STPSV_BLOCK>(
         handle, uplo, transA, diag, n, AP, stride_A, x, incx, stride_x, batch_count);
 }
@@ -225,6 +226,7 @@ rocblas_status rocblas_dtpsv_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tpsv_strided_batched_impl<DTPSV_BLOCK>(
         handle, uplo, transA, diag, n, AP, stride_A, x, incx, stride_x, batch_count);
 }
@@ -246,6 +248,7 @@ rocblas_status rocblas_ctpsv_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tpsv_strided_batched_impl<STPSV_BLOCK>(
         handle, uplo, transA, diag, n, AP, stride_A, x, incx, stride_x, batch_count);
 }
@@ -267,6 +270,7 @@ rocblas_status rocblas_ztpsv_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_tpsv_strided_batched_impl<DTPSV_BLOCK>(
         handle, uplo, transA, diag, n, AP, stride_A, x, incx, stride_x, batch_count);
 }
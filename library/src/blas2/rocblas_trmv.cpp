@@ -218,6 +218,7 @@ extern "C" {
                                  rocblas_int       incx)                          \
     try                                                                           \
     {                                                                             \
+        rocblas_call_scope call_scope(handle, __func__);                          \
         return rocblas_trmv_impl(handle, uplo, transA, diag, m, A, lda, x, incx); \
     }                                                                             \
     catch(...)                                                                    \
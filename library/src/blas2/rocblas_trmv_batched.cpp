@@ -235,6 +235,7 @@ extern "C" {
                                  rocblas_int       batch_count)           \
     try                                                                   \
     {                                                                     \
+        rocblas_call_scope call_scope(handle, __func__);                  \
         return rocblas_trmv_batched_impl(                                 \
             handle, uplo, transa, diag, m, a, lda, x, incx, batch_count); \
     }                                                                     \
@@ -209,6 +209,7 @@ rocblas_status rocblas_strsv(rocblas_handle    handle,
                              rocblas_int       incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_impl<ROCBLAS_SDCTRSV_NB>(handle, uplo, transA, diag, m, A, lda, x, incx);
 }
 catch(...)
@@ -227,6 +228,7 @@ rocblas_status rocblas_dtrsv(rocblas_handle    handle,
                              rocblas_int       incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_impl<ROCBLAS_SDCTRSV_NB>(handle, uplo, transA, diag, m, A, lda, x, incx);
 }
 catch(...)
@@ -245,6 +247,7 @@ rocblas_status rocblas_ctrsv(rocblas_handle               handle,
                              rocblas_int                  incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_impl<ROCBLAS_SDCTRSV_NB>(handle, uplo, transA, diag, m, A, lda, x, incx);
 }
 catch(...)
@@ -263,6 +266,7 @@ rocblas_status rocblas_ztrsv(rocblas_handle                handle,
                              rocblas_int                   incx)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_impl<ROCBLAS_ZTRSV_NB>(handle, uplo, transA, diag, m, A, lda, x, incx);
 }
 catch(...)
@@ -226,6 +226,7 @@ rocblas_status rocblas_strsv_batched(rocblas_handle     handle,
                                      rocblas_int batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_batched_impl<ROCBLAS_SDCTRSV_NB>(
         handle, uplo, transA, diag, m, A, lda, x, incx, batch_count);
 }
@@ -246,6 +247,7 @@ rocblas_status rocblas_dtrsv_batched(rocblas_handle      handle,
                                      rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_batched_impl<ROCBLAS_SDCTRSV_NB>(
         handle, uplo, transA, diag, m, A, lda, x, incx, batch_count);
 }
@@ -267,6 +269,7 @@ rocblas_status rocblas_ctrsv_batched(rocblas_handle                     handle,
                                      rocblas_int batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_batched_impl<ROCBLAS_SDCTRSV_NB>(
         handle, uplo, transA, diag, m, A, lda, x, incx, batch_count);
 }
@@ -287,6 +290,7 @@ rocblas_status rocblas_ztrsv_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_batched_impl<ROCBLAS_ZTRSV_NB>(
         handle, uplo, transA, diag, m, A, lda, x, incx, batch_count);
 }
@@ -242,6 +242,7 @@ rocblas_status rocblas_strsv_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_strided_batched_impl<ROCBLAS_SDCTRSV_NB>(
         handle, uplo, transA, diag, m, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -264,6 +265,7 @@ rocblas_status rocblas_dtrsv_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_strided_batched_impl<ROCBLAS_SDCTRSV_NB>(
         handle, uplo, transA, diag, m, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -286,6 +288,7 @@ rocblas_status rocblas_ctrsv_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_strided_batched_impl<ROCBLAS_SDCTRSV_NB>(
         handle, uplo, transA, diag, m, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -308,6 +311,7 @@ rocblas_status rocblas_ztrsv_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsv_strided_batched_impl<ROCBLAS_ZTRSV_NB>(
         handle, uplo, transA, diag, m, A, lda, stride_A, x, incx, stride_x, batch_count);
 }
@@ -259,6 +259,7 @@ rocblas_status rocblas_hgemm(rocblas_handle      handle,
                              rocblas_int         ldc)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_impl(
         handle, trans_a, trans_b, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
@@ -283,6 +284,7 @@ rocblas_status rocblas_sgemm(rocblas_handle    handle,
                              rocblas_int       ldc)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_impl(
         handle, trans_a, trans_b, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
@@ -307,6 +309,7 @@ rocblas_status rocblas_dgemm(rocblas_handle    handle,
                              rocblas_int       ldc)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_impl(
         handle, trans_a, trans_b, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
@@ -331,6 +334,7 @@ rocblas_status rocblas_cgemm(rocblas_handle               handle,
                              rocblas_int                  ldc)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_impl(
         handle, trans_a, trans_b, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
@@ -355,6 +359,7 @@ rocblas_status rocblas_zgemm(rocblas_handle                handle,
                              rocblas_int                   ldc)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_impl(
         handle, trans_a, trans_b, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
@@ -385,6 +390,7 @@ rocblas_status rocblas_hgemm_kernel_name(rocblas_handle      handle,
                                          rocblas_stride      stride_c,
                                          rocblas_int         b_c)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_status_not_implemented;
 }
 
@@ -407,6 +413,7 @@ rocblas_status rocblas_sgemm_kernel_name(rocblas_handle    handle,
                                          rocblas_stride    stride_c,
                                          rocblas_int       b_c)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_status_not_implemented;
 }
 
@@ -429,6 +436,7 @@ rocblas_status rocblas_dgemm_kernel_name(rocblas_handle    handle,
                                          rocblas_stride    stride_c,
                                          rocblas_int       b_c)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_status_not_implemented;
 }
 
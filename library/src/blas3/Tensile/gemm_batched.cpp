@@ -262,6 +262,7 @@ rocblas_status rocblas_hgemm_batched(rocblas_handle            handle,
                                      rocblas_int               batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_batched_impl<rocblas_half>(handle,
                                                    trans_a,
                                                    trans_b,
@@ -300,6 +301,7 @@ rocblas_status rocblas_sgemm_batched(rocblas_handle     handle,
                                      rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_batched_impl<float>(handle,
                                             trans_a,
                                             trans_b,
@@ -338,6 +340,7 @@ rocblas_status rocblas_dgemm_batched(rocblas_handle      handle,
                                      rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_batched_impl<double>(handle,
                                              trans_a,
                                              trans_b,
@@ -376,6 +379,7 @@ rocblas_status rocblas_cgemm_batched(rocblas_handle                     handle,
                                      rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_batched_impl<rocblas_float_complex>(handle,
                                                             trans_a,
                                                             trans_b,
@@ -414,6 +418,7 @@ rocblas_status rocblas_zgemm_batched(rocblas_handle                      handle,
                                      rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_batched_impl<rocblas_double_complex>(handle,
                                                              trans_a,
                                                              trans_b,
@@ -295,6 +295,7 @@ rocblas_status rocblas_hgemm_strided_batched(rocblas_handle      handle,
                                              rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_strided_batched_impl(handle,
                                              trans_a,
                                              trans_b,
@@ -338,6 +339,7 @@ rocblas_status rocblas_sgemm_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_strided_batched_impl(handle,
                                              trans_a,
                                              trans_b,
@@ -382,6 +384,7 @@ rocblas_status rocblas_dgemm_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_strided_batched_impl(handle,
                                              trans_a,
                                              trans_b,
@@ -426,6 +429,7 @@ rocblas_status rocblas_cgemm_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_strided_batched_impl(handle,
                                              trans_a,
                                              trans_b,
@@ -470,6 +474,7 @@ rocblas_status rocblas_zgemm_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_strided_batched_impl(handle,
                                              trans_a,
                                              trans_b,
@@ -210,6 +210,7 @@ extern "C" {
                                  rocblas_int    ldc)                               \
     try                                                                            \
     {                                                                              \
+        rocblas_call_scope call_scope(handle, __func__);                           \
         return rocblas_dgmm_impl<T_>(handle, side, m, n, A, lda, x, incx, C, ldc); \
     }                                                                              \
     catch(...)                                                                     \
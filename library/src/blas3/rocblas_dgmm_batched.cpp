@@ -227,6 +227,7 @@ extern "C" {
                                  rocblas_int     ldc,                      \
                                  rocblas_int     batch_count)              \
     {                                                                      \
+        rocblas_call_scope call_scope(handle, __func__);                   \
         try                                                                \
         {                                                                  \
             return rocblas_dgmm_batched_impl<T_>(                          \
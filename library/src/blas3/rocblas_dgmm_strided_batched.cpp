@@ -249,6 +249,7 @@ extern "C" {
                                  rocblas_int    batch_count)       \
     try                                                            \
     {                                                              \
+        rocblas_call_scope call_scope(handle, __func__);           \
         return rocblas_dgmm_strided_batched_impl<T_>(handle,       \
                                                      side,         \
                                                      m,            \
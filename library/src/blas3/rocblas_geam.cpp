@@ -243,6 +243,7 @@ extern "C" {
                                  rocblas_int       ldc)                         \
     try                                                                         \
     {                                                                           \
+        rocblas_call_scope call_scope(handle, __func__);                        \
         return rocblas_geam_impl<T_>(                                           \
             handle, transA, transB, m, n, alpha, A, lda, beta, B, ldb, C, ldc); \
     }                                                                           \
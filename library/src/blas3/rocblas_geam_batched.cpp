@@ -248,6 +248,7 @@ extern "C" {
                                  rocblas_int       batch_count)                              \
     try                                                                                      \
     {                                                                                        \
+        rocblas_call_scope call_scope(handle, __func__);                                     \
         return rocblas_geam_batched_impl<T_>(                                                \
             handle, transA, transB, m, n, alpha, A, lda, beta, B, ldb, C, ldc, batch_count); \
     }                                                                                        \
@@ -269,6 +269,7 @@ extern "C" {
                                  rocblas_int       batch_count)    \
     try                                                            \
     {                                                              \
+        rocblas_call_scope call_scope(handle, __func__);           \
         return rocblas_geam_strided_batched_impl<T_>(handle,       \
                                                      transA,       \
                                                      transB,       \
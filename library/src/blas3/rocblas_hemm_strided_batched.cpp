@@ -279,6 +279,7 @@ extern "C" {
                                  rocblas_int    batch_count)   \
     try                                                        \
     {                                                          \
+        rocblas_call_scope call_scope(handle, __func__);       \
         return rocblas_hemm_strided_batched_impl(handle,       \
                                                  side,         \
                                                  uplo,         \
@@ -257,6 +257,7 @@ extern "C" {
                                  rocblas_int       ldc)                                            \
     try                                                                                            \
     {                                                                                              \
+        rocblas_call_scope call_scope(handle, __func__);                                           \
         return rocblas_her2k_impl(handle, uplo, trans, n, k, alpha, A, lda, B, ldb, beta, C, ldc); \
     }                                                                                              \
     catch(...)                                                                                     \
@@ -262,6 +262,7 @@ extern "C" {
                                  rocblas_int       batch_count)                           \
     try                                                                                   \
     {                                                                                     \
+        rocblas_call_scope call_scope(handle, __func__);                                  \
         return rocblas_her2k_batched_impl(                                                \
             handle, uplo, trans, n, k, alpha, A, lda, B, ldb, beta, C, ldc, batch_count); \
     }                                                                                     \
@@ -282,6 +282,7 @@ extern "C" {
                                  rocblas_int       batch_count) \
     try                                                         \
     {                                                           \
+        rocblas_call_scope call_scope(handle, __func__);        \
         return rocblas_her2k_strided_batched_impl(handle,       \
                                                   uplo,         \
                                                   trans,        \
@@ -232,6 +232,7 @@ extern "C" {
                                  rocblas_int       ldc)                                         \
     try                                                                                         \
     {                                                                                           \
+        rocblas_call_scope call_scope(handle, __func__);                                        \
         return rocblas_herk_impl<NB_>(handle, uplo, transA, n, k, alpha, A, lda, beta, C, ldc); \
     }                                                                                           \
     catch(...)                                                                                  \
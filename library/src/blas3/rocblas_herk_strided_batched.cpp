@@ -248,6 +248,7 @@ extern "C" {
                                  rocblas_int       batch_count)     \
     try                                                             \
     {                                                               \
+        rocblas_call_scope call_scope(handle, __func__);            \
         return rocblas_herk_strided_batched_impl<NB_>(handle,       \
                                                       uplo,         \
                                                       transA,       \
@@ -261,6 +261,7 @@ extern "C" {
                                  rocblas_int    ldc)                                             \
     try                                                                                          \
     {                                                                                            \
+        rocblas_call_scope call_scope(handle, __func__);                                         \
         return rocblas_symm_impl(handle, side, uplo, m, n, alpha, A, lda, B, ldb, beta, C, ldc); \
     }                                                                                            \
     catch(...)                                                                                   \
@@ -268,6 +268,7 @@ extern "C" {
                                  rocblas_int     batch_count)                            \
     try                                                                                  \
     {                                                                                    \
+        rocblas_call_scope call_scope(handle, __func__);                                 \
         return rocblas_symm_batched_impl(                                                \
             handle, side, uplo, m, n, alpha, A, lda, B, ldb, beta, C, ldc, batch_count); \
     }                                                                                    \
@@ -288,6 +288,7 @@ extern "C" {
                                  rocblas_int    batch_count)   \
     try                                                        \
     {                                                          \
+        rocblas_call_scope call_scope(handle, __func__);       \
         return rocblas_symm_strided_batched_impl(handle,       \
                                                  side,         \
                                                  uplo,         \
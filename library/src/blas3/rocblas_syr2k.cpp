@@ -261,6 +261,7 @@ extern "C" {
                                  rocblas_int       ldc)                       \
     try                                                                       \
     {                                                                         \
+        rocblas_call_scope call_scope(handle, __func__);                      \
         return rocblas_syr2k_impl(                                            \
             handle, uplo, transA, n, k, alpha, A, lda, B, ldb, beta, C, ldc); \
     }                                                                         \
@@ -287,6 +287,7 @@ extern "C" {
                                  rocblas_int       batch_count) \
     try                                                         \
     {                                                           \
+        rocblas_call_scope call_scope(handle, __func__);        \
         return rocblas_syr2k_strided_batched_impl(handle,       \
                                                   uplo,         \
                                                   transA,       \
@@ -236,6 +236,7 @@ extern "C" {
                                  rocblas_int       ldc)                                         \
     try                                                                                         \
     {                                                                                           \
+        rocblas_call_scope call_scope(handle, __func__);                                        \
         return rocblas_syrk_impl<NB_>(handle, uplo, transA, n, k, alpha, A, lda, beta, C, ldc); \
     }                                                                                           \
     catch(...)                                                                                  \
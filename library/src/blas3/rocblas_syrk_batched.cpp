@@ -241,6 +241,7 @@ extern "C" {
                                  rocblas_int       batch_count)                    \
     try                                                                            \
     {                                                                              \
+        rocblas_call_scope call_scope(handle, __func__);                           \
         return rocblas_syrk_batched_impl<NB_>(                                     \
             handle, uplo, transA, n, k, alpha, A, lda, beta, C, ldc, batch_count); \
     }                                                                              \
@@ -254,6 +254,7 @@ extern "C" {
                                  rocblas_int       batch_count)     \
     try                                                             \
     {                                                               \
+        rocblas_call_scope call_scope(handle, __func__);            \
         return rocblas_syrk_strided_batched_impl<NB_>(handle,       \
                                                       uplo,         \
                                                       transA,       \
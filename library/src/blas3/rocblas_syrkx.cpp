@@ -268,6 +268,7 @@ extern "C" {
                                  rocblas_int       ldc)                      \
     try                                                                      \
     {                                                                        \
+        rocblas_call_scope call_scope(handle, __func__);                     \
         return rocblas_syrkx_impl<MIN_NB>(                                   \
             handle, uplo, trans, n, k, alpha, A, lda, B, ldb, beta, C, ldc); \
     }                                                                        \
@@ -274,6 +274,7 @@ extern "C" {
                                  rocblas_int       batch_count)                           \
     try                                                                                   \
     {                                                                                     \
+        rocblas_call_scope call_scope(handle, __func__);                                  \
         return rocblas_syrkx_batched_impl<MIN_NB>(                                        \
             handle, uplo, trans, n, k, alpha, A, lda, B, ldb, beta, C, ldc, batch_count); \
     }                                                                                     \
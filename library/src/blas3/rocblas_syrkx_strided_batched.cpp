@@ -294,6 +294,7 @@ extern "C" {
                                  rocblas_int       batch_count)         \
     try                                                                 \
     {                                                                   \
+        rocblas_call_scope call_scope(handle, __func__);                \
         return rocblas_syrkx_strided_batched_impl<MIN_NB>(handle,       \
                                                           uplo,         \
                                                           trans,        \
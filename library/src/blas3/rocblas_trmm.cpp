@@ -299,6 +299,7 @@ extern "C" {
                                  rocblas_int       ldb)                     \
     try                                                                     \
     {                                                                       \
+        rocblas_call_scope call_scope(handle, __func__);                    \
         return rocblas_trmm_impl<STOPPING_NB_>(                             \
             handle, side, uplo, transa, diag, m, n, alpha, a, lda, b, ldb); \
     }                                                                       \
@@ -283,6 +283,7 @@ extern "C" {
                                  rocblas_int       batch_count)                          \
     try                                                                                  \
     {                                                                                    \
+        rocblas_call_scope call_scope(handle, __func__);                                 \
         return rocblas_trmm_batched_impl<BATCHED_STOPPING_NB_>(                          \
             handle, side, uplo, transa, diag, m, n, alpha, a, lda, b, ldb, batch_count); \
     }                                                                                    \
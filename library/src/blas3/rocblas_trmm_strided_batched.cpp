@@ -298,6 +298,7 @@ extern "C" {
                                  rocblas_int       batch_count)                              \
     try                                                                                      \
     {                                                                                        \
+        rocblas_call_scope call_scope(handle, __func__);                                     \
         return rocblas_trmm_strided_batched_impl<STRIDED_BATCHED_STOPPING_NB_>(handle,       \
                                                                                side,         \
                                                                                uplo,         \
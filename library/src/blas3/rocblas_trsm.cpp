@@ -290,6 +290,7 @@ rocblas_status rocblas_strsm(rocblas_handle    handle,
                              rocblas_int       ldb)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsm_ex_impl<ROCBLAS_TRSM_NB, ROCBLAS_SDCTRSV_NB>(
         handle, side, uplo, transA, diag, m, n, alpha, A, lda, B, ldb);
 }
@@ -312,6 +313,7 @@ rocblas_status rocblas_dtrsm(rocblas_handle    handle,
                              rocblas_int       ldb)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsm_ex_impl<ROCBLAS_TRSM_NB, ROCBLAS_SDCTRSV_NB>(
         handle, side, uplo, transA, diag, m, n, alpha, A, lda, B, ldb);
 }
@@ -334,6 +336,7 @@ rocblas_status rocblas_ctrsm(rocblas_handle               handle,
                              rocblas_int                  ldb)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsm_ex_impl<ROCBLAS_TRSM_NB, ROCBLAS_SDCTRSV_NB>(
         handle, side, uplo, transA, diag, m, n, alpha, A, lda, B, ldb);
 }
@@ -356,6 +359,7 @@ rocblas_status rocblas_ztrsm(rocblas_handle                handle,
                              rocblas_int                   ldb)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsm_ex_impl<ROCBLAS_TRSM_NB, ROCBLAS_ZTRSV_NB>(
         handle, side, uplo, transA, diag, m, n, alpha, A, lda, B, ldb);
 }
@@ -381,6 +385,7 @@ rocblas_status rocblas_trsm_ex(rocblas_handle    handle,
                                rocblas_datatype  compute_type)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     switch(compute_type)
     {
     case rocblas_datatype_f64_r:
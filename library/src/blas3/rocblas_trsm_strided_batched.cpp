@@ -318,6 +318,7 @@ rocblas_status rocblas_strsm_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsm_strided_batched_ex_impl<ROCBLAS_TRSM_NB, ROCBLAS_SDCTRSV_NB>(handle,
                                                                                      side,
                                                                                      uplo,
@@ -356,6 +357,7 @@ rocblas_status rocblas_dtrsm_strided_batched(rocblas_handle    handle,
                                              rocblas_int       batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsm_strided_batched_ex_impl<ROCBLAS_TRSM_NB, ROCBLAS_SDCTRSV_NB>(handle,
                                                                                      side,
                                                                                      uplo,
@@ -394,6 +396,7 @@ rocblas_status rocblas_ctrsm_strided_batched(rocblas_handle               handle
                                              rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsm_strided_batched_ex_impl<ROCBLAS_TRSM_NB, ROCBLAS_SDCTRSV_NB>(handle,
                                                                                      side,
                                                                                      uplo,
@@ -432,6 +435,7 @@ rocblas_status rocblas_ztrsm_strided_batched(rocblas_handle                handl
                                              rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trsm_strided_batched_ex_impl<ROCBLAS_TRSM_NB, ROCBLAS_ZTRSV_NB>(handle,
                                                                                    side,
                                                                                    uplo,
@@ -474,6 +478,7 @@ rocblas_status rocblas_trsm_strided_batched_ex(rocblas_handle    handle,
                                                rocblas_datatype  compute_type)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     switch(compute_type)
     {
     case rocblas_datatype_f64_r:
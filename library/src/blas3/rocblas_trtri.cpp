@@ -174,6 +174,7 @@ rocblas_status rocblas_strtri(rocblas_handle   handle,
                               rocblas_int      ldinvA)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_impl<ROCBLAS_TRTRI_NB>(handle, uplo, diag, n, A, lda, invA, ldinvA);
 }
 catch(...)
@@ -191,6 +192,7 @@ rocblas_status rocblas_dtrtri(rocblas_handle   handle,
                               rocblas_int      ldinvA)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_impl<ROCBLAS_TRTRI_NB>(handle, uplo, diag, n, A, lda, invA, ldinvA);
 }
 catch(...)
@@ -208,6 +210,7 @@ rocblas_status rocblas_ctrtri(rocblas_handle               handle,
                               rocblas_int                  ldinvA)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_impl<ROCBLAS_TRTRI_NB>(handle, uplo, diag, n, A, lda, invA, ldinvA);
 }
 catch(...)
@@ -225,6 +228,7 @@ rocblas_status rocblas_ztrtri(rocblas_handle                handle,
                               rocblas_int                   ldinvA)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_impl<ROCBLAS_TRTRI_NB>(handle, uplo, diag, n, A, lda, invA, ldinvA);
 }
 catch(...)
@@ -201,6 +201,7 @@ rocblas_status rocblas_strtri_batched(rocblas_handle     handle,
                                       rocblas_int        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_batched_impl<ROCBLAS_TRTRI_NB>(
         handle, uplo, diag, n, A, lda, invA, ldinvA, batch_count);
 }
@@ -220,6 +221,7 @@ rocblas_status rocblas_dtrtri_batched(rocblas_handle      handle,
                                       rocblas_int         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_batched_impl<ROCBLAS_TRTRI_NB>(
         handle, uplo, diag, n, A, lda, invA, ldinvA, batch_count);
 }
@@ -239,6 +241,7 @@ rocblas_status rocblas_ctrtri_batched(rocblas_handle                     handle,
                                       rocblas_int                        batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_batched_impl<ROCBLAS_TRTRI_NB>(
         handle, uplo, diag, n, A, lda, invA, ldinvA, batch_count);
 }
@@ -258,6 +261,7 @@ rocblas_status rocblas_ztrtri_batched(rocblas_handle                      handle
                                       rocblas_int                         batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_batched_impl<ROCBLAS_TRTRI_NB>(
         handle, uplo, diag, n, A, lda, invA, ldinvA, batch_count);
 }
@@ -224,6 +224,7 @@ rocblas_status rocblas_strtri_strided_batched(rocblas_handle   handle,
                                               rocblas_int      batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_strided_batched_impl<ROCBLAS_TRTRI_NB>(
         handle, uplo, diag, n, A, lda, bsa, invA, ldinvA, bsinvA, batch_count);
 }
@@ -245,6 +246,7 @@ rocblas_status rocblas_dtrtri_strided_batched(rocblas_handle   handle,
                                               rocblas_int      batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_strided_batched_impl<ROCBLAS_TRTRI_NB>(
         handle, uplo, diag, n, A, lda, bsa, invA, ldinvA, bsinvA, batch_count);
 }
@@ -266,6 +268,7 @@ rocblas_status rocblas_ctrtri_strided_batched(rocblas_handle               handl
                                               rocblas_int                  batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_strided_batched_impl<ROCBLAS_TRTRI_NB>(
         handle, uplo, diag, n, A, lda, bsa, invA, ldinvA, bsinvA, batch_count);
 }
@@ -287,6 +290,7 @@ rocblas_status rocblas_ztrtri_strided_batched(rocblas_handle                hand
                                               rocblas_int                   batch_count)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_trtri_strided_batched_impl<ROCBLAS_TRTRI_NB>(
         handle, uplo, diag, n, A, lda, bsa, invA, ldinvA, bsinvA, batch_count);
 }
@@ -196,6 +196,7 @@ rocblas_status rocblas_axpy_batched_ex(rocblas_handle   handle,
                                        rocblas_int      batch_count,
                                        rocblas_datatype execution_type)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     try
     {
         return rocblas_axpy_batched_ex_impl<ROCBLAS_AXPY_NB>(handle,
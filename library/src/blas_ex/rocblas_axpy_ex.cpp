@@ -189,6 +189,7 @@ rocblas_status rocblas_axpy_ex(rocblas_handle   handle,
                                rocblas_int      incy,
                                rocblas_datatype execution_type)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     try
     {
         return rocblas_axpy_ex_impl<ROCBLAS_AXPY_NB>(handle,
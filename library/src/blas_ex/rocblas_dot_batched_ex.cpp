@@ -199,6 +199,7 @@ rocblas_status rocblas_dot_batched_ex(rocblas_handle   handle,
                                       rocblas_datatype result_type,
                                       rocblas_datatype execution_type)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     try
     {
         return rocblas_dot_batched_ex_impl<false>(handle,
@@ -235,6 +236,7 @@ rocblas_status rocblas_dotc_batched_ex(rocblas_handle   handle,
                                        rocblas_datatype result_type,
                                        rocblas_datatype execution_type)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     try
     {
         return rocblas_dot_batched_ex_impl<true>(handle,
@@ -186,6 +186,7 @@ rocblas_status rocblas_dot_ex(rocblas_handle   handle,
                               rocblas_datatype result_type,
                               rocblas_datatype execution_type)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     try
     {
         return rocblas_dot_ex_impl<false>(handle,
@@ -220,6 +221,7 @@ rocblas_status rocblas_dotc_ex(rocblas_handle   handle,
                                rocblas_datatype result_type,
                                rocblas_datatype execution_type)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     try
     {
         return rocblas_dot_ex_impl<true>(handle,
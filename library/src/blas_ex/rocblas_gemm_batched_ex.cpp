@@ -53,6 +53,7 @@ extern "C" rocblas_status rocblas_gemm_batched_ex(rocblas_handle    handle,
                                                   uint32_t          flags)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     if(!handle)
         return rocblas_status_invalid_handle;
 
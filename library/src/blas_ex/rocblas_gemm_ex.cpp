@@ -316,6 +316,7 @@ extern "C" rocblas_status rocblas_gemm_ex(rocblas_handle    handle,
                                           uint32_t          flags)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_ex_impl(handle,
                                 trans_a,
                                 trans_b,
@@ -527,6 +527,7 @@ extern "C" rocblas_status rocblas_gemm_ext2(rocblas_handle    handle,
                                             uint32_t          flags)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_gemm_ext2_impl(handle,
                                   m,
                                   n,
@@ -56,6 +56,7 @@ extern "C" rocblas_status rocblas_gemm_strided_batched_ex(rocblas_handle    hand
                                                           uint32_t          flags)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     if(!handle)
         return rocblas_status_invalid_handle;
 
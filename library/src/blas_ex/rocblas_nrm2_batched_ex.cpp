@@ -184,6 +184,7 @@ rocblas_status rocblas_nrm2_batched_ex(rocblas_handle   handle,
                                        rocblas_datatype result_type,
                                        rocblas_datatype execution_type)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     try
     {
         return rocblas_nrm2_batched_ex_impl<ROCBLAS_NRM2_NB>(
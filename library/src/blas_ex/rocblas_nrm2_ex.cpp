@@ -165,6 +165,7 @@ rocblas_status rocblas_nrm2_ex(rocblas_handle   handle,
                                rocblas_datatype result_type,
                                rocblas_datatype execution_type)
 {
+    rocblas_call_scope call_scope(handle, __func__);
     try
     {
         return rocblas_nrm2_ex_impl<ROCBLAS_NRM2_NB>(
@@ -156,6 +156,7 @@ rocblas_status rocblas_rot_batched_ex(rocblas_handle   handle,
                                       rocblas_datatype execution_type)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_batched_ex_impl(
         handle, n, x, x_type, incx, y, y_type, incy, c, s, cs_type, batch_count, execution_type);
 }
@@ -150,6 +150,7 @@ rocblas_status rocblas_rot_ex(rocblas_handle   handle,
                               rocblas_datatype execution_type)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_ex_impl(
         handle, n, x, x_type, incx, y, y_type, incy, c, s, cs_type, execution_type);
 }
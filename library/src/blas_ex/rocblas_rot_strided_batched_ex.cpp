@@ -169,6 +169,7 @@ rocblas_status rocblas_rot_strided_batched_ex(rocblas_handle   handle,
                                               rocblas_datatype execution_type)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_rot_strided_batched_ex_impl(handle,
                                                n,
                                                x,
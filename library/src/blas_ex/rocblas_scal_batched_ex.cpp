@@ -148,6 +148,7 @@ rocblas_status rocblas_scal_batched_ex(rocblas_handle   handle,
                                        rocblas_datatype execution_type)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     return rocblas_scal_batched_ex_impl<ROCBLAS_SCAL_NB>(
         handle, n, alpha, alpha_type, x, x_type, incx, batch_count, execution_type);
 }
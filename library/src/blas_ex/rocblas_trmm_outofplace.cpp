@@ -285,6 +285,7 @@ extern "C" {
                                  rocblas_int       ldc)                             \
     try                                                                             \
     {                                                                               \
+        rocblas_call_scope call_scope(handle, __func__);                            \
         return rocblas_trmm_outofplace_impl<NB_>(                                   \
             handle, side, uplo, transa, diag, m, n, alpha, a, lda, b, ldb, c, ldc); \
     }                                                                               \
@@ -291,6 +291,7 @@ extern "C" {
                                  rocblas_int       batch_count)                                  \
     try                                                                                          \
     {                                                                                            \
+        rocblas_call_scope call_scope(handle, __func__);                                         \
         return rocblas_trmm_outofplace_batched_impl<BATCHED_NB_>(                                \
             handle, side, uplo, transa, diag, m, n, alpha, a, lda, b, ldb, c, ldc, batch_count); \
     }                                                                                            \
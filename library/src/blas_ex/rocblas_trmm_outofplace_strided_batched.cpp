@@ -309,6 +309,7 @@ extern "C" {
                                  rocblas_int       batch_count)                                \
     try                                                                                        \
     {                                                                                          \
+        rocblas_call_scope call_scope(handle, __func__);                                       \
         return rocblas_trmm_outofplace_strided_batched_impl<STRIDED_BATCHED_NB_>(handle,       \
                                                                                  side,         \
                                                                                  uplo,         \
@@ -230,6 +230,7 @@ rocblas_status rocblas_trsv_ex(rocblas_handle    handle,
                                rocblas_datatype  compute_type)
 try
 {
+    rocblas_call_scope call_scope(handle, __func__);
     switch(compute_type)
     {
     case rocblas_datatype_f64_r:
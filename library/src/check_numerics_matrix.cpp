@@ -26,6 +26,9 @@
   *        rocblas_status_success        : Return status if the matrix does not have a NaN/Inf/denormal value
   *   rocblas_status_check_numerics_fail : Return status if the matrix contains a NaN/Inf/denormal value and 'check_numerics' enum is set to 'rocblas_check_numerics_mode_fail'
   *
+  *    If 'check_numerics' includes 'rocblas_check_numerics_mode_deferred', the function returns without waiting for the check,
+  *    and 'rocblas_status_check_numerics_fail' is returned by a later check of the handle instead, once the result has been read back.
+  *
 **/
 
 template <typename T>
@@ -49,27 +52,32 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     if(!m || !n || !batch_count || !A)
         return rocblas_status_success;
 
-    //Creating structure host object
-    rocblas_check_numerics_t h_abnormal;
+    //Skipping the check if the call is not selected by the sampling policy
+    if(!handle->check_numerics_sampler.check(
+           function_name,
+           is_input,
+           rocblas_check_numerics_sampler::profile(
+               {trans_a, uplo, matrix_type, m, n, lda, batch_count})))
+        return rocblas_status_success;
 
-    //Allocating memory for device structure
-    auto d_abnormal = handle->device_malloc(sizeof(rocblas_check_numerics_t));
+    //Getting the device flags of the check from the handle's persistent flag ring. In deferred
+    //mode, consecutive operands of the same call share one slot and one readback.
+    bool        deferred       = (check_numerics & rocblas_check_numerics_mode_deferred) != 0;
+    auto&       queue          = handle->check_numerics_queue;
+    hipStream_t rocblas_stream = handle->get_stream();
 
-    //Transferring the rocblas_check_numerics_t structure from host to the device
-    RETURN_IF_HIP_ERROR(hipMemcpy((rocblas_check_numerics_t*)d_abnormal,
-                                  &h_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyHostToDevice));
+    rocblas_check_numerics_t* d_abnormal;
+    RETURN_IF_ROCBLAS_ERROR(
+        queue.check(function_name, check_numerics, is_input, rocblas_stream, deferred, d_abnormal));
 
     //Checking trans_a to transpose a matrix 'A'
     rocblas_int num_rows_a = trans_a == rocblas_operation_none ? m : n;
     rocblas_int num_cols_a = trans_a == rocblas_operation_none ? n : m;
 
-    hipStream_t          rocblas_stream = handle->get_stream();
-    static constexpr int DIM_X          = 16;
-    static constexpr int DIM_Y          = 16;
-    rocblas_int          blocks_X       = (num_rows_a - 1) / DIM_X + 1;
-    rocblas_int          blocks_Y       = (num_cols_a - 1) / DIM_Y + 1;
+    static constexpr int DIM_X    = 16;
+    static constexpr int DIM_Y    = 16;
+    rocblas_int          blocks_X = (num_rows_a - 1) / DIM_X + 1;
+    rocblas_int          blocks_Y = (num_cols_a - 1) / DIM_Y + 1;
 
     dim3 blocks(blocks_X, blocks_Y, batch_count);
     dim3 threads(DIM_X, DIM_Y);
@@ -87,7 +95,7 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
                            offset_a,
                            lda,
                            stride_a,
-                           (rocblas_check_numerics_t*)d_abnormal);
+                           d_abnormal);
     }
     else if(matrix_type == rocblas_client_symmetric_matrix
             || matrix_type == rocblas_client_hermitian_matrix
@@ -104,17 +112,12 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
                            offset_a,
                            lda,
                            stride_a,
-                           (rocblas_check_numerics_t*)d_abnormal);
+                           d_abnormal);
     }
 
-    //Transferring the rocblas_check_numerics_t structure from device to the host
-    RETURN_IF_HIP_ERROR(hipMemcpy(&h_abnormal,
-                                  (rocblas_check_numerics_t*)d_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyDeviceToHost));
-
-    return rocblas_check_numerics_abnormal_struct(
-        function_name, check_numerics, is_input, &h_abnormal);
+    //In deferred mode, the result is reported once its readback has completed, and a failure
+    //is returned by a later check or by rocblas_synchronize_check_numerics
+    return deferred ? queue.poll() : queue.flush();
 }
 
 // INSTANTIATIONS TO SUPPORT output: T*, T* const*, and input: const T*, const T* const*
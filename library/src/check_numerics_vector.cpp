@@ -58,6 +58,74 @@ rocblas_status rocblas_check_numerics_abnormal_struct(const char*
     }
     return rocblas_status_success;
 }
+
+/*******************************************************************************
+ * flag ring and readback of the numerical checks of a handle
+ ******************************************************************************/
+bool rocblas_check_numerics_runtime::allocate(flags_t** device, flags_t** host, size_t count)
+{
+    if((hipMalloc)(device, count * sizeof(flags_t)) != hipSuccess)
+        return false;
+    if(hipHostMalloc(host, count * sizeof(flags_t)) != hipSuccess)
+    {
+        (hipFree)(*device);
+        return false;
+    }
+    return true;
+}
+
+void rocblas_check_numerics_runtime::deallocate(flags_t* device, flags_t* host)
+{
+    (hipFree)(device);
+    hipHostFree(host);
+}
+
+bool rocblas_check_numerics_runtime::clear(flags_t* device, hipStream_t stream)
+{
+    return hipMemsetAsync(device, 0, sizeof(flags_t), stream) == hipSuccess;
+}
+
+bool rocblas_check_numerics_runtime::read(flags_t* host, const flags_t* device, hipStream_t stream)
+{
+    return hipMemcpyAsync(host, device, sizeof(flags_t), hipMemcpyDeviceToHost, stream)
+           == hipSuccess;
+}
+
+bool rocblas_check_numerics_runtime::record(hipEvent_t& event, hipStream_t stream)
+{
+    if(!event && hipEventCreateWithFlags(&event, hipEventDisableTiming) != hipSuccess)
+    {
+        event = nullptr;
+        return false;
+    }
+    return hipEventRecord(event, stream) == hipSuccess;
+}
+
+bool rocblas_check_numerics_runtime::query(hipEvent_t event)
+{
+    return hipEventQuery(event) == hipSuccess;
+}
+
+bool rocblas_check_numerics_runtime::synchronize(hipEvent_t event)
+{
+    return hipEventSynchronize(event) == hipSuccess;
+}
+
+void rocblas_check_numerics_runtime::destroy(hipEvent_t event)
+{
+    hipEventDestroy(event);
+}
+
+rocblas_status rocblas_check_numerics_runtime::report(const char*    function_name,
+                                                      int            check_numerics,
+                                                      bool           is_input,
+                                                      const flags_t& flags)
+{
+    flags_t h_abnormal = flags;
+    return rocblas_check_numerics_abnormal_struct(
+        function_name, check_numerics, is_input, &h_abnormal);
+}
+
 /**
   *
   * rocblas_internal_check_numerics_vector_template(function_name, handle, n, x, offset_x, inc_x, stride_x, batch_count, check_numerics, is_input)
@@ -82,6 +150,9 @@ rocblas_status rocblas_check_numerics_abnormal_struct(const char*
   *        rocblas_status_success        : Return status if the vector does not have a NaN/Inf/denormal value
   *   rocblas_status_check_numerics_fail : Return status if the vector contains a NaN/Inf/denormal value and 'check_numerics' enum is set to 'rocblas_check_numerics_mode_fail'
   *
+  *    If 'check_numerics' includes 'rocblas_check_numerics_mode_deferred', the function returns without waiting for the check,
+  *    and 'rocblas_status_check_numerics_fail' is returned by a later check of the handle instead, once the result has been read back.
+  *
 **/
 
 template <typename T>
@@ -103,22 +174,27 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
         return rocblas_status_success;
     }
 
-    //Creating structure host object
-    rocblas_check_numerics_t h_abnormal;
+    //Skipping the check if the call is not selected by the sampling policy
+    if(!handle->check_numerics_sampler.check(
+           function_name,
+           is_input,
+           rocblas_check_numerics_sampler::profile({n, inc_x, batch_count})))
+        return rocblas_status_success;
+
+    //Getting the device flags of the check from the handle's persistent flag ring. In deferred
+    //mode, consecutive operands of the same call share one slot and one readback.
+    bool        deferred       = (check_numerics & rocblas_check_numerics_mode_deferred) != 0;
+    auto&       queue          = handle->check_numerics_queue;
+    hipStream_t rocblas_stream = handle->get_stream();
 
-    //Allocating memory for device structure
-    auto d_abnormal = handle->device_malloc(sizeof(rocblas_check_numerics_t));
+    rocblas_check_numerics_t* d_abnormal;
+    RETURN_IF_ROCBLAS_ERROR(
+        queue.check(function_name, check_numerics, is_input, rocblas_stream, deferred, d_abnormal));
 
-    //Transferring the rocblas_check_numerics_t structure from host to the device
-    RETURN_IF_HIP_ERROR(hipMemcpy((rocblas_check_numerics_t*)d_abnormal,
-                                  &h_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyHostToDevice));
+    constexpr rocblas_int NB = 256;
 
-    hipStream_t           rocblas_stream = handle->get_stream();
-    constexpr rocblas_int NB             = 256;
-    dim3                  blocks((n - 1) / NB + 1, batch_count);
-    dim3                  threads(NB);
+    dim3 blocks((n - 1) / NB + 1, batch_count);
+    dim3 threads(NB);
 
     hipLaunchKernelGGL((rocblas_check_numerics_vector_kernel<NB>),
                        blocks,
@@ -130,16 +206,11 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
                        offset_x,
                        inc_x,
                        stride_x,
-                       (rocblas_check_numerics_t*)d_abnormal);
-
-    //Transferring the rocblas_check_numerics_t structure from device to the host
-    RETURN_IF_HIP_ERROR(hipMemcpy(&h_abnormal,
-                                  (rocblas_check_numerics_t*)d_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyDeviceToHost));
+                       d_abnormal);
 
-    return rocblas_check_numerics_abnormal_struct(
-        function_name, check_numerics, is_input, &h_abnormal);
+    //In deferred mode, the result is reported once its readback has completed, and a failure
+    //is returned by a later check or by rocblas_synchronize_check_numerics
+    return deferred ? queue.poll() : queue.flush();
 }
 
 // INSTANTIATIONS TO SUPPORT output: T*, T* const*, and input: const T*, const T* const*
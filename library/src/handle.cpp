@@ -21,6 +21,8 @@
  * ************************************************************************ */
 #include "handle.hpp"
 #include <cstdarg>
+#include <cstdio>
+#include <fcntl.h>
 #include <limits>
 #ifdef WIN32
 #include <windows.h>
@@ -31,6 +33,47 @@
 // see TensileHost.cpp for normal rocblas_initialize definition
 // it isn't compiled if not BUILD_WITH_TENSILE so defining here
 extern "C" void rocblas_initialize() {}
+
+// Without Tensile there is nothing to load or select, so initialization is always complete
+extern "C" rocblas_status rocblas_initialize_async(const rocblas_gemm_shape* shapes,
+                                                   rocblas_int               count)
+{
+    if(count < 0)
+        return rocblas_status_invalid_size;
+    return count && !shapes ? rocblas_status_invalid_pointer : rocblas_status_success;
+}
+
+extern "C" rocblas_status
+    rocblas_get_initialize_progress(rocblas_int* ready, size_t* completed, size_t* total)
+{
+    if(!ready || !completed || !total)
+        return rocblas_status_invalid_pointer;
+    *ready     = 1;
+    *completed = *total = 0;
+    return rocblas_status_success;
+}
+
+// There is no solution selection without Tensile, so the solution cache is always empty
+extern "C" rocblas_status rocblas_get_solution_cache_stats(
+    rocblas_handle handle, size_t* hits, size_t* misses, size_t* evictions, size_t* size)
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!hits || !misses || !evictions || !size)
+        return rocblas_status_invalid_pointer;
+    *hits = *misses = *evictions = *size = 0;
+    return rocblas_status_success;
+}
+
+extern "C" rocblas_status rocblas_set_solution_cache_capacity(rocblas_handle handle, size_t)
+{
+    return handle ? rocblas_status_success : rocblas_status_invalid_handle;
+}
+
+extern "C" rocblas_status rocblas_clear_solution_cache(rocblas_handle handle)
+{
+    return handle ? rocblas_status_success : rocblas_status_invalid_handle;
+}
 #endif
 
 // forcing early cleanup
@@ -90,7 +133,8 @@ _rocblas_handle::_rocblas_handle()
     archMajor = arch / 100; // this may need to switch to string handling in the future
 
     // Device memory size
-    const char* env = read_env("ROCBLAS_DEVICE_MEMORY_SIZE");
+    size_t      device_memory_size = 0;
+    const char* env                = read_env("ROCBLAS_DEVICE_MEMORY_SIZE");
     if(env)
         device_memory_size = strtoul(env, nullptr, 0);
 
@@ -114,11 +158,20 @@ _rocblas_handle::_rocblas_handle()
                 device_memory_size = DEFAULT_DEVICE_MEMORY_SIZE;
             }
         }
+
+        // Lease device memory from the shared workspace pool if requested, instead of
+        // allocating it for the handle
+        const char* shared_env = read_env("ROCBLAS_SHARED_WORKSPACE");
+        if(shared_env && strtol(shared_env, nullptr, 0))
+        {
+            device_memory_owner = rocblas_device_memory_ownership::pool_managed;
+            device_memory_size  = 0;
+        }
     }
 
-    // Allocate device memory
-    if(device_memory_size)
-        THROW_IF_HIP_ERROR((hipMalloc)(&device_memory, device_memory_size));
+    // Allocate the first slab of device memory
+    if(!device_arena.reserve(device_memory_size))
+        THROW_IF_HIP_ERROR(device_arena.allocator().status);
 
     // Initialize logging
     init_logging();
@@ -132,7 +185,7 @@ _rocblas_handle::_rocblas_handle()
  ******************************************************************************/
 _rocblas_handle::~_rocblas_handle()
 {
-    if(device_memory_in_use)
+    if(device_arena.in_use())
     {
         rocblas_cerr
             << "rocBLAS internal error: Handle object destroyed while device memory still in use."
@@ -140,53 +193,175 @@ _rocblas_handle::~_rocblas_handle()
         rocblas_abort();
     }
 
-    // Free device memory unless it's user-owned
-    if(device_memory_owner != rocblas_device_memory_ownership::user_owned)
+    // Write the device memory statistics, if requested
+    if(device_memory_stats_os)
+        device_memory_stats.write_yaml(*device_memory_stats_os, device, device_arena.capacity());
+
+    // Write the latency statistics
+    if(latency_stats)
+        latency_stats->write_yaml(*latency_stats_os, device);
+
+    // Free device memory slabs, unless they are user-owned
+    if(!device_arena.release())
     {
-        auto hipStatus = (hipFree)(device_memory);
-        if(hipStatus != hipSuccess)
-        {
-            rocblas_cerr << "rocBLAS error during hipFree in handle destructor: "
-                         << rocblas_status_to_string(get_rocblas_status_for_hip_status(hipStatus))
-                         << std::endl;
-            rocblas_abort();
-        };
+        auto hipStatus = device_arena.allocator().status;
+        rocblas_cerr << "rocBLAS error during hipFree in handle destructor: "
+                     << rocblas_status_to_string(get_rocblas_status_for_hip_status(hipStatus))
+                     << std::endl;
+        rocblas_abort();
+    }
+}
+
+/*******************************************************************************
+ * allocator of device memory slabs for the workspace arena
+ ******************************************************************************/
+bool rocblas_device_slab_allocator::allocate(void** ptr, size_t size)
+{
+    hipError_t hipStatus = (hipMalloc)(ptr, size);
+    if(hipStatus != hipSuccess)
+    {
+        *ptr   = nullptr;
+        status = hipStatus;
+    }
+    return hipStatus == hipSuccess;
+}
+
+bool rocblas_device_slab_allocator::deallocate(void* ptr)
+{
+    hipError_t hipStatus = (hipFree)(ptr);
+    if(hipStatus != hipSuccess)
+        status = hipStatus;
+    return hipStatus == hipSuccess;
+}
+
+/*******************************************************************************
+ * events ordering the reuse of shared workspace slabs across streams
+ ******************************************************************************/
+bool rocblas_device_events::record(hipEvent_t& event, hipStream_t stream)
+{
+    if(!event && hipEventCreateWithFlags(&event, hipEventDisableTiming) != hipSuccess)
+    {
+        event = nullptr;
+        return false;
     }
+    return hipEventRecord(event, stream) == hipSuccess;
+}
+
+bool rocblas_device_events::query(hipEvent_t event)
+{
+    return hipEventQuery(event) == hipSuccess;
+}
+
+bool rocblas_device_events::wait(hipStream_t stream, hipEvent_t event)
+{
+    return hipStreamWaitEvent(stream, event, 0) == hipSuccess;
+}
+
+void rocblas_device_events::destroy(hipEvent_t event)
+{
+    hipEventDestroy(event);
+}
+
+/*******************************************************************************
+ * shared workspace pool of a device
+ ******************************************************************************/
+static rocblas_device_workspace_pool& get_workspace_pool(int device)
+{
+    // The pools are never destroyed, since device memory cannot be freed safely
+    // during static destruction
+    static auto* pools = [] {
+        int count = 0;
+        if(hipGetDeviceCount(&count) != hipSuccess)
+            count = 0;
+        return new std::vector<rocblas_device_workspace_pool>(count);
+    }();
+    return pools->at(device);
+}
+
+/*******************************************************************************
+ * lease a slab of at least size bytes from the shared workspace pool
+ ******************************************************************************/
+bool _rocblas_handle::lease_workspace(size_t size)
+{
+    // Temporarily change the thread's default device ID to the handle's device ID
+    // cppcheck-suppress unreadVariable
+    auto saved_device_id = push_device_id();
+
+    void*  addr;
+    size_t slab_size;
+    if(!get_workspace_pool(device).lease(
+           rocblas_workspace_slab_size(size), stream, addr, slab_size))
+        return false;
+
+    workspace_leases.push_back(addr);
+    device_arena.adopt(addr, slab_size);
+    return true;
+}
+
+/*******************************************************************************
+ * return the leased slabs to the shared workspace pool, in the order of the
+ * handle's stream
+ ******************************************************************************/
+bool _rocblas_handle::return_workspace_leases()
+{
+    if(device_arena.in_use())
+        return false;
+
+    // The leased slabs are not owned by the arena, so they are not freed
+    device_arena.release();
+
+    bool  success = true;
+    auto& pool    = get_workspace_pool(device);
+    for(void* addr : workspace_leases)
+        success = pool.release(addr, stream) && success;
+    workspace_leases.clear();
+    return success;
 }
 
 /*******************************************************************************
  * helper for allocating device memory
  ******************************************************************************/
-#if ROCBLAS_REALLOC_ON_DEMAND
-bool _rocblas_handle::device_allocator(size_t size)
+bool _rocblas_handle::device_allocator(size_t size, rocblas_device_arena::block& block)
 {
-    bool success = size <= device_memory_size - device_memory_in_use;
+    // The clock is only read when latency is measured
+    rocblas_latency_call::time_point start;
+    if(latency_stats)
+        start = rocblas_latency_call::now();
+    bool success = device_arena.allocate(size, false, block);
+    bool grew    = false;
+#if ROCBLAS_REALLOC_ON_DEMAND
     if(!success && device_memory_owner == rocblas_device_memory_ownership::rocblas_managed)
     {
-        if(device_memory_in_use)
-        {
-            rocblas_cerr << "rocBLAS internal error: Cannot reallocate device memory while it is "
-                            "already in use.";
-            rocblas_abort();
-        }
-
         // Temporarily change the thread's default device ID to the handle's device ID
         // cppcheck-suppress unreadVariable
         auto saved_device_id = push_device_id();
 
-        device_memory_size = 0;
-        if(!device_memory || (hipFree)(device_memory) == hipSuccess)
-        {
-            success = (hipMalloc)(&device_memory, size) == hipSuccess;
-            if(success)
-                device_memory_size = size;
-            else
-                device_memory = nullptr;
-        }
+        // Grow the arena by adding a slab. Memory already in use is not moved.
+        success = grew = device_arena.allocate(size, true, block);
     }
+#endif
+    if(!success && device_memory_owner == rocblas_device_memory_ownership::pool_managed)
+        success = grew = lease_workspace(size) && device_arena.allocate(size, false, block);
+    device_memory_stats.record(
+        routine, size, success, grew, device_arena.in_use(), device_arena.capacity());
+    if(latency_stats)
+        rocblas_latency_call::workspace(latency_stats.get(), start, rocblas_latency_call::now());
     return success;
 }
-#endif
+
+/*******************************************************************************
+ * helper for freeing device memory
+ ******************************************************************************/
+bool _rocblas_handle::device_deallocator(const rocblas_device_arena::block& block)
+{
+    if(!device_arena.deallocate(block))
+        return false;
+
+    // Once the handle's workspace is idle, leased slabs are returned to the shared pool
+    if(!workspace_leases.empty() && !device_arena.in_use())
+        return_workspace_leases();
+    return true;
+}
 
 /*******************************************************************************
  * start device memory size queries
@@ -238,7 +413,7 @@ try
         return rocblas_status_invalid_handle;
     if(!size)
         return rocblas_status_invalid_pointer;
-    *size = handle->device_memory_size;
+    *size = handle->device_arena.capacity();
     return rocblas_status_success;
 }
 catch(...)
@@ -255,16 +430,18 @@ static rocblas_status free_existing_device_memory(rocblas_handle handle)
     // Cannot change memory allocation when a device_malloc object is alive and
     // using device memory. This should never happen unless this function is
     // called from inside library code which borrows allocated device memory.
-    if(handle->device_memory_in_use)
+    if(handle->device_arena.in_use())
         return rocblas_status_internal_error;
 
-    // Free existing device memory in handle, unless owned by user
-    if(handle->device_memory_owner != rocblas_device_memory_ownership::user_owned)
-        RETURN_IF_HIP_ERROR((hipFree)(handle->device_memory));
+    // Return any slabs leased from the shared workspace pool
+    if(!handle->workspace_leases.empty() && !handle->return_workspace_leases())
+        return rocblas_status_internal_error;
+
+    // Free existing device memory slabs in handle, unless owned by user
+    if(!handle->device_arena.release())
+        return get_rocblas_status_for_hip_status(handle->device_arena.allocator().status);
 
-    // Clear the memory size and address, and set the memory to be rocBLAS-managed
-    handle->device_memory_size  = 0;
-    handle->device_memory       = nullptr;
+    // Set the memory to be rocBLAS-managed
     handle->device_memory_owner = rocblas_device_memory_ownership::rocblas_managed;
 
     return rocblas_status_success;
@@ -292,21 +469,16 @@ try
     if(!size)
         return rocblas_status_success;
 
-    // Allocate size rounded up to MIN_CHUNK_SIZE
-    size           = roundup_device_memory_size(size);
-    auto hipStatus = (hipMalloc)(&handle->device_memory, size);
-
-    if(hipStatus != hipSuccess)
+    // Allocate a single slab of size rounded up to MIN_CHUNK_SIZE
+    if(!handle->device_arena.reserve(roundup_device_memory_size(size)))
     {
-        // If allocation fails, nullify device memory address and return error
+        // If allocation fails, return error
         // Leave the memory under rocBLAS management for future calls
-        handle->device_memory = nullptr;
-        return get_rocblas_status_for_hip_status(hipStatus);
+        return get_rocblas_status_for_hip_status(handle->device_arena.allocator().status);
     }
     else
     {
-        // If allocation succeeds, set size, mark it under user-management, and return success
-        handle->device_memory_size  = size;
+        // If allocation succeeds, mark it under user-management, and return success
         handle->device_memory_owner = rocblas_device_memory_ownership::user_managed;
         return rocblas_status_success;
     }
@@ -339,8 +511,7 @@ try
     if(size && addr)
     {
         handle->device_memory_owner = rocblas_device_memory_ownership::user_owned;
-        handle->device_memory_size  = size;
-        handle->device_memory       = addr;
+        handle->device_arena.adopt(addr, size);
     }
 
     return rocblas_status_success;
@@ -350,6 +521,275 @@ catch(...)
     return exception_to_rocblas_status();
 }
 
+/*******************************************************************************
+ * Lease device memory from the shared workspace pool of the handle's device
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_shared_workspace(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    // Temporarily change the thread's default device ID to the handle's device ID
+    auto saved_device_id = handle->push_device_id();
+
+    // Free any allocated memory unless owned by user
+    rocblas_status status = free_existing_device_memory(handle);
+    if(status != rocblas_status_success)
+        return status;
+
+    handle->device_memory_owner = rocblas_device_memory_ownership::pool_managed;
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Get the size of the shared workspace pool of the handle's device
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_shared_workspace_size(rocblas_handle handle, size_t* size)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!size)
+        return rocblas_status_invalid_pointer;
+    *size = get_workspace_pool(handle->getDevice()).capacity();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Free the idle slabs of the shared workspace pool of the handle's device
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_trim_shared_workspace(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    // Temporarily change the thread's default device ID to the handle's device ID
+    auto saved_device_id = handle->push_device_id();
+
+    get_workspace_pool(handle->getDevice()).trim();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Get the device memory statistics
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_device_memory_stats(rocblas_handle handle,
+                                                          size_t*        peak_in_use,
+                                                          size_t*        allocations,
+                                                          size_t*        growths,
+                                                          size_t*        failures)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!peak_in_use || !allocations || !growths || !failures)
+        return rocblas_status_invalid_pointer;
+
+    const auto& stats = handle->device_memory_stats;
+    *peak_in_use      = stats.peak_in_use();
+    *allocations      = stats.allocations();
+    *growths          = stats.growths();
+    *failures         = stats.failures();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Reset the device memory statistics
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_reset_device_memory_stats(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    handle->device_memory_stats.reset(handle->device_arena.in_use(),
+                                      handle->device_arena.capacity());
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Write the device memory statistics to a file as YAML
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_write_device_memory_stats(rocblas_handle handle,
+                                                            const char*    filename)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!filename)
+        return rocblas_status_invalid_pointer;
+
+    // Check that the file can be written, since rocblas_internal_ostream aborts otherwise
+    FILE* file = fopen(filename, "a");
+    if(!file)
+        return rocblas_status_invalid_value;
+    fclose(file);
+
+    rocblas_internal_ostream os(filename);
+    handle->device_memory_stats.write_yaml(os, handle->device, handle->device_arena.capacity());
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Get the latency statistics of one phase of a function
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_latency_stats(rocblas_handle        handle,
+                                                    const char*           function,
+                                                    rocblas_latency_phase phase,
+                                                    double                percentile,
+                                                    size_t*               calls,
+                                                    double*               mean_ns,
+                                                    double*               percentile_ns)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!function || !calls || !mean_ns || !percentile_ns)
+        return rocblas_status_invalid_pointer;
+    if(phase < rocblas_latency_phase_total || phase > rocblas_latency_phase_dispatch
+       || !(percentile >= 0 && percentile <= 100))
+        return rocblas_status_invalid_value;
+
+    rocblas_latency_histogram hist;
+    if(handle->latency_stats)
+        hist = handle->latency_stats->histogram(function, phase);
+    *calls         = hist.count();
+    *mean_ns       = hist.mean();
+    *percentile_ns = hist.percentile(percentile);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Reset the latency statistics
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_reset_latency_stats(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(handle->latency_stats)
+        handle->latency_stats->reset();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Write the latency statistics to a file as YAML
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_write_latency_stats(rocblas_handle handle, const char* filename)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!filename)
+        return rocblas_status_invalid_pointer;
+
+    // Check that the file can be written, since rocblas_internal_ostream aborts otherwise
+    FILE* file = fopen(filename, "a");
+    if(!file)
+        return rocblas_status_invalid_value;
+    fclose(file);
+
+    rocblas_internal_ostream os(filename);
+    if(handle->latency_stats)
+        handle->latency_stats->write_yaml(os, handle->device);
+    else
+        rocblas_latency_stats{}.write_yaml(os, handle->device);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Wait for the deferred numerical checks of the handle, and report them
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_synchronize_check_numerics(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    return handle->check_numerics_queue.flush();
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Set the policy which selects the calls checked by numerical checking
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_check_numerics_sampling(
+    rocblas_handle handle, rocblas_check_numerics_sampling policy, double value)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    return handle->check_numerics_sampler.set_policy(policy, value) ? rocblas_status_success
+                                                                    : rocblas_status_invalid_value;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Get the sampling statistics of numerical checking for a function
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_check_numerics_sampling_stats(rocblas_handle handle,
+                                                                    const char*    function,
+                                                                    size_t*        calls,
+                                                                    size_t*        sampled)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!function || !calls || !sampled)
+        return rocblas_status_invalid_pointer;
+
+    auto stats = handle->check_numerics_sampler.stats(function);
+    *calls     = stats.calls;
+    *sampled   = stats.sampled;
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
 /*******************************************************************************
  * Returns whether device memory is rocblas-managed
  ******************************************************************************/
@@ -357,9 +797,10 @@ extern "C" bool rocblas_is_managing_device_memory(rocblas_handle handle)
 {
 #if ROCBLAS_REALLOC_ON_DEMAND
     return handle
-           && handle->device_memory_owner == rocblas_device_memory_ownership::rocblas_managed;
+           && (handle->device_memory_owner == rocblas_device_memory_ownership::rocblas_managed
+               || handle->device_memory_owner == rocblas_device_memory_ownership::pool_managed);
 #else
-    return false;
+    return handle && handle->device_memory_owner == rocblas_device_memory_ownership::pool_managed;
 #endif
 }
 
@@ -560,6 +1001,8 @@ extern "C" rocblas_status rocblas_device_malloc_free(rocblas_device_malloc_base*
  *                  is not set, and the environment variable ROCBLAS_LOG_PATH is set,
  *                  then ROCBLAS_LOG_PATH indicates the name of the file to open.
  *                  Otherwise open the stream to stderr.
+ *                  If the environment variable ROCBLAS_LOG_ASYNC is set to a nonzero
+ *                  value, log lines are written without waiting for them.
  *
  *  @param[in]
  *  environment_variable_name   const char*
@@ -573,8 +1016,62 @@ static auto open_log_stream(const char* environment_variable_name)
     logfile = read_env(environment_variable_name);
     if(!logfile)
         logfile = read_env("ROCBLAS_LOG_PATH");
-    return logfile ? std::make_unique<rocblas_internal_ostream>(logfile)
-                   : std::make_unique<rocblas_internal_ostream>(STDERR_FILENO);
+    auto os = logfile ? std::make_unique<rocblas_internal_ostream>(logfile)
+                      : std::make_unique<rocblas_internal_ostream>(STDERR_FILENO);
+
+    const char* async = read_env("ROCBLAS_LOG_ASYNC");
+    os->set_async(async && strtol(async, nullptr, 0));
+    return os;
+}
+
+/**
+ *  @brief Logging function
+ *
+ *  @details
+ *  open_append_stream Return a stream opened for appending to the file filename,
+ *                     so that every handle and process writing to the file adds
+ *                     to it, or nullptr if the file cannot be opened.
+ */
+
+static std::unique_ptr<rocblas_internal_ostream> open_append_stream(const char* filename)
+{
+#ifdef WIN32
+    int fd = _open(filename, _O_WRONLY | _O_CREAT | _O_APPEND, _S_IREAD | _S_IWRITE);
+#else
+    int fd = open(filename, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+#endif
+    if(fd == -1)
+        return nullptr;
+    auto os = std::make_unique<rocblas_internal_ostream>(fd);
+    CLOSE(fd);
+    return os;
+}
+
+/**
+ *  @brief Logging function
+ *
+ *  @details
+ *  open_binary_log Return the binary log shared by all handles, creating it the first
+ *                  time. ROCBLAS_LOG_BINARY_PATH indicates the name of the file to be
+ *                  opened; if it is not set, the file is rocblas_log.bin. The log is
+ *                  closed at exit, after writing the calls logged by all handles.
+ */
+static std::shared_ptr<rocblas_binary_log> open_binary_log()
+{
+    struct closer
+    {
+        std::shared_ptr<rocblas_binary_log> log;
+        ~closer()
+        {
+            log->close();
+        }
+    };
+
+    static closer binary_log{[] {
+        const char* logfile = read_env("ROCBLAS_LOG_BINARY_PATH");
+        return std::make_shared<rocblas_binary_log>(logfile ? logfile : "rocblas_log.bin");
+    }()};
+    return binary_log.log;
 }
 
 /*******************************************************************************
@@ -588,18 +1085,39 @@ void _rocblas_handle::init_logging()
     {
         layer_mode = static_cast<rocblas_layer_mode>(strtol(str_layer_mode, 0, 0));
 
+        // open the binary log, which replaces the log_trace and log_bench files
+        if(layer_mode & rocblas_layer_mode_log_binary
+           && layer_mode & (rocblas_layer_mode_log_trace | rocblas_layer_mode_log_bench))
+        {
+            log_binary = open_binary_log();
+            if(!log_binary->is_open())
+                log_binary.reset();
+        }
+
         // open log_trace file
-        if(layer_mode & rocblas_layer_mode_log_trace)
+        if(layer_mode & rocblas_layer_mode_log_trace && !log_binary)
             log_trace_os = open_log_stream("ROCBLAS_LOG_TRACE_PATH");
 
         // open log_bench file
-        if(layer_mode & rocblas_layer_mode_log_bench)
+        if(layer_mode & rocblas_layer_mode_log_bench && !log_binary)
             log_bench_os = open_log_stream("ROCBLAS_LOG_BENCH_PATH");
 
         // open log_profile file
         if(layer_mode & rocblas_layer_mode_log_profile)
             log_profile_os = open_log_stream("ROCBLAS_LOG_PROFILE_PATH");
+
+        // measure latency
+        if(layer_mode & rocblas_layer_mode_log_latency)
+        {
+            latency_stats    = std::make_shared<rocblas_latency_stats>();
+            latency_stats_os = open_log_stream("ROCBLAS_LOG_LATENCY_PATH");
+        }
     }
+
+    // open device memory statistics file
+    const char* stats_path = read_env("ROCBLAS_DEVICE_MEMORY_STATS_PATH");
+    if(stats_path)
+        device_memory_stats_os = open_append_stream(stats_path);
 }
 
 /*******************************************************************************
@@ -654,4 +1172,10 @@ void _rocblas_handle::init_check_numerics()
         check_numerics
             = static_cast<rocblas_check_numerics_mode>(strtol(str_check_numerics_mode, 0, 0));
     }
+
+    // set the sampling policy from value of environment variable ROCBLAS_CHECK_NUMERICS_SAMPLING
+    const char* str_sampling = read_env("ROCBLAS_CHECK_NUMERICS_SAMPLING");
+    if(str_sampling && !check_numerics_sampler.parse(str_sampling))
+        rocblas_cerr << "rocBLAS warning: invalid ROCBLAS_CHECK_NUMERICS_SAMPLING \""
+                     << str_sampling << "\"; every call is checked" << std::endl;
 }
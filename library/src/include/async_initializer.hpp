@@ -0,0 +1,143 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_async_initializer runs initialization tasks in order on a         *
+ * background thread, so that the caller does not block while a library is   *
+ * loaded. Tasks submitted while others are still running are appended to    *
+ * the queue. A thread is started when tasks are submitted to an idle queue, *
+ * and exits when the queue becomes empty.                                   *
+ *                                                                           *
+ * Progress is reported as the number of tasks which have been run, out of   *
+ * all of the tasks submitted so far.                                        *
+ *****************************************************************************/
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+class rocblas_async_initializer
+{
+public:
+    // A task returns false, or throws an exception, if it fails
+    using task = std::function<bool()>;
+
+private:
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_idle;
+    std::deque<task>        m_queue;
+    std::future<void>       m_worker;
+    bool                    m_running   = false;
+    size_t                  m_completed = 0;
+    size_t                  m_failed    = 0;
+    size_t                  m_total     = 0;
+
+    // Run tasks until the queue is empty
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(!m_queue.empty())
+        {
+            task t = std::move(m_queue.front());
+            m_queue.pop_front();
+            lock.unlock();
+
+            bool success = false;
+            try
+            {
+                success = t();
+            }
+            catch(...)
+            {
+            }
+
+            // Destroy the task, and whatever it captured, before reporting it as completed
+            t = nullptr;
+
+            lock.lock();
+            m_completed += 1;
+            m_failed += !success;
+        }
+        m_running = false;
+        m_idle.notify_all();
+    }
+
+public:
+    rocblas_async_initializer() = default;
+
+    // Tasks which have been submitted are run before the initializer is destroyed
+    ~rocblas_async_initializer()
+    {
+        wait();
+    }
+
+    // The initializer is not copyable or assignable
+    rocblas_async_initializer(const rocblas_async_initializer&) = delete;
+    rocblas_async_initializer& operator=(const rocblas_async_initializer&) = delete;
+
+    // Queue tasks to be run after those already submitted
+    void submit(std::vector<task> tasks)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_total += tasks.size();
+        for(auto& t : tasks)
+            m_queue.push_back(std::move(t));
+
+        // The previous thread, if any, has set m_running to false and is exiting
+        if(!m_running && !m_queue.empty())
+        {
+            m_running = true;
+            m_worker  = std::async(std::launch::async, [this] { run(); });
+        }
+    }
+
+    // Block until all of the submitted tasks have been run
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return !m_running; });
+    }
+
+    // Returns true if all of the submitted tasks have been run. completed and total
+    // are set to the number of tasks which have been run, and which have been submitted.
+    bool progress(size_t& completed, size_t& total) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        completed = m_completed;
+        total     = m_total;
+        return !m_running;
+    }
+
+    // Number of tasks which have failed
+    size_t failed() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_failed;
+    }
+};
@@ -0,0 +1,546 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Stream-ordered staging of strided and batched matrix transfers, used by   *
+ * rocblas_set_matrix_async, rocblas_get_matrix_async and the batched set    *
+ * and get matrix functions. Host packing and unpacking are enqueued on the  *
+ * stream as host functions, and the device side is copied by a kernel on    *
+ * the stream, so the calling thread returns as soon as the transfer is      *
+ * enqueued, and the host data is read or written when the stream reaches    *
+ * the transfer.                                                             *
+ *                                                                           *
+ * The matrices of a batch are moved in chunks of consecutive matrices, as   *
+ * planned by rocblas_batched_transfer_plan. Each chunk is packed into one   *
+ * staging buffer, moved by one copy, and unpacked by one kernel launch.     *
+ *                                                                           *
+ * The staging buffers are kept by a rocblas_deferred_release until an       *
+ * event recorded after the transfer has completed. It uses Events with the  *
+ * same interface as for rocblas_workspace_pool, except that wait() is not   *
+ * needed.                                                                   *
+ *                                                                           *
+ * HIP is reached through a Runtime, so that transfers can be tested with a  *
+ * host emulation of a stream. A Runtime must provide:                       *
+ *                                                                           *
+ *     using stream_t = ...;                                                 *
+ *     using host_buffer_t = ...;   // leases with get() and operator bool   *
+ *     using device_buffer_t = ...;                                          *
+ *     host_buffer_t lease_host(size_t size);                                *
+ *     device_buffer_t lease_device(size_t size);                            *
+ *     bool host_func(stream_t stream, void (*fn)(void*), void* arg);        *
+ *     bool copy(void* dst, const void* src, size_t size, bool to_device,    *
+ *               stream_t stream);                                           *
+ *     template <typename U, typename V>   // on the device, for each matrix *
+ *     bool copy_matrix(size_t rows, size_t cols, size_t elem_size,          *
+ *                      U a, size_t stride_a, size_t lda,                    *
+ *                      V b, size_t stride_b, size_t ldb,                    *
+ *                      size_t batch_count, stream_t stream);                *
+ *     bool defer(std::unique_ptr<rocblas_async_staging<Runtime>>& staging,  *
+ *                stream_t stream);                   // false if it fails   *
+ *     bool synchronize(stream_t stream);                                    *
+ *                                                                           *
+ * U and V address the matrices of a batch like the arguments of batched     *
+ * kernels: a char pointer and a stride in bytes, or an array of pointers    *
+ * and an offset in bytes. See rocblas_batched_tile.                         *
+ *****************************************************************************/
+
+#include "rocblas.h"
+#include "strided_copy.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+template <typename Events, typename Resource>
+class rocblas_deferred_release
+{
+public:
+    using stream_t = typename Events::stream_t;
+    using event_t  = typename Events::event_t;
+
+private:
+    struct pending_t
+    {
+        Resource resource;
+        event_t  event;
+    };
+
+    mutable std::mutex     m_mutex;
+    Events                 m_events;
+    std::vector<pending_t> m_pending;
+    std::vector<event_t>   m_idle_events; // events of released resources, for reuse
+
+    // Release the resources whose events have completed. Lock must be held.
+    size_t collect_locked()
+    {
+        size_t released = 0;
+        for(size_t i = 0; i < m_pending.size();)
+        {
+            if(m_events.query(m_pending[i].event))
+            {
+                m_idle_events.push_back(m_pending[i].event);
+                std::swap(m_pending[i], m_pending.back());
+                m_pending.pop_back();
+                released += 1;
+            }
+            else
+                ++i;
+        }
+        return released;
+    }
+
+public:
+    explicit rocblas_deferred_release(Events events = Events{})
+        : m_events(std::move(events))
+    {
+    }
+
+    // Pending resources are destroyed without waiting for their events
+    ~rocblas_deferred_release()
+    {
+        for(auto& pending : m_pending)
+            m_events.destroy(pending.event);
+        for(auto event : m_idle_events)
+            m_events.destroy(event);
+    }
+
+    // The object is not copyable or assignable
+    rocblas_deferred_release(const rocblas_deferred_release&) = delete;
+    rocblas_deferred_release& operator=(const rocblas_deferred_release&) = delete;
+
+    // Keep resource until the work enqueued on stream so far has completed. Completed
+    // resources are released first. Returns false if no event can be recorded, in
+    // which case resource is not moved from.
+    bool defer(Resource& resource, stream_t stream)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        collect_locked();
+
+        event_t event{};
+        if(!m_idle_events.empty())
+        {
+            event = m_idle_events.back();
+            m_idle_events.pop_back();
+        }
+        if(!m_events.record(event, stream))
+        {
+            if(event != event_t{})
+                m_idle_events.push_back(event);
+            return false;
+        }
+        m_pending.push_back({std::move(resource), event});
+        return true;
+    }
+
+    // Release the resources whose events have completed, returning how many were released
+    size_t collect()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return collect_locked();
+    }
+
+    // Number of resources which have not been released
+    size_t pending() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending.size();
+    }
+
+    // Number of events created, pending or idle
+    size_t event_count() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending.size() + m_idle_events.size();
+    }
+};
+
+// Largest size of the staging buffers of a batched transfer, and largest number of matrices
+// unpacked by one kernel launch
+constexpr size_t ROCBLAS_BATCHED_TRANSFER_MAX_BYTES = 16 << 20;
+constexpr size_t ROCBLAS_BATCHED_TRANSFER_MAX_TILES = 65535;
+
+// Matrix i of a batch, from a pointer and a stride in bytes
+template <typename T>
+T* rocblas_batched_tile(T* p, size_t i, size_t stride)
+{
+    return p + i * stride;
+}
+
+// Matrix i of a batch, from an array of pointers and an offset in bytes
+template <typename T>
+T* rocblas_batched_tile(T* const* p, size_t i, size_t offset)
+{
+    return p[i] + offset;
+}
+
+template <typename T>
+T* rocblas_batched_tile(T** p, size_t i, size_t offset)
+{
+    return p[i] + offset;
+}
+
+// Batch starting at matrix i. Arrays of pointers are not dereferenced, so that they can be
+// in device memory.
+template <typename T>
+T* rocblas_batched_offset(T* p, size_t i, size_t stride)
+{
+    return p + i * stride;
+}
+
+template <typename T>
+T* const* rocblas_batched_offset(T* const* p, size_t i, size_t)
+{
+    return p + i;
+}
+
+template <typename T>
+T* const* rocblas_batched_offset(T** p, size_t i, size_t)
+{
+    return p + i;
+}
+
+// Coalescing plan of a batched transfer of rows x cols matrices. Consecutive matrices are
+// grouped into chunks, which are packed into staging buffers of buffer_bytes() bytes.
+struct rocblas_batched_transfer_plan
+{
+    size_t row_bytes   = 0;
+    size_t cols        = 0;
+    size_t tile_bytes  = 0; // bytes of a packed matrix
+    size_t batch_count = 0;
+    size_t chunk_tiles = 0; // matrices per chunk, except the last one
+
+    rocblas_batched_transfer_plan(size_t rows,
+                                  size_t cols,
+                                  size_t elem_size,
+                                  size_t batch_count,
+                                  size_t max_bytes = ROCBLAS_BATCHED_TRANSFER_MAX_BYTES,
+                                  size_t max_tiles = ROCBLAS_BATCHED_TRANSFER_MAX_TILES)
+        : row_bytes(rows * elem_size)
+        , cols(cols)
+        , tile_bytes(rows * elem_size * cols)
+        , batch_count(batch_count)
+    {
+        // A chunk has at least one matrix, even if it is larger than max_bytes
+        chunk_tiles = max_bytes / std::max<size_t>(1, tile_bytes);
+        chunk_tiles = std::max<size_t>(1, std::min(chunk_tiles, max_tiles));
+        chunk_tiles = std::min(chunk_tiles, std::max<size_t>(1, batch_count));
+    }
+
+    size_t chunks() const
+    {
+        return (batch_count + chunk_tiles - 1) / chunk_tiles;
+    }
+
+    // First matrix of a chunk
+    size_t first(size_t chunk) const
+    {
+        return chunk * chunk_tiles;
+    }
+
+    // Number of matrices in a chunk
+    size_t count(size_t chunk) const
+    {
+        return std::min(chunk_tiles, batch_count - first(chunk));
+    }
+
+    size_t buffer_bytes() const
+    {
+        return chunk_tiles * tile_bytes;
+    }
+
+    // Whether the matrices of a chunk are contiguous in memory, so that they need no staging.
+    // Matrices from arrays of pointers are never contiguous.
+    template <typename T>
+    bool contiguous(T*, size_t ld_bytes, size_t stride) const
+    {
+        return ld_bytes == row_bytes && (batch_count == 1 || stride == tile_bytes);
+    }
+
+    template <typename T>
+    bool contiguous(T* const*, size_t, size_t) const
+    {
+        return false;
+    }
+
+    template <typename T>
+    bool contiguous(T**, size_t, size_t) const
+    {
+        return false;
+    }
+};
+
+// Staging buffers of an asynchronous transfer, with the matrices of its host copies
+template <typename Runtime>
+struct rocblas_async_staging
+{
+    // Argument of the host copy of a chunk
+    struct chunk_t
+    {
+        rocblas_async_staging* staging;
+        size_t                 first;
+        size_t                 count;
+    };
+
+    typename Runtime::host_buffer_t   host;
+    typename Runtime::device_buffer_t device;
+
+    // Host matrices, which are recorded when the transfer is enqueued because an array of
+    // pointers may be freed before the stream reaches the host copy
+    std::vector<char*>   tiles;
+    std::vector<chunk_t> chunks;
+    size_t               ld_bytes   = 0;
+    size_t               row_bytes  = 0;
+    size_t               cols       = 0;
+    bool                 to_buffer  = true; // pack the matrices, or unpack them
+    size_t               tile_bytes = 0;
+
+    // Record the host matrices of a batch and the chunks of plan
+    template <typename T>
+    void set_host_tiles(
+        T p, size_t ld, size_t stride, const rocblas_batched_transfer_plan& plan, bool pack)
+    {
+        tiles.resize(plan.batch_count);
+        for(size_t i = 0; i < plan.batch_count; ++i)
+            tiles[i] = (char*)rocblas_batched_tile(p, i, stride);
+        chunks.resize(plan.chunks());
+        for(size_t k = 0; k < chunks.size(); ++k)
+            chunks[k] = {this, plan.first(k), plan.count(k)};
+        ld_bytes   = ld;
+        row_bytes  = plan.row_bytes;
+        cols       = plan.cols;
+        tile_bytes = plan.tile_bytes;
+        to_buffer  = pack;
+    }
+
+    // Host function which packs or unpacks the host matrices of a chunk
+    static void host_copy(void* arg)
+    {
+        auto* c      = static_cast<chunk_t*>(arg);
+        auto* s      = c->staging;
+        char* packed = static_cast<char*>(s->host.get());
+        for(size_t i = c->first; i < c->first + c->count; ++i, packed += s->tile_bytes)
+        {
+            if(s->to_buffer)
+                rocblas_strided_copy_2d(
+                    packed, s->row_bytes, s->tiles[i], s->ld_bytes, s->row_bytes, s->cols);
+            else
+                rocblas_strided_copy_2d(
+                    s->tiles[i], s->ld_bytes, packed, s->row_bytes, s->row_bytes, s->cols);
+        }
+    }
+};
+
+// Hand the staging buffers over to the runtime until the stream has completed the transfer,
+// or wait for the stream if that fails. Returns status, or rocblas_status_internal_error if
+// the stream could not be synchronized.
+template <typename Runtime>
+rocblas_status
+    rocblas_async_staging_release(Runtime&                                         runtime,
+                                  std::unique_ptr<rocblas_async_staging<Runtime>>& staging,
+                                  typename Runtime::stream_t                       stream,
+                                  rocblas_status                                   status)
+{
+    if(!runtime.defer(staging, stream) && !runtime.synchronize(stream))
+        return rocblas_status_internal_error;
+    return status;
+}
+
+// Enqueue the copy of batch_count rows x cols matrices a_h on the host, with leading dimension
+// lda, to b_d on the device, with leading dimension ldb. Strides and offsets are in bytes. The
+// staging buffers are reused by the chunks in stream order. Returns rocblas_status_memory_error,
+// without enqueuing anything, if the staging buffers cannot be leased.
+template <typename Runtime, typename U, typename V>
+rocblas_status rocblas_set_matrix_batched_staged(
+    Runtime&                   runtime,
+    size_t                     rows,
+    size_t                     cols,
+    size_t                     elem_size,
+    U                          a_h,
+    size_t                     lda,
+    size_t                     stride_a,
+    V                          b_d,
+    size_t                     ldb,
+    size_t                     stride_b,
+    size_t                     batch_count,
+    typename Runtime::stream_t stream,
+    size_t                     max_bytes = ROCBLAS_BATCHED_TRANSFER_MAX_BYTES)
+{
+    rocblas_batched_transfer_plan plan(rows, cols, elem_size, batch_count, max_bytes);
+    bool pack_host     = !plan.contiguous(a_h, lda * elem_size, stride_a);
+    bool unpack_device = !plan.contiguous(b_d, ldb * elem_size, stride_b);
+
+    auto staging = std::make_unique<rocblas_async_staging<Runtime>>();
+    if(pack_host && !(staging->host = runtime.lease_host(plan.buffer_bytes())))
+        return rocblas_status_memory_error;
+    if(unpack_device && !(staging->device = runtime.lease_device(plan.buffer_bytes())))
+        return rocblas_status_memory_error;
+    if(pack_host)
+        staging->set_host_tiles(a_h, lda * elem_size, stride_a, plan, true);
+
+    bool ok = true;
+    for(size_t k = 0; ok && k < plan.chunks(); ++k)
+    {
+        size_t first = plan.first(k), count = plan.count(k);
+
+        // non-contiguous host matrices -> host buffer
+        const void* src = pack_host ? staging->host.get() : nullptr;
+        if(pack_host)
+            ok = runtime.host_func(
+                stream, rocblas_async_staging<Runtime>::host_copy, &staging->chunks[k]);
+        else
+            src = rocblas_batched_tile(a_h, first, stride_a);
+
+        // host buffer or contiguous host matrices -> device buffer or contiguous device matrices
+        void* dst = unpack_device ? staging->device.get() : nullptr;
+        if(!unpack_device)
+            dst = rocblas_batched_tile(b_d, first, stride_b);
+        ok = ok && runtime.copy(dst, src, count * plan.tile_bytes, true, stream);
+
+        // device buffer -> non-contiguous device matrices
+        if(ok && unpack_device)
+            ok = runtime.copy_matrix(rows,
+                                     cols,
+                                     elem_size,
+                                     (const char*)dst,
+                                     plan.tile_bytes,
+                                     rows,
+                                     rocblas_batched_offset(b_d, first, stride_b),
+                                     stride_b,
+                                     ldb,
+                                     count,
+                                     stream);
+    }
+
+    return rocblas_async_staging_release(
+        runtime, staging, stream, ok ? rocblas_status_success : rocblas_status_internal_error);
+}
+
+// Enqueue the copy of batch_count rows x cols matrices a_d on the device, with leading
+// dimension lda, to b_h on the host, with leading dimension ldb. Strides and offsets are in
+// bytes. The staging buffers are reused by the chunks in stream order. Returns
+// rocblas_status_memory_error, without enqueuing anything, if the staging buffers cannot be
+// leased.
+template <typename Runtime, typename U, typename V>
+rocblas_status rocblas_get_matrix_batched_staged(
+    Runtime&                   runtime,
+    size_t                     rows,
+    size_t                     cols,
+    size_t                     elem_size,
+    U                          a_d,
+    size_t                     lda,
+    size_t                     stride_a,
+    V                          b_h,
+    size_t                     ldb,
+    size_t                     stride_b,
+    size_t                     batch_count,
+    typename Runtime::stream_t stream,
+    size_t                     max_bytes = ROCBLAS_BATCHED_TRANSFER_MAX_BYTES)
+{
+    rocblas_batched_transfer_plan plan(rows, cols, elem_size, batch_count, max_bytes);
+    bool pack_device = !plan.contiguous(a_d, lda * elem_size, stride_a);
+    bool unpack_host = !plan.contiguous(b_h, ldb * elem_size, stride_b);
+
+    auto staging = std::make_unique<rocblas_async_staging<Runtime>>();
+    if(pack_device && !(staging->device = runtime.lease_device(plan.buffer_bytes())))
+        return rocblas_status_memory_error;
+    if(unpack_host && !(staging->host = runtime.lease_host(plan.buffer_bytes())))
+        return rocblas_status_memory_error;
+    if(unpack_host)
+        staging->set_host_tiles(b_h, ldb * elem_size, stride_b, plan, false);
+
+    bool ok = true;
+    for(size_t k = 0; ok && k < plan.chunks(); ++k)
+    {
+        size_t first = plan.first(k), count = plan.count(k);
+
+        // non-contiguous device matrices -> device buffer
+        const void* src = pack_device ? staging->device.get() : nullptr;
+        if(pack_device)
+            ok = runtime.copy_matrix(rows,
+                                     cols,
+                                     elem_size,
+                                     rocblas_batched_offset(a_d, first, stride_a),
+                                     stride_a,
+                                     lda,
+                                     (char*)src,
+                                     plan.tile_bytes,
+                                     rows,
+                                     count,
+                                     stream);
+        else
+            src = rocblas_batched_tile(a_d, first, stride_a);
+
+        // device buffer or contiguous device matrices -> host buffer or contiguous host matrices
+        void* dst = unpack_host ? staging->host.get() : nullptr;
+        if(!unpack_host)
+            dst = rocblas_batched_tile(b_h, first, stride_b);
+        ok = ok && runtime.copy(dst, src, count * plan.tile_bytes, false, stream);
+
+        // host buffer -> non-contiguous host matrices
+        if(ok && unpack_host)
+            ok = runtime.host_func(
+                stream, rocblas_async_staging<Runtime>::host_copy, &staging->chunks[k]);
+    }
+
+    return rocblas_async_staging_release(
+        runtime, staging, stream, ok ? rocblas_status_success : rocblas_status_internal_error);
+}
+
+// Enqueue the copy of a rows x cols matrix a_h on the host, with leading dimension lda, to
+// b_d on the device, with leading dimension ldb. Returns rocblas_status_memory_error, without
+// enqueuing anything, if the staging buffers cannot be leased.
+template <typename Runtime>
+rocblas_status rocblas_set_matrix_async_staged(Runtime&                   runtime,
+                                               size_t                     rows,
+                                               size_t                     cols,
+                                               size_t                     elem_size,
+                                               const void*                a_h,
+                                               size_t                     lda,
+                                               void*                      b_d,
+                                               size_t                     ldb,
+                                               typename Runtime::stream_t stream)
+{
+    return rocblas_set_matrix_batched_staged(
+        runtime, rows, cols, elem_size, (const char*)a_h, lda, 0, (char*)b_d, ldb, 0, 1, stream);
+}
+
+// Enqueue the copy of a rows x cols matrix a_d on the device, with leading dimension lda, to
+// b_h on the host, with leading dimension ldb. Returns rocblas_status_memory_error, without
+// enqueuing anything, if the staging buffers cannot be leased.
+template <typename Runtime>
+rocblas_status rocblas_get_matrix_async_staged(Runtime&                   runtime,
+                                               size_t                     rows,
+                                               size_t                     cols,
+                                               size_t                     elem_size,
+                                               const void*                a_d,
+                                               size_t                     lda,
+                                               void*                      b_h,
+                                               size_t                     ldb,
+                                               typename Runtime::stream_t stream)
+{
+    return rocblas_get_matrix_batched_staged(
+        runtime, rows, cols, elem_size, (const char*)a_d, lda, 0, (char*)b_h, ldb, 0, 1, stream);
+}
@@ -0,0 +1,785 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_binary_log records the arguments of trace and bench logging as    *
+ * fixed-size binary records, instead of formatting them as text.            *
+ *                                                                           *
+ * Each thread writes its records to a ring buffer of its own, without       *
+ * locking. A background thread drains the rings into the log file           *
+ * periodically, and when a ring is half full. Calls which do not fit in a   *
+ * full ring are dropped and counted, rather than blocking the caller.       *
+ *                                                                           *
+ * Each argument is stored as a type tag and a 64-bit value. Strings are     *
+ * interned: a string is written to the file once, and records refer to it   *
+ * by ID. A call whose arguments do not fit in one record continues in the   *
+ * following records of the same ring.                                       *
+ *                                                                           *
+ * rocblas_binary_log_decoder converts a log file back into the text of the  *
+ * trace and bench logs, by streaming each argument with its original type.  *
+ *****************************************************************************/
+
+#include "rocblas_ostream.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Version of the file format
+constexpr uint32_t ROCBLAS_BINARY_LOG_VERSION = 1;
+
+// Argument slots in each record, and in each call
+constexpr size_t ROCBLAS_BINARY_LOG_RECORD_SLOTS = 24;
+constexpr size_t ROCBLAS_BINARY_LOG_CALL_SLOTS   = 96;
+
+// Records in each thread's ring buffer, which must be a power of 2
+constexpr size_t ROCBLAS_BINARY_LOG_RING_RECORDS = 4096;
+
+// Maximum number of distinct strings. Further strings are logged as unknown.
+constexpr uint32_t ROCBLAS_BINARY_LOG_MAX_STRINGS = 1 << 16;
+
+// Interval at which the rings are drained
+constexpr std::chrono::milliseconds ROCBLAS_BINARY_LOG_FLUSH_INTERVAL{100};
+
+// The log which a call was made to
+enum class rocblas_log_kind : uint8_t
+{
+    trace,
+    bench,
+};
+
+// Type of a logged argument
+enum class rocblas_log_tag : uint8_t
+{
+    none,
+    i32,
+    u32,
+    i64,
+    u64,
+    f32,
+    f64,
+    c32,          // both parts in one slot
+    c64,          // real part, followed by a slot with the imaginary part
+    boolean,
+    character,
+    pointer,
+    string,       // string ID
+    bench_scalar, // string ID of the name, followed by the slots of the value
+    datatype,
+    operation,
+    fill,
+    diagonal,
+    side,
+    status,
+    atomics_mode,
+    gemm_flags,
+};
+
+/*********************************************************************
+ * A named scalar argument of bench logging, output as --name value, *
+ * followed by --namei value for a nonzero imaginary part            *
+ *********************************************************************/
+template <typename T>
+struct rocblas_log_bench_scalar
+{
+    const char* name;
+    T           value;
+
+    // x is passed by value, so that this is preferred to the generic output of any type
+    friend rocblas_internal_ostream& operator<<(rocblas_internal_ostream&   os,
+                                                rocblas_log_bench_scalar<T> x)
+    {
+        os << "--" << x.name << " ";
+        if constexpr(rocblas_is_complex<T>)
+        {
+            os << std::real(x.value);
+            if(std::imag(x.value))
+                os << " --" << x.name << "i " << std::imag(x.value);
+        }
+        else
+            os << x.value;
+        return os;
+    }
+};
+
+class rocblas_binary_log
+{
+public:
+    enum record_flags : uint8_t
+    {
+        continued = 1, // the call continues in the next record
+        truncated = 2, // the call had more arguments than could be logged
+    };
+
+    struct record_t
+    {
+        uint64_t timestamp; // steady clock, in nanoseconds
+        uint64_t handle;
+        uint32_t thread; // number of the thread's ring, in order of creation
+        uint8_t  kind;
+        uint8_t  count; // slots used
+        uint8_t  flags;
+        uint8_t  reserved;
+        uint8_t  tags[ROCBLAS_BINARY_LOG_RECORD_SLOTS];
+        uint64_t values[ROCBLAS_BINARY_LOG_RECORD_SLOTS];
+    };
+
+    struct header_t
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t record_size;
+    };
+
+    // The file is a header followed by chunks
+    enum chunk_type : uint32_t
+    {
+        chunk_string  = 1, // uint32_t ID followed by the characters
+        chunk_records = 2, // array of record_t
+        chunk_dropped = 3, // uint64_t number of calls dropped
+    };
+
+    struct chunk_t
+    {
+        uint32_t type;
+        uint32_t size; // bytes following the chunk header
+    };
+
+    static constexpr uint32_t unknown_string = ~uint32_t{0};
+
+private:
+    struct ring_t
+    {
+        std::vector<record_t> records = std::vector<record_t>(ROCBLAS_BINARY_LOG_RING_RECORDS);
+        std::atomic<size_t>   head{0}; // written by the thread
+        std::atomic<size_t>   tail{0}; // written by the flusher
+        std::atomic<bool>     retired{false};
+        uint32_t              thread = 0;
+
+        // String IDs already interned by the thread, which only it uses
+        std::unordered_map<const char*, uint32_t> literals;
+        std::unordered_map<std::string, uint32_t> strings;
+    };
+
+    // A thread's reference to its ring in a log
+    struct local_t
+    {
+        uint64_t                owner = 0;
+        std::shared_ptr<ring_t> ring;
+
+        ~local_t()
+        {
+            if(ring)
+                ring->retired = true;
+        }
+    };
+
+    static uint64_t next_id()
+    {
+        static std::atomic<uint64_t> id{0};
+        return ++id;
+    }
+
+    const uint64_t m_id = next_id();
+    FILE*          m_file;
+
+    std::mutex                                m_mutex;
+    std::condition_variable                   m_wake;
+    std::vector<std::shared_ptr<ring_t>>      m_rings;
+    uint32_t                                  m_threads = 0;
+    std::unordered_map<std::string, uint32_t> m_string_ids;
+    std::vector<std::string>                  m_strings;
+    size_t                                    m_strings_written = 0;
+    std::atomic<uint64_t>                     m_dropped{0};
+    std::atomic<bool>                         m_open{false};
+    bool                                      m_stop = false;
+    std::thread                               m_flusher;
+
+    void write_chunk(chunk_type type, const void* data, size_t size)
+    {
+        chunk_t chunk{type, uint32_t(size)};
+        fwrite(&chunk, sizeof(chunk), 1, m_file);
+        fwrite(data, 1, size, m_file);
+    }
+
+    // Write new strings, records and dropped counts to the file. Lock must be held.
+    void drain()
+    {
+        for(; m_strings_written < m_strings.size(); ++m_strings_written)
+        {
+            const std::string& str = m_strings[m_strings_written];
+            std::vector<char>  data(sizeof(uint32_t) + str.size());
+            uint32_t           id = uint32_t(m_strings_written);
+            memcpy(data.data(), &id, sizeof(id));
+            memcpy(data.data() + sizeof(id), str.data(), str.size());
+            write_chunk(chunk_string, data.data(), data.size());
+        }
+
+        for(auto& ring : m_rings)
+        {
+            // A retired ring is no longer written, so it is drained for the last time
+            bool   retired = ring->retired;
+            size_t head    = ring->head.load(std::memory_order_acquire);
+            size_t tail    = ring->tail.load(std::memory_order_relaxed);
+            while(tail != head)
+            {
+                // Write the records up to the end of the ring, or up to head
+                size_t first = tail % ROCBLAS_BINARY_LOG_RING_RECORDS;
+                size_t count = std::min(head - tail, ROCBLAS_BINARY_LOG_RING_RECORDS - first);
+                write_chunk(chunk_records, &ring->records[first], count * sizeof(record_t));
+                tail += count;
+            }
+            ring->tail.store(tail, std::memory_order_release);
+            if(retired)
+                ring.reset();
+        }
+        m_rings.erase(std::remove(m_rings.begin(), m_rings.end(), nullptr), m_rings.end());
+
+        uint64_t dropped = m_dropped.exchange(0);
+        if(dropped)
+            write_chunk(chunk_dropped, &dropped, sizeof(dropped));
+        fflush(m_file);
+    }
+
+    void flusher()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(!m_stop)
+        {
+            m_wake.wait_for(lock, ROCBLAS_BINARY_LOG_FLUSH_INTERVAL);
+            drain();
+        }
+    }
+
+    // The calling thread's ring, which is created the first time it logs a call
+    ring_t* get_ring()
+    {
+        static thread_local local_t local;
+        if(local.owner != m_id)
+        {
+            if(local.ring)
+                local.ring->retired = true;
+            auto ring = std::make_shared<ring_t>();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ring->thread = m_threads++;
+                m_rings.push_back(ring);
+            }
+            local.owner = m_id;
+            local.ring  = std::move(ring);
+        }
+        return local.ring.get();
+    }
+
+    // Look up the ID of a string, adding it if it is new
+    uint32_t intern(const std::string& str)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        p = m_string_ids.find(str);
+        if(p != m_string_ids.end())
+            return p->second;
+        if(m_strings.size() >= ROCBLAS_BINARY_LOG_MAX_STRINGS)
+            return unknown_string;
+        uint32_t id = uint32_t(m_strings.size());
+        m_strings.push_back(str);
+        m_string_ids.emplace(str, id);
+        return id;
+    }
+
+    // The arguments of one call, before they are split into records
+    class call_t
+    {
+        rocblas_binary_log& m_log;
+        ring_t&             m_ring;
+
+    public:
+        uint8_t  tags[ROCBLAS_BINARY_LOG_CALL_SLOTS];
+        uint64_t values[ROCBLAS_BINARY_LOG_CALL_SLOTS];
+        size_t   count     = 0;
+        bool     truncated = false;
+
+        call_t(rocblas_binary_log& log, ring_t& ring)
+            : m_log(log)
+            , m_ring(ring)
+        {
+        }
+
+        template <typename T>
+        void put(rocblas_log_tag tag, const T& value)
+        {
+            static_assert(sizeof(T) <= sizeof(uint64_t), "Slot values are 64 bits");
+            if(count == ROCBLAS_BINARY_LOG_CALL_SLOTS)
+            {
+                truncated = true;
+                return;
+            }
+            uint64_t bits = 0;
+            memcpy(&bits, &value, sizeof(T));
+            tags[count]   = uint8_t(tag);
+            values[count] = bits;
+            ++count;
+        }
+
+        // C strings are logged function names, options and enum names, which are string
+        // literals, so they are looked up by address only. Other strings are std::string.
+        void put_string(rocblas_log_tag tag, const char* str)
+        {
+            if(!str)
+                str = "(null)";
+            auto p = m_ring.literals.find(str);
+            if(p == m_ring.literals.end())
+                p = m_ring.literals.emplace(str, m_log.intern(str)).first;
+            put(tag, p->second);
+        }
+
+        void put_string(rocblas_log_tag tag, const std::string& str)
+        {
+            auto p = m_ring.strings.find(str);
+            if(p == m_ring.strings.end())
+                p = m_ring.strings.emplace(str, m_log.intern(str)).first;
+            put(tag, p->second);
+        }
+
+        template <typename T>
+        void add(const T& x)
+        {
+            using U = std::decay_t<T>;
+            if constexpr(std::is_same<U, rocblas_half>{} || std::is_same<U, rocblas_bfloat16>{})
+                put(rocblas_log_tag::f32, float(x));
+            else if constexpr(std::is_same<U, bool>{})
+                put(rocblas_log_tag::boolean, x);
+            else if constexpr(std::is_same<U, char>{})
+                put(rocblas_log_tag::character, x);
+            else if constexpr(std::is_same<U, rocblas_datatype>{})
+                put(rocblas_log_tag::datatype, x);
+            else if constexpr(std::is_same<U, rocblas_operation>{})
+                put(rocblas_log_tag::operation, x);
+            else if constexpr(std::is_same<U, rocblas_fill>{})
+                put(rocblas_log_tag::fill, x);
+            else if constexpr(std::is_same<U, rocblas_diagonal>{})
+                put(rocblas_log_tag::diagonal, x);
+            else if constexpr(std::is_same<U, rocblas_side>{})
+                put(rocblas_log_tag::side, x);
+            else if constexpr(std::is_same<U, rocblas_status>{})
+                put(rocblas_log_tag::status, x);
+            else if constexpr(std::is_same<U, rocblas_atomics_mode>{})
+                put(rocblas_log_tag::atomics_mode, x);
+            else if constexpr(std::is_same<U, rocblas_gemm_flags>{})
+                put(rocblas_log_tag::gemm_flags, x);
+            else if constexpr(std::is_enum<U>{})
+                add(std::underlying_type_t<U>(x));
+            else if constexpr(std::is_integral<U>{} && std::is_signed<U>{})
+            {
+                if constexpr(sizeof(U) <= sizeof(int32_t))
+                    put(rocblas_log_tag::i32, int32_t(x));
+                else
+                    put(rocblas_log_tag::i64, int64_t(x));
+            }
+            else if constexpr(std::is_integral<U>{})
+            {
+                if constexpr(sizeof(U) <= sizeof(uint32_t))
+                    put(rocblas_log_tag::u32, uint32_t(x));
+                else
+                    put(rocblas_log_tag::u64, uint64_t(x));
+            }
+            else if constexpr(std::is_same<U, float>{})
+                put(rocblas_log_tag::f32, x);
+            else if constexpr(std::is_same<U, double>{})
+                put(rocblas_log_tag::f64, x);
+            else if constexpr(std::is_same<U, rocblas_float_complex>{})
+                put(rocblas_log_tag::c32, x);
+            else if constexpr(std::is_same<U, rocblas_double_complex>{})
+            {
+                put(rocblas_log_tag::c64, std::real(x));
+                put(rocblas_log_tag::none, std::imag(x));
+            }
+            else if constexpr(std::is_same<U, const char*>{} || std::is_same<U, char*>{})
+                put_string(rocblas_log_tag::string, x);
+            else if constexpr(std::is_same<U, std::string>{})
+                put_string(rocblas_log_tag::string, x);
+            else if constexpr(std::is_pointer<U>{})
+                put(rocblas_log_tag::pointer, reinterpret_cast<uintptr_t>(x));
+            else
+                add_bench_scalar(x);
+        }
+
+        template <typename T>
+        void add_bench_scalar(const rocblas_log_bench_scalar<T>& x)
+        {
+            put_string(rocblas_log_tag::bench_scalar, x.name);
+            add(x.value);
+        }
+    };
+
+    // Copy a call to the ring as consecutive records, or drop it if the ring is full
+    void push(ring_t& ring, rocblas_log_kind kind, const void* handle, const call_t& call)
+    {
+        size_t n    = std::max<size_t>(1, (call.count + ROCBLAS_BINARY_LOG_RECORD_SLOTS - 1)
+                                           / ROCBLAS_BINARY_LOG_RECORD_SLOTS);
+        size_t head = ring.head.load(std::memory_order_relaxed);
+        size_t tail = ring.tail.load(std::memory_order_acquire);
+        if(head - tail + n > ROCBLAS_BINARY_LOG_RING_RECORDS)
+        {
+            m_dropped += 1;
+            m_wake.notify_one();
+            return;
+        }
+
+        uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now().time_since_epoch())
+                                 .count();
+        for(size_t i = 0; i < n; ++i)
+        {
+            record_t& r = ring.records[(head + i) % ROCBLAS_BINARY_LOG_RING_RECORDS];
+            size_t    first = i * ROCBLAS_BINARY_LOG_RECORD_SLOTS;
+            size_t    count = std::min(call.count - first, ROCBLAS_BINARY_LOG_RECORD_SLOTS);
+            r.timestamp     = timestamp;
+            r.handle        = reinterpret_cast<uintptr_t>(handle);
+            r.thread        = ring.thread;
+            r.kind          = uint8_t(kind);
+            r.count         = uint8_t(count);
+            r.flags         = (i + 1 < n ? continued : 0) | (call.truncated ? truncated : 0);
+            r.reserved      = 0;
+            memcpy(r.tags, call.tags + first, count);
+            memcpy(r.values, call.values + first, count * sizeof(uint64_t));
+        }
+        ring.head.store(head + n, std::memory_order_release);
+
+        // Wake the flusher when the ring becomes half full
+        if(head - tail < ROCBLAS_BINARY_LOG_RING_RECORDS / 2
+           && head + n - tail >= ROCBLAS_BINARY_LOG_RING_RECORDS / 2)
+            m_wake.notify_one();
+    }
+
+public:
+    static_assert((ROCBLAS_BINARY_LOG_RING_RECORDS & (ROCBLAS_BINARY_LOG_RING_RECORDS - 1)) == 0,
+                  "The ring size must be a power of 2");
+
+    // Create the log file at path, and start the flusher. The log is closed if the
+    // file cannot be created.
+    explicit rocblas_binary_log(const std::string& path)
+        : m_file(fopen(path.c_str(), "wb"))
+    {
+        if(!m_file)
+            return;
+        header_t header{};
+        memcpy(header.magic, "rocBLASb", sizeof(header.magic));
+        header.version     = ROCBLAS_BINARY_LOG_VERSION;
+        header.record_size = sizeof(record_t);
+        fwrite(&header, sizeof(header), 1, m_file);
+        m_open    = true;
+        m_flusher = std::thread([this] { flusher(); });
+    }
+
+    ~rocblas_binary_log()
+    {
+        close();
+    }
+
+    // The log is not copyable or assignable
+    rocblas_binary_log(const rocblas_binary_log&) = delete;
+    rocblas_binary_log& operator=(const rocblas_binary_log&) = delete;
+
+    bool is_open() const
+    {
+        return m_open;
+    }
+
+    // Stop the flusher, and write all remaining records. Calls logged afterwards are ignored.
+    void close()
+    {
+        if(!m_open.exchange(false))
+            return;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        m_flusher.join();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        drain();
+        fclose(m_file);
+        m_file = nullptr;
+    }
+
+    // Write all records which have been logged so far
+    void flush()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_file)
+            drain();
+    }
+
+    // Log a call with arguments xs
+    template <typename... Ts>
+    void write(rocblas_log_kind kind, const void* handle, const Ts&... xs)
+    {
+        if(!m_open)
+            return;
+        ring_t& ring = *get_ring();
+        call_t  call(*this, ring);
+        (call.add(xs), ...);
+        push(ring, kind, handle, call);
+    }
+};
+
+/*************************************************************************
+ * Decode a binary log file into the text of the trace and bench logs.   *
+ * Calls are output in the order in which they were made. dropped is set *
+ * to the number of calls which were dropped because a ring was full.    *
+ * Returns false if the file cannot be read, or is not a binary log.     *
+ *************************************************************************/
+class rocblas_binary_log_decoder
+{
+    using record_t = rocblas_binary_log::record_t;
+
+    std::unordered_map<uint32_t, std::string> m_strings;
+
+    const char* string(uint64_t id) const
+    {
+        auto p = m_strings.find(uint32_t(id));
+        return p != m_strings.end() ? p->second.c_str() : "?";
+    }
+
+    template <typename T>
+    static T value(uint64_t bits)
+    {
+        T x;
+        memcpy(&x, &bits, sizeof(T));
+        return x;
+    }
+
+    // Output the argument starting at slot i, returning the number of slots used
+    size_t put(rocblas_internal_ostream& os,
+               const uint8_t*            tags,
+               const uint64_t*           values,
+               size_t                    i,
+               size_t                    count,
+               const char*               bench_name = nullptr) const
+    {
+        auto out = [&](auto x) {
+            if(bench_name)
+                os << rocblas_log_bench_scalar<decltype(x)>{bench_name, x};
+            else
+                os << x;
+        };
+
+        switch(rocblas_log_tag(tags[i]))
+        {
+        case rocblas_log_tag::i32:
+            out(value<int32_t>(values[i]));
+            break;
+        case rocblas_log_tag::u32:
+            out(value<uint32_t>(values[i]));
+            break;
+        case rocblas_log_tag::i64:
+            out(value<int64_t>(values[i]));
+            break;
+        case rocblas_log_tag::u64:
+            out(value<uint64_t>(values[i]));
+            break;
+        case rocblas_log_tag::f32:
+            out(value<float>(values[i]));
+            break;
+        case rocblas_log_tag::f64:
+            out(value<double>(values[i]));
+            break;
+        case rocblas_log_tag::c32:
+            out(value<rocblas_float_complex>(values[i]));
+            break;
+        case rocblas_log_tag::c64:
+            if(i + 1 >= count)
+                return 1;
+            out(rocblas_double_complex{value<double>(values[i]), value<double>(values[i + 1])});
+            return 2;
+        case rocblas_log_tag::boolean:
+            os << value<bool>(values[i]);
+            break;
+        case rocblas_log_tag::character:
+            os << value<char>(values[i]);
+            break;
+        case rocblas_log_tag::pointer:
+            os << reinterpret_cast<const void*>(uintptr_t(values[i]));
+            break;
+        case rocblas_log_tag::string:
+            os << string(values[i]);
+            break;
+        case rocblas_log_tag::bench_scalar:
+            if(i + 1 >= count)
+                return 1;
+            return 1 + put(os, tags, values, i + 1, count, string(values[i]));
+        case rocblas_log_tag::datatype:
+            os << value<rocblas_datatype>(values[i]);
+            break;
+        case rocblas_log_tag::operation:
+            os << value<rocblas_operation>(values[i]);
+            break;
+        case rocblas_log_tag::fill:
+            os << value<rocblas_fill>(values[i]);
+            break;
+        case rocblas_log_tag::diagonal:
+            os << value<rocblas_diagonal>(values[i]);
+            break;
+        case rocblas_log_tag::side:
+            os << value<rocblas_side>(values[i]);
+            break;
+        case rocblas_log_tag::status:
+            os << value<rocblas_status>(values[i]);
+            break;
+        case rocblas_log_tag::atomics_mode:
+            os << value<rocblas_atomics_mode>(values[i]);
+            break;
+        case rocblas_log_tag::gemm_flags:
+            os << value<rocblas_gemm_flags>(values[i]);
+            break;
+        default:
+            os << "?";
+            break;
+        }
+        return 1;
+    }
+
+public:
+    bool decode(const std::string&        path,
+                rocblas_internal_ostream& trace_os,
+                rocblas_internal_ostream& bench_os,
+                uint64_t&                 dropped)
+    {
+        dropped = 0;
+        m_strings.clear();
+
+        std::ifstream file(path, std::ios::binary);
+        if(!file)
+            return false;
+        std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+
+        rocblas_binary_log::header_t header;
+        if(data.size() < sizeof(header))
+            return false;
+        memcpy(&header, data.data(), sizeof(header));
+        if(memcmp(header.magic, "rocBLASb", sizeof(header.magic))
+           || header.version != ROCBLAS_BINARY_LOG_VERSION
+           || header.record_size != sizeof(record_t))
+            return false;
+
+        // Read all chunks, since strings can follow the records which use them
+        std::vector<record_t> records;
+        for(size_t pos = sizeof(header); pos < data.size();)
+        {
+            rocblas_binary_log::chunk_t chunk;
+            if(data.size() - pos < sizeof(chunk))
+                return false;
+            memcpy(&chunk, &data[pos], sizeof(chunk));
+            pos += sizeof(chunk);
+            if(data.size() - pos < chunk.size)
+                return false;
+
+            const char* payload = &data[pos];
+            pos += chunk.size;
+            if(chunk.type == rocblas_binary_log::chunk_string && chunk.size >= sizeof(uint32_t))
+            {
+                uint32_t id;
+                memcpy(&id, payload, sizeof(id));
+                m_strings[id].assign(payload + sizeof(id), chunk.size - sizeof(id));
+            }
+            else if(chunk.type == rocblas_binary_log::chunk_records)
+            {
+                size_t n = chunk.size / sizeof(record_t);
+                records.resize(records.size() + n);
+                memcpy(&records[records.size() - n], payload, n * sizeof(record_t));
+            }
+            else if(chunk.type == rocblas_binary_log::chunk_dropped
+                    && chunk.size == sizeof(uint64_t))
+            {
+                uint64_t n;
+                memcpy(&n, payload, sizeof(n));
+                dropped += n;
+            }
+        }
+
+        // Join the records of each call, and order the calls by time. The records of a
+        // call are consecutive, since a ring is always drained up to the end of a call.
+        struct call_t
+        {
+            uint64_t timestamp;
+            uint8_t  kind;
+            size_t   first, last;
+        };
+        std::vector<call_t> calls;
+        for(size_t i = 0; i < records.size(); ++i)
+        {
+            size_t first = i;
+            while(records[i].flags & rocblas_binary_log::continued && i + 1 < records.size())
+                ++i;
+            calls.push_back({records[first].timestamp, records[first].kind, first, i});
+        }
+        std::stable_sort(calls.begin(), calls.end(), [](const call_t& a, const call_t& b) {
+            return a.timestamp < b.timestamp;
+        });
+
+        for(const auto& call : calls)
+        {
+            uint8_t  tags[ROCBLAS_BINARY_LOG_CALL_SLOTS];
+            uint64_t values[ROCBLAS_BINARY_LOG_CALL_SLOTS];
+            size_t   count = 0;
+            for(size_t r = call.first; r <= call.last; ++r)
+            {
+                size_t n = std::min<size_t>(records[r].count, ROCBLAS_BINARY_LOG_RECORD_SLOTS);
+                n        = std::min(n, ROCBLAS_BINARY_LOG_CALL_SLOTS - count);
+                memcpy(tags + count, records[r].tags, n);
+                memcpy(values + count, records[r].values, n * sizeof(uint64_t));
+                count += n;
+            }
+
+            bool        trace = call.kind == uint8_t(rocblas_log_kind::trace);
+            auto&       os    = trace ? trace_os : bench_os;
+            const char* sep   = trace ? "," : " ";
+            for(size_t i = 0; i < count;)
+            {
+                if(i)
+                    os << sep;
+                i += put(os, tags, values, i, count);
+            }
+            if(records[call.first].flags & rocblas_binary_log::truncated)
+                os << sep << "...";
+            os << std::endl;
+        }
+        return true;
+    }
+};
@@ -0,0 +1,269 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_check_numerics_queue keeps the results of a handle's numerical    *
+ * checks in a persistent ring of flag blocks on the device, mirrored in     *
+ * pinned host memory. A check clears a slot of the ring on the stream, and  *
+ * its kernels set the flags of the slot. When the slot is closed, it is     *
+ * copied to the host asynchronously, and an event is recorded after the     *
+ * copy, so no memory is allocated and no thread waits for a check.          *
+ *                                                                           *
+ * Consecutive checks of the same function, direction and stream may share   *
+ * a slot, so that all of the inputs or all of the outputs of a call are     *
+ * read back and reported once. The open slot is closed when a check which   *
+ * cannot share it is made, or when the queue is flushed.                    *
+ *                                                                           *
+ * Closed slots are retired in order once their events have completed: the   *
+ * flags are reported, and the first failure is kept until it is taken. The  *
+ * calling thread only waits when the queue is flushed, or when the ring is  *
+ * full and the oldest slot must be retired.                                 *
+ *                                                                           *
+ * Like the workspace statistics, the queue belongs to a handle and is not   *
+ * thread-safe. HIP is reached through a Runtime, which must provide:        *
+ *                                                                           *
+ *     using stream_t = ...;                                                 *
+ *     using event_t = ...;  // value-initialized events are not created yet *
+ *     using flags_t = ...;  // trivially copyable, all zero when clear      *
+ *     bool allocate(flags_t** device, flags_t** host, size_t count);        *
+ *     void deallocate(flags_t* device, flags_t* host);                      *
+ *     bool clear(flags_t* device, stream_t stream);                         *
+ *     bool read(flags_t* host, const flags_t* device, stream_t stream);     *
+ *     bool record(event_t& event, stream_t stream); // creates if needed    *
+ *     bool query(event_t event);                    // true if complete     *
+ *     bool synchronize(event_t event);                                      *
+ *     void destroy(event_t event);                                          *
+ *     rocblas_status report(const char* function_name, int check_numerics,  *
+ *                           bool is_input, const flags_t& flags);           *
+ *****************************************************************************/
+
+#include "rocblas.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Number of slots in the ring, i.e. the number of checks which can await readback
+constexpr size_t ROCBLAS_CHECK_NUMERICS_QUEUE_SLOTS = 256;
+
+template <typename Runtime>
+class rocblas_check_numerics_queue
+{
+public:
+    using stream_t = typename Runtime::stream_t;
+    using event_t  = typename Runtime::event_t;
+    using flags_t  = typename Runtime::flags_t;
+
+private:
+    struct slot_t
+    {
+        const char* function_name;
+        int         check_numerics;
+        bool        is_input;
+        bool        recorded; // whether the readback was enqueued and the event recorded
+        stream_t    stream;
+        event_t     event;
+    };
+
+    Runtime             m_runtime;
+    size_t              m_capacity;
+    flags_t*            m_device = nullptr;
+    flags_t*            m_host   = nullptr;
+    std::vector<slot_t> m_slots;
+    size_t              m_head      = 0; // index of the oldest slot in use
+    size_t              m_count     = 0; // number of slots in use
+    size_t              m_readbacks = 0;
+    bool                m_open      = false; // whether the newest slot in use is open
+    rocblas_status      m_status    = rocblas_status_success; // first failure not yet taken
+
+    size_t newest() const
+    {
+        return (m_head + m_count - 1) % m_capacity;
+    }
+
+    // Retire up to limit of the oldest closed slots, waiting for their readbacks if wait
+    // is true. Slots whose readback failed are dropped without being reported.
+    void retire(bool wait, size_t limit = ~size_t{0})
+    {
+        for(; limit && m_count > size_t(m_open); --limit)
+        {
+            slot_t& slot = m_slots[m_head];
+            if(slot.recorded)
+            {
+                if(!wait && !m_runtime.query(slot.event))
+                    break;
+
+                rocblas_status status = rocblas_status_internal_error;
+                if(!wait || m_runtime.synchronize(slot.event))
+                    status = m_runtime.report(
+                        slot.function_name, slot.check_numerics, slot.is_input, m_host[m_head]);
+                if(status != rocblas_status_success && m_status == rocblas_status_success)
+                    m_status = status;
+            }
+            m_head = (m_head + 1) % m_capacity;
+            m_count -= 1;
+        }
+    }
+
+public:
+    explicit rocblas_check_numerics_queue(size_t  capacity = ROCBLAS_CHECK_NUMERICS_QUEUE_SLOTS,
+                                          Runtime runtime  = Runtime{})
+        : m_runtime(std::move(runtime))
+        , m_capacity(capacity ? capacity : 1)
+    {
+    }
+
+    // Pending checks are reported, and the ring is freed, when the queue is destroyed
+    ~rocblas_check_numerics_queue()
+    {
+        flush();
+        for(auto& slot : m_slots)
+            if(slot.event != event_t{})
+                m_runtime.destroy(slot.event);
+        if(m_device)
+            m_runtime.deallocate(m_device, m_host);
+    }
+
+    // The queue is not copyable or assignable
+    rocblas_check_numerics_queue(const rocblas_check_numerics_queue&) = delete;
+    rocblas_check_numerics_queue& operator=(const rocblas_check_numerics_queue&) = delete;
+
+    // Get the device flags to be set by a check of the inputs or outputs of function_name
+    // on stream. If share is true and the open slot was opened for the same function,
+    // direction and stream, it is used; otherwise the open slot is closed, and a slot is
+    // cleared and opened. The ring is allocated by the first check.
+    rocblas_status check(const char* function_name,
+                         int         check_numerics,
+                         bool        is_input,
+                         stream_t    stream,
+                         bool        share,
+                         flags_t*&   flags)
+    {
+        if(share && m_open)
+        {
+            const slot_t& slot = m_slots[newest()];
+            if(slot.function_name == function_name && slot.is_input == is_input
+               && slot.stream == stream)
+            {
+                flags = m_device + newest();
+                return rocblas_status_success;
+            }
+        }
+
+        rocblas_status status = close();
+        if(status != rocblas_status_success)
+            return status;
+
+        if(!m_device)
+        {
+            if(!m_runtime.allocate(&m_device, &m_host, m_capacity))
+            {
+                m_device = m_host = nullptr;
+                return rocblas_status_memory_error;
+            }
+            m_slots.assign(m_capacity, slot_t{});
+        }
+
+        if(m_count == m_capacity)
+            retire(true, 1);
+
+        size_t i = (m_head + m_count) % m_capacity;
+        if(!m_runtime.clear(m_device + i, stream))
+            return rocblas_status_internal_error;
+
+        slot_t& slot        = m_slots[i];
+        slot.function_name  = function_name;
+        slot.check_numerics = check_numerics;
+        slot.is_input       = is_input;
+        slot.recorded       = false;
+        slot.stream         = stream;
+        m_count += 1;
+        m_open = true;
+        flags  = m_device + i;
+        return rocblas_status_success;
+    }
+
+    // Enqueue the readback of the open slot, if any. If it cannot be enqueued, an error
+    // is returned and the slot will not be reported.
+    rocblas_status close()
+    {
+        if(!m_open)
+            return rocblas_status_success;
+        m_open = false;
+
+        size_t  i     = newest();
+        slot_t& slot  = m_slots[i];
+        slot.recorded = m_runtime.read(m_host + i, m_device + i, slot.stream)
+                        && m_runtime.record(slot.event, slot.stream);
+        if(!slot.recorded)
+            return rocblas_status_internal_error;
+        m_readbacks += 1;
+        return rocblas_status_success;
+    }
+
+    // Return the first failure reported since it was last taken, and forget it
+    rocblas_status take_status()
+    {
+        return std::exchange(m_status, rocblas_status_success);
+    }
+
+    // Report the closed slots whose readbacks have completed, without waiting, and take
+    // the first failure
+    rocblas_status poll()
+    {
+        retire(false);
+        return take_status();
+    }
+
+    // Close the open slot, wait for all readbacks and report them, and take the first
+    // failure. A failure found by a check takes precedence over an error in the readback.
+    rocblas_status flush()
+    {
+        rocblas_status closed = close();
+        retire(true);
+        rocblas_status status = take_status();
+        return status != rocblas_status_success ? status : closed;
+    }
+
+    // Number of slots awaiting readback or report, including the open slot
+    size_t pending() const
+    {
+        return m_count;
+    }
+
+    // Number of readbacks enqueued so far
+    size_t readbacks() const
+    {
+        return m_readbacks;
+    }
+
+    bool is_open() const
+    {
+        return m_open;
+    }
+
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+};
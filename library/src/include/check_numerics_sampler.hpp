@@ -0,0 +1,262 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_check_numerics_sampler decides which calls of a handle are        *
+ * checked by numerical checking, so that its cost can be bounded. Under a   *
+ * rocblas_check_numerics_sampling policy, it checks every call, every Nth   *
+ * call of each function, a random fraction of the calls, or the first K     *
+ * calls of each function with each argument profile.                        *
+ *                                                                           *
+ * The checks of the inputs and outputs of a call are made separately, so    *
+ * the sampler is told about each check, and the decision made for the first *
+ * check of a call applies to the other checks of the call. A call ends when *
+ * the rocblas_call_scope of its public function is destroyed, so calls of   *
+ * the same function which return early, or only check their inputs, are     *
+ * counted separately. Internal functions called without a scope start a     *
+ * new call with a check of another function, or with a check of the inputs  *
+ * after a check of the outputs. The argument profile of a call is the shape *
+ * of its first checked operand.                                             *
+ *                                                                           *
+ * Random sampling uses a seeded generator, so that the calls which are      *
+ * checked can be reproduced. Like the workspace statistics, the sampler     *
+ * belongs to a handle and is not thread-safe.                               *
+ *****************************************************************************/
+
+#include "rocblas.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+class rocblas_check_numerics_sampler
+{
+public:
+    // Sampling decisions made for the calls of one function
+    struct function_stats
+    {
+        size_t calls   = 0; // number of calls
+        size_t sampled = 0; // number of calls which were checked
+    };
+
+private:
+    rocblas_check_numerics_sampling m_policy = rocblas_check_numerics_sample_all;
+    double                          m_value  = 0;
+    uint64_t                        m_seed;
+    uint64_t                        m_state;
+
+    // Function names are string literals, so they are looked up by address
+    std::unordered_map<const char*, function_stats> m_functions;
+    std::unordered_map<uint64_t, size_t>            m_profiles; // calls per function and profile
+
+    // The call whose checks are being made
+    const char* m_function   = nullptr;
+    bool        m_in_outputs = false;
+    bool        m_sampled    = true;
+
+    // splitmix64, mapped to a uniform double in [0, 1)
+    double next_uniform()
+    {
+        uint64_t z = (m_state += 0x9e3779b97f4a7c15);
+        z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z          = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        z ^= z >> 31;
+        return (z >> 11) * 0x1.0p-53;
+    }
+
+    // Decide whether a new call of function with the given profile is checked
+    bool decide(const char* function, uint64_t profile)
+    {
+        auto& stats = m_functions[function];
+        bool  sampled;
+        switch(m_policy)
+        {
+        case rocblas_check_numerics_sample_every_nth:
+            sampled = stats.calls % uint64_t(m_value) == 0;
+            break;
+        case rocblas_check_numerics_sample_fraction:
+            sampled = next_uniform() < m_value;
+            break;
+        case rocblas_check_numerics_sample_first:
+            sampled = m_profiles[profile ^ hash(uintptr_t(function))]++ < m_value;
+            break;
+        default:
+            sampled = true;
+            break;
+        }
+        stats.calls += 1;
+        stats.sampled += sampled;
+        return sampled;
+    }
+
+    static uint64_t hash(uint64_t value, uint64_t h = 0xcbf29ce484222325)
+    {
+        // FNV-1a over the bytes of value
+        for(int i = 0; i < 8; ++i, value >>= 8)
+            h = (h ^ (value & 0xff)) * 0x100000001b3;
+        return h;
+    }
+
+public:
+    explicit rocblas_check_numerics_sampler(uint64_t seed = 0)
+        : m_seed(seed)
+        , m_state(seed)
+    {
+    }
+
+    // Argument profile of an operand, from the integers which describe its shape
+    static uint64_t profile(std::initializer_list<int64_t> shape)
+    {
+        uint64_t h = hash(shape.size());
+        for(int64_t value : shape)
+            h = hash(value, h);
+        return h;
+    }
+
+    // Set the policy. value is N for every_nth, below 2^64 so that it converts to uint64_t,
+    // the fraction of calls between 0 and 1 for fraction, and K for first; it is ignored for
+    // all. Returns false, without changing the policy, if policy or value is invalid. The
+    // decisions and statistics restart.
+    bool set_policy(rocblas_check_numerics_sampling policy, double value)
+    {
+        switch(policy)
+        {
+        case rocblas_check_numerics_sample_all:
+            value = 0;
+            break;
+        case rocblas_check_numerics_sample_every_nth:
+            if(!(value >= 1 && value < 0x1.0p64 && value == std::floor(value)))
+                return false;
+            break;
+        case rocblas_check_numerics_sample_fraction:
+            if(!(value >= 0 && value <= 1))
+                return false;
+            break;
+        case rocblas_check_numerics_sample_first:
+            if(!(value >= 0 && value == std::floor(value)))
+                return false;
+            break;
+        default:
+            return false;
+        }
+        m_policy = policy;
+        m_value  = value;
+        reset();
+        return true;
+    }
+
+    // Set the policy from a string "all", "every:N", "fraction:P" or "first:K", as in the
+    // environment variable ROCBLAS_CHECK_NUMERICS_SAMPLING. Returns false if it is invalid.
+    bool parse(const char* spec)
+    {
+        static const std::pair<const char*, rocblas_check_numerics_sampling> names[] = {
+            {"every:", rocblas_check_numerics_sample_every_nth},
+            {"fraction:", rocblas_check_numerics_sample_fraction},
+            {"first:", rocblas_check_numerics_sample_first},
+        };
+
+        if(!strcmp(spec, "all"))
+            return set_policy(rocblas_check_numerics_sample_all, 0);
+        for(auto& name : names)
+        {
+            size_t len = strlen(name.first);
+            if(!strncmp(spec, name.first, len))
+            {
+                char*  end;
+                double value = strtod(spec + len, &end);
+                return end != spec + len && !*end && set_policy(name.second, value);
+            }
+        }
+        return false;
+    }
+
+    rocblas_check_numerics_sampling policy() const
+    {
+        return m_policy;
+    }
+
+    double value() const
+    {
+        return m_value;
+    }
+
+    // Whether a check of the inputs or outputs of function, whose operand has the given
+    // profile, is made. Only the first check of a call is sampled.
+    bool check(const char* function, bool is_input, uint64_t profile)
+    {
+        if(function != m_function || (is_input && m_in_outputs))
+            m_sampled = decide(function, profile);
+        m_function   = function;
+        m_in_outputs = !is_input;
+        return m_sampled;
+    }
+
+    // End the call whose checks are being made, so that the next check starts a new call
+    void end_call()
+    {
+        m_function = nullptr;
+    }
+
+    // Forget the decisions and statistics, and restart the random sequence
+    void reset()
+    {
+        m_functions.clear();
+        m_profiles.clear();
+        m_state    = m_seed;
+        m_function = nullptr;
+    }
+
+    // Statistics of function. Functions with equal names are merged.
+    function_stats stats(const char* function) const
+    {
+        function_stats merged;
+        for(const auto& p : m_functions)
+        {
+            if(!strcmp(p.first, function))
+            {
+                merged.calls += p.second.calls;
+                merged.sampled += p.second.sampled;
+            }
+        }
+        return merged;
+    }
+
+    // Statistics of each function, sorted by name
+    std::map<std::string, function_stats> functions() const
+    {
+        std::map<std::string, function_stats> sorted;
+        for(const auto& p : m_functions)
+        {
+            auto& s = sorted[p.first];
+            s.calls += p.second.calls;
+            s.sampled += p.second.sampled;
+        }
+        return sorted;
+    }
+};
@@ -22,10 +22,18 @@
 
 #pragma once
 
+#include "binary_log.hpp"
+#include "check_numerics_queue.hpp"
+#include "check_numerics_sampler.hpp"
+#include "latency_stats.hpp"
 #include "macros.hpp"
 #include "rocblas.h"
 #include "rocblas_ostream.hpp"
 #include "utility.hpp"
+#include "workspace_arena.hpp"
+#include "workspace_pool.hpp"
+#include "workspace_stats.hpp"
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <hip/hip_runtime.h>
@@ -44,10 +52,8 @@
 // forcing early cleanup
 extern "C" ROCBLAS_EXPORT void rocblas_shutdown();
 
-// Whether rocBLAS can reallocate device memory on demand, at the cost of only
-// allowing one allocation at a time, and at the cost of potential synchronization.
-// If this is 0, then stack-like allocation is allowed, but reallocation on demand
-// does not occur.
+// Whether rocBLAS can grow device memory on demand, by adding slabs to the handle's
+// workspace arena. If this is 0, then the arena never grows beyond its initial size.
 #define ROCBLAS_REALLOC_ON_DEMAND 1
 
 // Round up size to the nearest MIN_CHUNK_SIZE
@@ -68,11 +74,59 @@ enum class rocblas_device_memory_ownership
     rocblas_managed,
     user_managed,
     user_owned,
+    pool_managed, // leased from the device's shared workspace pool while in use
 };
 
 // helper function in handle.cpp
 static rocblas_status free_existing_device_memory(rocblas_handle);
 
+// Allocator of the device memory slabs in a handle's workspace arena
+struct rocblas_device_slab_allocator
+{
+    // Status of the last failed HIP call
+    hipError_t status = hipSuccess;
+
+    bool allocate(void** ptr, size_t size);
+    bool deallocate(void* ptr);
+};
+
+using rocblas_device_arena = rocblas_workspace_arena<rocblas_device_slab_allocator>;
+
+// Events which order the reuse of slabs of the shared workspace pool across streams
+struct rocblas_device_events
+{
+    using stream_t = hipStream_t;
+    using event_t  = hipEvent_t;
+
+    bool record(hipEvent_t& event, hipStream_t stream);
+    bool query(hipEvent_t event);
+    bool wait(hipStream_t stream, hipEvent_t event);
+    void destroy(hipEvent_t event);
+};
+
+using rocblas_device_workspace_pool
+    = rocblas_workspace_pool<rocblas_device_slab_allocator, rocblas_device_events>;
+
+// Flag ring and readback of the numerical checks of a handle
+struct rocblas_check_numerics_runtime
+{
+    using stream_t = hipStream_t;
+    using event_t  = hipEvent_t;
+    using flags_t  = rocblas_check_numerics_t;
+
+    bool allocate(flags_t** device, flags_t** host, size_t count);
+    void deallocate(flags_t* device, flags_t* host);
+    bool clear(flags_t* device, hipStream_t stream);
+    bool read(flags_t* host, const flags_t* device, hipStream_t stream);
+    bool record(hipEvent_t& event, hipStream_t stream);
+    bool query(hipEvent_t event);
+    bool synchronize(hipEvent_t event);
+    void destroy(hipEvent_t event);
+
+    rocblas_status
+        report(const char* function_name, int check_numerics, bool is_input, const flags_t& flags);
+};
+
 /*******************************************************************************
  * \brief rocblas_handle is a structure holding the rocblas library context.
  * It must be initialized using rocblas_create_handle() and the returned handle mus
@@ -222,6 +276,12 @@ public:
     // default check_numerics_mode is no numeric_check
     rocblas_check_numerics_mode check_numerics = rocblas_check_numerics_mode_no_check;
 
+    // results of numerical checks awaiting readback
+    rocblas_check_numerics_queue<rocblas_check_numerics_runtime> check_numerics_queue;
+
+    // selects the calls which are checked when check_numerics is enabled
+    rocblas_check_numerics_sampler check_numerics_sampler;
+
     // used by hipBLAS to set int8 datatype to int8_t or rocblas_int8x4
     rocblas_int8_type_for_hipblas rocblas_int8_type = rocblas_int8_type_for_hipblas_default;
 
@@ -229,6 +289,8 @@ public:
     std::unique_ptr<rocblas_internal_ostream> log_trace_os;
     std::unique_ptr<rocblas_internal_ostream> log_bench_os;
     std::unique_ptr<rocblas_internal_ostream> log_profile_os;
+    std::shared_ptr<rocblas_binary_log>       log_binary; // shared by all handles
+    std::shared_ptr<rocblas_latency_stats>    latency_stats; // nullptr unless measured
     void                                      init_logging();
     void                                      init_check_numerics();
 
@@ -239,10 +301,28 @@ public:
     friend rocblas_status(::rocblas_set_device_memory_size)(_rocblas_handle*, size_t);
     friend rocblas_status(::free_existing_device_memory)(rocblas_handle);
     friend rocblas_status(::rocblas_set_workspace)(_rocblas_handle*, void*, size_t);
+    friend rocblas_status(::rocblas_set_shared_workspace)(_rocblas_handle*);
     friend bool(::rocblas_is_managing_device_memory)(_rocblas_handle*);
     friend bool(::rocblas_is_user_managing_device_memory)(_rocblas_handle*);
     friend rocblas_status(::rocblas_set_stream)(_rocblas_handle*, hipStream_t);
 
+    // C interfaces for device memory statistics
+    friend rocblas_status(::rocblas_get_device_memory_stats)(
+        _rocblas_handle*, size_t*, size_t*, size_t*, size_t*);
+    friend rocblas_status(::rocblas_reset_device_memory_stats)(_rocblas_handle*);
+    friend rocblas_status(::rocblas_write_device_memory_stats)(_rocblas_handle*, const char*);
+
+    // C interfaces for latency statistics
+    friend rocblas_status(::rocblas_get_latency_stats)(_rocblas_handle*,
+                                                       const char*,
+                                                       rocblas_latency_phase,
+                                                       double,
+                                                       size_t*,
+                                                       double*,
+                                                       double*);
+    friend rocblas_status(::rocblas_reset_latency_stats)(_rocblas_handle*);
+    friend rocblas_status(::rocblas_write_latency_stats)(_rocblas_handle*, const char*);
+
     // C interfaces that interact with the solution selection process
     friend rocblas_status(::rocblas_set_solution_fitness_query)(_rocblas_handle*, double*);
     friend rocblas_status(::rocblas_set_performance_metric)(_rocblas_handle*,
@@ -256,9 +336,13 @@ public:
         return device_memory_size_query;
     }
 
+    // A handle using the shared workspace pool can lease at least the default size
     size_t get_available_workspace()
     {
-        return (device_memory_size - device_memory_in_use);
+        size_t available = device_arena.available();
+        if(device_memory_owner == rocblas_device_memory_ownership::pool_managed)
+            available = std::max(available, DEFAULT_DEVICE_MEMORY_SIZE);
+        return available;
     }
 
     // Get the solution fitness query
@@ -309,6 +393,10 @@ public:
     // Return the current stream
     hipStream_t get_stream() const
     {
+        // The first use of the stream marks the end of argument checking when latency
+        // is measured
+        if(latency_stats)
+            rocblas_latency_call::event(latency_stats.get());
         return stream;
     }
 
@@ -317,23 +405,39 @@ private:
     static constexpr size_t DEFAULT_DEVICE_MEMORY_SIZE = 32 * 1024 * 1024;
 
     // Variables holding state of device memory allocation
-    void*                           device_memory            = nullptr;
-    size_t                          device_memory_size       = 0;
-    size_t                          device_memory_in_use     = 0;
+    rocblas_device_arena            device_arena;
     bool                            device_memory_size_query = false;
     rocblas_device_memory_ownership device_memory_owner;
     size_t                          device_memory_query_size;
 
+    // Running statistics of device memory requests, and the optional stream they are
+    // written to when the handle is destroyed
+    rocblas_workspace_stats                   device_memory_stats;
+    std::unique_ptr<rocblas_internal_ostream> device_memory_stats_os;
+
+    // Public routine being called, which device memory requests are attributed to
+    const char* routine = nullptr;
+    friend class rocblas_call_scope;
+
+    // Stream the latency statistics are written to when the handle is destroyed
+    std::unique_ptr<rocblas_internal_ostream> latency_stats_os;
+
     // Solution fitness query (used for internal testing)
     double* solution_fitness_query = nullptr;
 
     // rocblas by default take the system default stream 0 users cannot create
     hipStream_t stream = 0;
 
-#if ROCBLAS_REALLOC_ON_DEMAND
-    // Helper for device memory allocator
-    bool device_allocator(size_t size);
-#endif
+    // Slabs of the shared workspace pool which are leased by the handle
+    std::vector<void*> workspace_leases;
+
+    // Helpers for leasing from and returning to the shared workspace pool
+    bool lease_workspace(size_t size);
+    bool return_workspace_leases();
+
+    // Helpers for device memory allocator
+    bool device_allocator(size_t size, rocblas_device_arena::block& block);
+    bool device_deallocator(const rocblas_device_arena::block& block);
 
     // Device ID is created at handle creation time and remains in effect for the life of the handle.
     const int device;
@@ -348,10 +452,10 @@ private:
     {
     protected:
         // Order is important:
-        rocblas_handle handle;
-        size_t         prev_device_memory_in_use;
-        size_t         size;
-        bool           success;
+        rocblas_handle              handle;
+        rocblas_device_arena::block block;
+        size_t                      size;
+        bool                        success;
 
     private:
         std::vector<void*> pointers; // Important: must come last
@@ -367,20 +471,15 @@ private:
             size_t old;
             size_t offsets[] = {(old = size, size += roundup_device_memory_size(sizes), old)...};
 
-#if ROCBLAS_REALLOC_ON_DEMAND
-            success = handle->device_allocator(size);
-#else
-            success = size <= handle->device_memory_size - handle->device_memory_in_use;
-#endif
+            success = handle->device_allocator(size, block);
 
             // If allocation failed, return an array of nullptr's
             // If total size is 0, return an array of nullptr's, but leave it marked as successful
             if(!success || !size)
                 return decltype(pointers)(sizeof...(sizes));
 
-            // We allocate the total amount needed, taking it from the available device memory.
-            char* addr = static_cast<char*>(handle->device_memory) + handle->device_memory_in_use;
-            handle->device_memory_in_use += size;
+            // We allocate the total amount needed as one block of the handle's arena.
+            char* addr = block.addr;
 
             // An array of pointers to all of the allocated arrays is formed.
             // If a size is 0, the corresponding pointer is nullptr
@@ -393,7 +492,6 @@ private:
         template <typename... Ss>
         explicit _device_malloc(rocblas_handle handle, Ss... sizes)
             : handle(handle)
-            , prev_device_memory_in_use(handle->device_memory_in_use)
             , size(0)
             , success(false)
             , pointers(allocate_pointers(size_t(sizes)...))
@@ -403,22 +501,10 @@ private:
         // Constructor for allocating count pointers of a certain total size
         explicit _device_malloc(rocblas_handle handle, std::nullptr_t, size_t count, size_t total)
             : handle(handle)
-            , prev_device_memory_in_use(handle->device_memory_in_use)
             , size(roundup_device_memory_size(total))
-            , success(
-                    #if ROCBLAS_REALLOC_ON_DEMAND
-                        handle->device_allocator(size)
-                    #else
-                        size <= handle->device_memory_size - handle->device_memory_in_use
-                    #endif
-                     )
-            , pointers(count,
-                       success ? static_cast<char*>(handle->device_memory)
-                                     + handle->device_memory_in_use
-                               : nullptr)
+            , success(handle->device_allocator(size, block))
+            , pointers(count, success ? block.addr : nullptr)
         {
-            if(success)
-                handle->device_memory_in_use += size;
         }
 
         // Move constructor
@@ -427,10 +513,11 @@ private:
         // rvalues. If std::move() is used to move a _device_malloc object
         // from a variable, then there must not be any alive allocations made
         // between the initialization of the variable and the object that it
-        // moves to, or the LIFO ordering will be violated and flagged.
+        // moves to, or the LIFO ordering of the newest slab may be violated
+        // and flagged.
         _device_malloc(_device_malloc&& other) noexcept
             : handle(other.handle)
-            , prev_device_memory_in_use(other.prev_device_memory_in_use)
+            , block(other.block)
             , size(other.size)
             , success(other.success)
             , pointers(std::move(other.pointers))
@@ -456,9 +543,9 @@ private:
             // If success == false or size == 0, the destructor is a no-op
             if(success && size)
             {
-                // Subtract size from the handle's device_memory_in_use, making sure
-                // it matches the device_memory_in_use when this object was created.
-                if((handle->device_memory_in_use -= size) != prev_device_memory_in_use)
+                // Return the block to the handle's arena. Blocks in the newest slab
+                // of the arena must be returned in the reverse order of allocation.
+                if(!handle->device_deallocator(block))
                 {
                     rocblas_cerr
                         << "rocBLAS internal error: device_malloc() RAII object not "
@@ -507,7 +594,7 @@ private:
     {
     public:
         explicit _gsu_malloc(rocblas_handle handle)
-            : _device_malloc(handle, handle->device_memory_size - handle->device_memory_in_use)
+            : _device_malloc(handle, handle->get_available_workspace())
         {
             handle->gsu_workspace_size = success ? size : 0;
             handle->gsu_workspace      = static_cast<void*>(*this);
@@ -586,6 +673,46 @@ public:
     };
 };
 
+/*******************************************************************************
+ * rocblas_call_scope lasts from the entry of a public rocBLAS routine until it
+ * returns. The handle's device memory requests made in the meantime are
+ * attributed to the routine, and its host latency is measured under the name of
+ * the routine. Its destruction also ends the call sampled by numerical checking.
+ * A routine called by another one is attributed to the outermost routine.
+ ******************************************************************************/
+class rocblas_call_scope
+{
+    rocblas_handle handle; // nullptr if another call is in scope
+
+public:
+    rocblas_call_scope(rocblas_handle handle, const char* routine)
+        : handle(handle && !handle->routine ? handle : nullptr)
+    {
+        if(this->handle)
+        {
+            this->handle->routine = routine;
+            // Device memory size queries are not timed
+            if(this->handle->latency_stats && !this->handle->is_device_memory_size_query())
+                rocblas_latency_call::begin(this->handle->latency_stats, routine);
+        }
+    }
+
+    ~rocblas_call_scope()
+    {
+        if(handle)
+        {
+            if(handle->latency_stats)
+                rocblas_latency_call::end(handle->latency_stats.get());
+            if(handle->check_numerics)
+                handle->check_numerics_sampler.end_call();
+            handle->routine = nullptr;
+        }
+    }
+
+    rocblas_call_scope(const rocblas_call_scope&) = delete;
+    rocblas_call_scope& operator=(const rocblas_call_scope&) = delete;
+};
+
 // For functions which don't use temporary device memory, and won't be likely
 // to use them in the future, the RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle)
 // macro can be used to return from a rocblas function with a requested size of 0.
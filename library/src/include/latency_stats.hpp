@@ -0,0 +1,367 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_latency_stats keeps histograms of the host time spent in each     *
+ * rocBLAS function, split into the phases of rocblas_latency_phase.         *
+ *                                                                           *
+ * Calls are not timed by the functions themselves. rocblas_latency_call is  *
+ * told about the events of a call by hooks in the handle and in logging:    *
+ * the call starts when the rocblas_call_scope of its public function is     *
+ * created, which names it, and its logging is done when the last of its     *
+ * trace, bench and profile logging is written. After that, the first        *
+ * workspace allocation or use of the handle's stream marks the end of       *
+ * argument checking. The call ends when its rocblas_call_scope is           *
+ * destroyed, as the public function returns, and it is recorded then. A     *
+ * call which does not end is not recorded.                                  *
+ *                                                                           *
+ * Histograms use HDR-style buckets: values are grouped by their power of 2, *
+ * and each power of 2 is split into ROCBLAS_LATENCY_SUB_BUCKETS buckets.    *
+ *****************************************************************************/
+
+#include "rocblas_ostream.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Each power of 2 is split into 2^ROCBLAS_LATENCY_SUB_BUCKET_BITS buckets, for a
+// relative error of at most 1/16. Values of 2^ROCBLAS_LATENCY_MAX_BITS ns (18 minutes)
+// or more are counted in the last bucket.
+constexpr int    ROCBLAS_LATENCY_SUB_BUCKET_BITS = 4;
+constexpr int    ROCBLAS_LATENCY_MAX_BITS        = 40;
+constexpr size_t ROCBLAS_LATENCY_SUB_BUCKETS     = size_t(1) << ROCBLAS_LATENCY_SUB_BUCKET_BITS;
+constexpr size_t ROCBLAS_LATENCY_BUCKETS
+    = size_t(ROCBLAS_LATENCY_MAX_BITS - ROCBLAS_LATENCY_SUB_BUCKET_BITS + 1)
+      * ROCBLAS_LATENCY_SUB_BUCKETS;
+
+constexpr int ROCBLAS_LATENCY_PHASES = rocblas_latency_phase_dispatch + 1;
+
+// Names of the phases, as written to YAML
+constexpr const char* rocblas_latency_phase_names[ROCBLAS_LATENCY_PHASES]
+    = {"total", "arguments", "logging", "workspace", "dispatch"};
+
+// Histogram of latencies in nanoseconds. It is not thread-safe.
+class rocblas_latency_histogram
+{
+    std::vector<uint64_t> m_buckets;
+    uint64_t              m_count = 0;
+    uint64_t              m_sum   = 0;
+    uint64_t              m_min   = 0;
+    uint64_t              m_max   = 0;
+
+public:
+    // Bucket containing value. Values below ROCBLAS_LATENCY_SUB_BUCKETS have their own bucket.
+    static size_t bucket(uint64_t value)
+    {
+        value = std::min(value, (uint64_t(1) << ROCBLAS_LATENCY_MAX_BITS) - 1);
+        if(value < ROCBLAS_LATENCY_SUB_BUCKETS)
+            return value;
+        int shift = 0;
+        while(value >> shift >= 2 * ROCBLAS_LATENCY_SUB_BUCKETS)
+            ++shift;
+        return (shift + 1) * ROCBLAS_LATENCY_SUB_BUCKETS
+               + ((value >> shift) - ROCBLAS_LATENCY_SUB_BUCKETS);
+    }
+
+    // Smallest value in a bucket
+    static uint64_t bucket_lower(size_t b)
+    {
+        if(b < ROCBLAS_LATENCY_SUB_BUCKETS)
+            return b;
+        size_t shift = b / ROCBLAS_LATENCY_SUB_BUCKETS - 1;
+        return (ROCBLAS_LATENCY_SUB_BUCKETS + b % ROCBLAS_LATENCY_SUB_BUCKETS) << shift;
+    }
+
+    void record(uint64_t value)
+    {
+        if(m_buckets.empty())
+            m_buckets.resize(ROCBLAS_LATENCY_BUCKETS);
+        m_buckets[bucket(value)] += 1;
+        m_min = m_count ? std::min(m_min, value) : value;
+        m_max = m_count ? std::max(m_max, value) : value;
+        m_count += 1;
+        m_sum += value;
+    }
+
+    void merge(const rocblas_latency_histogram& other)
+    {
+        if(!other.m_count)
+            return;
+        if(m_buckets.empty())
+            m_buckets.resize(ROCBLAS_LATENCY_BUCKETS);
+        for(size_t b = 0; b < ROCBLAS_LATENCY_BUCKETS; ++b)
+            m_buckets[b] += other.m_buckets[b];
+        m_min = m_count ? std::min(m_min, other.m_min) : other.m_min;
+        m_max = m_count ? std::max(m_max, other.m_max) : other.m_max;
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+    }
+
+    uint64_t count() const
+    {
+        return m_count;
+    }
+
+    uint64_t min() const
+    {
+        return m_min;
+    }
+
+    uint64_t max() const
+    {
+        return m_max;
+    }
+
+    double mean() const
+    {
+        return m_count ? double(m_sum) / m_count : 0;
+    }
+
+    // Value below which percent % of the values fall, estimated as the middle of its
+    // bucket and clamped to the range of the values. The smallest and largest values are
+    // exact. Returns 0 if there are no values.
+    uint64_t percentile(double percent) const
+    {
+        if(!m_count)
+            return 0;
+        uint64_t rank = std::max<uint64_t>(1, uint64_t(std::ceil(percent / 100 * m_count)));
+        if(rank >= m_count)
+            return m_max;
+        if(rank == 1)
+            return m_min;
+        uint64_t seen = 0;
+        size_t   b    = 0;
+        while(b < ROCBLAS_LATENCY_BUCKETS - 1 && (seen += m_buckets[b]) < rank)
+            ++b;
+        uint64_t lower = bucket_lower(b);
+        uint64_t upper = b < ROCBLAS_LATENCY_BUCKETS - 1 ? bucket_lower(b + 1) : lower + 1;
+        return std::min(std::max(lower + (upper - lower) / 2, m_min), m_max);
+    }
+};
+
+class rocblas_latency_stats
+{
+public:
+    using phases_t = std::array<rocblas_latency_histogram, ROCBLAS_LATENCY_PHASES>;
+
+private:
+    mutable std::mutex m_mutex;
+
+    // Function names are string literals, so they are looked up by address
+    std::unordered_map<const char*, phases_t> m_functions;
+
+public:
+    // Record the time in nanoseconds spent in each phase of a call of function
+    void record(const char* function, const uint64_t (&ns)[ROCBLAS_LATENCY_PHASES])
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto&                       phases = m_functions[function];
+        for(int p = 0; p < ROCBLAS_LATENCY_PHASES; ++p)
+            phases[p].record(ns[p]);
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_functions.clear();
+    }
+
+    // Histograms of each function, sorted by name. Functions with equal names are merged.
+    std::map<std::string, phases_t> functions() const
+    {
+        std::lock_guard<std::mutex>     lock(m_mutex);
+        std::map<std::string, phases_t> sorted;
+        for(const auto& f : m_functions)
+        {
+            auto& phases = sorted[f.first];
+            for(int p = 0; p < ROCBLAS_LATENCY_PHASES; ++p)
+                phases[p].merge(f.second[p]);
+        }
+        return sorted;
+    }
+
+    // Histogram of one phase of the calls of function, which is empty if it was not called
+    rocblas_latency_histogram histogram(const char* function, rocblas_latency_phase phase) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        rocblas_latency_histogram   hist;
+        for(const auto& f : m_functions)
+            if(!strcmp(f.first, function))
+                hist.merge(f.second[phase]);
+        return hist;
+    }
+
+    // Write the histograms as a YAML list item, with one flow mapping per phase of each
+    // function. Latencies are in nanoseconds.
+    void write_yaml(rocblas_internal_ostream& os, int device) const
+    {
+        auto sorted = functions();
+        os << "- " << std::make_pair("device", device) << "\n"
+           << "  functions:" << (sorted.empty() ? " []\n" : "\n");
+
+        for(const auto& f : sorted)
+        {
+            os << "    - " << std::make_pair("rocblas_function", f.first.c_str()) << "\n"
+               << "      " << std::make_pair("calls", f.second[0].count()) << "\n";
+            for(int p = 0; p < ROCBLAS_LATENCY_PHASES; ++p)
+            {
+                const auto& h = f.second[p];
+                os << "      " << rocblas_latency_phase_names[p] << "_ns: { "
+                   << std::make_pair("mean", uint64_t(std::llround(h.mean()))) << ", "
+                   << std::make_pair("p50", h.percentile(50)) << ", "
+                   << std::make_pair("p90", h.percentile(90)) << ", "
+                   << std::make_pair("p99", h.percentile(99)) << ", "
+                   << std::make_pair("max", h.max()) << " }\n";
+            }
+        }
+        os.flush();
+    }
+};
+
+// The call being timed on the current thread. Only the hooks are public.
+class rocblas_latency_call
+{
+    using clock = std::chrono::steady_clock;
+
+public:
+    using time_point = clock::time_point;
+
+private:
+
+    struct state_t
+    {
+        std::weak_ptr<rocblas_latency_stats> stats;
+        const rocblas_latency_stats*         owner    = nullptr; // nullptr if no call is open
+        const char*                          function = nullptr;
+        clock::time_point                    start, logged, first;
+        clock::duration                      workspace{};
+        bool                                 dispatched = false; // whether first is set
+
+        // Record the open call, which ended at end
+        void finish(clock::time_point end)
+        {
+            auto locked = stats.lock();
+            stats.reset();
+            owner = nullptr;
+            if(!locked)
+                return;
+
+            if(!dispatched)
+                first = end;
+            auto ns = [](clock::duration d) {
+                return uint64_t(std::max<int64_t>(0, std::chrono::nanoseconds(d).count()));
+            };
+            uint64_t phases[ROCBLAS_LATENCY_PHASES];
+            phases[rocblas_latency_phase_total]     = ns(end - start);
+            phases[rocblas_latency_phase_arguments] = ns(first - logged);
+            phases[rocblas_latency_phase_logging]   = ns(logged - start);
+            phases[rocblas_latency_phase_workspace] = ns(workspace);
+            phases[rocblas_latency_phase_dispatch]  = ns(end - first - workspace);
+            locked->record(function, phases);
+        }
+    };
+
+    static state_t& state()
+    {
+        thread_local state_t t_state;
+        return t_state;
+    }
+
+    // Mark the end of argument checking, which is the first event after logging
+    static void mark(state_t& s, clock::time_point time)
+    {
+        if(!s.dispatched)
+        {
+            s.first      = time;
+            s.dispatched = true;
+        }
+    }
+
+public:
+    // A call of function begins, as its public function is entered. A call which is
+    // still open has not ended, so it is dropped.
+    static void begin(const std::shared_ptr<rocblas_latency_stats>& stats, const char* function)
+    {
+        auto& s      = state();
+        s.stats      = stats;
+        s.owner      = stats.get();
+        s.function   = function;
+        s.workspace  = {};
+        s.dispatched = false;
+        s.start      = clock::now();
+        s.logged     = s.start;
+    }
+
+    // The open call has been logged, until more of it is logged
+    static void log_end(const rocblas_latency_stats* stats)
+    {
+        auto& s = state();
+        if(s.owner == stats && !s.dispatched)
+            s.logged = clock::now();
+    }
+
+    // The handle's stream is used
+    static void event(const rocblas_latency_stats* stats)
+    {
+        auto& s = state();
+        if(s.owner == stats && !s.dispatched)
+            mark(s, clock::now());
+    }
+
+    // Workspace was allocated between begin and end
+    static void workspace(const rocblas_latency_stats* stats,
+                          clock::time_point            begin,
+                          clock::time_point            end)
+    {
+        auto& s = state();
+        if(s.owner == stats)
+        {
+            mark(s, begin);
+            s.workspace += end - begin;
+        }
+    }
+
+    // The call open on this thread returns from its public function, and is recorded if
+    // it belongs to stats
+    static void end(const rocblas_latency_stats* stats)
+    {
+        auto& s = state();
+        if(s.owner == stats)
+            s.finish(clock::now());
+    }
+
+    static clock::time_point now()
+    {
+        return clock::now();
+    }
+};
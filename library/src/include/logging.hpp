@@ -22,8 +22,10 @@
 
 #pragma once
 
+#include "binary_log.hpp"
 #include "handle.hpp"
 #include "rocblas_ostream.hpp"
+#include "sharded_counter.hpp"
 #include "tuple_helper.hpp"
 #include <cmath>
 #include <cstdlib>
@@ -33,7 +35,6 @@
 #include <map>
 #include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -46,49 +47,23 @@
 template <typename TUP>
 class argument_profile
 {
-    // Output stream
+    // Output stream, and mutex for writing dumps to it
     mutable rocblas_internal_ostream os;
+    mutable std::mutex               os_mutex;
 
-    // Mutex for multithreaded access to table
-    mutable std::shared_timed_mutex mutex;
-
-    // Table mapping argument tuples into counts
-    // size_t is used for the map target type since atomic types are not movable, and
-    // the map elements will only be moved when we hold an exclusive lock to the map.
-    std::unordered_map<TUP,
-                       size_t,
-                       typename tuple_helper::hash_t<TUP>,
-                       typename tuple_helper::equal_t<TUP>>
-        map;
+    // Table mapping argument tuples into counts, sharded by thread so that
+    // concurrent calls do not contend on a lock
+    mutable rocblas_sharded_counter<TUP,
+                                    typename tuple_helper::hash_t<TUP>,
+                                    typename tuple_helper::equal_t<TUP>>
+        counts;
 
 public:
-    // A tuple of arguments is looked up in an unordered map.
-    // A count of the number of calls with these arguments is kept.
+    // A tuple of arguments is counted in the calling thread's shard of the table.
     // arg is assumed to be an rvalue for efficiency
     void operator()(TUP&& arg)
     {
-        { // Acquire a shared lock for reading map
-            std::shared_lock<std::shared_timed_mutex> lock(mutex);
-
-            // Look up the tuple in the map
-            auto p = map.find(arg);
-
-            // If tuple already exists, atomically increment count and return
-            if(p != map.end())
-            {
-                __atomic_fetch_add(&p->second, 1, __ATOMIC_SEQ_CST);
-                return;
-            }
-        } // Release shared lock
-
-        { // Acquire an exclusive lock for modifying map
-            std::lock_guard<std::shared_timed_mutex> lock(mutex);
-
-            // If doesn't already exist, insert tuple by moving arg and initializing count to 0.
-            // Increment the count after searching for tuple and returning old or new match.
-            // We hold a lock to the map, so we don't have to increment the count atomically.
-            map.emplace(std::move(arg), 0).first->second++;
-        } // Release exclusive lock
+        counts.add(std::move(arg));
     }
 
     // Constructor
@@ -101,19 +76,17 @@ public:
     // Dump the current profile
     void dump() const
     {
-        // Acquire an exclusive lock to use map
-        std::lock_guard<std::shared_timed_mutex> lock(mutex);
+        std::lock_guard<std::mutex> lock(os_mutex);
 
         // Clear the output buffer
         os.clear();
 
-        // Print all of the tuples in the map
-        for(const auto& p : map)
-        {
+        // Merge the shards of all threads, and print all of the tuples in the table
+        counts.for_each([&](const TUP& tup, size_t count) {
             os << "- ";
             tuple_helper::print_tuple_pairs(
-                os, std::tuple_cat(p.first, std::make_tuple("call_count", p.second)));
-        }
+                os, std::tuple_cat(tup, std::make_tuple("call_count", count)));
+        });
 
         // Flush out the dump
         os.flush();
@@ -150,6 +123,9 @@ void log_profile(rocblas_handle handle, const char* func, Ts&&... xs)
 
     // Profile the tuple
     profile(std::move(tup));
+
+    if(handle->latency_stats)
+        rocblas_latency_call::log_end(handle->latency_stats.get());
 }
 
 /********************************************
@@ -167,11 +143,18 @@ void log_arguments(rocblas_internal_ostream& os, const char* sep, H&& head, Ts&&
 
 // if trace logging is turned on with
 // (handle->layer_mode & rocblas_layer_mode_log_trace) != 0
-// log_function will call log_arguments to log arguments with a comma separator
+// log_function will call log_arguments to log arguments with a comma separator,
+// or will write them to the binary log if rocblas_layer_mode_log_binary is also set
 template <typename... Ts>
 void log_trace(rocblas_handle handle, Ts&&... xs)
 {
-    log_arguments(*handle->log_trace_os, ",", std::forward<Ts>(xs)..., handle->atomics_mode);
+    if(handle->log_binary)
+        handle->log_binary->write(rocblas_log_kind::trace, handle, xs..., handle->atomics_mode);
+    else
+        log_arguments(*handle->log_trace_os, ",", std::forward<Ts>(xs)..., handle->atomics_mode);
+
+    if(handle->latency_stats)
+        rocblas_latency_call::log_end(handle->latency_stats.get());
 }
 
 // if bench logging is turned on with
@@ -181,10 +164,21 @@ void log_trace(rocblas_handle handle, Ts&&... xs)
 template <typename... Ts>
 void log_bench(rocblas_handle handle, Ts&&... xs)
 {
-    if(handle->atomics_mode == rocblas_atomics_not_allowed)
+    if(handle->log_binary)
+    {
+        auto& log = *handle->log_binary;
+        if(handle->atomics_mode == rocblas_atomics_not_allowed)
+            log.write(rocblas_log_kind::bench, handle, xs..., "--atomics_not_allowed");
+        else
+            log.write(rocblas_log_kind::bench, handle, xs...);
+    }
+    else if(handle->atomics_mode == rocblas_atomics_not_allowed)
         log_arguments(*handle->log_bench_os, " ", std::forward<Ts>(xs)..., "--atomics_not_allowed");
     else
         log_arguments(*handle->log_bench_os, " ", std::forward<Ts>(xs)...);
+
+    if(handle->latency_stats)
+        rocblas_latency_call::log_end(handle->latency_stats.get());
 }
 
 /*************************************************
@@ -209,18 +203,17 @@ inline T log_trace_scalar_value(const T* value)
                      std::numeric_limits<typename T::value_type>::quiet_NaN()};
 }
 
+// The value is returned rather than formatted, so that it can be written to either log
 template <typename T>
-std::string log_trace_scalar_value(rocblas_handle handle, const T* value)
+auto log_trace_scalar_value(rocblas_handle handle, const T* value)
 {
-    rocblas_internal_ostream os;
-    T                        host;
+    T host;
     if(value && handle->pointer_mode == rocblas_pointer_mode_device)
     {
         hipMemcpy(&host, value, sizeof(host), hipMemcpyDeviceToHost);
         value = &host;
     }
-    os << log_trace_scalar_value(value);
-    return os.str();
+    return log_trace_scalar_value(value);
 }
 
 #define LOG_TRACE_SCALAR_VALUE(handle, value) log_trace_scalar_value(handle, value)
@@ -228,34 +221,36 @@ std::string log_trace_scalar_value(rocblas_handle handle, const T* value)
 /*************************************************
  * Bench log scalar values pointed to by pointer *
  *************************************************/
-inline std::string log_bench_scalar_value(const char* name, const rocblas_half* value)
+inline rocblas_log_bench_scalar<float> log_bench_scalar_arg(const char*         name,
+                                                             const rocblas_half* value)
 {
-    rocblas_internal_ostream ss;
-    ss << "--" << name << " " << (value ? float(*value) : std::numeric_limits<float>::quiet_NaN());
-    return ss.str();
+    return {name, value ? float(*value) : std::numeric_limits<float>::quiet_NaN()};
 }
 
 template <typename T, std::enable_if_t<!rocblas_is_complex<T>, int> = 0>
-std::string log_bench_scalar_value(const char* name, const T* value)
+rocblas_log_bench_scalar<T> log_bench_scalar_arg(const char* name, const T* value)
 {
-    rocblas_internal_ostream ss;
-    ss << "--" << name << " " << (value ? *value : std::numeric_limits<T>::quiet_NaN());
-    return ss.str();
+    return {name, value ? *value : std::numeric_limits<T>::quiet_NaN()};
 }
 
+// A null complex value is output as a NaN real part, without an imaginary part
 template <typename T, std::enable_if_t<+rocblas_is_complex<T>, int> = 0>
+rocblas_log_bench_scalar<T> log_bench_scalar_arg(const char* name, const T* value)
+{
+    return {name, value ? *value : T{std::numeric_limits<typename T::value_type>::quiet_NaN(), 0}};
+}
+
+template <typename T>
 std::string log_bench_scalar_value(const char* name, const T* value)
 {
     rocblas_internal_ostream ss;
-    ss << "--" << name << " "
-       << (value ? std::real(*value) : std::numeric_limits<typename T::value_type>::quiet_NaN());
-    if(value && std::imag(*value))
-        ss << " --" << name << "i " << std::imag(*value);
+    ss << log_bench_scalar_arg(name, value);
     return ss.str();
 }
 
+// The named value is returned rather than formatted, so that it can be written to either log
 template <typename T>
-std::string log_bench_scalar_value(rocblas_handle handle, const char* name, const T* value)
+auto log_bench_scalar_value(rocblas_handle handle, const char* name, const T* value)
 {
     T host;
     if(value && handle->pointer_mode == rocblas_pointer_mode_device)
@@ -263,7 +258,7 @@ std::string log_bench_scalar_value(rocblas_handle handle, const char* name, cons
         hipMemcpy(&host, value, sizeof(host), hipMemcpyDeviceToHost);
         value = &host;
     }
-    return log_bench_scalar_value(name, value);
+    return log_bench_scalar_arg(name, value);
 }
 
 #define LOG_BENCH_SCALAR_VALUE(handle, name) log_bench_scalar_value(handle, #name, name)
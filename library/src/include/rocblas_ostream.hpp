@@ -42,6 +42,7 @@
 #include <sys/stat.h>
 #include <thread>
 #include <utility>
+#include <vector>
 #ifdef WIN32
 #include <io.h>
 #include <iostream>
@@ -79,39 +80,6 @@ class ROCBLAS_INTERNAL_EXPORT rocblas_internal_ostream
      **************************************************************************/
     class worker
     {
-        // task_t represents a payload of data and a promise to finish
-        class task_t
-        {
-            std::string        m_str;
-            std::promise<void> m_promise;
-
-        public:
-            // The task takes ownership of the string payload and promise
-            task_t(std::string&& str, std::promise<void>&& promise)
-                : m_str(std::move(str))
-                , m_promise(std::move(promise))
-            {
-            }
-
-            // Notify the future to wake up
-            void set_value()
-            {
-                m_promise.set_value();
-            }
-
-            // Size of the string payload
-            size_t size() const
-            {
-                return m_str.size();
-            }
-
-            // Data of the string payload
-            const char* data() const
-            {
-                return m_str.data();
-            }
-        };
-
         // FILE is used for safety in the presence of signals
         FILE* m_file = nullptr;
 
@@ -121,21 +89,34 @@ class ROCBLAS_INTERNAL_EXPORT rocblas_internal_ostream
         // Condition variable for worker notification
         std::condition_variable m_cond;
 
-        // Mutex for this thread's queue
+        // Condition variable for notifying senders that their strings have been written
+        std::condition_variable m_done;
+
+        // Mutex for this thread's queue and counters
         std::mutex m_mutex;
 
-        // Queue of tasks
-        std::queue<task_t> m_queue;
+        // Queue of strings which have not been taken by the worker thread
+        std::vector<std::string> m_queue;
+
+        // Number of strings which have been queued, and which have been written
+        uint64_t m_queued  = 0;
+        uint64_t m_written = 0;
 
-        // Worker thread which waits for and handles tasks sequentially
+        // Set after a write error, after which strings are discarded
+        bool m_error = false;
+
+        // Write a batch of strings with as few system calls as possible
+        bool write_batch(const std::vector<std::string>& batch, size_t count);
+
+        // Worker thread which waits for and writes batches of strings
         void thread_function();
 
     public:
         // Worker constructor creates a worker thread for a raw filehandle
         explicit worker(int fd);
 
-        // Send a string to be written
-        void send(std::string);
+        // Send a string to be written. If wait is true, wait until it has been written.
+        void send(std::string, bool wait = true);
 
         // Destroy a worker when all std::shared_ptr references to it are gone
         ~worker();
@@ -184,12 +165,16 @@ class ROCBLAS_INTERNAL_EXPORT rocblas_internal_ostream
     // Flag indicating whether YAML mode is turned on
     bool m_yaml = false;
 
+    // Flag indicating whether flush() returns without waiting for the output to be written
+    bool m_async = false;
+
     // Get worker for file descriptor
     static std::shared_ptr<worker> get_worker(int fd);
 
     // Private explicit copy constructor duplicates the worker and starts a new buffer
     explicit rocblas_internal_ostream(const rocblas_internal_ostream& other)
         : m_worker_ptr(other.m_worker_ptr)
+        , m_async(other.m_async)
     {
     }
 
@@ -246,6 +231,19 @@ public:
     // Flush the output
     void flush();
 
+    // In async mode, flush() queues the output without waiting for it to be written.
+    // The output of a file is still written in order, and is complete once the file's
+    // worker is destroyed, but it may be lost if the process is killed.
+    void set_async(bool async)
+    {
+        m_async = async;
+    }
+
+    bool is_async() const
+    {
+        return m_async;
+    }
+
     // Destroy the rocblas_internal_ostream
     virtual ~rocblas_internal_ostream();
 
@@ -0,0 +1,208 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_sharded_counter counts how many times each key is added, from any *
+ * number of threads, without a lock shared between the threads.             *
+ *                                                                           *
+ * Each thread counts into its own shard of each counter. A shard's mutex is *
+ * only contended while the shard is being merged into the table of the      *
+ * counter, which happens when the shard holds max_entries keys, after every *
+ * flush_calls additions, when the counts are read, and when the thread      *
+ * exits. This bounds the memory held by each shard, and the time that       *
+ * counts can stay unmerged.                                                 *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Default limits on the keys held, and the additions made, by a shard between merges
+constexpr size_t ROCBLAS_SHARD_MAX_ENTRIES = 1024;
+constexpr size_t ROCBLAS_SHARD_FLUSH_CALLS = 1 << 16;
+
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class rocblas_sharded_counter
+{
+public:
+    using map_t = std::unordered_map<Key, size_t, Hash, KeyEqual>;
+
+private:
+    struct shard_t
+    {
+        std::mutex        mutex;
+        map_t             counts;
+        size_t            calls = 0;       // additions since the shard was last merged
+        std::atomic<bool> retired{false}; // whether the thread no longer uses the shard
+    };
+
+    // A thread's shards of the counters of the same type, by counter, and the shard it
+    // added to last. The shards are retired when the thread exits.
+    struct local_t
+    {
+        std::unordered_map<uint64_t, std::shared_ptr<shard_t>> shards;
+        uint64_t                                               owner = 0;
+        shard_t*                                               shard = nullptr;
+
+        ~local_t()
+        {
+            for(auto& p : shards)
+                p.second->retired = true;
+        }
+    };
+
+    // Counters are identified by a serial number rather than an address, which can be reused
+    static uint64_t next_id()
+    {
+        static std::atomic<uint64_t> id{0};
+        return ++id;
+    }
+
+    const uint64_t                        m_id = next_id();
+    const size_t                          m_max_entries;
+    const size_t                          m_flush_calls;
+    std::mutex                            m_mutex;
+    map_t                                 m_table;
+    std::vector<std::shared_ptr<shard_t>> m_shards;
+
+    // Move the counts of a shard into the table. Lock must be held.
+    void merge_shard(shard_t& shard)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for(auto it = shard.counts.begin(); it != shard.counts.end();)
+        {
+            auto next = std::next(it);
+            auto p    = m_table.find(it->first);
+            if(p != m_table.end())
+                p->second += it->second;
+            else
+                m_table.insert(shard.counts.extract(it));
+            it = next;
+        }
+        shard.counts.clear();
+        shard.calls = 0;
+    }
+
+    // Merge the retired shards into the table and drop them. Lock must be held.
+    void drop_retired()
+    {
+        auto retired = [&](const std::shared_ptr<shard_t>& shard) {
+            if(!shard->retired)
+                return false;
+            merge_shard(*shard);
+            return true;
+        };
+        m_shards.erase(std::remove_if(m_shards.begin(), m_shards.end(), retired), m_shards.end());
+    }
+
+    // Merge all shards into the table, and drop the retired ones. Lock must be held.
+    void merge_all()
+    {
+        for(auto& shard : m_shards)
+            merge_shard(*shard);
+        drop_retired();
+    }
+
+    // Find the calling thread's shard of this counter, giving it a new one if it has none
+    void attach(local_t& local)
+    {
+        auto p = local.shards.find(m_id);
+        if(p == local.shards.end())
+        {
+            // Forget the shards of destroyed counters, which only the thread still holds
+            for(auto it = local.shards.begin(); it != local.shards.end();)
+                it = it->second.use_count() == 1 ? local.shards.erase(it) : std::next(it);
+
+            auto shard = std::make_shared<shard_t>();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                drop_retired();
+                m_shards.push_back(shard);
+            }
+            p = local.shards.emplace(m_id, std::move(shard)).first;
+        }
+        local.owner = m_id;
+        local.shard = p->second.get();
+    }
+
+public:
+    explicit rocblas_sharded_counter(size_t max_entries = ROCBLAS_SHARD_MAX_ENTRIES,
+                                     size_t flush_calls = ROCBLAS_SHARD_FLUSH_CALLS)
+        : m_max_entries(max_entries ? max_entries : 1)
+        , m_flush_calls(flush_calls ? flush_calls : 1)
+    {
+    }
+
+    // The counter is not copyable or assignable
+    rocblas_sharded_counter(const rocblas_sharded_counter&) = delete;
+    rocblas_sharded_counter& operator=(const rocblas_sharded_counter&) = delete;
+
+    // Count one addition of key. key is only moved from if it is new to the shard.
+    void add(Key&& key)
+    {
+        static thread_local local_t local;
+        if(local.owner != m_id)
+            attach(local);
+
+        shard_t& shard = *local.shard;
+        bool     flush;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            ++shard.counts.try_emplace(std::move(key), 0).first->second;
+            flush = shard.counts.size() >= m_max_entries || ++shard.calls >= m_flush_calls;
+        }
+
+        if(flush)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            merge_shard(shard);
+        }
+    }
+
+    // Merge all shards, and call f(key, count) for each key which has been added
+    template <typename F>
+    void for_each(F&& f)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        merge_all();
+        for(const auto& p : m_table)
+            f(p.first, p.second);
+    }
+
+    // Number of shards in use, after merging and dropping the retired ones
+    size_t shard_count()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        merge_all();
+        return m_shards.size();
+    }
+};
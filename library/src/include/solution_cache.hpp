@@ -0,0 +1,240 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_solution_cache is a bounded, thread-safe LRU cache which memoizes *
+ * the result of solution selection for a normalized problem descriptor.     *
+ *                                                                           *
+ * It does not reference any Tensile identifiers, so that it can be used by  *
+ * tensile_host.cpp with Tensile solutions, and by the clients with a mock   *
+ * solution library.                                                         *
+ *****************************************************************************/
+
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+// Default number of problems remembered per device
+constexpr size_t ROCBLAS_SOLUTION_CACHE_DEFAULT_CAPACITY = 1024;
+
+// Parse a cache capacity, such as the value of ROCBLAS_SOLUTION_CACHE_SIZE. Returns false,
+// leaving capacity unchanged, unless str is a whole nonnegative number which fits in size_t.
+inline bool rocblas_parse_solution_cache_capacity(const char* str, size_t& capacity)
+{
+    while(isspace(static_cast<unsigned char>(*str)))
+        ++str;
+    if(!isdigit(static_cast<unsigned char>(*str)))
+        return false;
+
+    char*              end;
+    unsigned long long value;
+    errno = 0;
+    value = strtoull(str, &end, 0);
+    while(isspace(static_cast<unsigned char>(*end)))
+        ++end;
+    if(*end || errno == ERANGE || value > SIZE_MAX)
+        return false;
+    capacity = size_t(value);
+    return true;
+}
+
+/**********************************************************************
+ * Hash and compare the bytes of a trivially copyable key. Keys must  *
+ * be value-initialized before their members are set, so that padding *
+ * bytes compare and hash equal.                                      *
+ **********************************************************************/
+template <typename Key>
+struct rocblas_solution_cache_hash
+{
+    static_assert(std::is_trivially_copyable<Key>{},
+                  "Solution cache keys must be trivially copyable");
+
+    size_t operator()(const Key& key) const noexcept
+    {
+        auto     bytes = reinterpret_cast<const unsigned char*>(&key);
+        uint64_t hash  = 0xcbf29ce484222325;
+        for(size_t i = 0; i < sizeof(Key); ++i)
+            hash = (hash ^ bytes[i]) * 0x100000001b3;
+        return size_t(hash);
+    }
+};
+
+template <typename Key>
+struct rocblas_solution_cache_equal
+{
+    bool operator()(const Key& a, const Key& b) const noexcept
+    {
+        return !memcmp(&a, &b, sizeof(Key));
+    }
+};
+
+template <typename Key,
+          typename Value,
+          typename Hash     = rocblas_solution_cache_hash<Key>,
+          typename KeyEqual = rocblas_solution_cache_equal<Key>>
+class rocblas_solution_cache
+{
+    using lru_list = std::list<std::pair<Key, Value>>;
+
+    mutable std::mutex                                                   m_mutex;
+    lru_list                                                             m_lru;
+    std::unordered_map<Key, typename lru_list::iterator, Hash, KeyEqual> m_map;
+    size_t                                                               m_capacity;
+    std::atomic<size_t>                                                  m_hits{0};
+    std::atomic<size_t>                                                  m_misses{0};
+    std::atomic<size_t>                                                  m_evictions{0};
+
+    // Remove least recently used entries until size <= capacity. Lock must be held.
+    void trim()
+    {
+        while(m_map.size() > m_capacity)
+        {
+            m_map.erase(m_lru.back().first);
+            m_lru.pop_back();
+            ++m_evictions;
+        }
+    }
+
+public:
+    explicit rocblas_solution_cache(size_t capacity = ROCBLAS_SOLUTION_CACHE_DEFAULT_CAPACITY)
+        : m_capacity(capacity)
+    {
+    }
+
+    // The cache is not copyable or assignable
+    rocblas_solution_cache(const rocblas_solution_cache&) = delete;
+    rocblas_solution_cache& operator=(const rocblas_solution_cache&) = delete;
+
+    // A cache with a capacity of 0 is disabled
+    bool enabled() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_capacity != 0;
+    }
+
+    // Look up key, copying the cached value to value and returning true on a hit
+    bool find(const Key& key, Value& value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_map.find(key);
+        if(it == m_map.end())
+        {
+            ++m_misses;
+            return false;
+        }
+
+        // Move the entry to the front of the LRU list
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        value = it->second->second;
+        ++m_hits;
+        return true;
+    }
+
+    // Insert or replace the value for key, evicting the least recently used entry if full
+    void insert(const Key& key, Value value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_capacity)
+            return;
+
+        auto it = m_map.find(key);
+        if(it != m_map.end())
+        {
+            it->second->second = std::move(value);
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return;
+        }
+
+        m_lru.emplace_front(key, std::move(value));
+        m_map.emplace(key, m_lru.begin());
+        trim();
+    }
+
+    // Look up key, calling select() on a miss to compute the value to be cached.
+    // select() is called without holding the lock, and returns false if its value
+    // should not be cached (for example, if no solution was found).
+    template <typename Select>
+    Value find_or_select(const Key& key, Select&& select)
+    {
+        Value value{};
+        if(!find(key, value) && select(value))
+            insert(key, value);
+        return value;
+    }
+
+    // Change the capacity, evicting entries if necessary
+    void set_capacity(size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacity = capacity;
+        trim();
+    }
+
+    size_t capacity() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_capacity;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_map.size();
+    }
+
+    size_t hits() const
+    {
+        return m_hits;
+    }
+
+    size_t misses() const
+    {
+        return m_misses;
+    }
+
+    size_t evictions() const
+    {
+        return m_evictions;
+    }
+
+    // Remove all entries and reset the counters
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_map.clear();
+        m_lru.clear();
+        m_hits      = 0;
+        m_misses    = 0;
+        m_evictions = 0;
+    }
+};
@@ -0,0 +1,360 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_solution_cache_file persists the result of solution selection     *
+ * across processes. It maps the normalized descriptor of a problem to the   *
+ * index of the solution which was selected for it.                          *
+ *                                                                           *
+ * The file consists of a header followed by records sorted by the bytes of  *
+ * their keys. It is memory-mapped when it is opened, and searched in place. *
+ * Records added by the process are kept in memory, and are merged into the  *
+ * file by save(), which replaces the file atomically.                       *
+ *                                                                           *
+ * The records of a file are only used if its format version, record size,   *
+ * architecture name and library build ID all match those of the process.    *
+ * Otherwise the file is stale; if it is truncated or unsorted, it is        *
+ * corrupt. In both cases it is overwritten by the next save().              *
+ *                                                                           *
+ * Like rocblas_solution_cache, it does not reference Tensile identifiers.   *
+ *****************************************************************************/
+
+#include "solution_cache.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef WIN32
+#include <fstream>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Version of the file format. Files with a different version are stale.
+constexpr uint32_t ROCBLAS_SOLUTION_CACHE_FILE_VERSION = 1;
+
+template <typename Key,
+          typename Hash     = rocblas_solution_cache_hash<Key>,
+          typename KeyEqual = rocblas_solution_cache_equal<Key>>
+class rocblas_solution_cache_file
+{
+public:
+    // The state of the file when it was opened
+    enum class file_state
+    {
+        missing, // the file does not exist or cannot be read
+        loaded,  // the records of the file are used
+        stale,   // the file was written for another format, architecture or build
+        corrupt, // the file is truncated or malformed
+    };
+
+    struct header_t
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t record_size;
+        uint64_t count;
+        char     arch[64];
+        char     build_id[192];
+    };
+
+    struct record_t
+    {
+        Key     key;
+        int64_t index;
+    };
+
+private:
+    std::string     m_path;
+    header_t        m_header; // header expected for this process, except for count
+    file_state      m_state   = file_state::missing;
+    const record_t* m_records = nullptr; // records of the file, if it is loaded
+    size_t          m_count   = 0;
+
+#ifdef WIN32
+    std::vector<char> m_buffer;
+#else
+    void*  m_map      = nullptr;
+    size_t m_map_size = 0;
+#endif
+
+    // Records added by the process
+    mutable std::mutex                               m_mutex;
+    std::unordered_map<Key, int64_t, Hash, KeyEqual> m_added;
+
+    static bool key_less(const record_t& a, const record_t& b)
+    {
+        return memcmp(&a.key, &b.key, sizeof(Key)) < 0;
+    }
+
+    // Copy a string to a fixed-size field, truncating it and padding it with 0s
+    template <size_t N>
+    static void copy_field(char (&field)[N], const std::string& str)
+    {
+        memset(field, 0, N);
+        memcpy(field, str.data(), std::min(str.size(), N - 1));
+    }
+
+    // Map the file into memory, or read it on Windows. Returns false if it cannot be read.
+    bool map_file(const char*& data, size_t& size)
+    {
+#ifdef WIN32
+        std::ifstream file(m_path, std::ios::binary | std::ios::ate);
+        if(!file)
+            return false;
+        m_buffer.resize(size_t(file.tellg()));
+        file.seekg(0);
+        if(!file.read(m_buffer.data(), m_buffer.size()))
+            return false;
+        data = m_buffer.data();
+        size = m_buffer.size();
+        return true;
+#else
+        int fd = open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd == -1)
+            return false;
+
+        struct stat st;
+        bool        success = !fstat(fd, &st);
+        if(success && st.st_size)
+        {
+            void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(map == MAP_FAILED)
+                success = false;
+            else
+            {
+                m_map      = map;
+                m_map_size = st.st_size;
+            }
+        }
+        close(fd);
+
+        data = static_cast<const char*>(m_map);
+        size = m_map_size;
+        return success;
+#endif
+    }
+
+    void unmap_file()
+    {
+#ifdef WIN32
+        m_buffer.clear();
+#else
+        if(m_map)
+            munmap(m_map, m_map_size);
+        m_map      = nullptr;
+        m_map_size = 0;
+#endif
+        m_records = nullptr;
+        m_count   = 0;
+    }
+
+    // Validate the file and use its records
+    file_state load()
+    {
+        const char* data;
+        size_t      size;
+        if(!map_file(data, size))
+            return file_state::missing;
+
+        header_t header;
+        if(size < sizeof(header))
+            return file_state::corrupt;
+        memcpy(&header, data, sizeof(header));
+
+        if(memcmp(header.magic, m_header.magic, sizeof(header.magic)))
+            return file_state::corrupt;
+        if(header.version != m_header.version || header.record_size != m_header.record_size
+           || memcmp(header.arch, m_header.arch, sizeof(header.arch))
+           || memcmp(header.build_id, m_header.build_id, sizeof(header.build_id)))
+            return file_state::stale;
+        if(header.count != (size - sizeof(header)) / sizeof(record_t)
+           || (size - sizeof(header)) % sizeof(record_t))
+            return file_state::corrupt;
+
+        // The header is a multiple of 8 bytes, so the records are aligned
+        auto records = reinterpret_cast<const record_t*>(data + sizeof(header));
+        if(!std::is_sorted(records, records + header.count, key_less))
+            return file_state::corrupt;
+
+        m_records = records;
+        m_count   = header.count;
+        return file_state::loaded;
+    }
+
+    // Look up key in the records of the file
+    const record_t* find_loaded(const Key& key) const
+    {
+        record_t target;
+        memcpy(&target.key, &key, sizeof(Key));
+        auto it = std::lower_bound(m_records, m_records + m_count, target, key_less);
+        return it != m_records + m_count && !memcmp(&it->key, &key, sizeof(Key)) ? it : nullptr;
+    }
+
+public:
+    static_assert(sizeof(header_t) % alignof(record_t) == 0,
+                  "Records following the header must be aligned");
+
+    // Open the file at path, for the given architecture name and library build ID
+    rocblas_solution_cache_file(std::string        path,
+                                const std::string& arch,
+                                const std::string& build_id)
+        : m_path(std::move(path))
+    {
+        memset(&m_header, 0, sizeof(m_header));
+        memcpy(m_header.magic, "rocBLAS", sizeof(m_header.magic));
+        m_header.version     = ROCBLAS_SOLUTION_CACHE_FILE_VERSION;
+        m_header.record_size = sizeof(record_t);
+        copy_field(m_header.arch, arch);
+        copy_field(m_header.build_id, build_id);
+
+        m_state = load();
+        if(m_state != file_state::loaded)
+            unmap_file();
+    }
+
+    ~rocblas_solution_cache_file()
+    {
+        unmap_file();
+    }
+
+    // The file is not copyable or assignable
+    rocblas_solution_cache_file(const rocblas_solution_cache_file&) = delete;
+    rocblas_solution_cache_file& operator=(const rocblas_solution_cache_file&) = delete;
+
+    const std::string& path() const
+    {
+        return m_path;
+    }
+
+    file_state state() const
+    {
+        return m_state;
+    }
+
+    // Number of records loaded from the file
+    size_t loaded() const
+    {
+        return m_count;
+    }
+
+    // Number of records added by the process which are not in the file
+    size_t added() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_added.size();
+    }
+
+    // Look up the solution index for key, returning true if it is found
+    bool find(const Key& key, int64_t& index) const
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto                        it = m_added.find(key);
+            if(it != m_added.end())
+            {
+                index = it->second;
+                return true;
+            }
+        }
+
+        // The records of the file are immutable, and are searched without locking
+        auto record = find_loaded(key);
+        if(record)
+            index = record->index;
+        return record != nullptr;
+    }
+
+    // Record the solution index for key, to be written by save()
+    void insert(const Key& key, int64_t index)
+    {
+        auto record = find_loaded(key);
+        if(record && record->index == index)
+            return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_added[key] = index;
+    }
+
+    // Write the records of the file and the added records to a temporary file, which then
+    // replaces the file. Nothing is written if no records were added. Returns false on error.
+    bool save()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_added.empty())
+            return true;
+
+        std::vector<record_t> records;
+        records.reserve(m_count + m_added.size());
+        for(size_t i = 0; i < m_count; ++i)
+            if(!m_added.count(m_records[i].key))
+                records.push_back(m_records[i]);
+        for(const auto& p : m_added)
+        {
+            record_t record;
+            memset(&record, 0, sizeof(record));
+            memcpy(&record.key, &p.first, sizeof(Key));
+            record.index = p.second;
+            records.push_back(record);
+        }
+        std::sort(records.begin(), records.end(), key_less);
+
+        header_t header = m_header;
+        header.count    = records.size();
+
+#ifdef WIN32
+        std::string tmp_path = m_path + ".tmp" + std::to_string(_getpid());
+#else
+        std::string tmp_path = m_path + ".tmp" + std::to_string(getpid());
+#endif
+        FILE* file = fopen(tmp_path.c_str(), "wb");
+        if(!file)
+            return false;
+        bool success = fwrite(&header, sizeof(header), 1, file) == 1
+                       && fwrite(records.data(), sizeof(record_t), records.size(), file)
+                              == records.size();
+        success = !fclose(file) && success;
+
+#ifdef WIN32
+        // rename() does not replace an existing file on Windows
+        if(success)
+            remove(m_path.c_str());
+#endif
+        if(!success || rename(tmp_path.c_str(), m_path.c_str()))
+        {
+            remove(tmp_path.c_str());
+            return false;
+        }
+        return true;
+    }
+};
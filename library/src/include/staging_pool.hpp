@@ -0,0 +1,282 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_staging_pool is a thread-safe pool of staging buffers, used by    *
+ * the functions which copy vectors and matrices between the host and the    *
+ * device. A buffer is leased for the duration of a call and returned to the *
+ * pool afterwards, instead of being allocated and freed by every call.      *
+ *                                                                           *
+ * Requests are rounded up to a size class, a power of 2 of at least         *
+ * ROCBLAS_STAGING_MIN_SIZE bytes, so that buffers can be reused by requests *
+ * of similar sizes. Idle buffers are kept up to a limit on their total      *
+ * size, beyond which the least recently used ones are freed; trim() frees   *
+ * them on demand.                                                           *
+ *                                                                           *
+ * Buffer memory is obtained from an Allocator, with the same interface as   *
+ * for rocblas_workspace_arena. The pool must outlive its leases.            *
+ *****************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Smallest size class of a staging buffer
+constexpr size_t ROCBLAS_STAGING_MIN_SIZE = 64 << 10;
+
+// Default limit on the total size of the idle buffers of a pool
+constexpr size_t ROCBLAS_STAGING_DEFAULT_IDLE_LIMIT = 32 << 20;
+
+template <typename Allocator>
+class rocblas_staging_pool
+{
+public:
+    // Counters of a pool
+    struct stats_t
+    {
+        size_t requests    = 0; // number of nonzero-sized leases requested
+        size_t reuses      = 0; // number of leases satisfied by an idle buffer
+        size_t allocations = 0; // number of buffers allocated
+        size_t failures    = 0; // number of leases which could not be satisfied
+        size_t trimmed     = 0; // number of idle buffers freed
+        size_t held        = 0; // total size of all buffers, leased or idle
+        size_t leased      = 0; // total size of the leased buffers
+    };
+
+    // A leased buffer, which is returned to the pool when the lease is destroyed
+    class lease_t
+    {
+        rocblas_staging_pool* m_pool = nullptr;
+        void*                 m_addr = nullptr;
+        size_t                m_size = 0;
+
+        friend class rocblas_staging_pool;
+
+        lease_t(rocblas_staging_pool* pool, void* addr, size_t size)
+            : m_pool(pool)
+            , m_addr(addr)
+            , m_size(size)
+        {
+        }
+
+    public:
+        lease_t() = default;
+
+        lease_t(lease_t&& other) noexcept
+            : m_pool(std::exchange(other.m_pool, nullptr))
+            , m_addr(std::exchange(other.m_addr, nullptr))
+            , m_size(std::exchange(other.m_size, 0))
+        {
+        }
+
+        lease_t& operator=(lease_t&& other) noexcept
+        {
+            if(this != &other)
+            {
+                reset();
+                m_pool = std::exchange(other.m_pool, nullptr);
+                m_addr = std::exchange(other.m_addr, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+            }
+            return *this;
+        }
+
+        ~lease_t()
+        {
+            reset();
+        }
+
+        // Return the buffer to the pool
+        void reset()
+        {
+            if(m_pool)
+                m_pool->release(m_addr, m_size);
+            m_pool = nullptr;
+            m_addr = nullptr;
+            m_size = 0;
+        }
+
+        void* get() const
+        {
+            return m_addr;
+        }
+
+        // Size of the buffer, which may be larger than requested
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        explicit operator bool() const
+        {
+            return m_addr != nullptr;
+        }
+    };
+
+private:
+    struct buffer_t
+    {
+        void*    addr;
+        size_t   size;
+        uint64_t last_use; // value of m_clock when the buffer was returned
+    };
+
+    mutable std::mutex    m_mutex;
+    Allocator             m_allocator;
+    std::vector<buffer_t> m_idle;
+    size_t                m_idle_bytes = 0;
+    size_t                m_idle_limit;
+    uint64_t              m_clock = 0;
+    stats_t               m_stats;
+
+    // Free the least recently used idle buffers until at most keep bytes are idle.
+    // Lock must be held.
+    void trim_locked(size_t keep)
+    {
+        while(m_idle_bytes > keep && !m_idle.empty())
+        {
+            auto lru = m_idle.begin();
+            for(auto it = m_idle.begin(); it != m_idle.end(); ++it)
+                if(it->last_use < lru->last_use)
+                    lru = it;
+
+            // A buffer which cannot be freed is dropped from the pool
+            m_allocator.deallocate(lru->addr);
+            m_idle_bytes -= lru->size;
+            m_stats.held -= lru->size;
+            m_stats.trimmed += 1;
+            m_idle.erase(lru);
+        }
+    }
+
+    void release(void* addr, size_t size)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.leased -= size;
+        m_idle.push_back({addr, size, ++m_clock});
+        m_idle_bytes += size;
+        trim_locked(m_idle_limit);
+    }
+
+public:
+    explicit rocblas_staging_pool(size_t    idle_limit = ROCBLAS_STAGING_DEFAULT_IDLE_LIMIT,
+                                  Allocator allocator  = Allocator{})
+        : m_allocator(std::move(allocator))
+        , m_idle_limit(idle_limit)
+    {
+    }
+
+    ~rocblas_staging_pool()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        trim_locked(0);
+    }
+
+    // The pool is not copyable or assignable
+    rocblas_staging_pool(const rocblas_staging_pool&) = delete;
+    rocblas_staging_pool& operator=(const rocblas_staging_pool&) = delete;
+
+    // Round up size to its size class
+    static constexpr size_t size_class(size_t size)
+    {
+        size_t buffer = ROCBLAS_STAGING_MIN_SIZE;
+        while(buffer < size)
+            buffer *= 2;
+        return buffer;
+    }
+
+    // Lease a buffer of at least size bytes. The smallest idle buffer which is large
+    // enough is reused; otherwise a buffer of the size class is allocated. If that fails,
+    // the idle buffers are freed and the allocation is retried. On failure, or if size is
+    // 0, the lease is empty.
+    lease_t lease(size_t size)
+    {
+        if(!size)
+            return {};
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.requests += 1;
+
+        auto best = m_idle.end();
+        for(auto it = m_idle.begin(); it != m_idle.end(); ++it)
+            if(it->size >= size && (best == m_idle.end() || it->size < best->size))
+                best = it;
+
+        if(best != m_idle.end())
+        {
+            lease_t lease(this, best->addr, best->size);
+            m_idle_bytes -= best->size;
+            m_stats.leased += best->size;
+            m_stats.reuses += 1;
+            m_idle.erase(best);
+            return lease;
+        }
+
+        size_t buffer_size = size_class(size);
+        void*  addr        = nullptr;
+        if(!m_allocator.allocate(&addr, buffer_size))
+        {
+            trim_locked(0);
+            if(!m_allocator.allocate(&addr, buffer_size))
+            {
+                m_stats.failures += 1;
+                return {};
+            }
+        }
+
+        m_stats.allocations += 1;
+        m_stats.held += buffer_size;
+        m_stats.leased += buffer_size;
+        return lease_t(this, addr, buffer_size);
+    }
+
+    // Free idle buffers, least recently used first, until at most keep bytes are idle
+    void trim(size_t keep = 0)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        trim_locked(keep);
+    }
+
+    // Set the limit on the total size of the idle buffers, freeing buffers beyond it
+    void set_idle_limit(size_t limit)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_idle_limit = limit;
+        trim_locked(limit);
+    }
+
+    size_t idle_limit() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_idle_limit;
+    }
+
+    stats_t stats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+};
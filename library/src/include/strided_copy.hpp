@@ -0,0 +1,302 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Host-side packing and unpacking of strided vectors and matrices, used to  *
+ * stage strided host data in contiguous buffers for transfers to and from   *
+ * the device.                                                               *
+ *                                                                           *
+ * The common element sizes are copied by loops specialized for the size,    *
+ * which the compiler turns into plain loads and stores, instead of calling  *
+ * memcpy for each element. On x86-64, 4- and 8-byte elements are packed     *
+ * with AVX2 or AVX-512 gathers, and unpacked with AVX-512 scatters, when    *
+ * the CPU supports them; the choice is made once, at run time, so the       *
+ * library does not have to be built for a particular CPU. When elements are *
+ * a cache line or more apart, the strided side is prefetched ahead of the   *
+ * loop.                                                                     *
+ *****************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if(defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__)) \
+    && !defined(WIN32)
+#define ROCBLAS_STRIDED_COPY_X86 1
+#include <immintrin.h>
+#else
+#define ROCBLAS_STRIDED_COPY_X86 0
+#endif
+
+// Strides of at least this many bytes are prefetched, this many elements ahead
+constexpr size_t ROCBLAS_STRIDED_COPY_PREFETCH_STRIDE   = 64;
+constexpr size_t ROCBLAS_STRIDED_COPY_PREFETCH_DISTANCE = 16;
+
+// Instruction sets which can be used by the vector kernels
+enum class rocblas_strided_copy_isa
+{
+    scalar,
+    avx2,
+    avx512,
+};
+
+// The best instruction set supported by the CPU, detected on first use
+inline rocblas_strided_copy_isa rocblas_strided_copy_cpu_isa()
+{
+#if ROCBLAS_STRIDED_COPY_X86
+    static const rocblas_strided_copy_isa isa = [] {
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f"))
+            return rocblas_strided_copy_isa::avx512;
+        if(__builtin_cpu_supports("avx2"))
+            return rocblas_strided_copy_isa::avx2;
+        return rocblas_strided_copy_isa::scalar;
+    }();
+    return isa;
+#else
+    return rocblas_strided_copy_isa::scalar;
+#endif
+}
+
+// Copy n elements of SIZE bytes. Elements are src_stride bytes apart in src, and
+// dst_stride bytes apart in dst. If PREFETCH is true, the elements of src (when
+// packing) or dst (when unpacking) are prefetched ahead of the copy.
+template <size_t SIZE, bool PREFETCH = false>
+inline void rocblas_strided_copy_fixed(
+    char* dst, size_t dst_stride, const char* src, size_t src_stride, size_t n)
+{
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        if(PREFETCH && i + ROCBLAS_STRIDED_COPY_PREFETCH_DISTANCE + 4 <= n)
+        {
+            for(size_t j = ROCBLAS_STRIDED_COPY_PREFETCH_DISTANCE;
+                j < ROCBLAS_STRIDED_COPY_PREFETCH_DISTANCE + 4;
+                ++j)
+            {
+                if(src_stride > SIZE)
+                    __builtin_prefetch(src + j * src_stride, 0);
+                else
+                    __builtin_prefetch(dst + j * dst_stride, 1);
+            }
+        }
+#endif
+        memcpy(dst, src, SIZE);
+        memcpy(dst + dst_stride, src + src_stride, SIZE);
+        memcpy(dst + 2 * dst_stride, src + 2 * src_stride, SIZE);
+        memcpy(dst + 3 * dst_stride, src + 3 * src_stride, SIZE);
+        dst += 4 * dst_stride;
+        src += 4 * src_stride;
+    }
+    for(; i < n; ++i, dst += dst_stride, src += src_stride)
+        memcpy(dst, src, SIZE);
+}
+
+#if ROCBLAS_STRIDED_COPY_X86
+
+// The vector kernels pack into (or unpack from) a contiguous buffer, with element offsets
+// in the strided buffer given as 32-bit indices. They return the number of elements
+// copied, leaving the remainder to the scalar loop.
+
+template <size_t SIZE>
+__attribute__((target("avx2"))) inline size_t
+    rocblas_strided_gather_avx2(char* dst, const char* src, size_t src_stride, size_t n)
+{
+    constexpr size_t LANES = 32 / SIZE;
+    if(src_stride > INT32_MAX / LANES)
+        return 0;
+
+    int    s = int(src_stride);
+    size_t i = 0;
+    if constexpr(SIZE == 4)
+    {
+        __m256i index = _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+        for(; i + LANES <= n; i += LANES, dst += 32, src += LANES * src_stride)
+            _mm256_storeu_si256((__m256i*)dst,
+                                _mm256_i32gather_epi32((const int*)src, index, 1));
+    }
+    else
+    {
+        __m128i index = _mm_setr_epi32(0, s, 2 * s, 3 * s);
+        for(; i + LANES <= n; i += LANES, dst += 32, src += LANES * src_stride)
+            _mm256_storeu_si256((__m256i*)dst,
+                                _mm256_i32gather_epi64((const long long*)src, index, 1));
+    }
+    return i;
+}
+
+template <size_t SIZE>
+__attribute__((target("avx512f"))) inline size_t
+    rocblas_strided_gather_avx512(char* dst, const char* src, size_t src_stride, size_t n)
+{
+    constexpr size_t LANES = 64 / SIZE;
+    if(src_stride > INT32_MAX / LANES)
+        return 0;
+
+    size_t i = 0;
+    if constexpr(SIZE == 4)
+    {
+        __m512i index = _mm512_mullo_epi32(
+            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+            _mm512_set1_epi32(int(src_stride)));
+        for(; i + LANES <= n; i += LANES, dst += 64, src += LANES * src_stride)
+            _mm512_storeu_si512(dst, _mm512_i32gather_epi32(index, src, 1));
+    }
+    else
+    {
+        __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                           _mm256_set1_epi32(int(src_stride)));
+        for(; i + LANES <= n; i += LANES, dst += 64, src += LANES * src_stride)
+            _mm512_storeu_si512(dst, _mm512_i32gather_epi64(index, src, 1));
+    }
+    return i;
+}
+
+template <size_t SIZE>
+__attribute__((target("avx512f"))) inline size_t
+    rocblas_strided_scatter_avx512(char* dst, size_t dst_stride, const char* src, size_t n)
+{
+    constexpr size_t LANES = 64 / SIZE;
+    if(dst_stride > INT32_MAX / LANES)
+        return 0;
+
+    size_t i = 0;
+    if constexpr(SIZE == 4)
+    {
+        __m512i index = _mm512_mullo_epi32(
+            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+            _mm512_set1_epi32(int(dst_stride)));
+        for(; i + LANES <= n; i += LANES, src += 64, dst += LANES * dst_stride)
+            _mm512_i32scatter_epi32(dst, index, _mm512_loadu_si512(src), 1);
+    }
+    else
+    {
+        __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                           _mm256_set1_epi32(int(dst_stride)));
+        for(; i + LANES <= n; i += LANES, src += 64, dst += LANES * dst_stride)
+            _mm512_i32scatter_epi64(dst, index, _mm512_loadu_si512(src), 1);
+    }
+    return i;
+}
+
+#endif // ROCBLAS_STRIDED_COPY_X86
+
+// Copy n elements of SIZE bytes, using the vector kernels of isa for 4- and 8-byte
+// elements when one side is contiguous, and prefetching strides of a cache line or more
+template <size_t SIZE>
+inline void rocblas_strided_copy_dispatch(char*                    dst,
+                                          size_t                   dst_stride,
+                                          const char*              src,
+                                          size_t                   src_stride,
+                                          size_t                   n,
+                                          rocblas_strided_copy_isa isa)
+{
+#if ROCBLAS_STRIDED_COPY_X86
+    if constexpr(SIZE == 4 || SIZE == 8)
+    {
+        size_t done = 0;
+        if(dst_stride == SIZE && isa == rocblas_strided_copy_isa::avx512)
+            done = rocblas_strided_gather_avx512<SIZE>(dst, src, src_stride, n);
+        else if(dst_stride == SIZE && isa == rocblas_strided_copy_isa::avx2)
+            done = rocblas_strided_gather_avx2<SIZE>(dst, src, src_stride, n);
+        else if(src_stride == SIZE && isa == rocblas_strided_copy_isa::avx512)
+            done = rocblas_strided_scatter_avx512<SIZE>(dst, dst_stride, src, n);
+        dst += done * dst_stride;
+        src += done * src_stride;
+        n -= done;
+    }
+#endif
+    if(src_stride >= ROCBLAS_STRIDED_COPY_PREFETCH_STRIDE
+       || dst_stride >= ROCBLAS_STRIDED_COPY_PREFETCH_STRIDE)
+        rocblas_strided_copy_fixed<SIZE, true>(dst, dst_stride, src, src_stride, n);
+    else
+        rocblas_strided_copy_fixed<SIZE>(dst, dst_stride, src, src_stride, n);
+}
+
+// Copy n elements of elem_size bytes. Elements are src_stride bytes apart in src, and
+// dst_stride bytes apart in dst. Packing uses dst_stride == elem_size, and unpacking
+// uses src_stride == elem_size. isa selects the vector kernels, and defaults to the
+// best instruction set supported by the CPU.
+inline void rocblas_strided_copy_host(void*                    dst,
+                                      size_t                   dst_stride,
+                                      const void*              src,
+                                      size_t                   src_stride,
+                                      size_t                   n,
+                                      size_t                   elem_size,
+                                      rocblas_strided_copy_isa isa = rocblas_strided_copy_cpu_isa())
+{
+    auto d = static_cast<char*>(dst);
+    auto s = static_cast<const char*>(src);
+
+    if(dst_stride == elem_size && src_stride == elem_size)
+    {
+        memcpy(d, s, n * elem_size);
+        return;
+    }
+
+    switch(elem_size)
+    {
+    case 1:
+        return rocblas_strided_copy_dispatch<1>(d, dst_stride, s, src_stride, n, isa);
+    case 2:
+        return rocblas_strided_copy_dispatch<2>(d, dst_stride, s, src_stride, n, isa);
+    case 4:
+        return rocblas_strided_copy_dispatch<4>(d, dst_stride, s, src_stride, n, isa);
+    case 8:
+        return rocblas_strided_copy_dispatch<8>(d, dst_stride, s, src_stride, n, isa);
+    case 16:
+        return rocblas_strided_copy_dispatch<16>(d, dst_stride, s, src_stride, n, isa);
+    default:
+        for(size_t i = 0; i < n; ++i, d += dst_stride, s += src_stride)
+            memcpy(d, s, elem_size);
+    }
+}
+
+// Copy cols columns of row_bytes bytes each. Columns are src_ld bytes apart in src, and
+// dst_ld bytes apart in dst. Used to pack and unpack matrices with a leading dimension.
+inline void rocblas_strided_copy_2d(
+    void* dst, size_t dst_ld, const void* src, size_t src_ld, size_t row_bytes, size_t cols)
+{
+    auto d = static_cast<char*>(dst);
+    auto s = static_cast<const char*>(src);
+
+    if(dst_ld == row_bytes && src_ld == row_bytes)
+    {
+        memcpy(d, s, cols * row_bytes);
+        return;
+    }
+
+    // Short columns are copied as fixed-size elements
+    switch(row_bytes)
+    {
+    case 4:
+    case 8:
+    case 16:
+        return rocblas_strided_copy_host(d, dst_ld, s, src_ld, cols, row_bytes);
+    default:
+        for(size_t j = 0; j < cols; ++j, d += dst_ld, s += src_ld)
+            memcpy(d, s, row_bytes);
+    }
+}
@@ -0,0 +1,261 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_workspace_arena manages the temporary device memory of a handle   *
+ * as a list of slabs. Each slab is a stack: blocks are carved from the top  *
+ * of the slab, and the top is lowered when the topmost block is freed.      *
+ *                                                                           *
+ * When a request does not fit in any slab, the arena grows by adding a new  *
+ * slab, rounded up to a size class, instead of reallocating the memory that *
+ * is already in use. Owned slabs with no blocks in use are freed first,     *
+ * so that the capacity does not keep growing. The newest slab must be freed *
+ * in LIFO order; blocks in older slabs may be freed in any order, and the   *
+ * slab is reset once all of its blocks have been freed.                     *
+ *                                                                           *
+ * The arena only contains host-side bookkeeping. Slab memory is obtained    *
+ * from an Allocator, which must provide:                                    *
+ *                                                                           *
+ *     bool allocate(void** ptr, size_t size);                               *
+ *     bool deallocate(void* ptr);                                           *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Slabs are sized in powers of 2 from MIN_SLAB_SIZE to SLAB_SIZE_CLASS_LIMIT,
+// and in multiples of SLAB_SIZE_CLASS_LIMIT beyond that
+constexpr size_t ROCBLAS_WORKSPACE_MIN_SLAB_SIZE         = 1 << 20;
+constexpr size_t ROCBLAS_WORKSPACE_SLAB_SIZE_CLASS_LIMIT = 64 << 20;
+
+// Round up size to the size class of a new slab
+constexpr size_t rocblas_workspace_slab_size(size_t size)
+{
+    if(size > ROCBLAS_WORKSPACE_SLAB_SIZE_CLASS_LIMIT)
+        return (size + ROCBLAS_WORKSPACE_SLAB_SIZE_CLASS_LIMIT - 1)
+               / ROCBLAS_WORKSPACE_SLAB_SIZE_CLASS_LIMIT * ROCBLAS_WORKSPACE_SLAB_SIZE_CLASS_LIMIT;
+    size_t slab = ROCBLAS_WORKSPACE_MIN_SLAB_SIZE;
+    while(slab < size)
+        slab *= 2;
+    return slab;
+}
+
+template <typename Allocator>
+class rocblas_workspace_arena
+{
+public:
+    // A block of memory allocated from the arena
+    struct block
+    {
+        char*  addr = nullptr;
+        char*  slab = nullptr; // base address of the slab containing the block
+        size_t size = 0;
+    };
+
+private:
+    struct slab_t
+    {
+        char*  base;
+        size_t size;
+        size_t top;    // offset of the first unused byte
+        size_t live;   // number of blocks which have not been freed
+        bool   owned;  // whether the memory is freed by the arena
+        bool   strict; // whether blocks must be freed in LIFO order
+    };
+
+    Allocator           m_allocator;
+    std::vector<slab_t> m_slabs;
+    size_t              m_capacity = 0;
+    size_t              m_in_use   = 0;
+
+    // Carve size bytes from the top of a slab, if they fit
+    bool carve(slab_t& slab, size_t size, block& b)
+    {
+        if(size > slab.size - slab.top)
+            return false;
+        b.addr = slab.base + slab.top;
+        b.slab = slab.base;
+        b.size = size;
+        slab.top += size;
+        slab.live += 1;
+        m_in_use += size;
+        return true;
+    }
+
+    // Append a slab, which becomes the newest slab. Only the newest slab is
+    // strict about LIFO order; older slabs are reset when their last block is freed.
+    void push_slab(char* base, size_t size, bool owned)
+    {
+        if(!m_slabs.empty())
+            m_slabs.back().strict = false;
+        m_slabs.push_back({base, size, 0, 0, owned, true});
+        m_capacity += size;
+    }
+
+    // Add a slab of exactly size bytes from the allocator
+    bool add_slab(size_t size)
+    {
+        void* ptr = nullptr;
+        if(!m_allocator.allocate(&ptr, size))
+            return false;
+        push_slab(static_cast<char*>(ptr), size, true);
+        return true;
+    }
+
+    // Free the slabs which are owned by the arena and have no live blocks
+    void release_idle()
+    {
+        auto idle = [&](const slab_t& slab) {
+            if(slab.live || !slab.owned || !m_allocator.deallocate(slab.base))
+                return false;
+            m_capacity -= slab.size;
+            return true;
+        };
+        m_slabs.erase(std::remove_if(m_slabs.begin(), m_slabs.end(), idle), m_slabs.end());
+    }
+
+public:
+    explicit rocblas_workspace_arena(Allocator allocator = Allocator{})
+        : m_allocator(std::move(allocator))
+    {
+    }
+
+    ~rocblas_workspace_arena()
+    {
+        release();
+    }
+
+    // The arena is not copyable or assignable
+    rocblas_workspace_arena(const rocblas_workspace_arena&) = delete;
+    rocblas_workspace_arena& operator=(const rocblas_workspace_arena&) = delete;
+
+    Allocator& allocator()
+    {
+        return m_allocator;
+    }
+
+    // Total size of all slabs
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    // Total size of all blocks which have not been freed
+    size_t in_use() const
+    {
+        return m_in_use;
+    }
+
+    // Largest block which can be allocated without growing the arena
+    size_t available() const
+    {
+        size_t avail = 0;
+        for(auto& slab : m_slabs)
+            avail = std::max(avail, slab.size - slab.top);
+        return avail;
+    }
+
+    size_t slab_count() const
+    {
+        return m_slabs.size();
+    }
+
+    // Preallocate a slab of exactly size bytes
+    bool reserve(size_t size)
+    {
+        return !size || add_slab(size);
+    }
+
+    // Use memory owned by the caller as a slab, which the arena never frees
+    void adopt(void* addr, size_t size)
+    {
+        push_slab(static_cast<char*>(addr), size, false);
+    }
+
+    // Allocate a block of size bytes. The newest slab is tried first, then older
+    // slabs. If grow is true and no slab has room, idle slabs are freed and a new
+    // slab is added. A 0-sized request always succeeds, returning a block with a
+    // nullptr address.
+    bool allocate(size_t size, bool grow, block& b)
+    {
+        b = block{};
+        if(!size)
+            return true;
+
+        for(auto slab = m_slabs.rbegin(); slab != m_slabs.rend(); ++slab)
+            if(carve(*slab, size, b))
+                return true;
+
+        if(!grow)
+            return false;
+
+        // Free idle slabs before adding a larger one, so that they are not kept
+        // alongside it
+        release_idle();
+        if(!add_slab(rocblas_workspace_slab_size(size)))
+            return false;
+        return carve(m_slabs.back(), size, b);
+    }
+
+    // Free a block. Returns false, without freeing the block, if the block is in
+    // the newest slab and is not the most recently allocated live block in that slab.
+    bool deallocate(const block& b)
+    {
+        if(!b.size)
+            return true;
+
+        auto slab = std::find_if(
+            m_slabs.begin(), m_slabs.end(), [&](const slab_t& s) { return s.base == b.slab; });
+        if(slab == m_slabs.end())
+            return false;
+
+        bool on_top = b.addr + b.size == slab->base + slab->top;
+        if(!on_top && slab->strict)
+            return false;
+
+        m_in_use -= b.size;
+        if(!--slab->live)
+            slab->top = 0;
+        else if(on_top)
+            slab->top = b.addr - slab->base;
+        return true;
+    }
+
+    // Free all slabs which are owned by the arena, and forget the others.
+    // Returns false if any memory is in use, or if deallocation failed.
+    bool release()
+    {
+        if(m_in_use)
+            return false;
+        bool success = true;
+        for(auto& slab : m_slabs)
+            if(slab.owned && !m_allocator.deallocate(slab.base))
+                success = false;
+        m_slabs.clear();
+        m_capacity = 0;
+        return success;
+    }
+};
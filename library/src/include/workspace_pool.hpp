@@ -0,0 +1,221 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_workspace_pool is a thread-safe pool of workspace slabs shared by *
+ * the handles of a device. A handle leases a slab while it has workspace in *
+ * use, and returns it to the pool afterwards, so that idle handles hold no  *
+ * memory.                                                                   *
+ *                                                                           *
+ * Leases are stream-ordered. When a slab is returned, an event is recorded  *
+ * on the stream which used it. The slab can be leased again immediately for *
+ * the same stream, and for other streams once the event has completed. If   *
+ * no slab is ready and no memory can be allocated, the leasing stream waits *
+ * on the event of a slab which is still in use.                             *
+ *                                                                           *
+ * Slab memory is obtained from an Allocator, with the same interface as for *
+ * rocblas_workspace_arena. Events are managed by an Events class, which     *
+ * must provide:                                                             *
+ *                                                                           *
+ *     using stream_t = ...;                                                 *
+ *     using event_t = ...;  // value-initialized events are not created yet *
+ *     bool record(event_t& event, stream_t stream); // creates if needed    *
+ *     bool query(event_t event);                    // true if complete     *
+ *     bool wait(stream_t stream, event_t event);                            *
+ *     void destroy(event_t event);                                          *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+template <typename Allocator, typename Events>
+class rocblas_workspace_pool
+{
+public:
+    using stream_t = typename Events::stream_t;
+    using event_t  = typename Events::event_t;
+
+private:
+    struct slab_t
+    {
+        void*    addr;
+        size_t   size;
+        bool     leased;
+        bool     recorded; // whether event was recorded on stream when the slab was returned
+        stream_t stream;   // stream which last used the slab
+        event_t  event;
+    };
+
+    static constexpr size_t npos = ~size_t{0};
+
+    std::mutex          m_mutex;
+    Allocator           m_allocator;
+    Events              m_events;
+    std::vector<slab_t> m_slabs;
+    size_t              m_capacity = 0;
+
+    // Whether all of the work on a returned slab is ordered before new work on stream
+    bool ready(const slab_t& slab, stream_t stream)
+    {
+        return slab.stream == stream || (slab.recorded && m_events.query(slab.event));
+    }
+
+    // Allocate a new slab, returning its index or npos. Lock must be held.
+    size_t add_slab(size_t size, stream_t stream)
+    {
+        void* addr = nullptr;
+        if(!m_allocator.allocate(&addr, size))
+            return npos;
+        m_slabs.push_back({addr, size, false, false, stream, event_t{}});
+        m_capacity += size;
+        return m_slabs.size() - 1;
+    }
+
+    // Free the slabs which are not leased and whose work has completed. Lock must be held.
+    void release_idle()
+    {
+        auto idle = [&](const slab_t& slab) {
+            if(slab.leased || !slab.recorded || !m_events.query(slab.event)
+               || !m_allocator.deallocate(slab.addr))
+                return false;
+            m_events.destroy(slab.event);
+            m_capacity -= slab.size;
+            return true;
+        };
+        m_slabs.erase(std::remove_if(m_slabs.begin(), m_slabs.end(), idle), m_slabs.end());
+    }
+
+public:
+    explicit rocblas_workspace_pool(Allocator allocator = Allocator{}, Events events = Events{})
+        : m_allocator(std::move(allocator))
+        , m_events(std::move(events))
+    {
+    }
+
+    // Slabs are freed when the pool is destroyed, whether or not they are leased
+    ~rocblas_workspace_pool()
+    {
+        for(auto& slab : m_slabs)
+        {
+            if(slab.event != event_t{})
+                m_events.destroy(slab.event);
+            m_allocator.deallocate(slab.addr);
+        }
+    }
+
+    // The pool is not copyable or assignable
+    rocblas_workspace_pool(const rocblas_workspace_pool&) = delete;
+    rocblas_workspace_pool& operator=(const rocblas_workspace_pool&) = delete;
+
+    // Lease a slab of at least size bytes for work on stream. The smallest slab which is
+    // ready is preferred; otherwise a new slab of exactly size bytes is allocated. If that
+    // fails, stream waits on the smallest slab still in use by another stream, and as a
+    // last resort idle slabs are freed and the allocation is retried.
+    bool lease(size_t size, stream_t stream, void*& addr, size_t& slab_size)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        size_t best_ready = npos, best_pending = npos;
+        for(size_t i = 0; i < m_slabs.size(); ++i)
+        {
+            const auto& slab = m_slabs[i];
+            if(slab.leased || slab.size < size)
+                continue;
+            size_t& best = ready(slab, stream) ? best_ready : best_pending;
+            if(best == npos || slab.size < m_slabs[best].size)
+                best = i;
+        }
+
+        size_t i = best_ready;
+        if(i == npos)
+            i = add_slab(size, stream);
+        if(i == npos && best_pending != npos && m_slabs[best_pending].recorded
+           && m_events.wait(stream, m_slabs[best_pending].event))
+            i = best_pending;
+        if(i == npos)
+        {
+            release_idle();
+            i = add_slab(size, stream);
+        }
+        if(i == npos)
+            return false;
+
+        auto& slab  = m_slabs[i];
+        slab.leased = true;
+        slab.stream = stream;
+        addr        = slab.addr;
+        slab_size   = slab.size;
+        return true;
+    }
+
+    // Return a leased slab after work using it has been enqueued on stream.
+    // Returns false if addr is not a leased slab.
+    bool release(void* addr, stream_t stream)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for(auto& slab : m_slabs)
+        {
+            if(slab.addr == addr && slab.leased)
+            {
+                slab.leased   = false;
+                slab.stream   = stream;
+                slab.recorded = m_events.record(slab.event, stream);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Free the slabs which are not leased and whose work has completed
+    void trim()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        release_idle();
+    }
+
+    // Total size of all slabs
+    size_t capacity()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_capacity;
+    }
+
+    size_t slab_count()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_slabs.size();
+    }
+
+    size_t leased_count()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t count = 0;
+        for(const auto& slab : m_slabs)
+            count += slab.leased;
+        return count;
+    }
+};
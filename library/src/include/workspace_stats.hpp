@@ -0,0 +1,177 @@
+/* ************************************************************************
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_workspace_stats keeps running statistics of the requests made to  *
+ * a handle's workspace: the peak amount of memory in use, the number of     *
+ * allocations, how often the workspace had to grow, how many requests       *
+ * failed, and the bytes requested by each rocBLAS routine.                  *
+ *                                                                           *
+ * Requests are attributed to the public routine in whose rocblas_call_scope *
+ * they are made. Like the workspace itself, the statistics belong to a      *
+ * handle and are not thread-safe.                                           *
+ *****************************************************************************/
+
+#include "rocblas_ostream.hpp"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+class rocblas_workspace_stats
+{
+public:
+    // Statistics of the requests made by one routine
+    struct routine_stats
+    {
+        size_t calls       = 0; // number of nonzero requests
+        size_t requested   = 0; // total bytes requested
+        size_t max_request = 0; // largest single request
+        size_t failures    = 0; // number of requests which could not be satisfied
+    };
+
+private:
+    size_t m_peak_in_use   = 0;
+    size_t m_peak_capacity = 0;
+    size_t m_allocations   = 0;
+    size_t m_growths       = 0;
+    size_t m_failures      = 0;
+    size_t m_requested     = 0;
+
+    // Routine names are string literals, so they are looked up by address. The entry of
+    // the last routine is kept, since a routine usually makes several requests in a row.
+    std::unordered_map<const char*, routine_stats> m_routines;
+    const char*                                    m_last_routine = nullptr;
+    routine_stats*                                 m_last         = nullptr;
+
+public:
+    // Record a request of size bytes made by routine. grew tells whether the workspace
+    // had to grow to satisfy the request; in_use and capacity are the state of the
+    // workspace after the request. 0-sized requests are not recorded.
+    void record(
+        const char* routine, size_t size, bool success, bool grew, size_t in_use, size_t capacity)
+    {
+        if(!size)
+            return;
+
+        if(!m_last || routine != m_last_routine)
+        {
+            m_last_routine = routine;
+            m_last         = &m_routines[routine ? routine : "unknown"];
+        }
+        auto& r = *m_last;
+        r.calls += 1;
+        r.requested += size;
+        r.max_request = std::max(r.max_request, size);
+        m_requested += size;
+
+        if(success)
+            m_allocations += 1;
+        else
+        {
+            r.failures += 1;
+            m_failures += 1;
+        }
+        if(grew)
+            m_growths += 1;
+
+        m_peak_in_use   = std::max(m_peak_in_use, in_use);
+        m_peak_capacity = std::max(m_peak_capacity, capacity);
+    }
+
+    // Reset the counters. The peaks restart from the current state of the workspace.
+    void reset(size_t in_use, size_t capacity)
+    {
+        *this           = {};
+        m_peak_in_use   = in_use;
+        m_peak_capacity = capacity;
+    }
+
+    size_t peak_in_use() const
+    {
+        return m_peak_in_use;
+    }
+
+    size_t peak_capacity() const
+    {
+        return m_peak_capacity;
+    }
+
+    size_t allocations() const
+    {
+        return m_allocations;
+    }
+
+    size_t growths() const
+    {
+        return m_growths;
+    }
+
+    size_t failures() const
+    {
+        return m_failures;
+    }
+
+    size_t requested() const
+    {
+        return m_requested;
+    }
+
+    // Statistics of each routine, sorted by name. Routines with equal names are merged.
+    std::map<std::string, routine_stats> routines() const
+    {
+        std::map<std::string, routine_stats> sorted;
+        for(const auto& p : m_routines)
+        {
+            auto& r = sorted[p.first];
+            r.calls += p.second.calls;
+            r.requested += p.second.requested;
+            r.max_request = std::max(r.max_request, p.second.max_request);
+            r.failures += p.second.failures;
+        }
+        return sorted;
+    }
+
+    // Write the statistics as a YAML list item, with one flow mapping per routine
+    void write_yaml(rocblas_internal_ostream& os, int device, size_t capacity) const
+    {
+        os << "- " << std::make_pair("device", device) << "\n"
+           << "  " << std::make_pair("capacity", capacity) << "\n"
+           << "  " << std::make_pair("peak_capacity", m_peak_capacity) << "\n"
+           << "  " << std::make_pair("peak_in_use", m_peak_in_use) << "\n"
+           << "  " << std::make_pair("allocations", m_allocations) << "\n"
+           << "  " << std::make_pair("growths", m_growths) << "\n"
+           << "  " << std::make_pair("failures", m_failures) << "\n"
+           << "  " << std::make_pair("requested_bytes", m_requested) << "\n"
+           << "  routines:" << (m_routines.empty() ? " []\n" : "\n");
+
+        for(const auto& p : routines())
+            os << "    - { " << std::make_pair("routine", p.first.c_str()) << ", "
+               << std::make_pair("calls", p.second.calls) << ", "
+               << std::make_pair("requested_bytes", p.second.requested) << ", "
+               << std::make_pair("max_request_bytes", p.second.max_request) << ", "
+               << std::make_pair("failures", p.second.failures) << " }\n";
+        os.flush();
+    }
+};
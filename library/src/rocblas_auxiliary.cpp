@@ -20,9 +20,13 @@
  *
  *
  * ************************************************************************ */
+#include "async_transfer.hpp"
 #include "handle.hpp"
 #include "logging.hpp"
 #include "rocblas-auxiliary.h"
+#include "staging_pool.hpp"
+#include "strided_copy.hpp"
+#include <algorithm>
 #include <cctype>
 #include <cstdlib>
 #include <memory>
@@ -275,6 +279,10 @@ try
     if(stream != 0 && hipStreamQuery(stream) == hipErrorInvalidResourceHandle)
         return rocblas_status_invalid_value;
 
+    // Enqueue the readback of an open numerical check on the old stream, which the user
+    // may destroy once it is no longer used by the handle
+    RETURN_IF_ROCBLAS_ERROR(handle->check_numerics_queue.close());
+
     // Set the new stream
     handle->stream = stream;
     return rocblas_status_success;
@@ -331,29 +339,173 @@ rocblas_copy_void_ptr_vector_kernel(rocblas_int n,
     }
 }
 
-/* ============================================================================================ */
-// TODO: Need to replace this with new device memory allocation system
+/*******************************************************************************
+ * Staging buffers of the strided transfers. Pinned host buffers are leased from
+ * a pool shared by the process, and device buffers from a pool of the current
+ * device. The environment variable ROCBLAS_STAGING_POOL_LIMIT sets the limit on
+ * the total size of the idle buffers kept by each pool.
+ ******************************************************************************/
+struct rocblas_pinned_staging_allocator
+{
+    bool allocate(void** ptr, size_t size)
+    {
+        return hipHostMalloc(ptr, size) == hipSuccess;
+    }
+
+    bool deallocate(void* ptr)
+    {
+        return hipHostFree(ptr) == hipSuccess;
+    }
+};
 
-// device_malloc wraps hipMalloc and provides same API as malloc
-static void* device_malloc(size_t byte_size)
+struct rocblas_device_staging_allocator
 {
-    void* pointer = nullptr;
-    PRINT_IF_HIP_ERROR((hipMalloc)(&pointer, byte_size));
-    return pointer;
+    bool allocate(void** ptr, size_t size)
+    {
+        return (hipMalloc)(ptr, size) == hipSuccess;
+    }
+
+    bool deallocate(void* ptr)
+    {
+        return (hipFree)(ptr) == hipSuccess;
+    }
+};
+
+using rocblas_host_staging_pool   = rocblas_staging_pool<rocblas_pinned_staging_allocator>;
+using rocblas_device_staging_pool = rocblas_staging_pool<rocblas_device_staging_allocator>;
+
+static size_t staging_idle_limit()
+{
+    static const size_t limit = [] {
+        const char* env = getenv("ROCBLAS_STAGING_POOL_LIMIT");
+        return env ? size_t(strtoull(env, nullptr, 0)) : ROCBLAS_STAGING_DEFAULT_IDLE_LIMIT;
+    }();
+    return limit;
 }
 
-// device_free wraps hipFree and provides same API as free
-static void device_free(void* ptr)
+// The pools are never destroyed, since pinned and device memory cannot be freed
+// safely during static destruction
+static rocblas_host_staging_pool& host_staging_pool()
 {
-    PRINT_IF_HIP_ERROR((hipFree)(ptr));
+    static auto* pool = new rocblas_host_staging_pool(staging_idle_limit());
+    return *pool;
 }
 
-using rocblas_unique_ptr = std::unique_ptr<void, void (*)(void*)>;
+static std::vector<rocblas_device_staging_pool>& device_staging_pools()
+{
+    static auto* pools = [] {
+        int count = 0;
+        if(hipGetDeviceCount(&count) != hipSuccess)
+            count = 0;
+        auto* pools = new std::vector<rocblas_device_staging_pool>(count);
+        for(auto& pool : *pools)
+            pool.set_idle_limit(staging_idle_limit());
+        return pools;
+    }();
+    return *pools;
+}
+
+// Pool of the current device, or nullptr if it cannot be determined
+static rocblas_device_staging_pool* device_staging_pool()
+{
+    auto& pools = device_staging_pools();
+    int   device;
+    if(hipGetDevice(&device) != hipSuccess || device < 0 || size_t(device) >= pools.size())
+        return nullptr;
+    return &pools[device];
+}
+
+// Lease N host buffers and/or N device buffers of at least size bytes. Returns false
+// if any lease fails; the buffers already leased are returned when the leases are destroyed.
+template <size_t N>
+static bool lease_staging(size_t size,
+                          bool   host,
+                          bool   device,
+                          rocblas_host_staging_pool::lease_t (&t_h)[N],
+                          rocblas_device_staging_pool::lease_t (&t_d)[N])
+{
+    auto* d_pool = device ? device_staging_pool() : nullptr;
+    if(device && !d_pool)
+        return false;
+    for(size_t b = 0; b < N; ++b)
+    {
+        if(host && !(t_h[b] = host_staging_pool().lease(size)))
+            return false;
+        if(device && !(t_d[b] = d_pool->lease(size)))
+            return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Events which order the reuse of the two host staging buffers of a pipelined
+ * vector transfer. The event of a buffer is recorded after its transfer is
+ * enqueued. They are created once per thread, and again when the current device
+ * changes.
+ ******************************************************************************/
+class rocblas_staging_events
+{
+    int        m_device   = -1;
+    hipEvent_t m_event[2] = {};
+
+    void destroy()
+    {
+        for(auto& event : m_event)
+        {
+            if(event)
+                hipEventDestroy(event);
+            event = nullptr;
+        }
+        m_device = -1;
+    }
+
+public:
+    rocblas_staging_events() = default;
+
+    // The events are not copyable or assignable
+    rocblas_staging_events(const rocblas_staging_events&) = delete;
+    rocblas_staging_events& operator=(const rocblas_staging_events&) = delete;
+
+    ~rocblas_staging_events()
+    {
+        destroy();
+    }
+
+    // Create the events on the current device, if needed
+    bool init()
+    {
+        int current;
+        if(hipGetDevice(&current) != hipSuccess)
+            return false;
+        if(current == m_device)
+            return true;
+
+        destroy();
+        for(auto& event : m_event)
+            if(hipEventCreateWithFlags(&event, hipEventDisableTiming) != hipSuccess)
+            {
+                destroy();
+                return false;
+            }
+        m_device = current;
+        return true;
+    }
+
+    hipEvent_t operator[](int b) const
+    {
+        return m_event[b];
+    }
+};
+
+static rocblas_staging_events& staging_events()
+{
+    thread_local rocblas_staging_events events;
+    return events;
+}
 
 /*******************************************************************************
  *! \brief   copies void* vector x with stride incx on host to void* vector
      y with stride incy on device. Vectors have n elements of size elem_size.
-  TODO: Need to replace device memory allocation with new system
  ******************************************************************************/
 extern "C" rocblas_status rocblas_set_vector(rocblas_int n,
                                              rocblas_int elem_size,
@@ -388,59 +540,50 @@ try
 
         size_t x_h_byte_stride = (size_t)elem_size * incx;
         size_t y_d_byte_stride = (size_t)elem_size * incy;
-        size_t t_h_byte_stride = (size_t)elem_size;
 
+        // A non-contiguous host vector is packed into a pinned host buffer, and a
+        // non-contiguous device vector is unpacked from a device buffer by a kernel
+        bool pack_host     = incx != 1;
+        bool unpack_device = incy != 1;
+
+        rocblas_host_staging_pool::lease_t   t_h[2];
+        rocblas_device_staging_pool::lease_t t_d[2];
+        auto&                                events = staging_events();
+        if(!lease_staging(temp_byte_size, pack_host, unpack_device, t_h, t_d)
+           || (pack_host && !events.init()))
+            return rocblas_status_memory_error;
+
+        // Chunks alternate between the two buffers. While one chunk is transferred and
+        // unpacked on the device, the next one is packed on the host.
         for(int i_copy = 0; i_copy < n_copy; i_copy++)
         {
+            int         b           = i_copy % 2;
             int         i_start     = i_copy * n_elem;
             int         n_elem_max  = n - i_start < n_elem ? n - i_start : n_elem;
             int         contig_size = n_elem_max * elem_size;
             void*       y_d_start   = (char*)y_d + i_start * y_d_byte_stride;
             const void* x_h_start   = (const char*)x_h + i_start * x_h_byte_stride;
 
-            if((incx != 1) && (incy != 1))
+            const void* src = x_h_start;
+            if(pack_host)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
+                // Wait for the transfer of the chunk which last used the host buffer
+                PRINT_IF_HIP_ERROR(hipEventSynchronize(events[b]));
+
                 // non-contiguous host vector -> host buffer
-                for(size_t i_b = 0, i_x = i_start; i_b < n_elem_max; i_b++, i_x++)
-                {
-                    memcpy((char*)t_h + i_b * t_h_byte_stride,
-                           (const char*)x_h + i_x * x_h_byte_stride,
-                           elem_size);
-                }
-                // host buffer -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, t_h, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device vector
-                hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   n_elem_max,
-                                   elem_size,
-                                   t_d,
-                                   1,
-                                   y_d_start,
-                                   incy);
+                rocblas_strided_copy_host(
+                    t_h[b].get(), elem_size, x_h_start, x_h_byte_stride, n_elem_max, elem_size);
+                src = t_h[b].get();
             }
-            else if(incx == 1 && incy != 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // contiguous host vector -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, x_h_start, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device vector
+
+            // host buffer or contiguous host vector -> device buffer or contiguous device vector
+            void* dst = unpack_device ? t_d[b].get() : y_d_start;
+            PRINT_IF_HIP_ERROR(hipMemcpyAsync(dst, src, contig_size, hipMemcpyHostToDevice, 0));
+            if(pack_host)
+                PRINT_IF_HIP_ERROR(hipEventRecord(events[b], 0));
+
+            // device buffer -> non-contiguous device vector
+            if(unpack_device)
                 hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
                                    grid,
                                    threads,
@@ -448,29 +591,14 @@ try
                                    0,
                                    n_elem_max,
                                    elem_size,
-                                   t_d,
+                                   t_d[b].get(),
                                    1,
                                    y_d_start,
                                    incy);
-            }
-            else if(incx != 1 && incy == 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // non-contiguous host vector -> host buffer
-                for(size_t i_b = 0, i_x = i_start; i_b < n_elem_max; i_b++, i_x++)
-                {
-                    memcpy((char*)t_h + i_b * t_h_byte_stride,
-                           (const char*)x_h + i_x * x_h_byte_stride,
-                           elem_size);
-                }
-                // host buffer -> contiguous device vector
-                PRINT_IF_HIP_ERROR(hipMemcpy(y_d_start, t_h, contig_size, hipMemcpyHostToDevice));
-            }
         }
+
+        // The copy is complete when rocblas_set_vector returns
+        PRINT_IF_HIP_ERROR(hipStreamSynchronize(0));
     }
     return rocblas_status_success;
 }
@@ -516,28 +644,32 @@ try
 
         size_t x_d_byte_stride = (size_t)elem_size * incx;
         size_t y_h_byte_stride = (size_t)elem_size * incy;
-        size_t t_h_byte_stride = (size_t)elem_size;
 
-        for(int i_copy = 0; i_copy < n_copy; i_copy++)
-        {
-            int i_start           = i_copy * n_elem;
-            int n_elem_max        = n - (n_elem * i_copy) < n_elem ? n - (n_elem * i_copy) : n_elem;
-            int contig_size       = elem_size * n_elem_max;
-            const void* x_d_start = (const char*)x_d + i_start * x_d_byte_stride;
-            void*       y_h_start = (char*)y_h + i_start * y_h_byte_stride;
+        // A non-contiguous device vector is packed into a device buffer by a kernel, and
+        // a non-contiguous host vector is unpacked from a pinned host buffer
+        bool pack_device = incx != 1;
+        bool unpack_host = incy != 1;
+
+        rocblas_host_staging_pool::lease_t   t_h[2];
+        rocblas_device_staging_pool::lease_t t_d[2];
+        auto&                                events = staging_events();
+        if(!lease_staging(temp_byte_size, unpack_host, pack_device, t_h, t_d)
+           || (unpack_host && !events.init()))
+            return rocblas_status_memory_error;
+
+        // Enqueue the packing and transfer of a chunk, in the buffers of its parity
+        auto enqueue = [&](int i_copy) {
+            int         b           = i_copy % 2;
+            int         i_start     = i_copy * n_elem;
+            int         n_elem_max  = n - i_start < n_elem ? n - i_start : n_elem;
+            int         contig_size = elem_size * n_elem_max;
+            const void* x_d_start   = (const char*)x_d + i_start * x_d_byte_stride;
+            void*       y_h_start   = (char*)y_h + i_start * y_h_byte_stride;
 
-            if(incx != 1 && incy != 1)
+            // non-contiguous device vector -> device buffer
+            const void* src = x_d_start;
+            if(pack_device)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device vector -> device buffer
                 hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
                                    grid,
                                    threads,
@@ -547,59 +679,41 @@ try
                                    elem_size,
                                    x_d_start,
                                    incx,
-                                   t_d,
+                                   t_d[b].get(),
                                    1);
-                // device buffer -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, t_d, contig_size, hipMemcpyDeviceToHost));
-                // host buffer -> non-contiguous host vector
-                for(size_t i_b = 0, i_y = i_start; i_b < n_elem_max; i_b++, i_y++)
-                {
-                    memcpy((char*)y_h + i_y * y_h_byte_stride,
-                           (const char*)t_h + i_b * t_h_byte_stride,
-                           elem_size);
-                }
+                src = t_d[b].get();
             }
-            else if(incx == 1 && incy != 1)
+
+            // device buffer or contiguous device vector -> host buffer or contiguous host vector
+            void* dst = unpack_host ? t_h[b].get() : y_h_start;
+            PRINT_IF_HIP_ERROR(hipMemcpyAsync(dst, src, contig_size, hipMemcpyDeviceToHost, 0));
+            if(unpack_host)
+                PRINT_IF_HIP_ERROR(hipEventRecord(events[b], 0));
+        };
+
+        // While one chunk is unpacked on the host, the next one is packed and transferred
+        enqueue(0);
+        for(int i_copy = 0; i_copy < n_copy; i_copy++)
+        {
+            if(i_copy + 1 < n_copy)
+                enqueue(i_copy + 1);
+
+            if(unpack_host)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // congiguous device vector -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, x_d_start, contig_size, hipMemcpyDeviceToHost));
+                int   b          = i_copy % 2;
+                int   i_start    = i_copy * n_elem;
+                int   n_elem_max = n - i_start < n_elem ? n - i_start : n_elem;
+                void* y_h_start  = (char*)y_h + i_start * y_h_byte_stride;
 
                 // host buffer -> non-contiguous host vector
-                for(size_t i_b = 0, i_y = i_start; i_b < n_elem_max; i_b++, i_y++)
-                {
-                    memcpy((char*)y_h + i_y * y_h_byte_stride,
-                           (const char*)t_h + i_b * t_h_byte_stride,
-                           elem_size);
-                }
-            }
-            else if(incx != 1 && incy == 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device vector -> device buffer
-                hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   n_elem_max,
-                                   elem_size,
-                                   x_d_start,
-                                   incx,
-                                   t_d,
-                                   1);
-                // device buffer -> contiguous host vector
-                PRINT_IF_HIP_ERROR(hipMemcpy(y_h_start, t_d, contig_size, hipMemcpyDeviceToHost));
+                PRINT_IF_HIP_ERROR(hipEventSynchronize(events[b]));
+                rocblas_strided_copy_host(
+                    y_h_start, y_h_byte_stride, t_h[b].get(), elem_size, n_elem_max, elem_size);
             }
         }
+
+        // The copy is complete when rocblas_get_vector returns
+        PRINT_IF_HIP_ERROR(hipStreamSynchronize(0));
     }
     return rocblas_status_success;
 }
@@ -782,6 +896,15 @@ try
         size_t ldb_d_byte = (size_t)elem_size * ldb;
         size_t ldt_h_byte = (size_t)elem_size * rows;
 
+        // A non-contiguous host matrix is packed into a pinned host buffer, and a
+        // non-contiguous device matrix is unpacked from a device buffer by a kernel
+        rocblas_host_staging_pool::lease_t   t_h_lease[1];
+        rocblas_device_staging_pool::lease_t t_d_lease[1];
+        if(!lease_staging(temp_byte_size, lda != rows, ldb != rows, t_h_lease, t_d_lease))
+            return rocblas_status_memory_error;
+        void* t_h = t_h_lease[0].get();
+        void* t_d = t_d_lease[0].get();
+
         for(int i_copy = 0; i_copy < n_copy; i_copy++)
         {
             size_t      i_start     = i_copy * n_cols;
@@ -792,22 +915,9 @@ try
 
             if((lda != rows) && (ldb != rows))
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
                 // non-contiguous host matrix -> host buffer
-                for(size_t i_t = 0, i_a = i_start; i_t < n_cols_max; i_t++, i_a++)
-                {
-                    memcpy((char*)t_h + i_t * ldt_h_byte,
-                           (const char*)a_h + i_a * lda_h_byte,
-                           ldt_h_byte);
-                }
+                rocblas_strided_copy_2d(
+                    t_h, ldt_h_byte, a_h_start, lda_h_byte, ldt_h_byte, n_cols_max);
                 // host buffer -> device buffer
                 PRINT_IF_HIP_ERROR(hipMemcpy(t_d, t_h, contig_size, hipMemcpyHostToDevice));
                 // device buffer -> non-contiguous device matrix
@@ -827,11 +937,6 @@ try
             }
             else if(lda == rows && ldb != rows)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
                 // contiguous host matrix -> device buffer
                 PRINT_IF_HIP_ERROR(hipMemcpy(t_d, a_h_start, contig_size, hipMemcpyHostToDevice));
                 // device buffer -> non-contiguous device matrix
@@ -851,22 +956,17 @@ try
             }
             else if(lda != rows && ldb == rows)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
                 // non-contiguous host matrix -> host buffer
-                for(size_t i_t = 0, i_a = i_start; i_t < n_cols_max; i_t++, i_a++)
-                {
-                    memcpy((char*)t_h + i_t * ldt_h_byte,
-                           (const char*)a_h + i_a * lda_h_byte,
-                           ldt_h_byte);
-                }
+                rocblas_strided_copy_2d(
+                    t_h, ldt_h_byte, a_h_start, lda_h_byte, ldt_h_byte, n_cols_max);
                 // host buffer -> contiguous device matrix
                 PRINT_IF_HIP_ERROR(hipMemcpy(b_d_start, t_h, contig_size, hipMemcpyHostToDevice));
             }
         }
+
+        // The device buffer is returned to the pool once the last kernel has completed
+        if(ldb != rows)
+            PRINT_IF_HIP_ERROR(hipStreamSynchronize(0));
     }
     return rocblas_status_success;
 }
@@ -933,6 +1033,15 @@ try
         size_t ldb_h_byte = (size_t)elem_size * ldb;
         size_t ldt_h_byte = (size_t)elem_size * rows;
 
+        // A non-contiguous device matrix is packed into a device buffer by a kernel, and
+        // a non-contiguous host matrix is unpacked from a pinned host buffer
+        rocblas_host_staging_pool::lease_t   t_h_lease[1];
+        rocblas_device_staging_pool::lease_t t_d_lease[1];
+        if(!lease_staging(temp_byte_size, ldb != rows, lda != rows, t_h_lease, t_d_lease))
+            return rocblas_status_memory_error;
+        void* t_h = t_h_lease[0].get();
+        void* t_d = t_d_lease[0].get();
+
         for(int i_copy = 0; i_copy < n_copy; i_copy++)
         {
             int         i_start     = i_copy * n_cols;
@@ -942,15 +1051,6 @@ try
             void*       b_h_start   = (char*)b_h + i_start * ldb_h_byte;
             if(lda != rows && ldb != rows)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
                 // non-contiguous device matrix -> device buffer
                 hipLaunchKernelGGL(
                     (rocblas_copy_void_ptr_matrix_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
@@ -968,37 +1068,19 @@ try
                 // device buffer -> host buffer
                 PRINT_IF_HIP_ERROR(hipMemcpy(t_h, t_d, contig_size, hipMemcpyDeviceToHost));
                 // host buffer -> non-contiguous host matrix
-                for(size_t i_t = 0, i_b = i_start; i_t < n_cols_max; i_t++, i_b++)
-                {
-                    memcpy((char*)b_h + i_b * ldb_h_byte,
-                           (const char*)t_h + i_t * ldt_h_byte,
-                           ldt_h_byte);
-                }
+                rocblas_strided_copy_2d(
+                    b_h_start, ldb_h_byte, t_h, ldt_h_byte, ldt_h_byte, n_cols_max);
             }
             else if(lda == rows && ldb != rows)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
                 // congiguous device matrix -> host buffer
                 PRINT_IF_HIP_ERROR(hipMemcpy(t_h, a_d_start, contig_size, hipMemcpyDeviceToHost));
                 // host buffer -> non-contiguous host matrix
-                for(size_t i_t = 0, i_b = i_start; i_t < n_cols_max; i_t++, i_b++)
-                {
-                    memcpy((char*)b_h + i_b * ldb_h_byte,
-                           (const char*)t_h + i_t * ldt_h_byte,
-                           ldt_h_byte);
-                }
+                rocblas_strided_copy_2d(
+                    b_h_start, ldb_h_byte, t_h, ldt_h_byte, ldt_h_byte, n_cols_max);
             }
             else if(lda != rows && ldb == rows)
             {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
                 // non-contiguous device matrix -> device buffer
                 hipLaunchKernelGGL(
                     (rocblas_copy_void_ptr_matrix_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
@@ -1025,6 +1107,171 @@ catch(...) // catch all exceptions
     return exception_to_rocblas_status();
 }
 
+/*******************************************************************************
+ *! \brief  Matrix copy on device for each matrix of a batch. The matrices are
+     addressed by a char pointer and a stride in bytes, or by an array of
+     char pointers and an offset in bytes. Columns beyond the grid are copied
+     in a loop.
+ ******************************************************************************/
+template <rocblas_int DIM_X, rocblas_int DIM_Y, typename U, typename V>
+ROCBLAS_KERNEL(DIM_X* DIM_Y)
+rocblas_copy_void_ptr_matrix_batched_kernel(rocblas_int    rows,
+                                            rocblas_int    cols,
+                                            size_t         elem_size,
+                                            U              a,
+                                            rocblas_stride stride_a,
+                                            rocblas_int    lda,
+                                            V              b,
+                                            rocblas_stride stride_b,
+                                            rocblas_int    ldb)
+{
+    rocblas_int tx = blockIdx.x * blockDim.x + threadIdx.x;
+    if(tx >= rows)
+        return;
+
+    const char* A = load_ptr_batch(a, blockIdx.z, stride_a);
+    char*       B = load_ptr_batch(b, blockIdx.z, stride_b);
+    for(size_t ty = blockIdx.y * blockDim.y + threadIdx.y; ty < cols;
+        ty += size_t(gridDim.y) * blockDim.y)
+        memcpy(B + (tx + ldb * ty) * elem_size, A + (tx + lda * ty) * elem_size, elem_size);
+}
+
+/*******************************************************************************
+ * HIP runtime of the asynchronous strided and batched matrix transfers. Their
+ * staging buffers are leased from the staging pools, and returned once an event
+ * recorded on the stream after the transfer has completed. Completed transfers
+ * are collected by later transfers on the same device, and when the staging
+ * buffers are trimmed or queried.
+ ******************************************************************************/
+struct rocblas_hip_transfer_runtime
+{
+    using stream_t        = hipStream_t;
+    using host_buffer_t   = rocblas_host_staging_pool::lease_t;
+    using device_buffer_t = rocblas_device_staging_pool::lease_t;
+
+    host_buffer_t lease_host(size_t size)
+    {
+        return host_staging_pool().lease(size);
+    }
+
+    device_buffer_t lease_device(size_t size)
+    {
+        auto* pool = device_staging_pool();
+        return pool ? pool->lease(size) : device_buffer_t{};
+    }
+
+    bool host_func(hipStream_t stream, void (*fn)(void*), void* arg)
+    {
+        return hipLaunchHostFunc(stream, fn, arg) == hipSuccess;
+    }
+
+    bool copy(void* dst, const void* src, size_t size, bool to_device, hipStream_t stream)
+    {
+        auto kind = to_device ? hipMemcpyHostToDevice : hipMemcpyDeviceToHost;
+        return hipMemcpyAsync(dst, src, size, kind, stream) == hipSuccess;
+    }
+
+    // One kernel launch copies the matrices of a chunk, of which there are at most
+    // ROCBLAS_BATCHED_TRANSFER_MAX_TILES
+    template <typename U, typename V>
+    bool copy_matrix(size_t      rows,
+                     size_t      cols,
+                     size_t      elem_size,
+                     U           a,
+                     size_t      stride_a,
+                     size_t      lda,
+                     V           b,
+                     size_t      stride_b,
+                     size_t      ldb,
+                     size_t      batch_count,
+                     hipStream_t stream)
+    {
+        size_t blocksX = ((rows - 1) / MATRIX_DIM_X) + 1;
+        size_t blocksY = std::min(((cols - 1) / MATRIX_DIM_Y) + 1, size_t(65535));
+        dim3   grid(blocksX, blocksY, batch_count);
+        dim3   threads(MATRIX_DIM_X, MATRIX_DIM_Y);
+        hipLaunchKernelGGL(
+            (rocblas_copy_void_ptr_matrix_batched_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
+            grid,
+            threads,
+            0,
+            stream,
+            rows,
+            cols,
+            elem_size,
+            a,
+            stride_a,
+            lda,
+            b,
+            stride_b,
+            ldb);
+        return hipGetLastError() == hipSuccess;
+    }
+
+    bool defer(std::unique_ptr<rocblas_async_staging<rocblas_hip_transfer_runtime>>& staging,
+               hipStream_t                                                           stream);
+
+    bool synchronize(hipStream_t stream)
+    {
+        return hipStreamSynchronize(stream) == hipSuccess;
+    }
+};
+
+using rocblas_async_releases = rocblas_deferred_release<
+    rocblas_device_events,
+    std::unique_ptr<rocblas_async_staging<rocblas_hip_transfer_runtime>>>;
+
+// Deferred releases of the current device, or nullptr if it cannot be determined.
+// They are never destroyed, like the staging pools.
+static rocblas_async_releases* async_releases()
+{
+    static auto* releases = [] {
+        int count = 0;
+        if(hipGetDeviceCount(&count) != hipSuccess)
+            count = 0;
+        return new std::vector<rocblas_async_releases>(count);
+    }();
+    int device;
+    if(hipGetDevice(&device) != hipSuccess || device < 0 || size_t(device) >= releases->size())
+        return nullptr;
+    return &(*releases)[device];
+}
+
+bool rocblas_hip_transfer_runtime::defer(
+    std::unique_ptr<rocblas_async_staging<rocblas_hip_transfer_runtime>>& staging,
+    hipStream_t                                                           stream)
+{
+    auto* releases = async_releases();
+    return releases && releases->defer(staging, stream);
+}
+
+/*******************************************************************************
+ * HIP runtime of the synchronous batched matrix transfers. Host packing and
+ * unpacking run on the calling thread, the host-device copies are blocking, and
+ * the staging buffers are returned once the null stream has completed the
+ * transfer.
+ ******************************************************************************/
+struct rocblas_hip_sync_transfer_runtime : rocblas_hip_transfer_runtime
+{
+    bool host_func(hipStream_t, void (*fn)(void*), void* arg)
+    {
+        fn(arg);
+        return true;
+    }
+
+    bool copy(void* dst, const void* src, size_t size, bool to_device, hipStream_t)
+    {
+        auto kind = to_device ? hipMemcpyHostToDevice : hipMemcpyDeviceToHost;
+        return hipMemcpy(dst, src, size, kind) == hipSuccess;
+    }
+
+    bool defer(std::unique_ptr<rocblas_async_staging<rocblas_hip_sync_transfer_runtime>>&,
+               hipStream_t)
+    {
+        return false;
+    }
+};
+
 /*******************************************************************************
  *! \brief   copies void* matrix a_h with leading dimentsion lda on host to
      void* matrix b_d with leading dimension ldb on device. Matrices have
@@ -1055,7 +1302,14 @@ try
     }
     else
     {
-        // width is column vector in matrix
+        // Stage the matrix through pinned host and device buffers in stream order
+        rocblas_hip_transfer_runtime runtime;
+        rocblas_status               status = rocblas_set_matrix_async_staged(
+            runtime, rows, cols, elem_size, a_h, lda, b_d, ldb, stream);
+        if(status != rocblas_status_memory_error)
+            return status;
+
+        // If no staging buffers are available, width is column vector in matrix
         PRINT_IF_HIP_ERROR(hipMemcpy2DAsync(b_d,
                                             size_t(elem_size) * ldb,
                                             a_h,
@@ -1103,7 +1357,14 @@ try
     }
     else
     {
-        // width is column vector in matrix
+        // Stage the matrix through device and pinned host buffers in stream order
+        rocblas_hip_transfer_runtime runtime;
+        rocblas_status               status = rocblas_get_matrix_async_staged(
+            runtime, rows, cols, elem_size, a_d, lda, b_h, ldb, stream);
+        if(status != rocblas_status_memory_error)
+            return status;
+
+        // If no staging buffers are available, width is column vector in matrix
         PRINT_IF_HIP_ERROR(hipMemcpy2DAsync(b_h,
                                             size_t(elem_size) * ldb,
                                             a_d,
@@ -1120,6 +1381,398 @@ catch(...) // catch all exceptions
     return exception_to_rocblas_status();
 }
 
+/*******************************************************************************
+ * Argument checking of the batched set and get matrix functions. Returns
+ * rocblas_status_continue if the transfer must proceed.
+ ******************************************************************************/
+static rocblas_status rocblas_matrix_batched_arg_check(rocblas_int rows,
+                                                       rocblas_int cols,
+                                                       rocblas_int elem_size,
+                                                       const void* a,
+                                                       rocblas_int lda,
+                                                       const void* b,
+                                                       rocblas_int ldb,
+                                                       rocblas_int batch_count)
+{
+    if(rows < 0 || cols < 0 || lda <= 0 || ldb <= 0 || rows > lda || rows > ldb || elem_size <= 0
+       || batch_count < 0)
+        return rocblas_status_invalid_size;
+    if(rows == 0 || cols == 0 || batch_count == 0) // quick return
+        return rocblas_status_success;
+    if(!a || !b)
+        return rocblas_status_invalid_pointer;
+    return rocblas_status_continue;
+}
+
+/*******************************************************************************
+ *! \brief   copies batch_count void* matrices a_h[i] with leading dimension lda
+     on host to void* matrices b_d[i] with leading dimension ldb on device.
+     a_h is a host array and b_d is a device array. All matrices are packed
+     into one staging buffer per chunk, moved by one copy, and unpacked by one
+     kernel.
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_matrix_batched(rocblas_int       rows,
+                                                     rocblas_int       cols,
+                                                     rocblas_int       elem_size,
+                                                     const void* const a_h[],
+                                                     rocblas_int       lda,
+                                                     void* const       b_d[],
+                                                     rocblas_int       ldb,
+                                                     rocblas_int       batch_count)
+try
+{
+    auto status
+        = rocblas_matrix_batched_arg_check(rows, cols, elem_size, a_h, lda, b_d, ldb, batch_count);
+    if(status != rocblas_status_continue)
+        return status;
+
+    rocblas_hip_sync_transfer_runtime runtime;
+    return rocblas_set_matrix_batched_staged(runtime,
+                                             rows,
+                                             cols,
+                                             elem_size,
+                                             (const char* const*)a_h,
+                                             lda,
+                                             0,
+                                             (char* const*)b_d,
+                                             ldb,
+                                             0,
+                                             batch_count,
+                                             hipStream_t(0));
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   copies batch_count void* matrices a_d[i] with leading dimension lda
+     on device to void* matrices b_h[i] with leading dimension ldb on host.
+     a_d is a device array and b_h is a host array.
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_matrix_batched(rocblas_int       rows,
+                                                     rocblas_int       cols,
+                                                     rocblas_int       elem_size,
+                                                     const void* const a_d[],
+                                                     rocblas_int       lda,
+                                                     void* const       b_h[],
+                                                     rocblas_int       ldb,
+                                                     rocblas_int       batch_count)
+try
+{
+    auto status
+        = rocblas_matrix_batched_arg_check(rows, cols, elem_size, a_d, lda, b_h, ldb, batch_count);
+    if(status != rocblas_status_continue)
+        return status;
+
+    rocblas_hip_sync_transfer_runtime runtime;
+    return rocblas_get_matrix_batched_staged(runtime,
+                                             rows,
+                                             cols,
+                                             elem_size,
+                                             (const char* const*)a_d,
+                                             lda,
+                                             0,
+                                             (char* const*)b_h,
+                                             ldb,
+                                             0,
+                                             batch_count,
+                                             hipStream_t(0));
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   copies batch_count void* matrices a_h + i * stride_a with leading
+     dimension lda on host to void* matrices b_d + i * stride_b with leading
+     dimension ldb on device. Strides are in elements.
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_matrix_strided_batched(rocblas_int    rows,
+                                                             rocblas_int    cols,
+                                                             rocblas_int    elem_size,
+                                                             const void*    a_h,
+                                                             rocblas_int    lda,
+                                                             rocblas_stride stride_a,
+                                                             void*          b_d,
+                                                             rocblas_int    ldb,
+                                                             rocblas_stride stride_b,
+                                                             rocblas_int    batch_count)
+try
+{
+    auto status
+        = rocblas_matrix_batched_arg_check(rows, cols, elem_size, a_h, lda, b_d, ldb, batch_count);
+    if(status != rocblas_status_continue)
+        return status;
+
+    rocblas_hip_sync_transfer_runtime runtime;
+    return rocblas_set_matrix_batched_staged(runtime,
+                                             rows,
+                                             cols,
+                                             elem_size,
+                                             (const char*)a_h,
+                                             lda,
+                                             size_t(stride_a) * elem_size,
+                                             (char*)b_d,
+                                             ldb,
+                                             size_t(stride_b) * elem_size,
+                                             batch_count,
+                                             hipStream_t(0));
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   copies batch_count void* matrices a_d + i * stride_a with leading
+     dimension lda on device to void* matrices b_h + i * stride_b with leading
+     dimension ldb on host. Strides are in elements.
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_matrix_strided_batched(rocblas_int    rows,
+                                                             rocblas_int    cols,
+                                                             rocblas_int    elem_size,
+                                                             const void*    a_d,
+                                                             rocblas_int    lda,
+                                                             rocblas_stride stride_a,
+                                                             void*          b_h,
+                                                             rocblas_int    ldb,
+                                                             rocblas_stride stride_b,
+                                                             rocblas_int    batch_count)
+try
+{
+    auto status
+        = rocblas_matrix_batched_arg_check(rows, cols, elem_size, a_d, lda, b_h, ldb, batch_count);
+    if(status != rocblas_status_continue)
+        return status;
+
+    rocblas_hip_sync_transfer_runtime runtime;
+    return rocblas_get_matrix_batched_staged(runtime,
+                                             rows,
+                                             cols,
+                                             elem_size,
+                                             (const char*)a_d,
+                                             lda,
+                                             size_t(stride_a) * elem_size,
+                                             (char*)b_h,
+                                             ldb,
+                                             size_t(stride_b) * elem_size,
+                                             batch_count,
+                                             hipStream_t(0));
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   asynchronous rocblas_set_matrix_batched on stream. The host
+     matrices are packed by host functions enqueued on the stream.
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_matrix_batched_async(rocblas_int       rows,
+                                                           rocblas_int       cols,
+                                                           rocblas_int       elem_size,
+                                                           const void* const a_h[],
+                                                           rocblas_int       lda,
+                                                           void* const       b_d[],
+                                                           rocblas_int       ldb,
+                                                           rocblas_int       batch_count,
+                                                           hipStream_t       stream)
+try
+{
+    auto status
+        = rocblas_matrix_batched_arg_check(rows, cols, elem_size, a_h, lda, b_d, ldb, batch_count);
+    if(status != rocblas_status_continue)
+        return status;
+
+    rocblas_hip_transfer_runtime runtime;
+    return rocblas_set_matrix_batched_staged(runtime,
+                                             rows,
+                                             cols,
+                                             elem_size,
+                                             (const char* const*)a_h,
+                                             lda,
+                                             0,
+                                             (char* const*)b_d,
+                                             ldb,
+                                             0,
+                                             batch_count,
+                                             stream);
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   asynchronous rocblas_get_matrix_batched on stream. The host
+     matrices are unpacked by host functions enqueued on the stream.
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_matrix_batched_async(rocblas_int       rows,
+                                                           rocblas_int       cols,
+                                                           rocblas_int       elem_size,
+                                                           const void* const a_d[],
+                                                           rocblas_int       lda,
+                                                           void* const       b_h[],
+                                                           rocblas_int       ldb,
+                                                           rocblas_int       batch_count,
+                                                           hipStream_t       stream)
+try
+{
+    auto status
+        = rocblas_matrix_batched_arg_check(rows, cols, elem_size, a_d, lda, b_h, ldb, batch_count);
+    if(status != rocblas_status_continue)
+        return status;
+
+    rocblas_hip_transfer_runtime runtime;
+    return rocblas_get_matrix_batched_staged(runtime,
+                                             rows,
+                                             cols,
+                                             elem_size,
+                                             (const char* const*)a_d,
+                                             lda,
+                                             0,
+                                             (char* const*)b_h,
+                                             ldb,
+                                             0,
+                                             batch_count,
+                                             stream);
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   asynchronous rocblas_set_matrix_strided_batched on stream
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_matrix_strided_batched_async(rocblas_int    rows,
+                                                                   rocblas_int    cols,
+                                                                   rocblas_int    elem_size,
+                                                                   const void*    a_h,
+                                                                   rocblas_int    lda,
+                                                                   rocblas_stride stride_a,
+                                                                   void*          b_d,
+                                                                   rocblas_int    ldb,
+                                                                   rocblas_stride stride_b,
+                                                                   rocblas_int    batch_count,
+                                                                   hipStream_t    stream)
+try
+{
+    auto status
+        = rocblas_matrix_batched_arg_check(rows, cols, elem_size, a_h, lda, b_d, ldb, batch_count);
+    if(status != rocblas_status_continue)
+        return status;
+
+    rocblas_hip_transfer_runtime runtime;
+    return rocblas_set_matrix_batched_staged(runtime,
+                                             rows,
+                                             cols,
+                                             elem_size,
+                                             (const char*)a_h,
+                                             lda,
+                                             size_t(stride_a) * elem_size,
+                                             (char*)b_d,
+                                             ldb,
+                                             size_t(stride_b) * elem_size,
+                                             batch_count,
+                                             stream);
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   asynchronous rocblas_get_matrix_strided_batched on stream
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_matrix_strided_batched_async(rocblas_int    rows,
+                                                                   rocblas_int    cols,
+                                                                   rocblas_int    elem_size,
+                                                                   const void*    a_d,
+                                                                   rocblas_int    lda,
+                                                                   rocblas_stride stride_a,
+                                                                   void*          b_h,
+                                                                   rocblas_int    ldb,
+                                                                   rocblas_stride stride_b,
+                                                                   rocblas_int    batch_count,
+                                                                   hipStream_t    stream)
+try
+{
+    auto status
+        = rocblas_matrix_batched_arg_check(rows, cols, elem_size, a_d, lda, b_h, ldb, batch_count);
+    if(status != rocblas_status_continue)
+        return status;
+
+    rocblas_hip_transfer_runtime runtime;
+    return rocblas_get_matrix_batched_staged(runtime,
+                                             rows,
+                                             cols,
+                                             elem_size,
+                                             (const char*)a_d,
+                                             lda,
+                                             size_t(stride_a) * elem_size,
+                                             (char*)b_h,
+                                             ldb,
+                                             size_t(stride_b) * elem_size,
+                                             batch_count,
+                                             stream);
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Get the counters of the host staging pool and the pool of the current device
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_staging_buffer_stats(size_t* requests,
+                                                           size_t* reuses,
+                                                           size_t* host_bytes,
+                                                           size_t* device_bytes)
+try
+{
+    if(!requests || !reuses || !host_bytes || !device_bytes)
+        return rocblas_status_invalid_pointer;
+
+    // Buffers of completed asynchronous transfers are returned to the pools first
+    if(auto* releases = async_releases())
+        releases->collect();
+
+    auto  host_stats   = host_staging_pool().stats();
+    auto* d_pool       = device_staging_pool();
+    auto  device_stats = d_pool ? d_pool->stats() : rocblas_device_staging_pool::stats_t{};
+
+    *requests     = host_stats.requests + device_stats.requests;
+    *reuses       = host_stats.reuses + device_stats.reuses;
+    *host_bytes   = host_stats.held;
+    *device_bytes = device_stats.held;
+    return rocblas_status_success;
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Free the idle buffers of the host staging pool and the pool of the current device
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_trim_staging_buffers()
+try
+{
+    if(auto* releases = async_releases())
+        releases->collect();
+    host_staging_pool().trim();
+    if(auto* d_pool = device_staging_pool())
+        d_pool->trim();
+    return rocblas_status_success;
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
 // Convert rocblas_status to string
 extern "C" const char* rocblas_status_to_string(rocblas_status status)
 {
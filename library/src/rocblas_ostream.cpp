@@ -41,6 +41,10 @@ static void rocblas_abort_once [[noreturn]] ();
 #define FDOPEN(A, B) fdopen(A, B)
 #define OPEN(A) open(A, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
 #define CLOSE(A) close(A)
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
 #endif
 
 /***********************************************************************
@@ -185,7 +189,7 @@ void rocblas_internal_ostream::flush()
 
         // Empty string buffers kill the worker thread, so they are not flushed here
         if(str.size())
-            m_worker_ptr->send(std::move(str));
+            m_worker_ptr->send(std::move(str), !m_async);
 
         // Clear the string buffer
         clear();
@@ -215,44 +219,82 @@ std::ostream& rocblas_internal_ostream::yaml_off(std::ostream& os)
 
 // Send a string to the worker thread for this stream's device/inode
 // Empty strings tell the worker thread to exit
-void rocblas_internal_ostream::worker::send(std::string str)
+void rocblas_internal_ostream::worker::send(std::string str, bool wait)
 {
-    // Create a promise to wait for the operation to complete
-    std::promise<void> promise;
-
-    // The future indicating when the operation has completed
-    auto future = promise.get_future();
-
-#ifdef WIN32
-    // Passing an empty string will make the worker thread exit.
-    // The below flag will be used to handle worker thread exit condition for Windows
+    // Passing an empty string will make the worker thread exit, so it is always waited for
     bool empty_string = str.empty();
-#endif
 
-    // task_t consists of string and promise
-    // std::move transfers ownership of str and promise to task
-    task_t worker_task(std::move(str), std::move(promise));
-
-    // Submit the task to the worker assigned to this device/inode
+    // Submit the string to the worker assigned to this device/inode
     // Hold mutex for as short as possible, to reduce contention
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_queue.push(std::move(worker_task));
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_queue.push_back(std::move(str));
+    uint64_t ticket = ++m_queued;
 
-        // no lock needed for notification but keeping here
+    // Only wake up the worker if it may be waiting for an empty queue
+    if(m_queue.size() == 1)
         m_cond.notify_one();
-    }
 
-// Wait for the task to be completed, to ensure flushed IO
+    if(!wait && !empty_string)
+        return;
+
+    // Wait for the string to be written, to ensure flushed IO
+    auto written = [&] { return m_written >= ticket; };
 #ifdef WIN32
     if(empty_string)
-        // Occassionaly this thread is not getting the promise set by the 'worker' thread during exit condition.
-        // Added a timed wait to exit after one second, if we do not get the promise from worker thread.
-        future.wait_for(std::chrono::seconds(1));
+        // Occassionaly this thread is not getting notified by the 'worker' thread during exit condition.
+        // Added a timed wait to exit after one second, if we are not notified by the worker thread.
+        m_done.wait_for(lock, std::chrono::seconds(1), written);
     else
-        future.get();
+        m_done.wait(lock, written);
+#else
+    m_done.wait(lock, written);
+#endif
+}
+
+// Write the first count strings of batch to the FILE. Returns false on error.
+bool rocblas_internal_ostream::worker::write_batch(const std::vector<std::string>& batch,
+                                                   size_t                          count)
+{
+#ifdef WIN32
+    // The FILE buffers the strings, and it is flushed once per batch
+    for(size_t i = 0; i < count; ++i)
+        fwrite(batch[i].data(), 1, batch[i].size(), m_file);
+    return !ferror(m_file) && !fflush(m_file);
 #else
-    future.get();
+    // The FILE is never written to directly, so its file descriptor is written with
+    // writev(), in chunks of at most IOV_MAX strings, resuming after partial writes
+    int fd = fileno(m_file);
+
+    std::vector<iovec> iov;
+    iov.reserve(std::min<size_t>(count, IOV_MAX));
+
+    for(size_t i = 0; i < count;)
+    {
+        iov.clear();
+        for(; i < count && iov.size() < IOV_MAX; ++i)
+            iov.push_back({const_cast<char*>(batch[i].data()), batch[i].size()});
+
+        for(iovec* v = iov.data(); v != iov.data() + iov.size();)
+        {
+            ssize_t n = writev(fd, v, int(iov.data() + iov.size() - v));
+            if(n < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+                return false;
+            }
+
+            // Skip the strings which have been written, and the written part of the next
+            for(; v != iov.data() + iov.size() && size_t(n) >= v->iov_len; ++v)
+                n -= v->iov_len;
+            if(n)
+            {
+                v->iov_base = static_cast<char*>(v->iov_base) + n;
+                v->iov_len -= n;
+            }
+        }
+    }
+    return true;
 #endif
 }
 
@@ -262,6 +304,9 @@ void rocblas_internal_ostream::worker::thread_function()
     // Clear any errors in the FILE
     clearerr(m_file);
 
+    // Strings taken from the queue. Its capacity is swapped back and forth with the queue.
+    std::vector<std::string> batch;
+
     // Lock the mutex in preparation for cond.wait
     std::unique_lock<std::mutex> lock(m_mutex);
 
@@ -270,39 +315,34 @@ void rocblas_internal_ostream::worker::thread_function()
         // Wait for any data, ignoring spurious wakeups, locks lock on continue
         m_cond.wait(lock, [&] { return !m_queue.empty(); });
 
-        // With the mutex locked, get and pop data from the front of queue
-        task_t task = std::move(m_queue.front());
-        m_queue.pop();
+        // With the mutex locked, take all of the queued strings
+        batch.clear();
+        batch.swap(m_queue);
+        bool error = m_error;
 
         // Temporarily unlock queue mutex, unblocking other threads
         lock.unlock();
 
-        // An empty message indicates the closing of the stream
-        if(!task.size())
-        {
-            // Tell future to wake up
-            task.set_value();
-            break;
-        }
-
-        // Write the data
-        fwrite(task.data(), 1, task.size(), m_file);
+        // An empty message indicates the closing of the stream. Nothing is sent after it.
+        auto   end   = std::find_if(batch.begin(), batch.end(), [](auto& s) { return s.empty(); });
+        size_t count = end - batch.begin();
+        bool   exit  = end != batch.end();
 
-        // Detect any error and flush the C FILE stream
-        if(ferror(m_file) || fflush(m_file))
+        // Write the data, and after an error, discard it so that senders are not blocked
+        if(!error && count && !write_batch(batch, count))
         {
             perror("Error writing log file");
-
-            // Tell future to wake up
-            task.set_value();
-            break;
+            error = true;
         }
 
-        // Promise that the data has been written
-        task.set_value();
-
-        // Re-lock the mutex in preparation for cond.wait
+        // Tell the senders that their strings have been written
         lock.lock();
+        m_error = error;
+        m_written += batch.size();
+        m_done.notify_all();
+
+        if(exit)
+            break;
     }
 }
 
@@ -31,6 +31,9 @@ extern "C" void rocblas_shutdown();
  * or reference Tensile identifiers. tensile_host.hpp defines the interface. *
  *****************************************************************************/
 
+#include "async_initializer.hpp"
+#include "solution_cache.hpp"
+#include "solution_cache_file.hpp"
 #include "tensile_host.hpp"
 //#include <Tensile/AMDGPU.hpp>
 #include <Tensile/Contractions.hpp>
@@ -51,6 +54,7 @@ extern "C" void rocblas_shutdown();
 #include <memory>
 #include <mutex>
 #include <string>
+#include <sys/stat.h>
 #include <type_traits>
 #include <vector>
 
@@ -196,6 +200,18 @@ namespace
         }
     }
 
+    /*******************************************************************
+     * Size of GSU workspace available to Tensile for a handle. We set *
+     * it to max size_t if this is a size query.                       *
+     *******************************************************************/
+    size_t available_workspace_size(rocblas_handle handle)
+    {
+        return handle->is_device_memory_size_query()
+                   ? ~size_t{0}
+                   : (handle->get_available_workspace() / HPA_GSU_WORKSPACE_SIZE_GRANULARITY)
+                         * HPA_GSU_WORKSPACE_SIZE_GRANULARITY;
+    }
+
     /*************************************************************************
      * Class for converting alpha and beta between rocBLAS and Tensile types *
      * By default, alpha and beta are the same type as Tc compute_type       *
@@ -216,9 +232,11 @@ namespace
 
     /****************************************************************
      * Construct a Tensile Problem from a RocblasContractionProblem *
+     * with workspace_size bytes of GSU workspace                   *
      ****************************************************************/
     template <typename Ti, typename To, typename Tc>
-    auto ConstructTensileProblem(const RocblasContractionProblem<Ti, To, Tc>& prob)
+    auto ConstructTensileProblem(const RocblasContractionProblem<Ti, To, Tc>& prob,
+                                 size_t                                       workspace_size)
     {
         // Tensile DataTypes corresponding to rocBLAS data types
         static constexpr Tensile::DataType Tensile_Ti = tensile_datatype<Ti>;
@@ -319,13 +337,6 @@ namespace
                                     {prob.row_stride_d, prob.col_stride_d, prob.batch_stride_d},
                                     prob.buffer_offset_d};
 
-        // Size of GSU workspace. We set it to max size_t if this is a size query.
-        size_t workspace_size
-            = prob.handle->is_device_memory_size_query()
-                  ? ~size_t{0}
-                  : (prob.handle->get_available_workspace() / HPA_GSU_WORKSPACE_SIZE_GRANULARITY)
-                        * HPA_GSU_WORKSPACE_SIZE_GRANULARITY;
-
         // The ContractionProblem
         Tensile::ContractionProblem tensileProblem{a,
                                                    aops,
@@ -398,6 +409,117 @@ namespace
         return tensileProblem;
     }
 
+    // Construct a Tensile Problem with the GSU workspace available to the handle
+    template <typename Ti, typename To, typename Tc>
+    auto ConstructTensileProblem(const RocblasContractionProblem<Ti, To, Tc>& prob)
+    {
+        return ConstructTensileProblem(prob, available_workspace_size(prob.handle));
+    }
+
+    /****************************************************************************
+     * SolutionCacheKey is the normalized descriptor of a contraction problem.  *
+     * It contains every argument which can affect solution selection, and is   *
+     * used as the key of the per-device solution selection cache. The GSU      *
+     * workspace size is that given to selection, which is unbounded unless the *
+     * handle's workspace is too small for the unbounded selection.             *
+     ****************************************************************************/
+    struct SolutionCacheKey
+    {
+        Tensile::DataType          a_type;
+        Tensile::DataType          c_type;
+        Tensile::DataType          compute_type;
+        rocblas_operation          trans_a;
+        rocblas_operation          trans_b;
+        rocblas_gemm_flags         flags;
+        rocblas_atomics_mode       atomics_mode;
+        rocblas_performance_metric performance_metric;
+        size_t                     m, n, k;
+        size_t                     row_stride_a, col_stride_a, batch_stride_a, buffer_offset_a;
+        size_t                     row_stride_b, col_stride_b, batch_stride_b, buffer_offset_b;
+        size_t                     row_stride_c, col_stride_c, batch_stride_c, buffer_offset_c;
+        size_t                     row_stride_d, col_stride_d, batch_stride_d, buffer_offset_d;
+        size_t                     batch_count;
+        size_t                     workspace_size;
+        double                     alpha_category;
+        double                     beta_category;
+        bool                       strided_batch;
+        bool                       c_equals_d;
+
+        template <typename Ti, typename To, typename Tc>
+        SolutionCacheKey(const RocblasContractionProblem<Ti, To, Tc>& prob, size_t workspace_size)
+        {
+            // Clear padding bytes, since the key is hashed and compared bytewise
+            memset(static_cast<void*>(this), 0, sizeof(*this));
+
+            a_type             = tensile_datatype<Ti>;
+            c_type             = tensile_datatype<To>;
+            compute_type       = tensile_datatype<Tc>;
+            trans_a            = prob.trans_a;
+            trans_b            = prob.trans_b;
+            flags              = prob.flags;
+            atomics_mode       = prob.handle->atomics_mode;
+            performance_metric = prob.handle->performance_metric;
+
+            // alpha==0 is normalized into K=0, as in ConstructTensileProblem
+            m = prob.m;
+            n = prob.n;
+            k = prob.k && *prob.alpha ? prob.k : 0;
+
+            row_stride_a    = prob.row_stride_a;
+            col_stride_a    = prob.col_stride_a;
+            batch_stride_a  = prob.batch_stride_a;
+            buffer_offset_a = prob.buffer_offset_a;
+            row_stride_b    = prob.row_stride_b;
+            col_stride_b    = prob.col_stride_b;
+            batch_stride_b  = prob.batch_stride_b;
+            buffer_offset_b = prob.buffer_offset_b;
+            row_stride_c    = prob.row_stride_c;
+            col_stride_c    = prob.col_stride_c;
+            batch_stride_c  = prob.batch_stride_c;
+            buffer_offset_c = prob.buffer_offset_c;
+            row_stride_d    = prob.row_stride_d;
+            col_stride_d    = prob.col_stride_d;
+            batch_stride_d  = prob.batch_stride_d;
+            buffer_offset_d = prob.buffer_offset_d;
+            batch_count     = prob.batch_count;
+            strided_batch   = prob.strided_batch;
+            alpha_category  = prob.k ? value_category(*prob.alpha) : 0.0;
+            beta_category   = value_category(*prob.beta);
+            c_equals_d      = prob.C == prob.D;
+
+            this->workspace_size = workspace_size;
+        }
+    };
+
+    // The cached result of solution selection
+    struct SolutionCacheValue
+    {
+        std::shared_ptr<Tensile::ContractionSolution> solution;
+        size_t                                        workspace_size;
+    };
+
+    using SolutionCache     = rocblas_solution_cache<SolutionCacheKey, SolutionCacheValue>;
+    using SolutionCacheFile = rocblas_solution_cache_file<SolutionCacheKey>;
+
+    /***************************************************************************
+     * The build ID of the library identifies the rocBLAS version and the      *
+     * Tensile library file which was loaded, so that persisted solution       *
+     * indices are only used with the solutions which they were selected from. *
+     ***************************************************************************/
+    std::string tensile_library_build_id(const std::string& tensileLibraryPath)
+    {
+        size_t len = 0;
+        rocblas_get_version_string_size(&len);
+        std::string id(len, '\0');
+        rocblas_get_version_string(&id[0], len);
+        id.resize(strlen(id.c_str()));
+
+        struct stat st;
+        if(!stat(tensileLibraryPath.c_str(), &st))
+            id += ":" + std::to_string(st.st_size) + ":" + std::to_string(st.st_mtime);
+        return id + ":" + tensileLibraryPath;
+    }
+
     /***************************************************************
      * Construct the inputs to a Tensile ContractionProblem        *
      ***************************************************************/
@@ -462,6 +584,9 @@ namespace
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>> m_library;
         std::shared_ptr<hipDeviceProp_t>                                             m_deviceProp;
 
+        // The persistent solution selection cache, if ROCBLAS_SOLUTION_CACHE_PATH is set
+        std::unique_ptr<SolutionCacheFile> m_solution_file;
+
         // The adapter object. mutable is used to allow adapters to be modified
         // even when they are stored in a const vector which is immutable in size
         struct adapter_s
@@ -502,6 +627,10 @@ namespace
 
         ~TensileHost()
         {
+            // Selections made by this process are persisted for the next one
+            if(m_solution_file)
+                m_solution_file->save();
+
             for(auto& a : m_adapters)
                 delete a.adapter;
         }
@@ -516,6 +645,11 @@ namespace
             return m_deviceProp;
         }
 
+        auto* get_solution_file() const
+        {
+            return m_solution_file.get();
+        }
+
         auto& get_adapters() const
         {
             return m_adapters;
@@ -728,6 +862,11 @@ namespace
                         using MSL = Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>;
                         m_library = std::dynamic_pointer_cast<MSL>(lib);
                     }
+
+                    // Open the persistent solution selection cache, if one is requested
+                    if(const char* cache_path = getenv("ROCBLAS_SOLUTION_CACHE_PATH"))
+                        m_solution_file = std::make_unique<SolutionCacheFile>(
+                            cache_path, processor, tensile_library_build_id(tensileLibraryPath));
                     return 0;
                 }();
             }
@@ -745,16 +884,23 @@ namespace
         }
     };
 
+    // The TensileHost is constructed on the first call
+    TensileHost& get_tensile_host()
+    {
+        static TensileHost host;
+        return host;
+    }
+
     // Return the library and adapter for the current HIP device
     auto& get_library_and_adapter(
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>>* library
         = nullptr,
-        std::shared_ptr<hipDeviceProp_t>* deviceProp = nullptr,
-        int                               device     = -1)
+        std::shared_ptr<hipDeviceProp_t>* deviceProp   = nullptr,
+        int                               device       = -1,
+        SolutionCacheFile**               solutionFile = nullptr)
     try
     {
-        // TensileHost is initialized on the first call
-        static TensileHost host;
+        auto& host = get_tensile_host();
 
         if(device == -1)
             hipGetDevice(&device);
@@ -788,6 +934,8 @@ namespace
             *library = host.get_library();
         if(deviceProp)
             *deviceProp = host.get_device_property();
+        if(solutionFile)
+            *solutionFile = host.get_solution_file();
 
         return *adapter;
     }
@@ -805,6 +953,210 @@ namespace
         rocblas_abort();
     }
 
+    /***************************************************************************
+     * Return the solution selection cache for a HIP device. The capacity of   *
+     * each cache is set by ROCBLAS_SOLUTION_CACHE_SIZE; 0 disables caching.   *
+     * An invalid value is reported, and the default capacity is used.         *
+     ***************************************************************************/
+    SolutionCache& get_solution_cache(int device)
+    {
+        static std::vector<SolutionCache> caches = [] {
+            std::vector<SolutionCache> caches(TensileHost::GetDeviceCount());
+            if(const char* env = getenv("ROCBLAS_SOLUTION_CACHE_SIZE"))
+            {
+                size_t capacity;
+                if(rocblas_parse_solution_cache_capacity(env, capacity))
+                {
+                    for(auto& cache : caches)
+                        cache.set_capacity(capacity);
+                }
+                else
+                    rocblas_cerr << "rocBLAS warning: invalid ROCBLAS_SOLUTION_CACHE_SIZE \""
+                                 << env << "\"; the default capacity of "
+                                 << ROCBLAS_SOLUTION_CACHE_DEFAULT_CAPACITY << " is used"
+                                 << std::endl;
+            }
+            return caches;
+        }();
+        return caches.at(device);
+    }
+
+    /***************************************************************************
+     * Look up a persisted solution index in the library. nullptr is returned  *
+     * if the solution has not been loaded, or if it does not support problem. *
+     ***************************************************************************/
+    std::shared_ptr<Tensile::ContractionSolution> FindSolutionByIndex(
+        const Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>& library,
+        int64_t                                                          index,
+        const Tensile::ContractionProblem&                               problem,
+        const Tensile::Hardware&                                         hardware)
+    {
+        auto it = library.solutions.find(int(index));
+        if(it == library.solutions.end() || !it->second)
+            return nullptr;
+        auto& solution = it->second;
+        if(!(*solution->hardwarePredicate)(hardware) || !(*solution->problemPredicate)(problem))
+            return nullptr;
+        return solution;
+    }
+
+    /***************************************************************************
+     * Select the solution for a problem through the solution selection cache, *
+     * consulting the persistent cache before calling findBestSolution.        *
+     *                                                                         *
+     * The solution is first selected as if the GSU workspace were unbounded,  *
+     * so that the selection is shared by handles with any workspace size. If  *
+     * it needs more workspace than the handle has, the solution is selected   *
+     * again with the handle's workspace, and cached under that size.          *
+     ***************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    SolutionCacheValue
+        SelectSolution(const RocblasContractionProblem<Ti, To, Tc>&                 prob,
+                       const Tensile::ContractionProblem&                           tensile_prob,
+                       Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>& library,
+                       const Tensile::Hardware&                                     hardware,
+                       SolutionCacheFile*                                           solutionFile)
+    {
+        auto& cache = get_solution_cache(prob.handle->getDevice());
+
+        // The Tensile problem is only constructed on a miss
+        auto select = [&](const SolutionCacheKey& key, auto&& get_tensile_prob) {
+            return cache.find_or_select(key, [&](SolutionCacheValue& value) {
+                const Tensile::ContractionProblem problem = get_tensile_prob();
+                int64_t                           index;
+                if(solutionFile && solutionFile->find(key, index))
+                    value.solution = FindSolutionByIndex(library, index, problem, hardware);
+                if(!value.solution)
+                {
+                    value.solution = library.findBestSolution(problem, hardware, nullptr);
+                    if(!value.solution)
+                        return false;
+                    if(solutionFile)
+                        solutionFile->insert(key, value.solution->index);
+                }
+                value.workspace_size = value.solution->requiredWorkspaceSize(problem);
+                return true;
+            });
+        };
+
+        constexpr size_t unbounded = ~size_t{0};
+        auto             selected  = select(SolutionCacheKey(prob, unbounded),
+                                 [&] { return ConstructTensileProblem(prob, unbounded); });
+
+        size_t available = available_workspace_size(prob.handle);
+        if(!selected.solution || selected.workspace_size <= available)
+            return selected;
+        return select(SolutionCacheKey(prob, available), [&] { return tensile_prob; });
+    }
+
+    /***************************************************************************
+     * Select the solution for a gemm shape as rocblas_<t>gemm_strided_batched *
+     * would for a handle with the default settings, without running it. The   *
+     * selection is shared by handles with any workspace size which fits it.   *
+     * Returns false if no solution is found.                                  *
+     ***************************************************************************/
+    template <typename T>
+    bool PreresolveGemm(rocblas_handle handle, const rocblas_gemm_shape& shape)
+    {
+        // Quick returns do not select a solution
+        if(!shape.m || !shape.n || !shape.batch_count
+           || (shape.beta == 1 && (!shape.k || !shape.alpha)))
+            return true;
+
+        // Only the categories of alpha and beta affect solution selection
+        T alpha(value_category(shape.alpha));
+        T beta(value_category(shape.beta));
+
+        RocblasContractionProblem<T> prob{handle,         shape.trans_a,
+                                          shape.trans_b,  shape.m,
+                                          shape.n,        shape.k,
+                                          &alpha,         nullptr,
+                                          nullptr,        shape.lda,
+                                          shape.stride_a, 0,
+                                          nullptr,        nullptr,
+                                          shape.ldb,      shape.stride_b,
+                                          0,              &beta,
+                                          nullptr,        nullptr,
+                                          shape.ldc,      shape.stride_c,
+                                          0,              shape.batch_count,
+                                          true,           rocblas_gemm_flags_none};
+
+        if(!get_solution_cache(handle->getDevice()).enabled())
+            return true;
+
+        std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>> library;
+        std::shared_ptr<hipDeviceProp_t>                                             deviceProp;
+        SolutionCacheFile*                                                           solutionFile;
+
+        get_library_and_adapter(&library, &deviceProp, handle->getDevice(), &solutionFile);
+        auto hardware     = Tensile::hip::GetDevice(*deviceProp);
+        auto tensile_prob = ConstructTensileProblem(prob);
+        return SelectSolution(prob, tensile_prob, *library, *hardware, solutionFile).solution
+               != nullptr;
+    }
+
+    bool PreresolveGemm(rocblas_handle handle, const rocblas_gemm_shape& shape)
+    {
+        switch(shape.type)
+        {
+        case rocblas_datatype_f16_r:
+            return PreresolveGemm<rocblas_half>(handle, shape);
+        case rocblas_datatype_f32_r:
+            return PreresolveGemm<float>(handle, shape);
+        case rocblas_datatype_f64_r:
+            return PreresolveGemm<double>(handle, shape);
+        case rocblas_datatype_f32_c:
+            return PreresolveGemm<rocblas_float_complex>(handle, shape);
+        case rocblas_datatype_f64_c:
+            return PreresolveGemm<rocblas_double_complex>(handle, shape);
+        default:
+            return false;
+        }
+    }
+
+    // Validate a gemm shape as validateArgs would, returning rocblas_status_continue if valid
+    rocblas_status ValidateGemmShape(const rocblas_gemm_shape& shape)
+    {
+        switch(shape.type)
+        {
+        case rocblas_datatype_f16_r:
+        case rocblas_datatype_f32_r:
+        case rocblas_datatype_f64_r:
+        case rocblas_datatype_f32_c:
+        case rocblas_datatype_f64_c:
+            break;
+        default:
+            return rocblas_status_invalid_value;
+        }
+
+        for(auto trans : {shape.trans_a, shape.trans_b})
+            if(trans != rocblas_operation_none && trans != rocblas_operation_transpose
+               && trans != rocblas_operation_conjugate_transpose)
+                return rocblas_status_invalid_value;
+
+        if(shape.m < 0 || shape.n < 0 || shape.k < 0 || shape.batch_count < 0)
+            return rocblas_status_invalid_size;
+
+        rocblas_int num_rows_a = shape.trans_a == rocblas_operation_none ? shape.m : shape.k;
+        rocblas_int num_rows_b = shape.trans_b == rocblas_operation_none ? shape.k : shape.n;
+        if(num_rows_a > shape.lda || num_rows_b > shape.ldb || shape.m > shape.ldc)
+            return rocblas_status_invalid_size;
+
+        return rocblas_status_continue;
+    }
+
+    /****************************************************************************
+     * The background initializer of rocblas_initialize_async. The TensileHost  *
+     * is constructed first, so that it is destroyed after the initializer has  *
+     * finished running its tasks.                                              *
+     ****************************************************************************/
+    rocblas_async_initializer& get_async_initializer()
+    {
+        get_tensile_host();
+        static rocblas_async_initializer init;
+        return init;
+    }
+
     /**************************************************************************
     * We normally print error messages only once, to avoid excessive logging *
     **************************************************************************/
@@ -842,16 +1194,33 @@ rocblas_status runContractionProblem(const RocblasContractionProblem<Ti, To, Tc>
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>> library;
         std::shared_ptr<hipDeviceProp_t>                                             deviceProp;
         std::shared_ptr<Tensile::Hardware>                                           hardware;
+        SolutionCacheFile*                                                           solutionFile;
 
-        auto& adapter = get_library_and_adapter(&library, &deviceProp, prob.handle->getDevice());
+        auto& adapter = get_library_and_adapter(
+            &library, &deviceProp, prob.handle->getDevice(), &solutionFile);
 
         hardware = Tensile::hip::GetDevice(*deviceProp);
 
-        auto  tensile_prob  = ConstructTensileProblem(prob);
-        auto  handle        = prob.handle;
-        auto* fitness_query = handle->get_solution_fitness_query();
+        auto   tensile_prob  = ConstructTensileProblem(prob);
+        auto   handle        = prob.handle;
+        auto*  fitness_query = handle->get_solution_fitness_query();
+        auto&  cache         = get_solution_cache(handle->getDevice());
+        size_t WorkspaceSize = 0;
 
-        solution = library->findBestSolution(tensile_prob, *hardware, fitness_query);
+        // Solution selection is memoized, except for fitness and device memory size queries.
+        // On a miss, the persistent cache is consulted before selecting a solution.
+        if(fitness_query || handle->is_device_memory_size_query() || !cache.enabled())
+        {
+            solution = library->findBestSolution(tensile_prob, *hardware, fitness_query);
+            if(solution)
+                WorkspaceSize = solution->requiredWorkspaceSize(tensile_prob);
+        }
+        else
+        {
+            auto selected = SelectSolution(prob, tensile_prob, *library, *hardware, solutionFile);
+            solution      = std::move(selected.solution);
+            WorkspaceSize = selected.workspace_size;
+        }
 
         if(!solution)
         {
@@ -866,16 +1235,14 @@ rocblas_status runContractionProblem(const RocblasContractionProblem<Ti, To, Tc>
             else if(handle->is_device_memory_size_query())
             {
                 status = handle->set_optimal_device_memory_size(
-                    ((solution->requiredWorkspaceSize(tensile_prob)
-                      + HPA_GSU_WORKSPACE_SIZE_GRANULARITY - 1)
+                    ((WorkspaceSize + HPA_GSU_WORKSPACE_SIZE_GRANULARITY - 1)
                      / HPA_GSU_WORKSPACE_SIZE_GRANULARITY)
                     * HPA_GSU_WORKSPACE_SIZE_GRANULARITY);
             }
             else
             {
                 // check if the solution requires workspace for GSU and allocate it.
-                size_t WorkspaceSize = solution->requiredWorkspaceSize(tensile_prob);
-                auto   gsu_malloc    = prob.handle->gsu_malloc_by_size(WorkspaceSize);
+                auto gsu_malloc = prob.handle->gsu_malloc_by_size(WorkspaceSize);
 
                 adapter.launchKernels(
                     solution->solve(tensile_prob, GetTensileInputs(prob), *hardware),
@@ -912,6 +1279,130 @@ extern "C" void rocblas_initialize()
     get_library_and_adapter();
 }
 
+/*******************************************************************************
+ * ! \brief  Initialize rocBLAS for the current HIP device on a background     *
+ * thread, and select the solutions of the given gemm shapes in advance        *
+ *******************************************************************************/
+extern "C" rocblas_status rocblas_initialize_async(const rocblas_gemm_shape* shapes,
+                                                   rocblas_int               count)
+try
+{
+    if(count < 0)
+        return rocblas_status_invalid_size;
+    if(count && !shapes)
+        return rocblas_status_invalid_pointer;
+    for(rocblas_int i = 0; i < count; ++i)
+    {
+        rocblas_status status = ValidateGemmShape(shapes[i]);
+        if(status != rocblas_status_continue)
+            return status;
+    }
+
+    int device;
+    RETURN_IF_HIP_ERROR(hipGetDevice(&device));
+
+    rocblas_initialize_called() = true;
+
+    // Shapes are resolved with a handle with the default settings, created after loading
+    auto handle = std::make_shared<std::unique_ptr<_rocblas_handle>>();
+
+    std::vector<rocblas_async_initializer::task> tasks;
+    tasks.push_back([=] {
+        if(hipSetDevice(device) != hipSuccess)
+            return false;
+        get_library_and_adapter(nullptr, nullptr, device);
+        if(count)
+            handle->reset(new _rocblas_handle);
+        return true;
+    });
+    for(rocblas_int i = 0; i < count; ++i)
+        tasks.push_back(
+            [=, shape = shapes[i]] { return *handle && PreresolveGemm(handle->get(), shape); });
+
+    get_async_initializer().submit(std::move(tasks));
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * ! \brief  Query the progress of rocblas_initialize_async                    *
+ *******************************************************************************/
+extern "C" rocblas_status
+    rocblas_get_initialize_progress(rocblas_int* ready, size_t* completed, size_t* total)
+try
+{
+    if(!ready || !completed || !total)
+        return rocblas_status_invalid_pointer;
+    *ready = get_async_initializer().progress(*completed, *total);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * ! \brief  Query the solution selection cache for the handle's HIP device    *
+ *******************************************************************************/
+extern "C" rocblas_status rocblas_get_solution_cache_stats(
+    rocblas_handle handle, size_t* hits, size_t* misses, size_t* evictions, size_t* size)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!hits || !misses || !evictions || !size)
+        return rocblas_status_invalid_pointer;
+
+    auto& cache = get_solution_cache(handle->getDevice());
+    *hits       = cache.hits();
+    *misses     = cache.misses();
+    *evictions  = cache.evictions();
+    *size       = cache.size();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * ! \brief  Set the capacity of the solution selection cache for the handle's *
+ * HIP device. A capacity of 0 disables the cache.                             *
+ *******************************************************************************/
+extern "C" rocblas_status rocblas_set_solution_cache_capacity(rocblas_handle handle,
+                                                              size_t         capacity)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    get_solution_cache(handle->getDevice()).set_capacity(capacity);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * ! \brief  Clear the solution selection cache for the handle's HIP device,   *
+ * and reset its counters                                                      *
+ *******************************************************************************/
+extern "C" rocblas_status rocblas_clear_solution_cache(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    get_solution_cache(handle->getDevice()).clear();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
 /******************************************************************************
  * Intantiate the cases of runContractionProblem which are needed to satisfy  *
  * rocBLAS dependencies. This file's template functions are not defined in a  *